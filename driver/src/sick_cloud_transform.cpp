@@ -96,6 +96,27 @@ sick_scan_xd::SickCloudTransform::SickCloudTransform(rosNodePtr nh, const std::s
 
 // Initializes rotation matrix and translation vector from a 6D pose configuration (x,y,z,roll,pitch,yaw) in [m] resp. [rad]
 bool sick_scan_xd::SickCloudTransform::init(const std::string& add_transform_xyz_rpy, bool cartesian_input_only, bool add_transform_check_dynamic_updates)
+{
+    TransformSnapshot snapshot;
+    if (!parse(add_transform_xyz_rpy, cartesian_input_only, snapshot))
+    {
+        return false;
+    }
+    // Initialization successful
+    m_snapshot = std::make_shared<const TransformSnapshot>(snapshot);
+    m_cartesian_input_only = cartesian_input_only;
+    m_add_transform_check_dynamic_updates = add_transform_check_dynamic_updates;
+    m_watcher = 0;
+    if (m_add_transform_check_dynamic_updates && m_nh)
+    {
+        m_watcher = std::make_shared<DynamicUpdateWatcher>(m_nh, m_snapshot, m_cartesian_input_only);
+    }
+    ROS_INFO_STREAM("SickCloudTransform: check_dynamic_updates = " << (m_add_transform_check_dynamic_updates ? "true" : "false"));
+    return true;
+}
+
+// Computes the transform snapshot from a 6D pose configuration (x,y,z,roll,pitch,yaw) in [m] resp. [rad]
+bool sick_scan_xd::SickCloudTransform::parse(const std::string& add_transform_xyz_rpy, bool cartesian_input_only, TransformSnapshot& snapshot)
 {
     // Split string add_transform_xyz_rpy to 6D pose x,y,z,roll,pitch,yaw in [m] resp. [rad]
     std::istringstream config_stream(add_transform_xyz_rpy);
@@ -123,18 +144,18 @@ bool sick_scan_xd::SickCloudTransform::init(const std::string& add_transform_xyz
         ROS_ERROR_STREAM("## ERROR SickCloudTransform(): Can't parse config string \"" << add_transform_xyz_rpy << "\", use 6D pose \"x,y,z,roll,pitch,yaw\" in [m] resp. [rad]");
         return false;
     }
-    m_translation_vector[0] = config_values[0];
-    m_translation_vector[1] = config_values[1];
-    m_translation_vector[2] = config_values[2];
-    m_apply_3x3_rotation = false;
-    m_rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 }; // 3x3 identity
-    m_azimuth_offset = 0;
+    snapshot.translation_vector[0] = config_values[0];
+    snapshot.translation_vector[1] = config_values[1];
+    snapshot.translation_vector[2] = config_values[2];
+    snapshot.apply_3x3_rotation = false;
+    snapshot.rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 }; // 3x3 identity
+    snapshot.azimuth_offset = 0;
     if (cartesian_input_only)
     {
         if (fabs(config_values[3]) > FLT_EPSILON || fabs(config_values[4]) > FLT_EPSILON || fabs(config_values[5]) > FLT_EPSILON)
         {
-            m_apply_3x3_rotation = true; // i.e. we have to apply the 3x3 rotation matrix to the cartesian pointclouds
-            m_rotation_matrix = eulerToRot3x3(config_values[3], config_values[4], config_values[5]);
+            snapshot.apply_3x3_rotation = true; // i.e. we have to apply the 3x3 rotation matrix to the cartesian pointclouds
+            snapshot.rotation_matrix = eulerToRot3x3(config_values[3], config_values[4], config_values[5]);
         }
     }
     else
@@ -143,33 +164,81 @@ bool sick_scan_xd::SickCloudTransform::init(const std::string& add_transform_xyz
         {
             // roll == 0, pitch == 0, i.e. only yaw (rotation about z-axis) is configured. In this case an offset can be added to the lidar azimuth
             // before conversion to cartesian pointcloud, which is faster than a 3x3 matrix multiplication.
-            m_apply_3x3_rotation = false; // roll == 0, pitch == 0, offset for azimuth is sufficient
-            m_rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 }; // 3x3 identity
-            m_azimuth_offset = config_values[5];   // azimuth offset := yaw in [rad]
+            snapshot.apply_3x3_rotation = false; // roll == 0, pitch == 0, offset for azimuth is sufficient
+            snapshot.rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 }; // 3x3 identity
+            snapshot.azimuth_offset = config_values[5];   // azimuth offset := yaw in [rad]
         }
         else
         {
-            m_apply_3x3_rotation = true; // i.e. we have to apply the 3x3 rotation matrix to the cartesian pointclouds
-            m_rotation_matrix = eulerToRot3x3(config_values[3], config_values[4], config_values[5]);
-            m_azimuth_offset = 0;
+            snapshot.apply_3x3_rotation = true; // i.e. we have to apply the 3x3 rotation matrix to the cartesian pointclouds
+            snapshot.rotation_matrix = eulerToRot3x3(config_values[3], config_values[4], config_values[5]);
+            snapshot.azimuth_offset = 0;
         }
     }
-    // Initialization successful
-    m_add_transform_xyz_rpy = add_transform_xyz_rpy;
-    m_cartesian_input_only = cartesian_input_only;
-    m_add_transform_check_dynamic_updates = add_transform_check_dynamic_updates;
+    snapshot.add_transform_xyz_rpy = add_transform_xyz_rpy;
     ROS_INFO_STREAM("SickCloudTransform: add_transform_xyz_rpy = (" << add_transform_xyz_rpy << ")");
-    ROS_INFO_STREAM("SickCloudTransform: azimuth_offset = " << (m_azimuth_offset * 180.0 / M_PI) << " [deg]");
+    ROS_INFO_STREAM("SickCloudTransform: azimuth_offset = " << (snapshot.azimuth_offset * 180.0 / M_PI) << " [deg]");
     ROS_INFO_STREAM("SickCloudTransform: additional 3x3 rotation matrix = { (" 
-        << m_rotation_matrix[0][0] << "," << m_rotation_matrix[0][1] << "," << m_rotation_matrix[0][2] << "), (" 
-        << m_rotation_matrix[1][0] << "," << m_rotation_matrix[1][1] << "," << m_rotation_matrix[1][2] << "), (" 
-        << m_rotation_matrix[2][0] << "," << m_rotation_matrix[2][1] << "," << m_rotation_matrix[2][2] << ") }");
-    ROS_INFO_STREAM("SickCloudTransform: apply 3x3 rotation = " << (m_apply_3x3_rotation ? "true" : "false"));
-    ROS_INFO_STREAM("SickCloudTransform: additional translation = (" << m_translation_vector[0] << "," << m_translation_vector[1] << "," << m_translation_vector[2] << ")");
-    ROS_INFO_STREAM("SickCloudTransform: check_dynamic_updates = " << (m_add_transform_check_dynamic_updates ? "true" : "false"));
+        << snapshot.rotation_matrix[0][0] << "," << snapshot.rotation_matrix[0][1] << "," << snapshot.rotation_matrix[0][2] << "), (" 
+        << snapshot.rotation_matrix[1][0] << "," << snapshot.rotation_matrix[1][1] << "," << snapshot.rotation_matrix[1][2] << "), (" 
+        << snapshot.rotation_matrix[2][0] << "," << snapshot.rotation_matrix[2][1] << "," << snapshot.rotation_matrix[2][2] << ") }");
+    ROS_INFO_STREAM("SickCloudTransform: apply 3x3 rotation = " << (snapshot.apply_3x3_rotation ? "true" : "false"));
+    ROS_INFO_STREAM("SickCloudTransform: additional translation = (" << snapshot.translation_vector[0] << "," << snapshot.translation_vector[1] << "," << snapshot.translation_vector[2] << ")");
     return true;
 }
 
+// Starts the watcher thread for dynamic updates of parameter "add_transform_xyz_rpy"
+sick_scan_xd::SickCloudTransform::DynamicUpdateWatcher::DynamicUpdateWatcher(rosNodePtr nh, const TransformSnapshotPtr& snapshot, bool cartesian_input_only)
+: m_nh(nh), m_cartesian_input_only(cartesian_input_only)
+{
+    std::atomic_store(&m_current, snapshot);
+    m_run_watcher_thread = true;
+    m_watcher_thread = new std::thread(&sick_scan_xd::SickCloudTransform::DynamicUpdateWatcher::runWatcherThreadCb, this);
+}
+
+// Stops the watcher thread
+sick_scan_xd::SickCloudTransform::DynamicUpdateWatcher::~DynamicUpdateWatcher()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_watcher_mutex);
+        m_run_watcher_thread = false;
+    }
+    m_watcher_cond.notify_all();
+    if (m_watcher_thread)
+    {
+        if (m_watcher_thread->joinable())
+            m_watcher_thread->join();
+        delete m_watcher_thread;
+        m_watcher_thread = 0;
+    }
+}
+
+// Thread callback, checks parameter "add_transform_xyz_rpy" and swaps the transform snapshot after parameter changes
+void sick_scan_xd::SickCloudTransform::DynamicUpdateWatcher::runWatcherThreadCb(void)
+{
+    std::unique_lock<std::mutex> lock(m_watcher_mutex);
+    while (m_run_watcher_thread)
+    {
+        m_watcher_cond.wait_for(lock, std::chrono::milliseconds(m_check_interval_millisec), [this] { return !m_run_watcher_thread; });
+        if (!m_run_watcher_thread || !rosOk())
+            break;
+        TransformSnapshotPtr current_snapshot = current();
+        std::string add_transform_xyz_rpy = current_snapshot->add_transform_xyz_rpy;
+        rosGetParam(m_nh, "add_transform_xyz_rpy", add_transform_xyz_rpy);
+        if (add_transform_xyz_rpy != current_snapshot->add_transform_xyz_rpy && add_transform_xyz_rpy != m_invalid_add_transform_xyz_rpy)
+        {
+            TransformSnapshot snapshot;
+            if (!parse(add_transform_xyz_rpy, m_cartesian_input_only, snapshot))
+            {
+                ROS_ERROR_STREAM("## ERROR SickCloudTransform(): Re-Initialization by \"" << add_transform_xyz_rpy << "\" failed, use 6D pose \"x,y,z,roll,pitch,yaw\" in [m] resp. [rad]");
+                m_invalid_add_transform_xyz_rpy = add_transform_xyz_rpy;
+                continue;
+            }
+            std::atomic_store(&m_current, std::make_shared<const TransformSnapshot>(snapshot)); // previous snapshot is released by its last reader
+        }
+    }
+}
+
 // converts roll (rotation about X), pitch (rotation about Y), yaw (rotation about Z) to 3x3 rotation matrix
 sick_scan_xd::SickCloudTransform::Matrix3x3 sick_scan_xd::SickCloudTransform::eulerToRot3x3(float roll, float pitch, float yaw)
 {
@@ -86,6 +86,11 @@ namespace sick_scan_xd
         return s_cartesian_poincloud_callback_handler.isListenerRegistered(handle, listener);
 	}
 
+    bool hasCartesianPointcloudListener(rosNodePtr handle)
+    {
+        return s_cartesian_poincloud_callback_handler.hasListeners(handle);
+	}
+
     void addPolarPointcloudListener(rosNodePtr handle, PointCloud2Callback listener)
     {
         s_polar_poincloud_callback_handler.addListener(handle, listener);
@@ -106,6 +111,11 @@ namespace sick_scan_xd
         return s_polar_poincloud_callback_handler.isListenerRegistered(handle, listener);
 	}
 
+    bool hasPolarPointcloudListener(rosNodePtr handle)
+    {
+        return s_polar_poincloud_callback_handler.hasListeners(handle);
+	}
+
     void addImuListener(rosNodePtr handle, ImuCallback listener)
     {
         s_imu_callback_handler.addListener(handle, listener);
@@ -151,8 +151,25 @@ namespace sick_scan_xd
   /* Null, because instance will be initialized on demand. */
   SickScanFieldMonSingleton *SickScanFieldMonSingleton::instance = 0;
 
+  /* Field monitoring instance of the lidar processed by the current thread, or 0 (process wide instance) */
+  static thread_local SickScanFieldMonSingleton *s_bound_field_mon_instance = 0;
+
+  SickScanFieldMonSingleton::ScopedInstance::ScopedInstance(SickScanFieldMonSingleton* field_mon) : m_prev_instance(s_bound_field_mon_instance)
+  {
+    s_bound_field_mon_instance = field_mon;
+  }
+
+  SickScanFieldMonSingleton::ScopedInstance::~ScopedInstance()
+  {
+    s_bound_field_mon_instance = m_prev_instance;
+  }
+
   SickScanFieldMonSingleton *SickScanFieldMonSingleton::getInstance()
   {
+    if (s_bound_field_mon_instance)
+    {
+      return s_bound_field_mon_instance;
+    }
     if (instance == 0)
     {
       instance = new SickScanFieldMonSingleton();
@@ -558,13 +558,6 @@ namespace sick_scan_xd
 
     SickScanImuValue imuValue;
     ros_sensor_msgs::Imu imuMsg_;
-    static rosTime lastTimeStamp;
-
-    static double lastRoll = 0.0;
-    static double lastPitch = 0.0;
-    static double lastYaw = 0.0;
-
-    static bool firstTime = true;
     /*
     static int cnt = 0;
     static u_int32_t timeStampSecBuffer[1000];
@@ -86,6 +86,9 @@
 #define _USE_MATH_DEFINES
 
 #include <math.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
@@ -97,8 +100,6 @@
 
 #define DELETE_PTR(p) if(p){delete(p);p=0;}
 
-static bool isInitialized = false;
-static sick_scan_xd::SickScanCommonTcp *s_scanner = NULL;
 static std::string versionInfo = std::string(SICK_GENERIC_MAJOR_VER) + '.' + std::string(SICK_GENERIC_MINOR_VER) + '.' + std::string(SICK_GENERIC_PATCH_LEVEL);
 static bool s_shutdownSignalReceived = false;
 
@@ -142,9 +143,50 @@ public:
   std::thread* generic_laser_thread;
 };
 
-static GenericLaserCallable* s_generic_laser_thread = 0;
+/*
+* State of a lidar processed by mainGenericLaserInternal. Multiple lidars can run in one process (e.g. multiple
+* sick_scan_xd api instances), each lidar has its own GenericLaserInstance identified by its node handle.
+*/
+class GenericLaserInstance
+{
+public:
+  sick_scan_xd::SickScanCommonTcp* scanner = 0;
+  NodeRunState runState = scanner_init;
+  bool isInitialized = false;
+  GenericLaserCallable* generic_laser_thread = 0;
+};
+
+typedef std::shared_ptr<GenericLaserInstance> GenericLaserInstancePtr;
+static std::map<rosNodePtr, GenericLaserInstancePtr> s_generic_laser_instances; // all lidars of this process, key: node handle
+static std::mutex s_generic_laser_instances_mutex; // protects s_generic_laser_instances
+
+// Returns the GenericLaserInstance of a node handle, a new instance is created on first call
+static GenericLaserInstancePtr getGenericLaserInstance(rosNodePtr nhPriv)
+{
+  std::lock_guard<std::mutex> lock(s_generic_laser_instances_mutex);
+  GenericLaserInstancePtr& instance = s_generic_laser_instances[nhPriv];
+  if (!instance)
+    instance = std::make_shared<GenericLaserInstance>();
+  return instance;
+}
+
+// Returns a copy of all GenericLaserInstances
+static std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>> getGenericLaserInstances(void)
+{
+  std::lock_guard<std::mutex> lock(s_generic_laser_instances_mutex);
+  return std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>>(s_generic_laser_instances.begin(), s_generic_laser_instances.end());
+}
+
+// Removes the GenericLaserInstance of a node handle after shutdown. The entry is only removed if it is still the given instance,
+// i.e. a new lidar started with the same node handle is kept. Callers still holding the instance keep it valid until they release it.
+static void eraseGenericLaserInstance(rosNodePtr nhPriv, const GenericLaserInstancePtr& instance)
+{
+  std::lock_guard<std::mutex> lock(s_generic_laser_instances_mutex);
+  std::map<rosNodePtr, GenericLaserInstancePtr>::iterator iter = s_generic_laser_instances.find(nhPriv);
+  if (iter != s_generic_laser_instances.end() && iter->second == instance)
+    s_generic_laser_instances.erase(iter);
+}
 
-static NodeRunState runState = scanner_init;
 SICK_DIAGNOSTIC_STATUS s_status_code = SICK_DIAGNOSTIC_STATUS::INIT;
 std::string s_status_message = "";
 
@@ -176,22 +218,59 @@ bool getTagVal(std::string tagVal, std::string &tag, std::string &val)
   return (ret);
 }
 
-bool stopScannerAndExit(bool force_immediate_shutdown)
+static bool stopGenericLaserInstance(const GenericLaserInstancePtr& instance, bool force_immediate_shutdown)
 {
   bool success = true;
-  if (s_scanner != NULL)
+  if (instance->scanner != NULL)
   {
-    if (isInitialized)
+    if (instance->isInitialized)
     {
-      success = s_scanner->stopScanData(force_immediate_shutdown);
+      success = instance->scanner->stopScanData(force_immediate_shutdown);
     }
-    runState = scanner_finalize;
+    instance->runState = scanner_finalize;
     setDiagnosticStatus(SICK_DIAGNOSTIC_STATUS::EXIT, "sick_scan_xd exit");
   }
+  return success;
+}
+
+bool stopScannerAndExit(bool force_immediate_shutdown)
+{
+  bool success = true;
+  std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>> instances = getGenericLaserInstances();
+  for (size_t n = 0; n < instances.size(); n++)
+  {
+    success = stopGenericLaserInstance(instances[n].second, force_immediate_shutdown) && success;
+  }
   joinGenericLaser();
   return success;
 }
 
+bool stopScannerAndExit(rosNodePtr nhPriv, bool force_immediate_shutdown)
+{
+  GenericLaserInstancePtr instance = getGenericLaserInstance(nhPriv);
+  bool success = stopGenericLaserInstance(instance, force_immediate_shutdown);
+  if (instance->generic_laser_thread != 0)
+  {
+    instance->generic_laser_thread->join();
+    delete instance->generic_laser_thread;
+    instance->generic_laser_thread = 0;
+  }
+  eraseGenericLaserInstance(nhPriv, instance);
+  return success;
+}
+
+size_t numberOfGenericLaserThreads(void)
+{
+  size_t num_threads = 0;
+  std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>> instances = getGenericLaserInstances();
+  for (size_t n = 0; n < instances.size(); n++)
+  {
+    if (instances[n].second->generic_laser_thread != 0)
+      num_threads++;
+  }
+  return num_threads;
+}
+
 bool shutdownSignalReceived()
 {
  return s_shutdownSignalReceived;
@@ -346,6 +425,9 @@ bool parseLaunchfileSetParameter(rosNodePtr nhPriv, int argc, char **argv)
 */
 void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNodePtr nhPriv, bool do_ros_spin, int & exit_code)
 {
+  GenericLaserInstancePtr instance = getGenericLaserInstance(nhPriv); // keeps the instance valid until mainGenericLaserInternal returns
+  sick_scan_xd::SickScanCommonTcp*& scanner = instance->scanner;
+  NodeRunState& runState = instance->runState;
   std::string tag;
   std::string val;
 
@@ -620,10 +702,10 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
         setDiagnosticStatus(SICK_DIAGNOSTIC_STATUS::INIT, "sick_scan_xd initializing " + hostname + ":" + port);
         ROS_INFO_STREAM("Start initialising scanner [Ip: " << hostname  << "] [Port:" << port << "]");
         // attempt to connect/reconnect
-        DELETE_PTR(s_scanner);  // disconnect scanner
+        DELETE_PTR(scanner);  // disconnect scanner
         if (useTCP)
         {
-          s_scanner = new sick_scan_xd::SickScanCommonTcp(hostname, port, timelimit, nhPriv, parser, colaDialectId);
+          scanner = new sick_scan_xd::SickScanCommonTcp(hostname, port, timelimit, nhPriv, parser, colaDialectId);
         }
         else
         {
@@ -633,9 +715,9 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
 
         if (emulSensor)
         {
-          s_scanner->setEmulSensor(true);
+          scanner->setEmulSensor(true);
         }
-        exit_code = s_scanner->init(nhPriv);
+        exit_code = scanner->init(nhPriv);
         if (exit_code == sick_scan_xd::ExitError || exit_code == sick_scan_xd::ExitFatal)
         {
 		      ROS_ERROR("## ERROR in mainGenericLaser: init failed, retrying..."); // ROS_ERROR("init failed, shutting down");
@@ -647,11 +729,11 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
         rosGetParam(nhPriv, "start_services", start_services);
         if (true == start_services)
         {
-            services = new sick_scan_xd::SickScanServices(nhPriv, s_scanner, parser->getCurrentParamPtr());
+            services = new sick_scan_xd::SickScanServices(nhPriv, scanner, parser->getCurrentParamPtr());
             ROS_INFO("SickScanServices: ros services initialized");
         }
 
-        isInitialized = true;
+        instance->isInitialized = true;
         // signal(SIGINT, SIG_DFL); // change back to standard signal handler after initialising
 
         if (exit_code == sick_scan_xd::ExitSuccess) // OK -> loop again
@@ -686,11 +768,11 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
           {
             rosSpinOnce(nhPriv);
           }
-          exit_code = s_scanner->loopOnce(nhPriv);
+          exit_code = scanner->loopOnce(nhPriv);
 
           if(scan_msg_monitor && message_monitoring_enabled) // Monitor scanner messages
           {
-            exit_code = scan_msg_monitor->checkStateReinitOnError(nhPriv, runState, s_scanner, parser, services);
+            exit_code = scan_msg_monitor->checkStateReinitOnError(nhPriv, runState, scanner, parser, services);
             if(exit_code == sick_scan_xd::ExitSuccess) // monitoring reports normal operation
             {
               setDiagnosticStatus(SICK_DIAGNOSTIC_STATUS::OK, "");
@@ -725,7 +807,7 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
   DELETE_PTR(scan_msg_monitor);
   DELETE_PTR(pointcloud_monitor);
   DELETE_PTR(services);
-  DELETE_PTR(s_scanner); // close connnect
+  DELETE_PTR(scanner); // close connnect
   DELETE_PTR(parser); // close parser
   return;
 }
@@ -742,12 +824,13 @@ void mainGenericLaserInternal(int argc, char **argv, std::string nodeName, rosNo
 */
 bool startGenericLaser(int argc, char **argv, std::string nodeName, rosNodePtr nhPriv, int* exit_code)
 {
-  if (s_generic_laser_thread == 0)
+  GenericLaserInstancePtr instance = getGenericLaserInstance(nhPriv);
+  if (instance->generic_laser_thread == 0)
   {
-    runState = scanner_init;
-    s_generic_laser_thread = new GenericLaserCallable(argc, argv, nodeName, nhPriv, exit_code);
+    instance->runState = scanner_init;
+    instance->generic_laser_thread = new GenericLaserCallable(argc, argv, nodeName, nhPriv, exit_code);
   }
-  return (s_generic_laser_thread != 0);
+  return (instance->generic_laser_thread != 0);
 }
 
 /*!
@@ -755,12 +838,17 @@ bool startGenericLaser(int argc, char **argv, std::string nodeName, rosNodePtr n
 */
 void joinGenericLaser(void)
 {
-  if (s_generic_laser_thread != 0)
+  std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>> instances = getGenericLaserInstances();
+  for (size_t n = 0; n < instances.size(); n++)
   {
-
-    s_generic_laser_thread->join();
-    delete s_generic_laser_thread;
-    s_generic_laser_thread = 0;
+    GenericLaserInstancePtr instance = instances[n].second;
+    if (instance->generic_laser_thread != 0)
+    {
+      instance->generic_laser_thread->join();
+      delete instance->generic_laser_thread;
+      instance->generic_laser_thread = 0;
+      eraseGenericLaserInstance(instances[n].first, instance);
+    }
   }
 }
 
@@ -775,7 +863,9 @@ void joinGenericLaser(void)
 int mainGenericLaser(int argc, char **argv, std::string nodeName, rosNodePtr nhPriv)
 {
   int result;
+  GenericLaserInstancePtr instance = getGenericLaserInstance(nhPriv);
   mainGenericLaserInternal(argc, argv, nodeName, nhPriv, true, result);
+  eraseGenericLaserInstance(nhPriv, instance);
   return result;
 }
 
@@ -783,9 +873,21 @@ int mainGenericLaser(int argc, char **argv, std::string nodeName, rosNodePtr nhP
 #include "softwarePLL.h"
 #include "sick_scan_api.h"
 #include "sick_scan/sick_nav_scandata_parser.h"
+// Returns the lidar of an api handle, or 0 if the lidar is not initialized
+static sick_scan_xd::SickScanCommonTcp* getApiScanner(SickScanApiHandle apiHandle)
+{
+  std::vector<std::pair<rosNodePtr, GenericLaserInstancePtr>> instances = getGenericLaserInstances();
+  for (size_t n = 0; n < instances.size(); n++)
+  {
+    if ((SickScanApiHandle)(&(*instances[n].first)) == apiHandle)
+      return instances[n].second->scanner;
+  }
+  return 0;
+}
 int32_t SickScanApiNavOdomVelocityImpl(SickScanApiHandle apiHandle, SickScanNavOdomVelocityMsg* src_msg) // odometry data in nav coordinates
 {
-  if(s_scanner)
+  sick_scan_xd::SickScanCommonTcp* scanner = getApiScanner(apiHandle);
+  if(scanner)
   {
     sick_scan_msg::NAVOdomVelocity nav_msg;
     nav_msg.vel_x = src_msg->vel_x;
@@ -793,24 +895,25 @@ int32_t SickScanApiNavOdomVelocityImpl(SickScanApiHandle apiHandle, SickScanNavO
     nav_msg.omega = src_msg->omega;
     nav_msg.timestamp = src_msg->timestamp;
     nav_msg.coordbase = src_msg->coordbase;
-    s_scanner->messageCbNavOdomVelocity(nav_msg);
+    scanner->messageCbNavOdomVelocity(nav_msg);
     return SICK_SCAN_API_SUCCESS;
   }
   return SICK_SCAN_API_ERROR;
 }
 int32_t SickScanApiOdomVelocityImpl(SickScanApiHandle apiHandle, SickScanOdomVelocityMsg* src_msg) // odometry data in system coordinates
 {
-  if(s_scanner && s_scanner->getCurrentParamPtr() && SoftwarePLL::instance().IsInitialized())
+  sick_scan_xd::SickScanCommonTcp* scanner = getApiScanner(apiHandle);
+  if(scanner && scanner->getCurrentParamPtr() && scanner->getSoftwarePLL().IsInitialized())
   {
     sick_scan_msg::NAVOdomVelocity nav_msg;
     nav_msg.vel_x = src_msg->vel_x;
     nav_msg.vel_y = src_msg->vel_y;
-    double angle_shift = -1.0 * s_scanner->getCurrentParamPtr()->getScanAngleShift();
+    double angle_shift = -1.0 * scanner->getCurrentParamPtr()->getScanAngleShift();
     sick_scan_xd::rotateXYbyAngleOffset(nav_msg.vel_x, nav_msg.vel_y, angle_shift); // Convert to velocity in lidar coordinates in m/s
     nav_msg.omega = src_msg->omega; // angular velocity in radians/s
     nav_msg.coordbase = 0; // 0 = local coordinate system of the NAV350
-    SoftwarePLL::instance().convSystemtimeToLidarTimestamp(src_msg->timestamp_sec, src_msg->timestamp_nsec, nav_msg.timestamp);
-    s_scanner->messageCbNavOdomVelocity(nav_msg);
+    scanner->getSoftwarePLL().convSystemtimeToLidarTimestamp(src_msg->timestamp_sec, src_msg->timestamp_nsec, nav_msg.timestamp);
+    scanner->messageCbNavOdomVelocity(nav_msg);
     return SICK_SCAN_API_SUCCESS;
   }
   else
@@ -85,8 +85,25 @@ namespace sick_scan_xd
 /* Null, because instance will be initialized on demand. */
   SickScanRadarSingleton *SickScanRadarSingleton::instance = 0;
 
+  /* Radar instance of the lidar processed by the current thread, or 0 (process wide instance) */
+  static thread_local SickScanRadarSingleton *s_bound_radar_instance = 0;
+
+  SickScanRadarSingleton::ScopedInstance::ScopedInstance(SickScanRadarSingleton* radar) : m_prev_instance(s_bound_radar_instance)
+  {
+    s_bound_radar_instance = radar;
+  }
+
+  SickScanRadarSingleton::ScopedInstance::~ScopedInstance()
+  {
+    s_bound_radar_instance = m_prev_instance;
+  }
+
   SickScanRadarSingleton *SickScanRadarSingleton::getInstance(rosNodePtr nh)
   {
+    if (s_bound_radar_instance)
+    {
+      return s_bound_radar_instance;
+    }
     if (instance == 0)
     {
       instance = new SickScanRadarSingleton(nh);
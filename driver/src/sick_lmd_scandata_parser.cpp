@@ -142,7 +142,6 @@ namespace sick_scan_xd
                   int numberOf16BitChannels = 0;
                   int numberOf8BitChannels = 0;
                   uint32_t SystemCountScan = 0;
-                  static uint32_t lastSystemCountScan = 0;// this variable is used to ensure that only the first time stamp of an multi layer scann is used for PLL updating
                   uint32_t SystemCountTransmit = 0;
 
                   memcpy(&elevAngleX200, receiveBuffer + 50, 2);
@@ -170,11 +169,11 @@ namespace sick_scan_xd
                   double timestampfloat = sec(recvTimeStamp) + nsec(recvTimeStamp) * 1e-9;
                   bool bRet;
                   if (SystemCountScan !=
-                      lastSystemCountScan)//MRS 6000 sends 6 packets with same  SystemCountScan we should only update the pll once with this time stamp since the SystemCountTransmit are different and this will only increase jitter of the pll
+                      SoftwarePLL::instance().lastSystemCountScan)//MRS 6000 sends 6 packets with same  SystemCountScan we should only update the pll once with this time stamp since the SystemCountTransmit are different and this will only increase jitter of the pll
                   {
                     bRet = SoftwarePLL::instance().updatePLL(sec(recvTimeStamp), nsec(recvTimeStamp),
                                                              SystemCountTransmit);
-                    lastSystemCountScan = SystemCountScan;
+                    SoftwarePLL::instance().lastSystemCountScan = SystemCountScan;
                   }
                   // ROS_DEBUG_STREAM("recvTimeStamp before software-pll correction: " << recvTimeStamp);
                   rosTime tmp_time = recvTimeStamp;
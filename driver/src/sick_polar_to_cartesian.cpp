@@ -0,0 +1,350 @@
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+#include <algorithm>
+#include <float.h>
+#include <sick_scan/sick_polar_to_cartesian.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SICK_POLAR_TO_CARTESIAN_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SICK_POLAR_TO_CARTESIAN_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SICK_POLAR_TO_CARTESIAN_NEON 1
+#endif
+
+namespace sick_scan_xd
+{
+    /*
+    * Parameter of the optional transform, copied from SickCloudTransform once for each block of points
+    */
+    class PolarToCartesianTransformParam
+    {
+    public:
+        PolarToCartesianTransformParam(SickCloudTransform* transform) : apply_transform(false), apply_rotation(false)
+        {
+            for (int n = 0; n < 9; n++)
+                rot[n] = ((n % 4) == 0) ? 1.0f : 0.0f;
+            trans[0] = trans[1] = trans[2] = 0;
+            if (transform)
+            {
+                SickCloudTransform::TransformSnapshotPtr snapshot = transform->snapshot(); // read once for all points
+                apply_rotation = snapshot->apply_3x3_rotation;
+                const SickCloudTransform::Matrix3x3& rotation_matrix = snapshot->rotation_matrix;
+                const SickCloudTransform::Vector3D& translation_vector = snapshot->translation_vector;
+                for (int row = 0; row < 3; row++)
+                {
+                    for (int col = 0; col < 3; col++)
+                        rot[3 * row + col] = rotation_matrix[row][col];
+                    trans[row] = translation_vector[row];
+                }
+                apply_transform = true;
+            }
+        }
+        bool apply_transform; // true if the translation has to be applied (identical to SickCloudTransform::applyTransform)
+        bool apply_rotation;  // true if the 3x3 rotation has to be applied
+        float rot[9];         // 3x3 rotation matrix, row major
+        float trans[3];       // translation vector
+    };
+
+#if defined SICK_POLAR_TO_CARTESIAN_AVX2
+    class SimdFloatAVX2
+    {
+    public:
+        typedef __m256 type;
+        static const size_t width = 8;
+        static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+        static inline void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+        static inline type set1(float f) { return _mm256_set1_ps(f); }
+        static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+        static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+    };
+    typedef SimdFloatAVX2 SimdFloat;
+#elif defined SICK_POLAR_TO_CARTESIAN_SSE2
+    class SimdFloatSSE2
+    {
+    public:
+        typedef __m128 type;
+        static const size_t width = 4;
+        static inline type load(const float* p) { return _mm_loadu_ps(p); }
+        static inline void store(float* p, type v) { _mm_storeu_ps(p, v); }
+        static inline type set1(float f) { return _mm_set1_ps(f); }
+        static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+        static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+    };
+    typedef SimdFloatSSE2 SimdFloat;
+#elif defined SICK_POLAR_TO_CARTESIAN_NEON
+    class SimdFloatNEON
+    {
+    public:
+        typedef float32x4_t type;
+        static const size_t width = 4;
+        static inline type load(const float* p) { return vld1q_f32(p); }
+        static inline void store(float* p, type v) { vst1q_f32(p, v); }
+        static inline type set1(float f) { return vdupq_n_f32(f); }
+        static inline type mul(type a, type b) { return vmulq_f32(a, b); }
+        static inline type add(type a, type b) { return vaddq_f32(a, b); }
+    };
+    typedef SimdFloatNEON SimdFloat;
+#endif
+
+#if defined SICK_POLAR_TO_CARTESIAN_AVX2 || defined SICK_POLAR_TO_CARTESIAN_SSE2 || defined SICK_POLAR_TO_CARTESIAN_NEON
+    /*
+    * Vectorized conversion of all complete vectors of points, returns the number of converted points (multiple of V::width).
+    * The order of the arithmetic operations is identical to the scalar conversion, i.e. results are identical.
+    */
+    template <class V> static size_t convertSimd(size_t num_points, const float* range, const float* cos_azimuth, const float* sin_azimuth,
+        const float* cos_elevation, const float* sin_elevation, size_t elevation_stride, float scale,
+        const PolarToCartesianTransformParam& param, float* x, float* y, float* z)
+    {
+        typename V::type v_scale = V::set1(scale);
+        typename V::type v_cos_elevation = V::set1(cos_elevation[0]);
+        typename V::type v_sin_elevation = V::set1(sin_elevation[0]);
+        typename V::type v_rot[9], v_trans[3];
+        for (int n = 0; n < 9; n++)
+            v_rot[n] = V::set1(param.rot[n]);
+        for (int n = 0; n < 3; n++)
+            v_trans[n] = V::set1(param.trans[n]);
+        size_t n = 0;
+        for (; n + V::width <= num_points; n += V::width)
+        {
+            typename V::type v_range = V::load(range + n);
+            if (elevation_stride)
+            {
+                v_cos_elevation = V::load(cos_elevation + n);
+                v_sin_elevation = V::load(sin_elevation + n);
+            }
+            typename V::type v_range_cos = V::mul(v_range, v_cos_elevation);
+            typename V::type v_x = V::mul(V::mul(v_range_cos, V::load(cos_azimuth + n)), v_scale);
+            typename V::type v_y = V::mul(V::mul(v_range_cos, V::load(sin_azimuth + n)), v_scale);
+            typename V::type v_z = V::mul(V::mul(v_range, v_sin_elevation), v_scale);
+            if (param.apply_rotation)
+            {
+                typename V::type v_u = V::add(V::add(V::mul(v_x, v_rot[0]), V::mul(v_y, v_rot[1])), V::mul(v_z, v_rot[2]));
+                typename V::type v_v = V::add(V::add(V::mul(v_x, v_rot[3]), V::mul(v_y, v_rot[4])), V::mul(v_z, v_rot[5]));
+                typename V::type v_w = V::add(V::add(V::mul(v_x, v_rot[6]), V::mul(v_y, v_rot[7])), V::mul(v_z, v_rot[8]));
+                v_x = v_u;
+                v_y = v_v;
+                v_z = v_w;
+            }
+            if (param.apply_transform)
+            {
+                v_x = V::add(v_x, v_trans[0]);
+                v_y = V::add(v_y, v_trans[1]);
+                v_z = V::add(v_z, v_trans[2]);
+            }
+            V::store(x + n, v_x);
+            V::store(y + n, v_y);
+            V::store(z + n, v_z);
+        }
+        return n;
+    }
+#endif
+
+    /*
+    * Scalar conversion of points start_idx up to num_points - 1
+    */
+    static void convertScalar(size_t start_idx, size_t num_points, const float* range, const float* cos_azimuth, const float* sin_azimuth,
+        const float* cos_elevation, const float* sin_elevation, size_t elevation_stride, float scale,
+        const PolarToCartesianTransformParam& param, float* x, float* y, float* z)
+    {
+        for (size_t n = start_idx; n < num_points; n++)
+        {
+            float range_cos = range[n] * cos_elevation[n * elevation_stride];
+            float point_x = range_cos * cos_azimuth[n] * scale;
+            float point_y = range_cos * sin_azimuth[n] * scale;
+            float point_z = range[n] * sin_elevation[n * elevation_stride] * scale;
+            if (param.apply_rotation)
+            {
+                float u = point_x * param.rot[0] + point_y * param.rot[1] + point_z * param.rot[2];
+                float v = point_x * param.rot[3] + point_y * param.rot[4] + point_z * param.rot[5];
+                float w = point_x * param.rot[6] + point_y * param.rot[7] + point_z * param.rot[8];
+                point_x = u;
+                point_y = v;
+                point_z = w;
+            }
+            if (param.apply_transform)
+            {
+                point_x += param.trans[0];
+                point_y += param.trans[1];
+                point_z += param.trans[2];
+            }
+            x[n] = point_x;
+            y[n] = point_y;
+            z[n] = point_z;
+        }
+    }
+} // namespace sick_scan_xd
+
+/*
+* Converts num_points polar points to cartesian points.
+*/
+void sick_scan_xd::PolarToCartesian::convert(size_t num_points, const float* range, const float* cos_azimuth, const float* sin_azimuth,
+    const float* cos_elevation, const float* sin_elevation, size_t elevation_stride, float scale,
+    SickCloudTransform* transform, float* x, float* y, float* z)
+{
+    if (num_points == 0)
+        return;
+    PolarToCartesianTransformParam param(transform);
+    size_t start_idx = 0;
+#if defined SICK_POLAR_TO_CARTESIAN_AVX2 || defined SICK_POLAR_TO_CARTESIAN_SSE2 || defined SICK_POLAR_TO_CARTESIAN_NEON
+    start_idx = convertSimd<SimdFloat>(num_points, range, cos_azimuth, sin_azimuth, cos_elevation, sin_elevation, elevation_stride, scale, param, x, y, z);
+#endif
+    convertScalar(start_idx, num_points, range, cos_azimuth, sin_azimuth, cos_elevation, sin_elevation, elevation_stride, scale, param, x, y, z);
+}
+
+/*
+* Applies an optional range filter and converts num_points polar points to cartesian points.
+*/
+size_t sick_scan_xd::PolarToCartesian::convert(size_t num_points, float* range, const SickRangeFilter& range_filter, uint8_t* point_valid,
+    const float* cos_azimuth, const float* sin_azimuth, const float* cos_elevation, const float* sin_elevation, size_t elevation_stride,
+    float scale, SickCloudTransform* transform, float* x, float* y, float* z)
+{
+    size_t num_valid = 0;
+    for (size_t n = 0; n < num_points; n++)
+    {
+        bool range_modified = false;
+        point_valid[n] = (range_filter.apply(range[n], range_modified) ? 1 : 0);
+        num_valid += point_valid[n];
+    }
+    if (x && y && z)
+        convert(num_points, range, cos_azimuth, sin_azimuth, cos_elevation, sin_elevation, elevation_stride, scale, transform, x, y, z);
+    return num_valid;
+}
+
+/*
+* Returns the instruction set used by convert(): "avx2", "sse2", "neon" or "scalar"
+*/
+const char* sick_scan_xd::PolarToCartesian::simdInstructionSet(void)
+{
+#if defined SICK_POLAR_TO_CARTESIAN_AVX2
+    return "avx2";
+#elif defined SICK_POLAR_TO_CARTESIAN_SSE2
+    return "sse2";
+#elif defined SICK_POLAR_TO_CARTESIAN_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/*
+* Returns true, if the tables have been computed for the given scan configuration, otherwise false
+*/
+bool sick_scan_xd::PolarToCartesianTable::matches(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset, const float* elevation_key, size_t elevation_key_size) const
+{
+    if (!m_valid || m_angle_start != angle_start || m_angle_increment != angle_increment || m_num_points != num_points
+    || m_mirror_factor != mirror_factor || m_azimuth_offset != azimuth_offset || m_elevation_key.size() != elevation_key_size)
+        return false;
+    return std::equal(m_elevation_key.begin(), m_elevation_key.end(), elevation_key);
+}
+
+/*
+* Sets the scan configuration and resizes the tables. The tables have to be filled by the caller afterwards.
+*/
+void sick_scan_xd::PolarToCartesianTable::reset(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset, const float* elevation_key, size_t elevation_key_size, size_t elevation_stride)
+{
+    m_valid = true;
+    m_angle_start = angle_start;
+    m_angle_increment = angle_increment;
+    m_num_points = num_points;
+    m_mirror_factor = mirror_factor;
+    m_azimuth_offset = azimuth_offset;
+    m_elevation_key.assign(elevation_key, elevation_key + elevation_key_size);
+    this->elevation_stride = elevation_stride;
+    size_t num_elevation_values = (elevation_stride > 0) ? num_points : 1;
+    azimuth.resize(num_points);
+    cos_azimuth.resize(num_points);
+    sin_azimuth.resize(num_points);
+    elevation.resize(num_elevation_values);
+    cos_elevation.resize(num_elevation_values);
+    sin_elevation.resize(num_elevation_values);
+}
+
+/*
+* Returns the lookup table for a given scan configuration. If no cached table matches, the least recently used table
+* is reset to the new scan configuration and table_valid is set to false, i.e. the caller has to fill the tables.
+*/
+sick_scan_xd::PolarToCartesianTable& sick_scan_xd::PolarToCartesianTableCache::lookup(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset,
+    const float* elevation_key, size_t elevation_key_size, size_t elevation_stride, bool& table_valid)
+{
+    m_lookup_cnt++;
+    size_t lru_idx = 0;
+    for (size_t n = 0; n < m_tables.size(); n++)
+    {
+        if (m_tables[n].matches(angle_start, angle_increment, num_points, mirror_factor, azimuth_offset, elevation_key, elevation_key_size))
+        {
+            m_tables[n].last_used = m_lookup_cnt;
+            table_valid = true;
+            return m_tables[n];
+        }
+        if (m_tables[n].last_used < m_tables[lru_idx].last_used)
+            lru_idx = n;
+    }
+    if (m_tables.size() < std::max<size_t>(1, m_max_num_tables))
+    {
+        lru_idx = m_tables.size();
+        m_tables.push_back(PolarToCartesianTable());
+    }
+    PolarToCartesianTable& table = m_tables[lru_idx];
+    table.reset(angle_start, angle_increment, num_points, mirror_factor, azimuth_offset, elevation_key, elevation_key_size, elevation_stride);
+    table.last_used = m_lookup_cnt;
+    table_valid = false;
+    return table;
+}
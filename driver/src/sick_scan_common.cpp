@@ -80,6 +80,7 @@
 #include <sick_scan/sick_scan_parse_util.h>
 #include <sick_scan/sick_lmd_scandata_parser.h>
 #include <sick_scan/sick_nav_scandata_parser.h>
+#include <sick_scan/sick_polar_to_cartesian.h>
 
 #include "sick_scan/binScanf.hpp"
 #include "sick_scan/dataDumper.h"
@@ -191,12 +192,6 @@ static char getFirmwareVersionIdMRS1xxx(const std::string& deviceIdentStr) // Ge
   return version_id;
 }
 
-static bool& isFieldEvaluationActive()
-{
-  static bool field_evaluation_active = false;
-  return field_evaluation_active;
-}
-
 namespace sick_scan_xd
 {
   /*!
@@ -453,6 +448,7 @@ namespace sick_scan_xd
     diagnosticPub_ = 0;
     parser_ = parser;
     m_nh =nh;
+    SoftwarePLL::numLidarInstances()++;
 
 #ifdef USE_DIAGNOSTIC_UPDATER
 #if __ROS_VERSION == 1
@@ -466,6 +462,24 @@ namespace sick_scan_xd
 
     expectedFrequency_ = this->parser_->getCurrentParamPtr()->getExpectedFrequency();
     m_min_intensity = 0.0; // Set range of LaserScan messages to infinity, if intensity < min_intensity (default: 0)
+    m_publish_pipeline = 0;
+    m_field_mon = new SickScanFieldMonSingleton();
+    m_radar = 0;
+    if (this->parser_->getCurrentParamPtr()->getDeviceIsRadar())
+      m_radar = new SickScanRadarSingleton(nh);
+    m_scan_imu = 0;
+    m_loop_first_time_called = true;
+    m_slam_bundle = false;
+    m_echo_for_slam = "";
+    m_loop_iteration_count = 0;
+    m_layer_cnt = 0;
+    memset(m_layer_seq, 0, sizeof(m_layer_seq));
+    m_cloud_output_sector_size = 40;
+    m_cloud_output_sector_count = 9;
+    m_field_evaluation_active = false;
+    m_cloud_frame_start = true;
+    m_cartesian_cloud_required = false;
+    m_polar_cloud_required = false;
 
     setSensorIsRadar(false);
     init_cmdTables(nh);
@@ -563,6 +577,17 @@ namespace sick_scan_xd
     rosDeclareParam(nh, "cloud_output_mode", config_.cloud_output_mode);
     rosGetParam(nh, "cloud_output_mode", config_.cloud_output_mode);
 
+    // Sectors of partial pointclouds published in cloud_output_mode 2: cloud_output_sector_count sectors with cloud_output_sector_size shots each
+    rosDeclareParam(nh, "cloud_output_sector_size", m_cloud_output_sector_size);
+    rosGetParam(nh, "cloud_output_sector_size", m_cloud_output_sector_size);
+    rosDeclareParam(nh, "cloud_output_sector_count", m_cloud_output_sector_count);
+    rosGetParam(nh, "cloud_output_sector_count", m_cloud_output_sector_count);
+    if (!clampCloudOutputSectors(parser_->getCurrentParamPtr()->getNumberOfShots(), m_cloud_output_sector_size, m_cloud_output_sector_count) && config_.cloud_output_mode == 2)
+    {
+      ROS_WARN_STREAM("## WARNING: cloud_output_sector_size and cloud_output_sector_count must be positive and cloud_output_sector_size * cloud_output_sector_count must not exceed "
+        << parser_->getCurrentParamPtr()->getNumberOfShots() << " shots per scan, using cloud_output_sector_size=" << m_cloud_output_sector_size << " and cloud_output_sector_count=" << m_cloud_output_sector_count);
+    }
+
     double expected_frequency_tolerance = 0.1; // frequency should be target +- 10%
     rosDeclareParam(nh, "expected_frequency_tolerance", expected_frequency_tolerance);
     rosGetParam(nh, "expected_frequency_tolerance", expected_frequency_tolerance);
@@ -678,6 +703,19 @@ namespace sick_scan_xd
     // The additional transform applies to cartesian lidar pointclouds and visualization marker (fields)
     // It is NOT applied to polar pointclouds, radarscans, ldmrs objects or other messages
     m_add_transform_xyz_rpy = sick_scan_xd::SickCloudTransform(nh, false);
+
+    // Optional pipeline mode: LaserScan and PointCloud2 messages are published by a separate publish thread, i.e. parsing is not stalled by slow publishing (default: false)
+    bool pipeline_mode = false;
+    int pipeline_queue_size = 16;
+    rosDeclareParam(nh, "pipeline_mode", pipeline_mode);
+    rosGetParam(nh, "pipeline_mode", pipeline_mode);
+    rosDeclareParam(nh, "pipeline_queue_size", pipeline_queue_size);
+    rosGetParam(nh, "pipeline_queue_size", pipeline_queue_size);
+    if (pipeline_mode)
+    {
+      m_publish_pipeline = new sick_scan_xd::SickScanPublishPipeline(std::max(1, pipeline_queue_size));
+      ROS_INFO_STREAM("SickScanCommon: pipeline mode activated, scan data are published by a separate thread (queue size " << std::max(1, pipeline_queue_size) << ")");
+    }
   }
 
   /*!
@@ -890,8 +928,18 @@ namespace sick_scan_xd
   */
   SickScanCommon::~SickScanCommon()
   {
+    if (m_publish_pipeline)
+    {
+      m_publish_pipeline->stop(); // publish pending messages before publishers are deleted
+      delete m_publish_pipeline;
+      m_publish_pipeline = 0;
+    }
     delete cloud_marker_;
     delete diagnosticPub_;
+    delete m_scan_imu;
+    delete m_radar;
+    delete m_field_mon;
+    SoftwarePLL::numLidarInstances()--;
     printf("SickScanCommon closed.\n");
   }
 
@@ -1226,7 +1274,7 @@ namespace sick_scan_xd
   //     * Switch to configured cola-dialect (Cola-B = useBinaryCmd) using "sWN EIHstCola" and restart
   ExitCode SickScanCommon::checkColaTypeAndSwitchToConfigured(bool useBinaryCmd)
   {
-    static bool tim240_binary_mode = useBinaryCmd;
+    bool tim240_binary_mode = this->parser_->getTim240BinaryMode(useBinaryCmd);
     bool useBinaryCmdCfg = useBinaryCmd;
     if (this->parser_->getCurrentParamPtr()->getScannerName().compare(SICK_SCANNER_TIM_240_NAME) == 0)
     {
@@ -1250,7 +1298,7 @@ namespace sick_scan_xd
       }
       if (this->parser_->getCurrentParamPtr()->getScannerName().compare(SICK_SCANNER_TIM_240_NAME) == 0)
       {
-        tim240_binary_mode = !tim240_binary_mode; // TiM240 does not respond to any request if once sent a sopas command in wrong cola dialect. Toggle Cola dialect directly after restart required for TiM240.
+        this->parser_->setTim240BinaryMode(!tim240_binary_mode); // TiM240 does not respond to any request if once sent a sopas command in wrong cola dialect. Toggle Cola dialect directly after restart required for TiM240.
         ROS_INFO_STREAM("checkColaDialect: switching to Cola-" << (useBinaryCmd ? "B" : "A") << " after restart (TiM-240)");
       }
       return ExitError;
@@ -1264,7 +1312,7 @@ namespace sick_scan_xd
         {
           ROS_INFO_STREAM("checkColaDialect sucessful using Cola-" << (useBinaryCmd ? "B" : "A") << ", switch to Cola-" << (useBinaryCmdCfg ? "B" : "A") << " (TiM-240)");
           switchColaProtocol(useBinaryCmdCfg);
-          tim240_binary_mode = useBinaryCmdCfg;
+          this->parser_->setTim240BinaryMode(useBinaryCmdCfg);
           return ExitError; // Restart after protocol switch required for TiM240
         }
       }
@@ -1372,6 +1420,7 @@ namespace sick_scan_xd
 #if __ROS_VERSION > 0
   void SickScanCommon::messageCbRosOdom(const ros_nav_msgs::Odometry& msg)
   {
+    ScopedLidarInstance lidar_instance(this); // SoftwarePLL of this lidar
     sick_scan_msg::NAVOdomVelocity nav_odom_vel_msg;
     nav_odom_vel_msg.vel_x = msg.twist.twist.linear.x;
     nav_odom_vel_msg.vel_y = msg.twist.twist.linear.y;
@@ -1450,6 +1499,7 @@ namespace sick_scan_xd
   */
   int SickScanCommon::init(rosNodePtr nh)
   {
+    ScopedLidarInstance lidar_instance(this); // SoftwarePLL, field monitoring and radar of this lidar
     m_nh = nh;
     int result = init_device();
     if (result != 0)
@@ -2230,10 +2280,10 @@ namespace sick_scan_xd
           std::string sopas_reply = DataDumper::binDataToAsciiString(replyDummy.data(), replyDummy.size());
           ROS_INFO_STREAM("response to \"sRN SetActiveApplications\": " << sopas_reply);
           if (sopas_reply.find("FEVL\\x01") != std::string::npos)
-            isFieldEvaluationActive() = true;
+            m_field_evaluation_active = true;
           if (sopas_reply.find("FEVL\\x00") != std::string::npos)
-            isFieldEvaluationActive() = false;
-          ROS_INFO_STREAM("FieldEvaluationActive = " << (isFieldEvaluationActive() ? "true": "false"));
+            m_field_evaluation_active = false;
+          ROS_INFO_STREAM("FieldEvaluationActive = " << (m_field_evaluation_active ? "true": "false"));
         }
 
         if (result == 0) // command sent successfully
@@ -2587,6 +2637,7 @@ namespace sick_scan_xd
             angleCompensator->parseReply(useBinaryCmd, tmpVec);
 
             ROS_INFO_STREAM("Angle Comp. Formula used: " << angleCompensator->getHumanReadableFormula());
+            m_polar_to_cartesian_tables.clear(); // azimuth tables depend on the angle compensation
           }
           break;
           // if (parser_->getCurrentParamPtr()->getScannerName().compare(SICK_SCANNER_NAV_2XX_NAME) == 0)
@@ -4295,12 +4346,68 @@ namespace sick_scan_xd
   }
 
 
+  /*!
+  \brief Clamps the sectors of partial pointclouds (cloud_output_mode 2) to the number of shots per scan,
+         i.e. sector_size * sector_count must not exceed num_shots (ignored if num_shots <= 0).
+  \return true if sector_size and sector_count have not been changed, false otherwise
+  */
+  bool SickScanCommon::clampCloudOutputSectors(int num_shots, int& sector_size, int& sector_count)
+  {
+    int size = std::max(1, sector_size), count = std::max(1, sector_count);
+    if (num_shots > 0)
+    {
+      size = std::min(size, num_shots);
+      count = std::min(count, std::max(1, num_shots / size));
+    }
+    bool unchanged = (size == sector_size && count == sector_count);
+    sector_size = size;
+    sector_count = count;
+    return unchanged;
+  }
+
+  /*!
+  \brief Slices sector sector_idx of a partial pointcloud (cloud_output_mode 2) from the layers accumulated in cloud.
+         Shots [j * sector_size * sector_count + sector_idx * sector_size, + sector_size) of the 4 layers j are copied
+         from row 1 + layer_seq[(j + layer_cnt) % 4] of cloud, clamped to the cloud width and height. Width, point_step,
+         row_step and data of partial_cloud are set to the copied points, header and fields are not modified.
+  */
+  void SickScanCommon::slicePartialCloud(const ros_sensor_msgs::PointCloud2& cloud, const int layer_seq[4], int layer_cnt, int sector_size, int sector_count, int sector_idx, ros_sensor_msgs::PointCloud2& partial_cloud)
+  {
+    int numTotalShots = sector_size * sector_count;
+    int colStart = sector_idx * sector_size;
+    int colAvail[4] = { 0 }, rowIdx[4] = { 0 }, numPoints = 0;
+    for (int j = 0; j < 4; j++)
+    {
+      int layerIdx = (j + layer_cnt) % 4;  // j = 0 -> oldest
+      rowIdx[j] = 1 + layer_seq[layerIdx]; // +1, da es bei -1 beginnt
+      int colIdx = j * numTotalShots + colStart;
+      if (rowIdx[j] >= 0 && rowIdx[j] < (int)cloud.height && colIdx < (int)cloud.width)
+        colAvail[j] = std::min<int>(sector_size, cloud.width - colIdx);
+      numPoints += colAvail[j];
+    }
+    partial_cloud.width = numPoints;
+    partial_cloud.point_step = cloud.point_step;
+    partial_cloud.row_step = partial_cloud.point_step * partial_cloud.width;
+    partial_cloud.data.resize(partial_cloud.row_step);
+    size_t partOff = 0;
+    for (int j = 0; j < 4; j++)
+    {
+      if (colAvail[j] > 0)
+      {
+        size_t colIdx = (size_t)j * numTotalShots + colStart;
+        memcpy(&(partial_cloud.data[partOff]), &(cloud.data[((size_t)rowIdx[j] * cloud.width + colIdx) * cloud.point_step]), (size_t)colAvail[j] * cloud.point_step);
+        partOff += (size_t)colAvail[j] * cloud.point_step;
+      }
+    }
+  }
+
   /*!
   \brief parsing datagram and publishing ros messages
   \return error code
   */
   int SickScanCommon::loopOnce(rosNodePtr nh)
   {
+    ScopedLidarInstance lidar_instance(this); // SoftwarePLL, field monitoring and radar of this lidar
     //static int cnt = 0;
 #ifdef USE_DIAGNOSTIC_UPDATER
     if(diagnostics_)
@@ -4315,7 +4422,6 @@ namespace sick_scan_xd
 
     unsigned char receiveBuffer[65536];
     int actual_length = 0;
-    static unsigned int iteration_count = 0;
     bool useBinaryProtocol = this->parser_->getCurrentParamPtr()->getUseBinaryProtocol();
 
     rosTime recvTimeStamp = rosTimeNow();  // timestamp incoming package, will be overwritten by get_datagram
@@ -4335,23 +4441,21 @@ namespace sick_scan_xd
 
     int numPacketsProcessed = 0; // count number of processed datagrams
 
-    static bool firstTimeCalled = true;
     static bool dumpData = false;
     static int verboseLevel = 0; // for low level debugging only
-    static bool slamBundle = false;
     float timeIncrement;
-    static std::string echoForSlam = "";
-    if (firstTimeCalled == true)
+    if (m_loop_first_time_called == true)
     {
 
       /* Dump Binary Protocol */
-        rosDeclareParam(nh, "slam_echo", echoForSlam);
-        rosGetParam(nh, "slam_echo", echoForSlam);
+        rosDeclareParam(nh, "slam_echo", m_echo_for_slam);
+        rosGetParam(nh, "slam_echo", m_echo_for_slam);
 
-        rosDeclareParam(nh, "slam_bundle", slamBundle);
-        rosGetParam(nh, "slam_bundle", slamBundle);
+        rosDeclareParam(nh, "slam_bundle", m_slam_bundle);
+        rosGetParam(nh, "slam_bundle", m_slam_bundle);
 
-      firstTimeCalled = false;
+      m_scan_imu = new SickScanImu(this, nh);
+      m_loop_first_time_called = false;
     }
     do
     {
@@ -4361,6 +4465,8 @@ namespace sick_scan_xd
 
       int result = get_datagram(nh, recvTimeStamp, receiveBuffer, 65536, &actual_length, useBinaryProtocol, &packetsInLoop, datagram_keywords);
       numPacketsProcessed++;
+      uint64_t receiveTimestampNsec = (uint64_t)sec(recvTimeStamp) * 1000000000ULL + (uint64_t)nsec(recvTimeStamp); // receive timestamp before update by software-pll, for pipeline latency statistics
+      uint64_t parseStartTimestampNsec = rosNanosecTimestampNow();
 
       rosDuration dur = recvTimeStampPush - recvTimeStamp;
 
@@ -4379,7 +4485,7 @@ namespace sick_scan_xd
       } // return success to continue looping
 
       // ----- if requested, skip frames
-      if (iteration_count++ % (config_.skip + 1) != 0)
+      if (m_loop_iteration_count++ % (config_.skip + 1) != 0)
       {
         return ExitSuccess;
       }
@@ -4410,7 +4516,7 @@ namespace sick_scan_xd
         return errorCode; // return success to continue looping
       }
 
-      static SickScanImu scanImu(this, nh); // todo remove static
+      SickScanImu& scanImu = *m_scan_imu;
       if (scanImu.isImuDatagram((char *) receiveBuffer, actual_length))
       {
         int errorCode = ExitSuccess;
@@ -4510,7 +4616,45 @@ namespace sick_scan_xd
       }
       else
       {
-        ros_sensor_msgs::LaserScan msg;
+        // Publish LaserScan and PointCloud2 messages and notify listener. Called by loopOnce (default) or by the publish thread (pipeline mode).
+        auto publishLaserScan = [this](const ros_sensor_msgs::LaserScan& laserscan_msg)
+        {
+#if defined USE_DIAGNOSTIC_UPDATER // && __ROS_VERSION == 1
+          if(diagnosticPub_)
+            diagnosticPub_->publish(laserscan_msg);
+          else
+            rosPublish(pub_, laserscan_msg);
+#else
+          rosPublish(pub_, laserscan_msg);
+#endif
+        };
+        // Clouds not required at parse time are not generated (cartesian_valid resp. polar_valid is false) and not published.
+        auto notifyCloudListener = [this, nh](const ros_sensor_msgs::PointCloud2& cartesian_cloud, const ros_sensor_msgs::PointCloud2& polar_cloud, int num_echos, bool cartesian_valid, bool polar_valid)
+        {
+          sick_scan_xd::PointCloud2withEcho cloud_msg(&cartesian_cloud, num_echos, 0); // no copy, cloud is borrowed while listeners are notified
+          sick_scan_xd::PointCloud2withEcho cloud_msg_polar(&polar_cloud, num_echos, 0);
+          if (polar_valid && hasPolarPointcloudListener(nh))
+            notifyPolarPointcloudListener(nh, &cloud_msg_polar);
+          if (cartesian_valid && hasCartesianPointcloudListener(nh))
+            notifyCartesianPointcloudListener(nh, &cloud_msg);
+        };
+        auto publishCloud = [this, notifyCloudListener](const ros_sensor_msgs::PointCloud2& cartesian_cloud, const ros_sensor_msgs::PointCloud2& polar_cloud, int num_echos, bool cartesian_valid, bool polar_valid)
+        {
+          notifyCloudListener(cartesian_cloud, polar_cloud, num_echos, cartesian_valid, polar_valid);
+          if (cartesian_valid)
+            rosPublish(cloud_pub_, cartesian_cloud);
+        };
+        auto publishPartialPointCloud = [this, nh](const ros_sensor_msgs::PointCloud2& partial_cloud, int num_echos)
+        {
+          if (hasCartesianPointcloudListener(nh))
+          {
+            sick_scan_xd::PointCloud2withEcho partial_cloud_msg(&partial_cloud, num_echos, 0);
+            notifyCartesianPointcloudListener(nh, &partial_cloud_msg);
+          }
+          rosPublish(cloud_pub_, partial_cloud);
+        };
+
+        ros_sensor_msgs::LaserScan& msg = m_scan_decode_buffer.beginTelegram(); // decoded telegram resp. LaserScan message of the current echo, reused from telegram to telegram
         sick_scan_msg::Encoder EncoderMsg;
         EncoderMsg.header.stamp = recvTimeStamp + rosDurationFromSec(config_.time_offset);
         //TODO remove this hardcoded variable
@@ -4518,7 +4662,7 @@ namespace sick_scan_xd
         EncoderMsg.header.frame_id = "Encoder";
         ROS_HEADER_SEQ(EncoderMsg.header, numPacketsProcessed);
         msg.header.stamp = recvTimeStamp + rosDurationFromSec(config_.time_offset); // default: ros-timestamp at message received, will be updated by software-pll
-        msg.header.frame_id = config_.frame_id; // Use configured frame_id for both laser scan and pointcloud messages
+        msg.header.frame_id.assign(config_.frame_id); // Use configured frame_id for both laser scan and pointcloud messages
         double elevationAngleInRad = 0.0;
         short elevAngleX200 = 0;  // signed short (F5 B2  -> Layer 24
         // F5B2h -> -2638/200= -13.19°
@@ -4534,8 +4678,7 @@ namespace sick_scan_xd
         char *dstart, *dend;
         bool dumpDbg = false;
         bool dataToProcess = true;
-        std::vector<float> vang_vec;
-        vang_vec.clear();
+        std::vector<float>& vang_vec = m_scan_decode_buffer.vang;
 		dstart = NULL;
 		dend = NULL;
 
@@ -4554,8 +4697,6 @@ namespace sick_scan_xd
           if (useBinaryProtocol)
           {
             // if binary protocol used then parse binary message
-            std::vector<unsigned char> receiveBufferVec = std::vector<unsigned char>(receiveBuffer,
-                                                                                     receiveBuffer + actual_length);
 #ifdef DEBUG_DUMP_TO_CONSOLE_ENABLED
             if (actual_length > 1000)
             {
@@ -4565,7 +4706,7 @@ namespace sick_scan_xd
 
             DataDumper::instance().dumpUcharBufferToConsole(receiveBuffer, actual_length);
 #endif
-            if (receiveBufferVec.size() > 8)
+            if (actual_length > 8)
             {
               long idVal = 0;
               long lenVal = 0;
@@ -4701,11 +4842,12 @@ namespace sick_scan_xd
             double elevationAngleDegree = 0.0;
 
 
-            std::vector<float> rangeTmp = msg.ranges;  // copy all range value
-            std::vector<float> intensityTmp = msg.intensities; // copy all intensity value
+            m_scan_decode_buffer.takeEchos(msg); // move range and intensity values of all echos to the decode buffer (no copy)
+            const std::vector<float>& rangeTmp = m_scan_decode_buffer.ranges_all_echos;  // all range values
+            const std::vector<float>& intensityTmp = m_scan_decode_buffer.intensities_all_echos; // all intensity values
 
             int intensityTmpNum = intensityTmp.size();
-            float *intensityTmpPtr = NULL;
+            const float *intensityTmpPtr = NULL;
             if (intensityTmpNum > 0)
             {
               intensityTmpPtr = &intensityTmp[0];
@@ -4772,9 +4914,7 @@ namespace sick_scan_xd
             else if (numEchos > 0)
             {
 
-              size_t startOffset = 0;
-              size_t endOffset = 0;
-              int echoPartNum = msg.ranges.size() / numEchos;
+              int echoPartNum = rangeTmp.size() / numEchos;
               for (int i = 0; i < numEchos; i++)
               {
 
@@ -4785,25 +4925,7 @@ namespace sick_scan_xd
                   numValidEchos++;
                   sendMsg = true;
                 }
-                startOffset = i * echoPartNum;
-                endOffset = (i + 1) * echoPartNum;
-
-                msg.ranges.clear();
-                msg.intensities.clear();
-                msg.ranges = std::vector<float>(
-                    rangeTmp.begin() + startOffset,
-                    rangeTmp.begin() + endOffset);
-                // check also for MRS1104
-                if (endOffset <= intensityTmp.size() && (intensityTmp.size() > 0))
-                {
-                  msg.intensities = std::vector<float>(
-                      intensityTmp.begin() + startOffset,
-                      intensityTmp.begin() + endOffset);
-                }
-                else
-                {
-                  msg.intensities.resize(echoPartNum); // fill with zeros
-                }
+                m_scan_decode_buffer.sliceEcho(i, echoPartNum, msg); // ranges and intensities of echo i, missing intensities filled with zeros (check also for MRS1104)
                 {
                   // numEchos
                   char szTmp[255] = {0};
@@ -4833,18 +4955,18 @@ namespace sick_scan_xd
                     strcpy(szTmp, config_.frame_id.c_str());  // Use configured frame_id for both laser scan and pointcloud messages
                   }
 
-                  msg.header.frame_id = std::string(szTmp);
+                  msg.header.frame_id.assign(szTmp);
                   // Hector slam can only process ONE valid frame id.
-                  if (echoForSlam.length() > 0)
+                  if (m_echo_for_slam.length() > 0)
                   {
-                    if (slamBundle)
+                    if (m_slam_bundle)
                     {
                       // try to map first echos to horizontal layers.
                       if (i == 0)
                       {
                         // first echo
-                        msg.header.frame_id = echoForSlam;
-                        strcpy(szTmp, echoForSlam.c_str());  //
+                        msg.header.frame_id.assign(m_echo_for_slam);
+                        strcpy(szTmp, m_echo_for_slam.c_str());  //
                         if (elevationAngleInRad != 0.0)
                         {
                           float cosVal = (float)cos(elevationAngleInRad);
@@ -4857,7 +4979,7 @@ namespace sick_scan_xd
                       }
                     }
 
-                    if (echoForSlam.compare(szTmp) == 0)
+                    if (m_echo_for_slam.compare(szTmp) == 0)
                     {
                       sendMsg = true;
                     }
@@ -4883,7 +5005,10 @@ namespace sick_scan_xd
 #ifndef _MSC_VER
                 if (parser_->getCurrentParamPtr()->getEncoderMode() >= 0 && FireEncoder == true)//
                 {
-                  rosPublish(Encoder_pub, EncoderMsg);
+                  if (m_publish_pipeline)
+                    m_publish_pipeline->push([this, EncoderMsg]() { rosPublish(Encoder_pub, EncoderMsg); }, receiveTimestampNsec, parseStartTimestampNsec);
+                  else
+                    rosPublish(Encoder_pub, EncoderMsg);
                 }
                 if (numOfLayers > 4)
                 {
@@ -4892,17 +5017,10 @@ namespace sick_scan_xd
                 if (sendMsg & outputChannelFlagId)  // publish only configured channels - workaround for cfg-bug MRS1104
                 {
 
-                  // rosPublish(pub_, msg);
-#if defined USE_DIAGNOSTIC_UPDATER // && __ROS_VERSION == 1
-                  // if(diagnostics_)
-                  //   diagnostics_->broadcast(diagnostic_msgs_DiagnosticStatus_OK, "SickScanCommon running, no error");
-                  if(diagnosticPub_)
-                    diagnosticPub_->publish(msg);
+                  if (m_publish_pipeline)
+                    m_publish_pipeline->push([publishLaserScan, msg]() { publishLaserScan(msg); }, receiveTimestampNsec, parseStartTimestampNsec);
                   else
-                    rosPublish(pub_, msg);
-#else
-                  rosPublish(pub_, msg);
-#endif
+                    publishLaserScan(msg);
 
                 }
 #else
@@ -4914,14 +5032,24 @@ namespace sick_scan_xd
             {
               if (rosOk())
                 ROS_WARN_STREAM("## WARNING in SickScanCommon::loopOnce(): no echos in measurement message (numEchos=" << numEchos
-                  << ", msg.ranges.size()=" << msg.ranges.size() << ", msg.intensities.size()=" << msg.intensities.size() << ")");
+                  << ", msg.ranges.size()=" << rangeTmp.size() << ", msg.intensities.size()=" << intensityTmp.size() << ")");
               else
                 ROS_INFO_STREAM("SickScanCommon::loopOnce(): no echos in measurement message");
             }
 
             if (publishPointCloud == true && numValidEchos > 0 && msg.ranges.size() > 0)
             {
-
+              // The cartesian pointcloud is generated only if it is published to subscribers or API listeners, the polar pointcloud only for API listeners.
+              // Subscriptions are checked at the start of each pointcloud, i.e. unused pointclouds are not computed. Multi-layer pointclouds
+              // span multiple telegrams, therefore the flags are latched until the pointcloud is published and not changed within a pointcloud.
+              if (m_cloud_frame_start)
+              {
+                m_cartesian_cloud_required = (rosNumSubscribers(cloud_pub_) > 0 || hasCartesianPointcloudListener(nh));
+                m_polar_cloud_required = hasPolarPointcloudListener(nh);
+                m_cloud_frame_start = false;
+              }
+              bool cartesianCloudRequired = m_cartesian_cloud_required;
+              bool polarCloudRequired = m_polar_cloud_required;
 
               const int numChannels = 4; // x y z i (for intensity)
 
@@ -4931,7 +5059,7 @@ namespace sick_scan_xd
                 numTmpLayer = 1; // LMS_1XXX has 4 interlaced layer, each layer published in one pointcloud message
                 baseLayer = 0;
                 layer = 0;
-                msg.header.frame_id = config_.frame_id; // Use configured frame_id for both laser scan and pointcloud messages
+                msg.header.frame_id.assign(config_.frame_id); // Use configured frame_id for both laser scan and pointcloud messages
               }
 
               cloud_.header.stamp = recvTimeStamp + rosDurationFromSec(config_.time_offset);
@@ -4953,28 +5081,29 @@ namespace sick_scan_xd
                 cloud_.fields[i].count = 1;
                 cloud_.fields[i].datatype = ros_sensor_msgs::PointField::FLOAT32;
               }
-              cloud_.data.resize(cloud_.row_step * cloud_.height, 0);
-
-              cloud_polar_.header = cloud_.header;
-              cloud_polar_.height = cloud_.height;
-              cloud_polar_.width = cloud_.width;
-              cloud_polar_.is_bigendian = cloud_.is_bigendian;
-              cloud_polar_.is_dense = cloud_.is_dense;
-              cloud_polar_.point_step = cloud_.point_step;
-              cloud_polar_.row_step = cloud_.row_step;
-              cloud_polar_.fields = cloud_.fields;
-              cloud_polar_.fields[0].name = "range";
-              cloud_polar_.fields[1].name = "azimuth";
-              cloud_polar_.fields[2].name = "elevation";
-              cloud_polar_.data.resize(cloud_.data.size(), 0);
-
-              unsigned char *cloudDataPtr = &(cloud_.data[0]);
-              unsigned char *cloudDataPtr_polar = &(cloud_polar_.data[0]);
+              if (cartesianCloudRequired)
+              {
+                cloud_.data.resize(cloud_.row_step * cloud_.height, 0);
+              }
 
-              // prepare lookup for elevation angle table
+              if (polarCloudRequired)
+              {
+                cloud_polar_.header = cloud_.header;
+                cloud_polar_.height = cloud_.height;
+                cloud_polar_.width = cloud_.width;
+                cloud_polar_.is_bigendian = cloud_.is_bigendian;
+                cloud_polar_.is_dense = cloud_.is_dense;
+                cloud_polar_.point_step = cloud_.point_step;
+                cloud_polar_.row_step = cloud_.row_step;
+                cloud_polar_.fields = cloud_.fields;
+                cloud_polar_.fields[0].name = "range";
+                cloud_polar_.fields[1].name = "azimuth";
+                cloud_polar_.fields[2].name = "elevation";
+                cloud_polar_.data.resize(cloud_.row_step * cloud_.height, 0);
+              }
 
-              std::vector<float> cosAlphaTable; // Lookup table for cos
-              std::vector<float> sinAlphaTable; // Lookup table for sin
+              unsigned char *cloudDataPtr = cloud_.data.data();
+              unsigned char *cloudDataPtr_polar = cloud_polar_.data.data();
 
               size_t rangeNumAllEchos = rangeTmp.size(); // rangeTmp.size() := number of range values in all echos (max. 5 echos)
               size_t rangeNumAllEchosCloud = cloud_.height * cloud_.width; // number of points allocated in the point cloud
@@ -4982,8 +5111,6 @@ namespace sick_scan_xd
               size_t rangeNum = rangeNumAllEchos / numValidEchos;
               // ROS_INFO_STREAM("numValidEchos=" << numValidEchos << ", numEchos=" << numEchos << ", cloud_.height * cloud_.width=" << cloud_.height * cloud_.width << ", rangeNum=" << rangeNum);
 
-              cosAlphaTable.resize(rangeNum);
-              sinAlphaTable.resize(rangeNum);
               float mirror_factor = 1.0;
               float angleShift=0;
               if (this->parser_->getCurrentParamPtr()->getScanMirroredAndShifted()) // i.e. NAV3xx-series
@@ -4993,9 +5120,9 @@ namespace sick_scan_xd
 
               size_t rangeNumPointcloudAllEchos = 0;
               SickRangeFilter range_filter(this->parser_->get_range_min(), this->parser_->get_range_max(), this->parser_->get_range_filter_config());
-              for (size_t iEcho = 0; iEcho < numValidEchos; iEcho++)
+              if (cartesianCloudRequired || polarCloudRequired)
               {
-
+                // lookup tables for azimuth and elevation angles (identical for all echos), cached until the scan configuration changes
                 float angle = (float)config_.min_ang;
                 if(this->parser_->getCurrentParamPtr()->getScannerName().compare(SICK_SCANNER_TIM_240_NAME) == 0
                 || this->parser_->getCurrentParamPtr()->getScannerName().compare(SICK_SCANNER_LMS_1XXX_NAME) == 0  // Check and todo: Can we use msg.angle_min for all lidars?
@@ -5003,116 +5130,110 @@ namespace sick_scan_xd
                 {
                   angle = msg.angle_min - angleShift; // LMS-1xxx and MRS-1xxx have 4 interlaced layer with different start angle in each layer, start angle parsed from LMDscandata and set in msg.angle_min
                 }
-
-                float *cosAlphaTablePtr = &cosAlphaTable[0];
-                float *sinAlphaTablePtr = &sinAlphaTable[0];
-
-                float *vangPtr = NULL;
-                float *rangeTmpPtr = &rangeTmp[0];
-                if (vang_vec.size() > 0)
+                float elevationKey = 0.0;  // constant elevation angle of this layer
+                if (elevationPreCalculated) // FOR MRS6124 without VANGL
                 {
-                  vangPtr = &vang_vec[0];
+                  elevationKey = (float)elevationAngleInRad;
                 }
-
-                size_t rangeNumPointcloudCurEcho = 0;
-                for (size_t rangeIdxScan = 0; rangeIdxScan < rangeNum; rangeIdxScan++)
+                else
                 {
-                  enum enum_index_descr
-                  {
-                    idx_x,
-                    idx_y,
-                    idx_z,
-                    idx_intensity,
-                    idx_num
-                  };
-                  long pointcloud_adroff = rangeNumPointcloudCurEcho * (numChannels * (int) sizeof(float));
-                  pointcloud_adroff += (layer - baseLayer) * cloud_.row_step;
-                  pointcloud_adroff += iEcho * cloud_.row_step * numTmpLayer;
-                  assert(pointcloud_adroff < cloud_.data.size()); // issue #49
-
-                  unsigned char *ptr = cloudDataPtr + pointcloud_adroff;
-                  float *fptr = (float *) (cloudDataPtr + pointcloud_adroff);
-                  float *fptr_polar = (float *) (cloudDataPtr_polar + pointcloud_adroff);
-
-                  float phi = angle; // azimuth angle
-                  float alpha = 0.0;  // elevation angle
-
-                  if (useGivenElevationAngle) // FOR MRS6124
+                  elevationKey = (float)(layer * elevationAngleDegree); // for MRS1104
+                }
+                const float* elevationKeyPtr = (useGivenElevationAngle ? vang_vec.data() : &elevationKey); // FOR MRS6124: elevation angle of each point given by vang_vec
+                size_t elevationKeySize = (useGivenElevationAngle ? rangeNum : 1);
+                bool angleTableValid = false;
+                float azimuthOffset = m_add_transform_xyz_rpy.azimuthOffset();
+                PolarToCartesianTable& angleTable = m_polar_to_cartesian_tables.lookup(angle, msg.angle_increment, rangeNum, mirror_factor, azimuthOffset,
+                  elevationKeyPtr, elevationKeySize, (useGivenElevationAngle ? 1 : 0), angleTableValid);
+                if (!angleTableValid) // scan configuration changed: recompute sin and cos tables
+                {
+                  for (size_t elevationIdx = 0; elevationIdx < angleTable.elevation.size(); elevationIdx++)
                   {
-                    alpha = -vangPtr[rangeIdxScan] * deg2rad_const;
+                    float alpha = (useGivenElevationAngle ? (-vang_vec[elevationIdx] * deg2rad_const) : elevationKey); // elevation angle
+                    angleTable.elevation[elevationIdx] = alpha;
+                    angleTable.cos_elevation[elevationIdx] = cos(alpha); // for z-value (elevation)
+                    angleTable.sin_elevation[elevationIdx] = mirror_factor * sin(alpha);
                   }
-                  else
+                  for (size_t rangeIdxScan = 0; rangeIdxScan < rangeNum; rangeIdxScan++)
                   {
-                    if (elevationPreCalculated) // FOR MRS6124 without VANGL
-                    {
-                      alpha = (float)elevationAngleInRad;
-                    }
-                    else
+                    double phi_used = angle + angleShift; // azimuth angle
+                    if (this->angleCompensator != NULL)
                     {
-                      alpha = (float)(layer * elevationAngleDegree); // for MRS1104
+                      phi_used = angleCompensator->compensateAngleInRadFromRos(phi_used);
                     }
+                    float phi2_used = phi_used + azimuthOffset;
+                    angleTable.azimuth[rangeIdxScan] = phi_used;
+                    angleTable.cos_azimuth[rangeIdxScan] = mirror_factor * (float)cos(phi2_used);
+                    angleTable.sin_azimuth[rangeIdxScan] = mirror_factor * (float)sin(phi2_used);
+                    angle += msg.angle_increment;
                   }
+                }
 
-                  if (iEcho == 0)
-                  {
-                    cosAlphaTablePtr[rangeIdxScan] = cos(alpha); // for z-value (elevation)
-                    sinAlphaTablePtr[rangeIdxScan] = sin(alpha);
-                  }
-                  else
-                  {
-                    // Just for Debugging: printf("%3d %8.3lf %8.3lf\n", (int)rangeIdxScan, cosAlphaTablePtr[rangeIdxScan], sinAlphaTablePtr[rangeIdxScan]);
-                  }
+                m_scan_decode_buffer.resizeEchoPoints(rangeNum);
+                std::vector<float>& rangeEcho = m_scan_decode_buffer.echo_range; // range values of the current echo, modified by range filter
+                std::vector<uint8_t>& rangeEchoValid = m_scan_decode_buffer.echo_valid; // rangeEchoValid[rangeIdxScan] := 0, if point dropped by range filter, otherwise 1
+                std::vector<float>& xEcho = m_scan_decode_buffer.echo_x; // cartesian points of the current echo
+                std::vector<float>& yEcho = m_scan_decode_buffer.echo_y;
+                std::vector<float>& zEcho = m_scan_decode_buffer.echo_z;
+                for (size_t iEcho = 0; iEcho < numValidEchos; iEcho++)
+                {
+                  // Apply range filter, convert to cartesian coordinates (if required) and apply optional transform
+                  m_scan_decode_buffer.convertEcho(iEcho, rangeNum, range_filter, angleTable, &m_add_transform_xyz_rpy, cartesianCloudRequired);
 
-                  // Apply range filter
-                  float range_meter = rangeTmpPtr[iEcho * rangeNum + rangeIdxScan];
-                  bool range_modified = false;
-                  if (range_filter.apply(range_meter, range_modified)) // otherwise point dropped by range filter
+                  size_t rangeNumPointcloudCurEcho = 0;
+                  for (size_t rangeIdxScan = 0; rangeIdxScan < rangeNum; rangeIdxScan++)
                   {
-                    // ROS_DEBUG_STREAM("alpha:" << alpha << " elevPreCalc:" << std::to_string(elevationPreCalculated) << " layer:" << layer << " elevDeg:" << elevationAngleDegree
-                    //   << " numOfLayers:" << numOfLayers << " elevAngleX200:" << elevAngleX200);
-
-                    // Thanks to Sebastian Pütz <spuetz@uos.de> for his hint
-                    float rangeCos = range_meter * cosAlphaTablePtr[rangeIdxScan];
-
-                    double phi_used = phi  + angleShift;
-                    if (this->angleCompensator != NULL)
+                    if (!rangeEchoValid[rangeIdxScan]) // point dropped by range filter
                     {
-                      phi_used = angleCompensator->compensateAngleInRadFromRos(phi_used);
+                      continue;
                     }
-                    // Cartesian pointcloud
-                    float phi2_used = phi_used + m_add_transform_xyz_rpy.azimuthOffset();
-                    fptr[idx_x] = rangeCos * (float)cos(phi2_used) * mirror_factor;  // copy x value in pointcloud
-                    fptr[idx_y] = rangeCos * (float)sin(phi2_used) * mirror_factor;  // copy y value in pointcloud
-                    fptr[idx_z] = range_meter * sinAlphaTablePtr[rangeIdxScan] * mirror_factor; // copy z value in pointcloud
-
-                    m_add_transform_xyz_rpy.applyTransform(fptr[idx_x], fptr[idx_y], fptr[idx_z]);
-
-                    // Polar pointcloud (sick_scan_xd API)
-                    fptr_polar[idx_x] = range_meter; // range in meter
-                    fptr_polar[idx_y] = phi_used;    // azimuth in radians
-                    fptr_polar[idx_z] = alpha;       // elevation in radians
-
-                    fptr[idx_intensity] = 0.0;
+                    enum enum_index_descr
+                    {
+                      idx_x,
+                      idx_y,
+                      idx_z,
+                      idx_intensity,
+                      idx_num
+                    };
+                    long pointcloud_adroff = rangeNumPointcloudCurEcho * (numChannels * (int) sizeof(float));
+                    pointcloud_adroff += (layer - baseLayer) * cloud_.row_step;
+                    pointcloud_adroff += iEcho * cloud_.row_step * numTmpLayer;
+                    assert(pointcloud_adroff < cloud_.row_step * cloud_.height); // issue #49
+
+                    float intensity = 0.0;
                     if (config_.intensity)
                     {
                       int intensityIndex = aiValidEchoIdx[iEcho] * rangeNum + rangeIdxScan;
                       // intensity values available??
                       if (intensityIndex < intensityTmpNum)
                       {
-                        fptr[idx_intensity] = intensityTmpPtr[intensityIndex]; // copy intensity value in pointcloud
+                        intensity = intensityTmpPtr[intensityIndex]; // copy intensity value in pointcloud
                       }
                     }
-                    fptr_polar[idx_intensity] = fptr[idx_intensity];
+
+                    // Cartesian pointcloud
+                    if (cartesianCloudRequired)
+                    {
+                      float *fptr = (float *) (cloudDataPtr + pointcloud_adroff);
+                      fptr[idx_x] = xEcho[rangeIdxScan];  // copy x value in pointcloud
+                      fptr[idx_y] = yEcho[rangeIdxScan];  // copy y value in pointcloud
+                      fptr[idx_z] = zEcho[rangeIdxScan];  // copy z value in pointcloud
+                      fptr[idx_intensity] = intensity;
+                    }
+
+                    // Polar pointcloud (sick_scan_xd API)
+                    if (polarCloudRequired)
+                    {
+                      float *fptr_polar = (float *) (cloudDataPtr_polar + pointcloud_adroff);
+                      fptr_polar[idx_x] = rangeEcho[rangeIdxScan]; // range in meter
+                      fptr_polar[idx_y] = angleTable.azimuth[rangeIdxScan];  // azimuth in radians
+                      fptr_polar[idx_z] = angleTable.elevation[rangeIdxScan * angleTable.elevation_stride]; // elevation in radians
+                      fptr_polar[idx_intensity] = intensity;
+                    }
                     rangeNumPointcloudCurEcho++;
                   }
-                  angle += msg.angle_increment;
+                  rangeNumPointcloudAllEchos = std::max<size_t>(rangeNumPointcloudAllEchos, rangeNumPointcloudCurEcho);
                 }
-                rangeNumPointcloudAllEchos = std::max<size_t>(rangeNumPointcloudAllEchos, rangeNumPointcloudCurEcho);
-
-                // Publish
-                //static int cnt = 0;
-                int layerOff = (layer - baseLayer);
-
               }
 
               bool shallIFire = false;
@@ -5127,14 +5248,11 @@ namespace sick_scan_xd
                 // ROS_INFO_STREAM("scan_layer_filter activated: scan_layer_filter = " << m_scan_layer_filter_cfg.scan_layer_filter << ", elevAngleX200 = " << elevAngleX200 << ", layer = " << cur_layer << ", last_active_layer = " << m_scan_layer_filter_cfg.last_active_layer << ", shallIFire = " << shallIFire);
               }
 
-              static int layerCnt = 0;
-              static int layerSeq[4];
-
               if (config_.cloud_output_mode > 0)
               {
 
-                layerSeq[layerCnt % 4] = layer;
-                if (layerCnt >= 4)  // mind. erst einmal vier Layer zusammensuchen
+                m_layer_seq[m_layer_cnt % 4] = layer;
+                if (m_layer_cnt >= 4)  // mind. erst einmal vier Layer zusammensuchen
                 {
                   shallIFire = true; // here are at least 4 layers available
                 }
@@ -5143,34 +5261,40 @@ namespace sick_scan_xd
                   shallIFire = false;
                 }
 
-                layerCnt++;
+                m_layer_cnt++;
               }
 
               if (shallIFire) // shall i fire the signal???
               {
+                m_cloud_frame_start = true; // the next scan starts a new pointcloud
                 if (this->parser_->get_range_filter_config() == RangeFilterResultHandling::RANGE_FILTER_DROP && rangeNumPointcloudAllEchos < rangeNum)
                 {
                   // Points have been dropped, resize point cloud to number of points after applying the range filter
-                  range_filter.resizePointCloud(rangeNumPointcloudAllEchos, cloud_);
-                  range_filter.resizePointCloud(rangeNumPointcloudAllEchos, cloud_polar_);
+                  if (cartesianCloudRequired)
+                    range_filter.resizePointCloud(rangeNumPointcloudAllEchos, cloud_);
+                  if (polarCloudRequired)
+                    range_filter.resizePointCloud(rangeNumPointcloudAllEchos, cloud_polar_);
                 }
 
-                sick_scan_xd::PointCloud2withEcho cloud_msg(&cloud_, numValidEchos, 0);
-                sick_scan_xd::PointCloud2withEcho cloud_msg_polar(&cloud_polar_, numValidEchos, 0);
 #ifdef ROSSIMU
-                notifyPolarPointcloudListener(nh, &cloud_msg_polar);
-                notifyCartesianPointcloudListener(nh, &cloud_msg);
+                if (m_publish_pipeline) // pipeline mode: notify listeners with a copy of the required clouds, cloud_ and cloud_polar_ are updated by the next datagram
+                  m_publish_pipeline->push([notifyCloudListener, cloud = (cartesianCloudRequired ? cloud_ : ros_sensor_msgs::PointCloud2()), cloud_polar = (polarCloudRequired ? cloud_polar_ : ros_sensor_msgs::PointCloud2()), numValidEchos, cartesianCloudRequired, polarCloudRequired]()
+                    { notifyCloudListener(cloud, cloud_polar, numValidEchos, cartesianCloudRequired, polarCloudRequired); }, receiveTimestampNsec, parseStartTimestampNsec);
+                else
+                  notifyCloudListener(cloud_, cloud_polar_, numValidEchos, cartesianCloudRequired, polarCloudRequired);
                 // plotPointCloud(cloud_);
 #else
                 // ROS_DEBUG_STREAM("publishing cloud " << cloud_.height << " x " << cloud_.width << " data, cloud_output_mode=" << config_.cloud_output_mode);
                 if (config_.cloud_output_mode==0)
                 {
                   // standard handling of scans
-                  notifyPolarPointcloudListener(nh, &cloud_msg_polar);
-                  notifyCartesianPointcloudListener(nh, &cloud_msg);
-                  rosPublish(cloud_pub_, cloud_);
+                  if (m_publish_pipeline) // pipeline mode: publish a copy of the required clouds, cloud_ and cloud_polar_ are updated by the next datagram
+                    m_publish_pipeline->push([publishCloud, cloud = (cartesianCloudRequired ? cloud_ : ros_sensor_msgs::PointCloud2()), cloud_polar = (polarCloudRequired ? cloud_polar_ : ros_sensor_msgs::PointCloud2()), numValidEchos, cartesianCloudRequired, polarCloudRequired]()
+                      { publishCloud(cloud, cloud_polar, numValidEchos, cartesianCloudRequired, polarCloudRequired); }, receiveTimestampNsec, parseStartTimestampNsec);
+                  else
+                    publishCloud(cloud_, cloud_polar_, numValidEchos, cartesianCloudRequired, polarCloudRequired);
                 }
-                else if (config_.cloud_output_mode == 2)
+                else if (config_.cloud_output_mode == 2 && cartesianCloudRequired) // partial clouds are cut from the cartesian pointcloud
                 {
                   // Following cases are interesting:
                   // LMS5xx: seq is always 0 -> publish every scan
@@ -5181,86 +5305,49 @@ namespace sick_scan_xd
                   //          angle increment is 0.75° (yields 274,5° covery -> OK)
                   // MRS6124: Publish very 24th layer at the layer = 237 , MRS6124 contains no sequence with seq 0
                   //BBB
-                  int numTotalShots = 360; //TODO where is this from ?
-                  int numPartialShots = 40; //
+                  // Partial clouds are sliced from the layers accumulated in cloud_ into preallocated messages, i.e. cloud_ is not copied
+                  // and the message storage is reused from scan to scan. Sector size and count are configured by parameter
+                  // "cloud_output_sector_size" (default: 40 shots) and "cloud_output_sector_count" (default: 9 sectors).
+                  int numPartialShots = m_cloud_output_sector_size; // number of shots per sector
+                  int numTotalShots = m_cloud_output_sector_size * m_cloud_output_sector_count; // default: 360
+                  if (m_partial_clouds.size() != (size_t)m_cloud_output_sector_count)
+                  {
+                    m_partial_clouds.resize(m_cloud_output_sector_count);
+                  }
 
-                  for (int i = 0; i < numTotalShots; i += numPartialShots)
+                  for (int sectorIdx = 0, i = 0; sectorIdx < m_cloud_output_sector_count; sectorIdx++, i += numPartialShots)
                   {
-                    ros_sensor_msgs::PointCloud2 partialCloud;
-                    partialCloud = cloud_;
+                    ros_sensor_msgs::PointCloud2& partialCloud = m_partial_clouds[sectorIdx];
                     rosTime partialTimeStamp = cloud_.header.stamp;
 
                     partialTimeStamp = partialTimeStamp + rosDurationFromSec((i + 0.5 * (numPartialShots - 1)) * timeIncrement);
                     partialTimeStamp = partialTimeStamp + rosDurationFromSec((3 * numTotalShots) * timeIncrement);
                     partialCloud.header.stamp = partialTimeStamp;
-                    partialCloud.width = numPartialShots * 3;  // die sind sicher in diesem Bereich
-
-                    int diffTo1100 = cloud_.width - 3 * (numTotalShots + i);
-                    if (diffTo1100 > numPartialShots)
-                    {
-                      diffTo1100 = numPartialShots;
-                    }
-                    if (diffTo1100 < 0)
-                    {
-                      diffTo1100 = 0;
-                    }
-                    partialCloud.width += diffTo1100;
-                    // printf("Offset: %4d Breite: %4d\n", i, partialCloud.width);
+                    partialCloud.header.frame_id.assign(cloud_.header.frame_id);
+                    ROS_HEADER_SEQ(partialCloud.header, 0);
                     partialCloud.height = 1;
-
-
                     partialCloud.is_bigendian = false;
                     partialCloud.is_dense = true;
-                    partialCloud.point_step = numChannels * sizeof(float);
-                    partialCloud.row_step = partialCloud.point_step * partialCloud.width;
-                    partialCloud.fields.resize(numChannels);
-                    for (int ii = 0; ii < numChannels; ii++)
-                    {
-                      std::string channelId[] = {"x", "y", "z", "intensity"};
-                      partialCloud.fields[ii].name = channelId[ii];
-                      partialCloud.fields[ii].offset = ii * sizeof(float);
-                      partialCloud.fields[ii].count = 1;
-                      partialCloud.fields[ii].datatype = ros_sensor_msgs::PointField::FLOAT32;
-                    }
-
-                    partialCloud.data.resize(partialCloud.row_step, 0);
-
-                    int partOff = 0;
-                    for (int j = 0; j < 4; j++)
+                    if (partialCloud.fields.size() != (size_t)numChannels) // field descriptors are set once
                     {
-                      int layerIdx = (j + (layerCnt)) % 4;  // j = 0 -> oldest
-                      int rowIdx = 1 + layerSeq[layerIdx % 4]; // +1, da es bei -1 beginnt
-                      int colIdx = j * numTotalShots + i;
-                      int maxAvail = cloud_.width - colIdx; //
-                      if (maxAvail < 0)
+                      partialCloud.fields.resize(numChannels);
+                      for (int ii = 0; ii < numChannels; ii++)
                       {
-                        maxAvail = 0;
+                        std::string channelId[] = {"x", "y", "z", "intensity"};
+                        partialCloud.fields[ii].name = channelId[ii];
+                        partialCloud.fields[ii].offset = ii * sizeof(float);
+                        partialCloud.fields[ii].count = 1;
+                        partialCloud.fields[ii].datatype = ros_sensor_msgs::PointField::FLOAT32;
                       }
-
-                      if (maxAvail > numPartialShots)
-                      {
-                        maxAvail = numPartialShots;
-                      }
-
-                      // printf("Most recent LayerIdx: %2d RowIdx: %4d ColIdx: %4d\n", layer, rowIdx, colIdx);
-                      if (maxAvail > 0)
-                      {
-                        memcpy(&(partialCloud.data[partOff]),
-                               &(cloud_.data[(rowIdx * cloud_.width + colIdx + i) * cloud_.point_step]),
-                               cloud_.point_step * maxAvail);
-
-                      }
-
-                      partOff += maxAvail * partialCloud.point_step;
                     }
+                    slicePartialCloud(cloud_, m_layer_seq, m_layer_cnt, numPartialShots, m_cloud_output_sector_count, sectorIdx, partialCloud);
                     assert(partialCloud.data.size() == partialCloud.width * partialCloud.point_step);
 
 
-                    sick_scan_xd::PointCloud2withEcho partial_cloud_msg(&partialCloud, numValidEchos, 0);
-                    notifyCartesianPointcloudListener(nh, &partial_cloud_msg);
-                    rosPublish(cloud_pub_, partialCloud);
-                    //memcpy(&(partialCloud.data[0]), &(cloud_.data[0]) + i * cloud_.point_step, cloud_.point_step * numPartialShots);
-                    //cloud_pub_.publish(partialCloud);
+                    if (m_publish_pipeline) // pipeline mode: publish a copy of the slice, m_partial_clouds are updated by the next scan
+                      m_publish_pipeline->push([publishPartialPointCloud, partial_cloud = partialCloud, numValidEchos]() { publishPartialPointCloud(partial_cloud, numValidEchos); }, receiveTimestampNsec, parseStartTimestampNsec);
+                    else
+                      publishPartialPointCloud(partialCloud, numValidEchos);
                   }
                 }
                 //                cloud_pub_.publish(cloud_);
@@ -5540,7 +5627,7 @@ namespace sick_scan_xd
           // buffer[6] = 0x01; // MRS1xxx with firmware version > 1 supports RANG+FEVL -> overwrite with "<STX>sWN{SPC}SetActiveApplications{SPC}1{SPC}FEVL{SPC}1<ETX>"
           // MRS1xxx with firmware version > 1 supports RANG+FEVL -> overwrite with "<STX>sWN{SPC}SetActiveApplications{SPC}2{SPC}FEVL{SPC}1{SPC}RANG{SPC}1<ETX>"
           // resp. binary "sWN SetActiveApplications \00\02\46\45\56\4C\01\52\41\4e\47\01"
-          uint8_t field_evaluation_status = isFieldEvaluationActive() ? 0x01: 0x00;
+          uint8_t field_evaluation_status = m_field_evaluation_active ? 0x01: 0x00;
           std::vector<uint8_t> binary_parameter = {0x00, 0x02, 0x46, 0x45, 0x56, 0x4C, field_evaluation_status, 0x52, 0x41, 0x4e, 0x47, 0x01};
           for (int ii = 0; ii < binary_parameter.size(); ii++)
             buffer[ii] = binary_parameter[ii];
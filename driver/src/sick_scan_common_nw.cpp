@@ -201,6 +201,14 @@ uint64_t SickScanCommonNw::getNanosecTimestampLastTcpMessageReceived(void)
   return m_tcp.getNanosecTimestampLastTcpMessageReceived(); 
 }
 
+/**
+  * Returns the receive timestamp of the data passed to the read callback (kernel receive timestamp if supported, otherwise the time of the recv call)
+  */
+rosTime SickScanCommonNw::getReceiveTimestamp(void)
+{
+  return m_tcp.getReceiveTimestamp();
+}
+
 //
 // Close TCP-connection and shut down read thread
 //
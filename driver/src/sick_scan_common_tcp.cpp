@@ -74,6 +74,7 @@
 #include <sick_scan/sick_scan_messages.h>
 #include <sick_scan/tcp/colaa.hpp>
 #include <sick_scan/tcp/colab.hpp>
+#include <sick_scan/sick_socket_reactor.h>
 
 #include <algorithm>
 #include <iterator>
@@ -217,9 +218,14 @@ namespace sick_scan_xd
 
     assert(this->getProtocolType() != CoLa_Unknown);
 
-    m_numberOfBytesInReceiveBuffer = 0;
     m_alreadyReceivedBytes = 0;
     this->setReplyMode(0);
+
+    // Optional epoll reactor: io_reactor_threads > 0 threads receive the data of all lidars (default: 0, i.e. one receive thread per tcp connection)
+    int io_reactor_threads = 0;
+    rosDeclareParam(nh, "io_reactor_threads", io_reactor_threads);
+    rosGetParam(nh, "io_reactor_threads", io_reactor_threads);
+    m_nw.setSocketReactor(sick_scan_xd::SocketReactor::sharedInstance(io_reactor_threads));
     // io_service_.setReadCallbackFunction(boost::bind(&SopasDevice::readCallbackFunction, this, _1, _2));
 
     // Set up the deadline actor to implement timeouts.
@@ -313,184 +319,196 @@ namespace sick_scan_xd
     return (m_emulSensor);
   }
 
+  SopasFrameAssembler::SopasFrameAssembler(size_t initial_capacity, size_t max_capacity)
+  : m_buffer(initial_capacity), m_begin(0), m_end(0), m_search_pos(0), m_max_capacity(std::max(initial_capacity, max_capacity))
+  {
+  }
+
   //
-  // Look for 23-frame (STX/ETX) in receive buffer.
-  // Move frame to start of buffer
+  // Append received bytes to the receive buffer. The buffer is compacted only if the free space at its end is too small.
   //
-  // Return: 0 : No (complete) frame found
-  //        >0 : Frame length
+  bool SopasFrameAssembler::append(const UINT8* data, size_t length)
+  {
+    if (m_end + length > m_buffer.size())
+    {
+      size_t bytes_in_buffer = m_end - m_begin;
+      if (bytes_in_buffer + length > m_max_capacity)
+      {
+        ROS_WARN_STREAM("SopasFrameAssembler::append(): receive buffer overflow (" << (bytes_in_buffer + length) << " bytes exceed max. capacity of " << m_max_capacity << " bytes), " << bytes_in_buffer << " bytes discarded");
+        clear();
+        if (length > m_max_capacity)
+          return false;
+      }
+      else
+      {
+        if (m_begin > 0) // move the pending (incomplete) frame to the start of the buffer
+        {
+          memmove(m_buffer.data(), m_buffer.data() + m_begin, bytes_in_buffer);
+          m_search_pos -= m_begin;
+          m_end -= m_begin;
+          m_begin = 0;
+        }
+        if (m_end + length > m_buffer.size())
+          m_buffer.resize(std::min(std::max(2 * m_buffer.size(), m_end + length), m_max_capacity));
+      }
+    }
+    memcpy(m_buffer.data() + m_end, data, length);
+    m_end += length;
+    return true;
+  }
+
+  void SopasFrameAssembler::clear(void)
+  {
+    m_begin = 0;
+    m_end = 0;
+    m_search_pos = 0;
+  }
+
   //
-  SopasEventMessage SickScanCommonTcp::findFrameInReceiveBuffer()
+  // Look for 23-frame (STX/ETX) resp. 0x02020202 + length + payload + checksum in receive buffer.
+  //
+  // Return: frame with size 0 : No (complete) frame found
+  //         frame with size > 0 : Frame found and removed from the buffer
+  //
+  SopasEventMessage SopasFrameAssembler::nextFrame(SopasProtocol protocol, bool verbose)
   {
-    UINT32 frameLen = 0;
-    UINT32 i;
+    UINT8* buffer = m_buffer.data();
+    if (m_begin >= m_end)
+    {
+      clear(); // buffer empty, restart at the front
+      return SopasEventMessage();
+    }
 
     // Depends on protocol...
-    if (getProtocolType() == CoLa_A)
+    if (protocol == CoLa_A)
     {
       //
       // COLA-A
       //
       // Must start with STX (0x02)
-      if (m_receiveBuffer[0] != 0x02)
+      if (buffer[m_begin] != 0x02)
       {
-        // Look for starting STX (0x02)
-        for (i = 1; i < m_numberOfBytesInReceiveBuffer; i++)
-        {
-          if (m_receiveBuffer[i] == 0x02)
-          {
-            break;
-          }
-        }
-
-        // Found beginning of frame?
-        if (i >= m_numberOfBytesInReceiveBuffer)
+        const UINT8* stx = (const UINT8*)memchr(buffer + m_begin, 0x02, m_end - m_begin);
+        if (stx == 0)
         {
           // No start found, everything can be discarded
-          m_numberOfBytesInReceiveBuffer = 0; // Invalidate buffer
+          clear();
           return SopasEventMessage(); // No frame found
         }
-
-        // Move frame start to index 0
-        UINT32 newLen = m_numberOfBytesInReceiveBuffer - i;
-        memmove(&(m_receiveBuffer[0]), &(m_receiveBuffer[i]), newLen);
-        m_numberOfBytesInReceiveBuffer = newLen;
+        m_begin = stx - buffer;
       }
 
-      // Look for ending ETX (0x03)
-      for (i = 1; i < m_numberOfBytesInReceiveBuffer; i++)
-      {
-        if (m_receiveBuffer[i] == 0x03)
-        {
-          break;
-        }
-      }
-
-      // Found end?
-      if (i >= m_numberOfBytesInReceiveBuffer)
+      // Look for ending ETX (0x03), continue search behind the bytes already searched
+      size_t search_start = std::max(m_search_pos, m_begin + 1);
+      const UINT8* etx = (search_start < m_end) ? (const UINT8*)memchr(buffer + search_start, 0x03, m_end - search_start) : 0;
+      if (etx == 0)
       {
         // No end marker found, so it's not a complete frame (yet)
+        m_search_pos = m_end;
         return SopasEventMessage(); // No frame found
       }
 
       // Calculate frame length in byte
-      frameLen = i + 1;
-
-      return SopasEventMessage(m_receiveBuffer, CoLa_A, frameLen);
+      size_t frameLen = (etx - buffer) - m_begin + 1;
+      SopasEventMessage frame(buffer + m_begin, CoLa_A, (UINT32)frameLen);
+      m_begin += frameLen;
+      m_search_pos = m_begin;
+      return frame;
     }
-    else if (getProtocolType() == CoLa_B)
+    else if (protocol == CoLa_B)
     {
-      UINT32 magicWord;
-      UINT32 payloadlength;
-
-      if (m_numberOfBytesInReceiveBuffer < 4)
-      {
-        return SopasEventMessage();
-      }
-      UINT16 pos = 0;
-      magicWord = colab::getIntegerFromBuffer<UINT32>(m_receiveBuffer, pos);
-      if (magicWord != 0x02020202)
+      while (1)
       {
-        // Look for starting STX (0x02020202)
-        for (i = 1; i <= m_numberOfBytesInReceiveBuffer - 4; i++)
+        static const UINT8 magicWord[4] = { 0x02, 0x02, 0x02, 0x02 };
+        while (m_end - m_begin >= 4 && memcmp(buffer + m_begin, magicWord, 4) != 0)
         {
-          pos = i; // this is needed, as the position value is updated by getIntegerFromBuffer
-          magicWord = colab::getIntegerFromBuffer<UINT32>(m_receiveBuffer, pos);
-          if (magicWord == 0x02020202)
+          // Look for starting STX (0x02020202)
+          const UINT8* stx = (const UINT8*)memchr(buffer + m_begin + 1, 0x02, m_end - m_begin - 1);
+          if (stx == 0)
           {
-            // found magic word
-            break;
+            // No start found, everything can be discarded
+            clear();
+            return SopasEventMessage(); // No frame found
           }
+          m_begin = stx - buffer;
         }
 
-        // Found beginning of frame?
-        if (i > m_numberOfBytesInReceiveBuffer - 4)
-        {
-          // No start found, everything can be discarded
-          m_numberOfBytesInReceiveBuffer = 0; // Invalidate buffer
-          return SopasEventMessage(); // No frame found
-        }
-        else
+        // Pruefe Laenge des Pufferinhalts
+        if (m_end - m_begin < 9)
         {
-          // Move frame start to index
-          UINT32 bytesToMove = m_numberOfBytesInReceiveBuffer - i;
-          memmove(&(m_receiveBuffer[0]), &(m_receiveBuffer[i]), bytesToMove); // payload+magic+length+s+checksum
-          m_numberOfBytesInReceiveBuffer = bytesToMove;
+          // Es sind nicht genug Daten fuer einen Frame
+          printInfoMessage("SopasFrameAssembler::nextFrame: Frame cannot be decoded yet, only " + ::toString(m_end - m_begin) + " bytes in the buffer.", verbose);
+          return SopasEventMessage();
         }
-      }
-
-      // Pruefe Laenge des Pufferinhalts
-      if (m_numberOfBytesInReceiveBuffer < 9)
-      {
-        // Es sind nicht genug Daten fuer einen Frame
-        printInfoMessage("SickScanCommonNw::findFrameInReceiveBuffer: Frame cannot be decoded yet, only " +
-                         ::toString(m_numberOfBytesInReceiveBuffer) + " bytes in the buffer.", m_beVerbose);
-        return SopasEventMessage();
-      }
 
-      // Read length of payload
-      pos = 4;
-      payloadlength = colab::getIntegerFromBuffer<UINT32>(m_receiveBuffer, pos);
-      printInfoMessage(
-          "SickScanCommonNw::findFrameInReceiveBuffer: Decoded payload length is " + ::toString(payloadlength) +
-          " bytes.", m_beVerbose);
-
-      // Ist die Datenlaenge plausibel und wuede in den Puffer passen?
-      if (payloadlength > (sizeof(m_receiveBuffer) - 9))
-      {
-        // magic word + length + checksum = 9
-        printWarning(
-            "SickScanCommonNw::findFrameInReceiveBuffer: Frame too big for receive buffer. Frame discarded with length:"
-            + ::toString(payloadlength) + ".");
-        m_numberOfBytesInReceiveBuffer = 0;
-        return SopasEventMessage();
-      }
-      if ((payloadlength + 9) > m_numberOfBytesInReceiveBuffer)
-      {
-        // magic word + length + s + checksum = 10
-        printInfoMessage(
-            "SickScanCommonNw::findFrameInReceiveBuffer: Frame not complete yet. Waiting for the rest of it (" +
-            ::toString(payloadlength + 9 - m_numberOfBytesInReceiveBuffer) + " bytes missing).", m_beVerbose);
-        return SopasEventMessage(); // frame not complete
-      }
+        // Read length of payload (big endian)
+        const UINT8* p_length = buffer + m_begin + 4;
+        size_t payloadlength = ((size_t)p_length[0] << 24) | ((size_t)p_length[1] << 16) | ((size_t)p_length[2] << 8) | (size_t)p_length[3];
+        printInfoMessage("SopasFrameAssembler::nextFrame: Decoded payload length is " + ::toString(payloadlength) + " bytes.", verbose);
 
-      // Calculate the total frame length in bytes: Len = Frame (9 bytes) + Payload
-      frameLen = payloadlength + 9;
+        // Ist die Datenlaenge plausibel?
+        if (payloadlength + 9 > m_max_capacity)
+        {
+          // magic word + length + checksum = 9
+          printWarning("SopasFrameAssembler::nextFrame: Frame too big for receive buffer. Frame discarded with length:" + ::toString(payloadlength) + ".");
+          m_begin += 4; // skip magic word and resync with the next frame
+          continue;
+        }
+        if ((payloadlength + 9) > m_end - m_begin)
+        {
+          // magic word + length + s + checksum = 10
+          printInfoMessage("SopasFrameAssembler::nextFrame: Frame not complete yet. Waiting for the rest of it (" + ::toString(payloadlength + 9 - (m_end - m_begin)) + " bytes missing).", verbose);
+          return SopasEventMessage(); // frame not complete
+        }
 
-      //
-      // test checksum of payload
-      //
-      UINT8 temp = 0;
-      UINT8 temp_xor = 0;
-      UINT8 checkSum;
+        // Calculate the total frame length in bytes: Len = Frame (9 bytes) + Payload
+        size_t frameLen = payloadlength + 9;
 
-      // Read original checksum
-      pos = frameLen - 1;
-      checkSum = colab::getIntegerFromBuffer<UINT8>(m_receiveBuffer, pos);
+        //
+        // test checksum of payload: xor of all payload bytes, computed with 8 byte words
+        //
+        const UINT8* payload = buffer + m_begin + 8;
+        UINT8 checkSum = payload[payloadlength];
+        uint64_t xor64 = 0;
+        size_t j = 0;
+        for (; j + 8 <= payloadlength; j += 8)
+        {
+          uint64_t word;
+          memcpy(&word, payload + j, sizeof(word));
+          xor64 ^= word;
+        }
+        xor64 ^= (xor64 >> 32);
+        xor64 ^= (xor64 >> 16);
+        xor64 ^= (xor64 >> 8);
+        UINT8 temp_xor = (UINT8)(xor64 & 0xFF);
+        for (; j < payloadlength; j++)
+        {
+          temp_xor ^= payload[j];
+        }
 
-      // Erzeuge die Pruefsumme zum Vergleich
-      for (UINT16 j = 8; j < (frameLen - 1); j++)
-      {
-        pos = j;
-        temp = colab::getIntegerFromBuffer<UINT8>(m_receiveBuffer, pos);
-        temp_xor = temp_xor ^ temp;
-      }
+        // Vergleiche die Pruefsummen
+        if (temp_xor != checkSum)
+        {
+          printWarning("SopasFrameAssembler::nextFrame: Wrong checksum, Frame discarded.");
+          m_begin += 4; // skip magic word and resync with the next frame
+          continue;
+        }
 
-      // Vergleiche die Pruefsummen
-      if (temp_xor != checkSum)
-      {
-        printWarning("SickScanCommonNw::findFrameInReceiveBuffer: Wrong checksum, Frame discarded.");
-        m_numberOfBytesInReceiveBuffer = 0;
-        return SopasEventMessage();
+        SopasEventMessage frame(buffer + m_begin, CoLa_B, (UINT32)frameLen);
+        m_begin += frameLen;
+        return frame;
       }
-
-      return SopasEventMessage(m_receiveBuffer, CoLa_B, frameLen);
     }
 
     // Return empty frame
     return SopasEventMessage();
   }
 
+  SopasEventMessage SickScanCommonTcp::findFrameInReceiveBuffer()
+  {
+    return m_receiveBuffer.nextFrame((SopasProtocol)getProtocolType(), m_beVerbose);
+  }
+
 
   /**
  * Read callback. Diese Funktion wird aufgerufen, sobald Daten auf der Schnittstelle
@@ -521,47 +539,26 @@ namespace sick_scan_xd
                                                                                        frame.getRawData() +
                                                                                        frame.size()));
     // recvQueue.push(std::vector<unsigned char>(frame.getRawData(), frame.getRawData() + frame.size()));
-    recvQueue.push(dataGramWidthTimeStamp);
+    recvQueue.push(std::move(dataGramWidthTimeStamp));
   }
 
   void SickScanCommonTcp::readCallbackFunction(UINT8 *buffer, UINT32 &numOfBytes)
   {
-    rosTime rcvTimeStamp = rosTimeNow(); // stamp received datagram
+    rosTime rcvTimeStamp = m_nw.getReceiveTimestamp(); // stamp received datagram (kernel receive timestamp if supported)
     bool beVerboseHere = false;
     printInfoMessage(
         "SickScanCommonNw::readCallbackFunction(): Called with " + toString(numOfBytes) + " available bytes.",
         beVerboseHere);
 
     ScopedLock lock(&m_receiveDataMutex); // Mutex for access to the input buffer
-    UINT32 remainingSpace = sizeof(m_receiveBuffer) - m_numberOfBytesInReceiveBuffer;
-    UINT32 bytesToBeTransferred = numOfBytes;
-    if (remainingSpace < numOfBytes)
+    if (m_receiveBuffer.append(buffer, numOfBytes))
     {
-      bytesToBeTransferred = remainingSpace;
-      // printWarning("SickScanCommonNw::readCallbackFunction(): Input buffer space is to small, transferring only " +
-      //              ::toString(bytesToBeTransferred) + " of " + ::toString(numOfBytes) + " bytes.");
-    }
-    else
-    {
-      // printInfoMessage("SickScanCommonNw::readCallbackFunction(): Transferring " + ::toString(bytesToBeTransferred) +
-      //                   " bytes from TCP to input buffer.", beVerboseHere);
-    }
-
-    if (bytesToBeTransferred > 0)
-    {
-      // Data can be transferred into our input buffer
-      memcpy(&(m_receiveBuffer[m_numberOfBytesInReceiveBuffer]), buffer, bytesToBeTransferred);
-      m_numberOfBytesInReceiveBuffer += bytesToBeTransferred;
-
-      UINT32 size = 0;
-
       while (1)
       {
         // Now work on the input buffer until all received datasets are processed
         SopasEventMessage frame = findFrameInReceiveBuffer();
 
-        size = frame.size();
-        if (size == 0)
+        if (frame.size() == 0)
         {
           // Framesize = 0: There is no valid frame in the buffer. The buffer is either empty or the frame
           // is incomplete, so leave the loop
@@ -578,20 +575,9 @@ namespace sick_scan_xd
               "SickScanCommonNw::readCallbackFunction(): Processing a frame of length " + ::toString(frame.size()) +
               " bytes.", beVerboseHere);
           processFrame(rcvTimeStamp, frame);
-          UINT32 bytesToMove = m_numberOfBytesInReceiveBuffer - size;
-          memmove(&(m_receiveBuffer[0]), &(m_receiveBuffer[size]), bytesToMove); // payload+magic+length+s+checksum
-          m_numberOfBytesInReceiveBuffer = bytesToMove;
-
         }
       }
     }
-    else
-    {
-      // There was input data from the TCP interface, but our input buffer was unable to hold a single byte.
-      // Either we have not read data from our buffer for a long time, or something has gone wrong. To re-sync,
-      // we clear the input buffer here.
-      m_numberOfBytesInReceiveBuffer = 0;
-    }
   }
 
 
@@ -0,0 +1,131 @@
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+#include <algorithm>
+#include <sick_scan/sick_scan_decode_buffer.h>
+
+/*
+* Prepares the decoding of a new telegram and returns the LaserScan message to decode into.
+* Scalar fields are reset to default, ranges and intensities are cleared (capacity is kept).
+*/
+ros_sensor_msgs::LaserScan& sick_scan_xd::ScanDecodeBuffer::beginTelegram(void)
+{
+    ROS_HEADER_SEQ(scan.header, 0);
+    scan.angle_min = 0;
+    scan.angle_max = 0;
+    scan.angle_increment = 0;
+    scan.time_increment = 0;
+    scan.scan_time = 0;
+    scan.range_min = 0;
+    scan.range_max = 0;
+    scan.ranges.clear();
+    scan.intensities.clear();
+    vang.clear();
+    return scan;
+}
+
+/*
+* Moves the decoded ranges and intensities of all echos from the LaserScan message into the telegram buffers
+* ranges_all_echos and intensities_all_echos (swap, no copy). The message is filled by sliceEcho afterwards.
+*/
+void sick_scan_xd::ScanDecodeBuffer::takeEchos(ros_sensor_msgs::LaserScan& msg)
+{
+    ranges_all_echos.swap(msg.ranges);
+    intensities_all_echos.swap(msg.intensities);
+}
+
+/*
+* Sets ranges and intensities of a LaserScan message to the values of echo echo_idx, i.e. to the slice
+* [echo_idx * num_values, (echo_idx + 1) * num_values) of the telegram buffers. Intensities are set to 0,
+* if the telegram does not contain intensity values for this echo.
+*/
+void sick_scan_xd::ScanDecodeBuffer::sliceEcho(size_t echo_idx, size_t num_values, ros_sensor_msgs::LaserScan& msg) const
+{
+    size_t start_offset = echo_idx * num_values;
+    size_t end_offset = (echo_idx + 1) * num_values;
+    msg.ranges.assign(ranges_all_echos.begin() + std::min(start_offset, ranges_all_echos.size()), ranges_all_echos.begin() + std::min(end_offset, ranges_all_echos.size()));
+    if (end_offset <= intensities_all_echos.size() && intensities_all_echos.size() > 0) // check also for MRS1104
+        msg.intensities.assign(intensities_all_echos.begin() + start_offset, intensities_all_echos.begin() + end_offset);
+    else
+        msg.intensities.assign(num_values, 0.0f); // fill with zeros
+}
+
+/*
+* Resizes the point buffers for one echo (range, valid flag and cartesian coordinates) to num_points
+*/
+void sick_scan_xd::ScanDecodeBuffer::resizeEchoPoints(size_t num_points)
+{
+    echo_range.resize(num_points);
+    echo_valid.resize(num_points);
+    echo_x.resize(num_points);
+    echo_y.resize(num_points);
+    echo_z.resize(num_points);
+}
+
+/*
+* Copies the range values of echo echo_idx, i.e. the slice [echo_idx * num_points, (echo_idx + 1) * num_points) of ranges_all_echos,
+* into echo_range, applies the range filter and converts the points to cartesian coordinates echo_x, echo_y and echo_z
+* (if cartesian is true) using the lookup tables. The point buffers must have been resized by resizeEchoPoints(num_points).
+* Returns the number of points not dropped by the range filter.
+*/
+size_t sick_scan_xd::ScanDecodeBuffer::convertEcho(size_t echo_idx, size_t num_points, const SickRangeFilter& range_filter, const PolarToCartesianTable& table, SickCloudTransform* transform, bool cartesian)
+{
+    const float* echo_start = ranges_all_echos.data() + echo_idx * num_points;
+    std::copy(echo_start, echo_start + num_points, echo_range.begin());
+    return PolarToCartesian::convert(num_points, echo_range.data(), range_filter, echo_valid.data(), table.cos_azimuth.data(), table.sin_azimuth.data(),
+        table.cos_elevation.data(), table.sin_elevation.data(), table.elevation_stride, 1.0f, transform,
+        (cartesian ? echo_x.data() : 0), (cartesian ? echo_y.data() : 0), (cartesian ? echo_z.data() : 0));
+}
@@ -0,0 +1,201 @@
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+#include <sstream>
+#include <iomanip>
+#include <sick_scan/sick_scan_publish_pipeline.h>
+
+/*
+* Prints the number of measurements, mean and max latency in milliseconds
+*/
+std::string sick_scan_xd::PipelineStageStatistics::print(void) const
+{
+  std::stringstream s;
+  s << std::fixed << std::setprecision(3) << meanMilliseconds() << " ms mean, " << maxMilliseconds() << " ms max";
+  return s.str();
+}
+
+/*
+* Constructor, starts the publish thread
+* @param[in] max_queue_size max. number of publish jobs waiting for the publish thread
+*/
+sick_scan_xd::SickScanPublishPipeline::SickScanPublishPipeline(size_t max_queue_size)
+: m_max_queue_size(std::max<size_t>(1, max_queue_size)), m_run_publish_thread(true), m_publish_thread(0), m_num_dropped_jobs(0), m_last_print_timestamp_nsec(0)
+{
+  m_publish_thread = new std::thread(&sick_scan_xd::SickScanPublishPipeline::runPublishThread, this);
+}
+
+/*
+* Destructor, publishes all pending jobs and stops the publish thread
+*/
+sick_scan_xd::SickScanPublishPipeline::~SickScanPublishPipeline()
+{
+  stop();
+}
+
+/*
+* Pushes a publish job to the queue of the publish thread.
+* @param[in] publish_function function publishing and notifying messages, runs in the publish thread
+* @param[in] receive_timestamp_nsec system time in nanoseconds when the datagram was received
+* @param[in] parse_start_timestamp_nsec system time in nanoseconds when parsing of the datagram started
+*/
+void sick_scan_xd::SickScanPublishPipeline::push(PublishFunction&& publish_function, uint64_t receive_timestamp_nsec, uint64_t parse_start_timestamp_nsec)
+{
+  PublishJob job;
+  job.publish_function = std::move(publish_function);
+  job.receive_timestamp_nsec = receive_timestamp_nsec;
+  job.parse_start_timestamp_nsec = parse_start_timestamp_nsec;
+  job.push_timestamp_nsec = rosNanosecTimestampNow();
+  {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    if (!m_publish_thread)
+      return;
+    while (m_queue.size() >= m_max_queue_size)
+    {
+      m_queue.pop_front(); // publish thread too slow: drop the oldest job
+      m_num_dropped_jobs++;
+      if (m_num_dropped_jobs == 1 || (m_num_dropped_jobs % 100) == 0)
+        ROS_WARN_STREAM("## WARNING SickScanPublishPipeline::push(): publish queue full, " << m_num_dropped_jobs << " publish jobs dropped");
+    }
+    m_queue.push_back(std::move(job));
+  }
+  m_queue_cond.notify_one();
+}
+
+/*
+* Publishes all pending jobs and stops the publish thread
+*/
+void sick_scan_xd::SickScanPublishPipeline::stop(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    m_run_publish_thread = false;
+  }
+  m_queue_cond.notify_all();
+  std::thread* publish_thread = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    std::swap(publish_thread, m_publish_thread);
+  }
+  if (publish_thread)
+  {
+    if (publish_thread->joinable())
+      publish_thread->join();
+    delete publish_thread;
+    ROS_INFO_STREAM("SickScanPublishPipeline: " << printStatistics());
+  }
+}
+
+/*
+* Returns the number of publish jobs dropped because of a full queue
+*/
+size_t sick_scan_xd::SickScanPublishPipeline::getNumberOfDroppedJobs(void)
+{
+  std::lock_guard<std::mutex> lock(m_queue_mutex);
+  return m_num_dropped_jobs;
+}
+
+/*
+* Prints the latency statistics of all pipeline stages
+*/
+std::string sick_scan_xd::SickScanPublishPipeline::printStatistics(void)
+{
+  std::lock_guard<std::mutex> lock(m_queue_mutex);
+  std::stringstream s;
+  s << m_total_latency.count() << " jobs published, " << m_num_dropped_jobs << " dropped, latency receive queue: " << m_receive_latency.print()
+    << ", parse: " << m_parse_latency.print() << ", publish queue: " << m_queue_latency.print() << ", publish: " << m_publish_latency.print()
+    << ", total: " << m_total_latency.print();
+  return s.str();
+}
+
+/*
+* Thread function: runs all publish jobs in the order they were pushed
+*/
+void sick_scan_xd::SickScanPublishPipeline::runPublishThread(void)
+{
+  while (true)
+  {
+    PublishJob job;
+    {
+      std::unique_lock<std::mutex> lock(m_queue_mutex);
+      m_queue_cond.wait(lock, [this]{ return !m_queue.empty() || !m_run_publish_thread; });
+      if (m_queue.empty())
+        break; // m_run_publish_thread == false and all jobs published
+      job = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    uint64_t publish_start_nsec = rosNanosecTimestampNow();
+    if (job.publish_function)
+      job.publish_function();
+    uint64_t publish_end_nsec = rosNanosecTimestampNow();
+    bool print_statistics = false;
+    {
+      std::lock_guard<std::mutex> lock(m_queue_mutex);
+      m_receive_latency.add(1.0e-6 * (double)((int64_t)(job.parse_start_timestamp_nsec - job.receive_timestamp_nsec)));
+      m_parse_latency.add(1.0e-6 * (double)((int64_t)(job.push_timestamp_nsec - job.parse_start_timestamp_nsec)));
+      m_queue_latency.add(1.0e-6 * (double)((int64_t)(publish_start_nsec - job.push_timestamp_nsec)));
+      m_publish_latency.add(1.0e-6 * (double)((int64_t)(publish_end_nsec - publish_start_nsec)));
+      m_total_latency.add(1.0e-6 * (double)((int64_t)(publish_end_nsec - job.receive_timestamp_nsec)));
+      if (publish_end_nsec > m_last_print_timestamp_nsec + 10000000000ULL) // print statistics every 10 seconds in debug mode
+      {
+        m_last_print_timestamp_nsec = publish_end_nsec;
+        print_statistics = true;
+      }
+    }
+    if (print_statistics)
+      ROS_DEBUG_STREAM("SickScanPublishPipeline: " << printStatistics());
+  }
+}
@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <chrono>
 #include <exception>
 #include <iomanip>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <signal.h>
 #include <sstream>
 #include <string>
@@ -18,9 +23,12 @@ template <typename HandleType, class MsgType> std::mutex sick_scan_xd::SickWaitF
 
 static std::string s_scannerName = "sick_scan";
 static std::map<SickScanApiHandle,std::string> s_api_caller;
+static int s_api_instance_cnt = 0; // number of created api handles, each api handle has its own parameter namespace "~", "~1", "~2", ... (multiple lidars in one process)
 static std::vector<void*> s_malloced_resources;
 static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanPointCloudMsg>          s_callback_handler_cartesian_pointcloud_messages;
 static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanPointCloudMsg>          s_callback_handler_polar_pointcloud_messages;
+static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanPointCloudMsg,SickScanPointCloudMsgZeroCopyCallback> s_callback_handler_cartesian_pointcloud_zerocopy_messages;
+static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanPointCloudMsg,SickScanPointCloudMsgZeroCopyCallback> s_callback_handler_polar_pointcloud_zerocopy_messages;
 static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanImuMsg>                 s_callback_handler_imu_messages;
 static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanLFErecMsg>              s_callback_handler_lferec_messages;
 static sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanLIDoutputstateMsg>      s_callback_handler_lidoutputstate_messages;
@@ -53,12 +61,11 @@ static rosNodePtr castApiHandleToNode(SickScanApiHandle apiHandle)
 *  Message converter
 */
 
-static SickScanPointCloudMsg convertPointCloudMsg(const sick_scan_xd::PointCloud2withEcho& msg_with_echo)
+static void convertPointCloudMsgHeader(const sick_scan_xd::PointCloud2withEcho& msg_with_echo, SickScanPointCloudMsg& export_msg, std::vector<SickScanPointFieldMsg>& export_fields)
 {
-    SickScanPointCloudMsg export_msg;
     memset(&export_msg, 0, sizeof(export_msg));
     // Copy header and pointcloud dimension
-    const ros_sensor_msgs::PointCloud2& msg = msg_with_echo.pointcloud;
+    const ros_sensor_msgs::PointCloud2& msg = msg_with_echo.pointcloud();
     ROS_HEADER_SEQ(export_msg.header, msg.header.seq); // export_msg.header.seq = msg.header.seq;
     export_msg.header.timestamp_sec = sec(msg.header.stamp); // msg.header.stamp.sec;
     export_msg.header.timestamp_nsec = nsec(msg.header.stamp); // msg.header.stamp.nsec;
@@ -73,7 +80,7 @@ static SickScanPointCloudMsg convertPointCloudMsg(const sick_scan_xd::PointCloud
     export_msg.segment_idx = msg_with_echo.segment_idx;
     // Copy field descriptions
     int num_fields = msg.fields.size();
-    std::vector<SickScanPointFieldMsg> export_fields(num_fields);
+    export_fields.resize(num_fields);
     for(int n = 0; n < num_fields; n++)
     {
         SickScanPointFieldMsg export_field;
@@ -84,6 +91,15 @@ static SickScanPointCloudMsg convertPointCloudMsg(const sick_scan_xd::PointCloud
         export_field.count = msg.fields[n].count;
         export_fields[n] = export_field;
     }
+}
+
+static SickScanPointCloudMsg convertPointCloudMsg(const sick_scan_xd::PointCloud2withEcho& msg_with_echo)
+{
+    SickScanPointCloudMsg export_msg;
+    std::vector<SickScanPointFieldMsg> export_fields;
+    convertPointCloudMsgHeader(msg_with_echo, export_msg, export_fields);
+    const ros_sensor_msgs::PointCloud2& msg = msg_with_echo.pointcloud();
+    int num_fields = export_fields.size();
     export_msg.fields.buffer = (SickScanPointFieldMsg*)malloc(num_fields * sizeof(SickScanPointFieldMsg));
     if (export_msg.fields.buffer != 0)
     {
@@ -103,6 +119,113 @@ static SickScanPointCloudMsg convertPointCloudMsg(const sick_scan_xd::PointCloud
     return export_msg;
 }
 
+/*
+*  Ring of reference counted pointcloud buffers for zero-copy pointcloud callbacks (SickScanApiRegister...PointCloudMsgZeroCopy).
+*  A pointcloud is copied once into the next free buffer, all zero-copy callbacks receive a view of this buffer.
+*  Each acquired buffer gets a new unique handle (passed to the zero-copy callbacks), buffers are released by this handle.
+*  The layout of SickScanPointCloudMsg is not changed by zero-copy callbacks, i.e. handles are passed separately and tracked by this ring.
+*  A stale or repeated release of a reused buffer does not match its current handle and is rejected.
+*  The buffer is reused after all callbacks have released it by SickScanApiReleasePointCloudBuffer.
+*/
+class PointCloudBufferRing
+{
+public:
+
+    PointCloudBufferRing(size_t num_buffers = 16) : m_buffers(num_buffers), m_next_buffer_idx(0), m_next_buffer_handle(1), m_dropped_cnt(0), m_dropped_warning_time(std::chrono::steady_clock::time_point::min()) {}
+
+    // Copies a pointcloud into the next free buffer and returns a message referencing this buffer and the handle of this buffer. Returns false, if all buffers are in use.
+    bool acquire(const sick_scan_xd::PointCloud2withEcho& msg_with_echo, int32_t ref_cnt, SickScanPointCloudMsg& export_msg, uint64_t& buffer_handle)
+    {
+        std::unique_lock<std::mutex> lock(m_buffer_mutex);
+        PointCloudBuffer* buffer = 0;
+        for(size_t cnt = 0; buffer == 0 && cnt < m_buffers.size(); cnt++)
+        {
+            if (m_buffers[m_next_buffer_idx].ref_cnt <= 0)
+                buffer = &m_buffers[m_next_buffer_idx];
+            m_next_buffer_idx = (m_next_buffer_idx + 1) % m_buffers.size();
+        }
+        if (buffer == 0)
+        {
+            m_dropped_cnt++;
+            return false;
+        }
+        const ros_sensor_msgs::PointCloud2& msg = msg_with_echo.pointcloud();
+        size_t data_size = msg.row_step * msg.height;
+        convertPointCloudMsgHeader(msg_with_echo, export_msg, buffer->fields);
+        buffer->data.resize(data_size);
+        if (data_size > 0)
+            memcpy(buffer->data.data(), msg.data.data(), data_size);
+        buffer->ref_cnt = ref_cnt;
+        buffer->handle = m_next_buffer_handle++;
+        export_msg.fields.buffer = buffer->fields.data();
+        export_msg.fields.size = buffer->fields.size();
+        export_msg.fields.capacity = buffer->fields.size();
+        export_msg.data.buffer = buffer->data.data();
+        export_msg.data.size = data_size;
+        export_msg.data.capacity = data_size;
+        buffer_handle = buffer->handle;
+        return true;
+    }
+
+    // Releases a buffer after use. Returns false, if buffer_handle does not identify a currently acquired buffer of this ring.
+    bool release(uint64_t buffer_handle)
+    {
+        std::unique_lock<std::mutex> lock(m_buffer_mutex);
+        if (buffer_handle == 0)
+            return false;
+        for(size_t n = 0; n < m_buffers.size(); n++)
+        {
+            if (m_buffers[n].ref_cnt > 0 && m_buffers[n].handle == buffer_handle)
+            {
+                m_buffers[n].ref_cnt -= 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns true at most once per warning_interval if pointclouds have been dropped since the last warning, dropped_cnt is the number of dropped pointclouds
+    bool droppedWarning(size_t& dropped_cnt, double warning_interval = 1.0)
+    {
+        std::unique_lock<std::mutex> lock(m_buffer_mutex);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (m_dropped_cnt == 0 || std::chrono::duration<double>(now - m_dropped_warning_time).count() < warning_interval)
+            return false;
+        dropped_cnt = m_dropped_cnt;
+        m_dropped_cnt = 0;
+        m_dropped_warning_time = now;
+        return true;
+    }
+
+protected:
+
+    struct PointCloudBuffer
+    {
+        std::vector<uint8_t> data;                  // pointcloud data
+        std::vector<SickScanPointFieldMsg> fields;  // field descriptions
+        int32_t ref_cnt = 0;                        // number of zero-copy callbacks still using this buffer
+        uint64_t handle = 0;                        // unique handle of the current use of this buffer (0: never acquired)
+    };
+
+    std::vector<PointCloudBuffer> m_buffers;
+    size_t m_next_buffer_idx;
+    uint64_t m_next_buffer_handle;                              // handle of the next acquired buffer, incremented by each acquire
+    size_t m_dropped_cnt;                                       // number of pointclouds dropped since the last warning
+    std::chrono::steady_clock::time_point m_dropped_warning_time; // time of the last warning about dropped pointclouds
+    std::mutex m_buffer_mutex;
+};
+static std::map<SickScanApiHandle, std::shared_ptr<PointCloudBufferRing>> s_pointcloud_buffer_rings; // ring of pointcloud buffers for each api handle
+static std::mutex s_pointcloud_buffer_rings_mutex;
+
+static std::shared_ptr<PointCloudBufferRing> getPointCloudBufferRing(SickScanApiHandle apiHandle)
+{
+    std::unique_lock<std::mutex> lock(s_pointcloud_buffer_rings_mutex);
+    std::shared_ptr<PointCloudBufferRing>& buffer_ring = s_pointcloud_buffer_rings[apiHandle];
+    if (!buffer_ring)
+        buffer_ring = std::make_shared<PointCloudBufferRing>();
+    return buffer_ring;
+}
+
 static void freePointCloudMsg(SickScanPointCloudMsg& export_msg)
 {
     if (export_msg.fields.buffer != 0)
@@ -513,8 +636,8 @@ static void freeVisualizationMarkerMsg(SickScanVisualizationMarkerMsg& msg)
 
 static void cartesian_pointcloud_callback(rosNodePtr node, const sick_scan_xd::PointCloud2withEcho* msg)
 {
-    ROS_DEBUG_STREAM("api_impl cartesian_pointcloud_callback: PointCloud2 message, " << msg->pointcloud.width << "x" << msg->pointcloud.height << " points");
-    DUMP_API_POINTCLOUD_MESSAGE("impl", msg->pointcloud);
+    ROS_DEBUG_STREAM("api_impl cartesian_pointcloud_callback: PointCloud2 message, " << msg->pointcloud().width << "x" << msg->pointcloud().height << " points");
+    DUMP_API_POINTCLOUD_MESSAGE("impl", msg->pointcloud());
     // Convert ros_sensor_msgs::PointCloud2 message to SickScanPointCloudMsg and export (i.e. notify all listeners)
     SickScanPointCloudMsg export_msg = convertPointCloudMsg(*msg);
     SickScanApiHandle apiHandle = castNodeToApiHandle(node);
@@ -524,7 +647,7 @@ static void cartesian_pointcloud_callback(rosNodePtr node, const sick_scan_xd::P
 
 static void polar_pointcloud_callback(rosNodePtr node, const sick_scan_xd::PointCloud2withEcho* msg)
 {
-    ROS_DEBUG_STREAM("api_impl polar_pointcloud_callback: PointCloud2 message, " << msg->pointcloud.width << "x" << msg->pointcloud.height << " points");
+    ROS_DEBUG_STREAM("api_impl polar_pointcloud_callback: PointCloud2 message, " << msg->pointcloud().width << "x" << msg->pointcloud().height << " points");
     // Convert ros_sensor_msgs::PointCloud2 message to SickScanPointCloudMsg and export (i.e. notify all listeners)
     SickScanPointCloudMsg export_msg = convertPointCloudMsg(*msg);
     SickScanApiHandle apiHandle = castNodeToApiHandle(node);
@@ -532,6 +655,42 @@ static void polar_pointcloud_callback(rosNodePtr node, const sick_scan_xd::Point
     freePointCloudMsg(export_msg);
 }
 
+static void notifyZeroCopyPointCloudListener(sick_scan_xd::SickCallbackHandler<SickScanApiHandle,SickScanPointCloudMsg,SickScanPointCloudMsgZeroCopyCallback>& callback_handler, rosNodePtr node, const sick_scan_xd::PointCloud2withEcho* msg)
+{
+    // Copy ros_sensor_msgs::PointCloud2 message once into a buffer and notify all zero-copy listeners, each listener releases the buffer after use
+    SickScanApiHandle apiHandle = castNodeToApiHandle(node);
+    std::list<SickScanPointCloudMsgZeroCopyCallback> listeners = callback_handler.getListener(apiHandle);
+    listeners.remove(0);
+    if (listeners.empty())
+        return;
+    SickScanPointCloudMsg export_msg;
+    uint64_t buffer_handle = 0;
+    std::shared_ptr<PointCloudBufferRing> buffer_ring = getPointCloudBufferRing(apiHandle);
+    if (!buffer_ring->acquire(*msg, (int32_t)listeners.size(), export_msg, buffer_handle))
+    {
+        size_t dropped_cnt = 0;
+        if (buffer_ring->droppedWarning(dropped_cnt))
+            ROS_WARN_STREAM("## WARNING api_impl notifyZeroCopyPointCloudListener(): all pointcloud buffers in use, " << dropped_cnt << " pointcloud(s) dropped. Release pointcloud buffers by SickScanApiReleasePointCloudBuffer() after use.");
+        return;
+    }
+    for(std::list<SickScanPointCloudMsgZeroCopyCallback>::iterator iter_listener = listeners.begin(); iter_listener != listeners.end(); iter_listener++)
+    {
+        (*iter_listener)(apiHandle, &export_msg, buffer_handle);
+    }
+}
+
+static void cartesian_pointcloud_zerocopy_callback(rosNodePtr node, const sick_scan_xd::PointCloud2withEcho* msg)
+{
+    ROS_DEBUG_STREAM("api_impl cartesian_pointcloud_zerocopy_callback: PointCloud2 message, " << msg->pointcloud().width << "x" << msg->pointcloud().height << " points");
+    notifyZeroCopyPointCloudListener(s_callback_handler_cartesian_pointcloud_zerocopy_messages, node, msg);
+}
+
+static void polar_pointcloud_zerocopy_callback(rosNodePtr node, const sick_scan_xd::PointCloud2withEcho* msg)
+{
+    ROS_DEBUG_STREAM("api_impl polar_pointcloud_zerocopy_callback: PointCloud2 message, " << msg->pointcloud().width << "x" << msg->pointcloud().height << " points");
+    notifyZeroCopyPointCloudListener(s_callback_handler_polar_pointcloud_zerocopy_messages, node, msg);
+}
+
 static void imu_callback(rosNodePtr node, const ros_sensor_msgs::Imu* msg)
 {
     // ROS_DEBUG_STREAM("api_impl lferec_callback: Imu message = {" << (*msg) << "}");
@@ -646,7 +805,9 @@ SickScanApiHandle SickScanApiCreate(int argc, char** argv)
         SickScanApiHandle apiHandle = castNodeToApiHandle(node);
         #else
         ros::init(argc, argv, s_scannerName, ros::init_options::NoSigintHandler);
-        SickScanApiHandle apiHandle = new ros::NodeHandle("~");
+        std::string node_namespace = "~" + (s_api_instance_cnt > 0 ? std::to_string(s_api_instance_cnt) : std::string());
+        s_api_instance_cnt++;
+        SickScanApiHandle apiHandle = new ros::NodeHandle(node_namespace);
         #endif
 
         signal(SIGINT, rosSignalHandler);
@@ -680,6 +841,12 @@ int32_t SickScanApiRelease(SickScanApiHandle apiHandle)
         s_api_caller[apiHandle].clear();
         s_callback_handler_cartesian_pointcloud_messages.clear();
         s_callback_handler_polar_pointcloud_messages.clear();
+        s_callback_handler_cartesian_pointcloud_zerocopy_messages.clear();
+        s_callback_handler_polar_pointcloud_zerocopy_messages.clear();
+        {
+            std::unique_lock<std::mutex> lock(s_pointcloud_buffer_rings_mutex);
+            s_pointcloud_buffer_rings.erase(apiHandle);
+        }
         s_callback_handler_imu_messages.clear();
         s_callback_handler_lferec_messages.clear();
         s_callback_handler_lidoutputstate_messages.clear();
@@ -816,8 +983,10 @@ int32_t SickScanApiClose(SickScanApiHandle apiHandle)
             ROS_ERROR_STREAM("## ERROR SickScanApiClose(): invalid apiHandle");
             return SICK_SCAN_API_NOT_INITIALIZED;
         }
-        // stopScannerAndExit(true);
-        rosSignalHandler(SIGINT); // Send Ctrl-C for gentle shutdown
+        if (numberOfGenericLaserThreads() > 1) // multiple lidars running: close this lidar, other lidars continue
+            stopScannerAndExit(castApiHandleToNode(apiHandle), true);
+        else
+            rosSignalHandler(SIGINT); // Send Ctrl-C for gentle shutdown
         return SICK_SCAN_API_SUCCESS;
     }
     catch(const std::exception& e)
@@ -935,6 +1104,138 @@ int32_t SickScanApiDeregisterPolarPointCloudMsg(SickScanApiHandle apiHandle, Sic
     return SICK_SCAN_API_ERROR;
 }
 
+// Register / deregister a zero-copy callback for cartesian PointCloud messages. The callback receives a view of a pointcloud buffer, which has to be released by SickScanApiReleasePointCloudBuffer after use.
+int32_t SickScanApiRegisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    try
+    {
+        if (apiHandle == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiRegisterCartesianPointCloudMsgZeroCopy(): invalid apiHandle");
+            return SICK_SCAN_API_NOT_INITIALIZED;
+        }
+        s_callback_handler_cartesian_pointcloud_zerocopy_messages.addListener(apiHandle, callback);
+        rosNodePtr node = castApiHandleToNode(apiHandle);
+        if (!sick_scan_xd::isCartesianPointcloudListenerRegistered(node, cartesian_pointcloud_zerocopy_callback))
+            sick_scan_xd::addCartesianPointcloudListener(node, cartesian_pointcloud_zerocopy_callback);
+        return SICK_SCAN_API_SUCCESS;
+    }
+    catch(const std::exception& e)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiRegisterCartesianPointCloudMsgZeroCopy(): exception " << e.what());
+    }
+    catch(...)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiRegisterCartesianPointCloudMsgZeroCopy(): unknown exception ");
+    }
+    return SICK_SCAN_API_ERROR;
+}
+int32_t SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    try
+    {
+        if (apiHandle == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(): invalid apiHandle");
+            return SICK_SCAN_API_NOT_INITIALIZED;
+        }
+        s_callback_handler_cartesian_pointcloud_zerocopy_messages.removeListener(apiHandle, callback);
+        rosNodePtr node = castApiHandleToNode(apiHandle);
+        if (!s_callback_handler_cartesian_pointcloud_zerocopy_messages.hasListeners(apiHandle))
+            sick_scan_xd::removeCartesianPointcloudListener(node, cartesian_pointcloud_zerocopy_callback);
+        return SICK_SCAN_API_SUCCESS;
+    }
+    catch(const std::exception& e)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(): exception " << e.what());
+    }
+    catch(...)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(): unknown exception ");
+    }
+    return SICK_SCAN_API_ERROR;
+}
+
+// Register / deregister a zero-copy callback for polar PointCloud messages. The callback receives a view of a pointcloud buffer, which has to be released by SickScanApiReleasePointCloudBuffer after use.
+int32_t SickScanApiRegisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    try
+    {
+        if (apiHandle == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiRegisterPolarPointCloudMsgZeroCopy(): invalid apiHandle");
+            return SICK_SCAN_API_NOT_INITIALIZED;
+        }
+        s_callback_handler_polar_pointcloud_zerocopy_messages.addListener(apiHandle, callback);
+        rosNodePtr node = castApiHandleToNode(apiHandle);
+        if (!sick_scan_xd::isPolarPointcloudListenerRegistered(node, polar_pointcloud_zerocopy_callback))
+            sick_scan_xd::addPolarPointcloudListener(node, polar_pointcloud_zerocopy_callback);
+        return SICK_SCAN_API_SUCCESS;
+    }
+    catch(const std::exception& e)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiRegisterPolarPointCloudMsgZeroCopy(): exception " << e.what());
+    }
+    catch(...)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiRegisterPolarPointCloudMsgZeroCopy(): unknown exception ");
+    }
+    return SICK_SCAN_API_ERROR;
+}
+int32_t SickScanApiDeregisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    try
+    {
+        if (apiHandle == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterPolarPointCloudMsgZeroCopy(): invalid apiHandle");
+            return SICK_SCAN_API_NOT_INITIALIZED;
+        }
+        s_callback_handler_polar_pointcloud_zerocopy_messages.removeListener(apiHandle, callback);
+        rosNodePtr node = castApiHandleToNode(apiHandle);
+        if (!s_callback_handler_polar_pointcloud_zerocopy_messages.hasListeners(apiHandle))
+            sick_scan_xd::removePolarPointcloudListener(node, polar_pointcloud_zerocopy_callback);
+        return SICK_SCAN_API_SUCCESS;
+    }
+    catch(const std::exception& e)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterPolarPointCloudMsgZeroCopy(): exception " << e.what());
+    }
+    catch(...)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiDeregisterPolarPointCloudMsgZeroCopy(): unknown exception ");
+    }
+    return SICK_SCAN_API_ERROR;
+}
+
+// Release a pointcloud buffer received by a zero-copy callback
+int32_t SickScanApiReleasePointCloudBuffer(SickScanApiHandle apiHandle, uint64_t buffer_handle)
+{
+    try
+    {
+        if (apiHandle == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiReleasePointCloudBuffer(): invalid apiHandle");
+            return SICK_SCAN_API_NOT_INITIALIZED;
+        }
+        if (!getPointCloudBufferRing(apiHandle)->release(buffer_handle))
+        {
+            ROS_ERROR_STREAM("## ERROR SickScanApiReleasePointCloudBuffer(): pointcloud buffer " << buffer_handle << " not found (handle not received by a zero-copy callback or already released)");
+            return SICK_SCAN_API_ERROR;
+        }
+        return SICK_SCAN_API_SUCCESS;
+    }
+    catch(const std::exception& e)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiReleasePointCloudBuffer(): exception " << e.what());
+    }
+    catch(...)
+    {
+        ROS_ERROR_STREAM("## ERROR SickScanApiReleasePointCloudBuffer(): unknown exception ");
+    }
+    return SICK_SCAN_API_ERROR;
+}
+
 // Register / deregister a callback for Imu messages
 int32_t SickScanApiRegisterImuMsg(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback)
 {
@@ -1410,14 +1711,14 @@ int32_t SickScanApiWaitNextCartesianPointCloudMsg(SickScanApiHandle apiHandle, S
         sick_scan_xd::WaitForCartesianPointCloudMessageHandler::addWaitForMessageHandlerHandler(&wait_message_handler);
         sick_scan_xd::PointCloud2withEcho ros_msg;
         if (wait_message_handler.waitForNextMessage(ros_msg, timeout_sec) 
-            && ros_msg.pointcloud.width * ros_msg.pointcloud.height > 0
-            && ros_msg.pointcloud.fields.size() >= 3
-            && ros_msg.pointcloud.fields[0].name == "x"
-            && ros_msg.pointcloud.fields[1].name == "y"
-            && ros_msg.pointcloud.fields[2].name == "z")
+            && ros_msg.pointcloud().width * ros_msg.pointcloud().height > 0
+            && ros_msg.pointcloud().fields.size() >= 3
+            && ros_msg.pointcloud().fields[0].name == "x"
+            && ros_msg.pointcloud().fields[1].name == "y"
+            && ros_msg.pointcloud().fields[2].name == "z")
         {
             // ros_sensor_msgs::PointCloud2 message received, convert to SickScanPointCloudMsg
-            ROS_INFO_STREAM("SickScanApiWaitNextCartesianPointCloudMsg: PointCloud2 message, " << ros_msg.pointcloud.width << "x" << ros_msg.pointcloud.height << " points");
+            ROS_INFO_STREAM("SickScanApiWaitNextCartesianPointCloudMsg: PointCloud2 message, " << ros_msg.pointcloud().width << "x" << ros_msg.pointcloud().height << " points");
             *msg = convertPointCloudMsg(ros_msg);
             ret_val = SICK_SCAN_API_SUCCESS;
         }
@@ -1454,14 +1755,14 @@ int32_t SickScanApiWaitNextPolarPointCloudMsg(SickScanApiHandle apiHandle, SickS
         sick_scan_xd::WaitForPolarPointCloudMessageHandler::addWaitForMessageHandlerHandler(&wait_message_handler);
         sick_scan_xd::PointCloud2withEcho ros_msg;
         if (wait_message_handler.waitForNextMessage(ros_msg, timeout_sec) 
-            && ros_msg.pointcloud.width * ros_msg.pointcloud.height > 0
-            && ros_msg.pointcloud.fields.size() >= 3
-            && ros_msg.pointcloud.fields[0].name == "range"
-            && ros_msg.pointcloud.fields[1].name == "azimuth"
-            && ros_msg.pointcloud.fields[2].name == "elevation")
+            && ros_msg.pointcloud().width * ros_msg.pointcloud().height > 0
+            && ros_msg.pointcloud().fields.size() >= 3
+            && ros_msg.pointcloud().fields[0].name == "range"
+            && ros_msg.pointcloud().fields[1].name == "azimuth"
+            && ros_msg.pointcloud().fields[2].name == "elevation")
         {
             // ros_sensor_msgs::PointCloud2 message received, convert to SickScanPointCloudMsg
-            ROS_INFO_STREAM("SickScanApiWaitNextPolarPointCloudMsg: PointCloud2 message, " << ros_msg.pointcloud.width << "x" << ros_msg.pointcloud.height << " points");
+            ROS_INFO_STREAM("SickScanApiWaitNextPolarPointCloudMsg: PointCloud2 message, " << ros_msg.pointcloud().width << "x" << ros_msg.pointcloud().height << " points");
             *msg = convertPointCloudMsg(ros_msg);
             ret_val = SICK_SCAN_API_SUCCESS;
         }
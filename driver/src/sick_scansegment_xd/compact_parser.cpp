@@ -52,10 +52,12 @@
  *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
  *
  */
+#include "sick_scan/sick_polar_to_cartesian.h"
 #include "sick_scan/softwarePLL.h"
 #include "sick_scansegment_xd/compact_parser.h"
 #include "sick_scansegment_xd/config.h"
 #include "sick_scansegment_xd/udp_receiver.h"
+#include <mutex>
 
 union COMPACT_4BYTE_UNION
 {
@@ -213,9 +215,9 @@ std::string sick_scansegment_xd::CompactModuleMeasurementData::to_string() const
         for(int line_idx = 0; line_idx < scanlines.size(); line_idx++)
         {
             description << (line_idx > 0 ? "," : "") << "scanline[" << line_idx << "]=[";
-            for(int point_idx = 0; point_idx < scanlines[line_idx].points.size(); point_idx++)
+            for(int point_idx = 0; point_idx < scanlines[line_idx].count; point_idx++)
             {
-                const ScanSegmentParserOutput::LidarPoint& point = scanlines[line_idx].points[point_idx];
+                const ScanSegmentParserOutput::LidarPoint point = points.get(scanlines[line_idx].start + point_idx);
                 description << (point_idx > 0 ? "," : "") << "(";
                 description << point.x << "," << point.y << "," << point.z << "," << point.i << ",";
                 description << point.range << "," << point.azimuth << "," << point.elevation << ",";
@@ -442,6 +444,8 @@ int sick_scansegment_xd::CompactDataParser::GetLayerIDfromElevation(float layer_
   else
   {
     static std::map<int,int> elevation_layerid_map;
+    static std::mutex elevation_layerid_mutex; // segments can be parsed in parallel, see MsgPackConverter
+    std::unique_lock<std::mutex> elevation_layerid_lock(elevation_layerid_mutex);
     if (elevation_layerid_map.find(layer_elevation_mdeg) == elevation_layerid_map.end())
     {
       elevation_layerid_map[layer_elevation_mdeg] = elevation_layerid_map.size() + 1; // Add new layer
@@ -496,7 +500,10 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
 
   uint32_t num_layers = meta_data.NumberOfLinesInModule;
   uint32_t num_echos = meta_data.NumberOfEchosPerBeam;
+  uint32_t num_beams = meta_data.NumberOfBeamsPerScan;
   measurement_data.scandata = std::vector<ScanSegmentParserOutput::Scangroup>(num_layers);
+  measurement_data.points.resize((size_t)num_layers * num_echos * num_beams); // point (layer_idx, echo_idx, point_idx) is stored at index (layer_idx * num_echos + echo_idx) * num_beams + point_idx
+  ScanSegmentParserOutput::SegmentPoints& points = measurement_data.points;
 
   ROS_DEBUG_STREAM("CompactDataParser::ParseModuleMeasurementData(): num_bytes=" << num_bytes << ", num_layers=" << num_layers
     << ", num_points=" << meta_data.NumberOfBeamsPerScan << ", num_echos=" << num_echos << ", dist_available=" << dist_available
@@ -521,15 +528,16 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
     measurement_data.scandata[layer_idx].timestampStart_nsec = layer_timeStamp_start_nsec;
     measurement_data.scandata[layer_idx].timestampStop_sec = layer_timeStamp_stop_sec;
     measurement_data.scandata[layer_idx].timestampStop_nsec = layer_timeStamp_stop_nsec;
-    measurement_data.scandata[layer_idx].scanlines = std::vector<ScanSegmentParserOutput::Scanline>(num_echos);
+    measurement_data.scandata[layer_idx].scanlines.reserve(num_echos);
     for (uint32_t echo_idx = 0; echo_idx < num_echos; echo_idx++)
     {
-      measurement_data.scandata[layer_idx].scanlines[echo_idx].points = std::vector<ScanSegmentParserOutput::LidarPoint>(meta_data.NumberOfBeamsPerScan);
+      measurement_data.scandata[layer_idx].scanlines.push_back(ScanSegmentParserOutput::Scanline(((size_t)layer_idx * num_echos + echo_idx) * num_beams, num_beams));
     }
     lut_layer_elevation[layer_idx] = -meta_data.Phi[layer_idx]; // elevation must be negated, a positive pitch-angle yields negative z-coordinates (compare to MsgPackParser::Parse in msgpack_parser.cpp)
     lut_layer_azimuth_start[layer_idx] = meta_data.ThetaStart[layer_idx];
     lut_layer_azimuth_stop[layer_idx] = meta_data.ThetaStop[layer_idx];
     lut_layer_azimuth_delta[layer_idx] = (lut_layer_azimuth_stop[layer_idx] - lut_layer_azimuth_start[layer_idx]) / (float)(std::max(1, (int)meta_data.NumberOfBeamsPerScan - 1));
+    measurement_data.scandata[layer_idx].azimuthIncrement = (meta_data.NumberOfBeamsPerScan > 1) ? std::fabs(lut_layer_azimuth_delta[layer_idx]) : 0;
     lut_sin_elevation[layer_idx] = std::sin(lut_layer_elevation[layer_idx]);
     lut_cos_elevation[layer_idx] = std::cos(lut_layer_elevation[layer_idx]);
     lut_groupIdx[layer_idx] = GetLayerIDfromElevation(meta_data.Phi[layer_idx]);
@@ -544,10 +552,8 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
       float layer_azimuth_start = lut_layer_azimuth_start[layer_idx];
       float layer_azimuth_stop = lut_layer_azimuth_stop[layer_idx];
       float layer_azimuth_delta = lut_layer_azimuth_delta[layer_idx];
-      float sin_elevation = lut_sin_elevation[layer_idx];
-      float cos_elevation = lut_cos_elevation[layer_idx];
       int groupIdx = lut_groupIdx[layer_idx];
-      std::vector<ScanSegmentParserOutput::LidarPoint> points(num_echos);
+      size_t layer_point_offset = (size_t)layer_idx * num_echos * num_beams + point_idx; // index of (layer_idx, echo_idx, point_idx) is layer_point_offset + echo_idx * num_beams
       uint8_t beam_property = 0;
       float azimuth = 0;
       for (uint32_t echo_idx = 0; echo_idx < num_echos; echo_idx++)
@@ -560,7 +566,7 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
               << ", point " << point_idx << " of " << meta_data.NumberOfBeamsPerScan << ", echo " << echo_idx << " of " << num_echos);
             return false;
           }
-          points[echo_idx].range = (dist_scale_factor * (float)readUnsigned<uint16_t>(payload + byte_cnt, &byte_cnt)) / 1000.0f;
+          points.range[layer_point_offset + echo_idx * num_beams] = (dist_scale_factor * (float)readUnsigned<uint16_t>(payload + byte_cnt, &byte_cnt)) / 1000.0f;
         }
         if (rssi_available)
         {
@@ -570,7 +576,7 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
               << ", point " << point_idx << " of " << meta_data.NumberOfBeamsPerScan << ", echo " << echo_idx << " of " << num_echos);
             return false;
           }
-          points[echo_idx].i = (float)readUnsigned<uint16_t>(payload + byte_cnt, &byte_cnt);
+          points.i[layer_point_offset + echo_idx * num_beams] = (float)readUnsigned<uint16_t>(payload + byte_cnt, &byte_cnt);
         }
       }
       std::vector<ReadBeamAzimOrderEnum> azim_prop_order;
@@ -620,26 +626,19 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
           }
         }
       }
-      float sin_azimuth = std::sin(azimuth);
-      float cos_azimuth = std::cos(azimuth);
       // std::stringstream s;
       // s << "Measurement[" << layer_idx << "," << point_idx << "]=(";
       // for(uint32_t echo_idx = 0; echo_idx < num_echos; echo_idx++)
-      //     s << points[echo_idx].range << "," << points[echo_idx].i << ",";
+      //     s << points.range[layer_point_offset + echo_idx * num_beams] << "," << points.i[layer_point_offset + echo_idx * num_beams] << ",";
       // s << (int)beam_property << "," << azimuth << ")";
       // ROS_DEBUG_STREAM("" << s.str());
       for (uint32_t echo_idx = 0; echo_idx < num_echos; echo_idx++)
       {
-        points[echo_idx].azimuth = azimuth;
-        points[echo_idx].elevation = layer_elevation;
-        points[echo_idx].x = points[echo_idx].range * cos_azimuth * cos_elevation;
-        points[echo_idx].y = points[echo_idx].range * sin_azimuth * cos_elevation;
-        points[echo_idx].z = points[echo_idx].range * sin_elevation;
-        points[echo_idx].echoIdx = echo_idx;
-        points[echo_idx].groupIdx = groupIdx;
-        points[echo_idx].pointIdx = point_idx;
-        points[echo_idx].reflectorbit |= (beam_property & 0x01); // reflector bit is set, if a reflector is detected on any number of echos
-        measurement_data.scandata[layer_idx].scanlines[echo_idx].points[point_idx] = points[echo_idx];
+        size_t n = layer_point_offset + echo_idx * num_beams;
+        float range = (dist_available ? points.range[n] : 0);
+        float intensity = (rssi_available ? points.i[n] : 0);
+        uint8_t reflectorbit = (beam_property & 0x01); // reflector bit is set, if a reflector is detected on any number of echos
+        points.set(n, 0, 0, 0, intensity, range, azimuth, layer_elevation, groupIdx, echo_idx, point_idx, reflectorbit); // x, y, z converted below
       }
     }
   }
@@ -648,6 +647,24 @@ bool sick_scansegment_xd::CompactDataParser::ParseModuleMeasurementData(const ui
     ROS_ERROR_STREAM("## ERROR CompactDataParser::ParseModuleMeasurementData(" << __LINE__ << "): byte_cnt=" << byte_cnt << ", num_bytes=" << num_bytes);
     return false;
   }
+  // Convert to cartesian coordinates, all echos of a beam have the same azimuth, all beams of a layer have the same elevation
+  std::vector<float> cos_azimuth(num_beams);
+  std::vector<float> sin_azimuth(num_beams);
+  for (uint32_t layer_idx = 0; layer_idx < num_layers; layer_idx++)
+  {
+    size_t layer_offset = (size_t)layer_idx * num_echos * num_beams;
+    for (uint32_t point_idx = 0; point_idx < num_beams; point_idx++)
+    {
+      cos_azimuth[point_idx] = std::cos(points.azimuth[layer_offset + point_idx]);
+      sin_azimuth[point_idx] = std::sin(points.azimuth[layer_offset + point_idx]);
+    }
+    for (uint32_t echo_idx = 0; echo_idx < num_echos; echo_idx++)
+    {
+      size_t n = layer_offset + echo_idx * num_beams;
+      sick_scan_xd::PolarToCartesian::convert(num_beams, points.range.data() + n, cos_azimuth.data(), sin_azimuth.data(),
+        &lut_cos_elevation[layer_idx], &lut_sin_elevation[layer_idx], 0, 1.0f, 0, points.x.data() + n, points.y.data() + n, points.z.data() + n);
+    }
+  }
   measurement_data.valid = true;
   return measurement_data.valid;
 }
@@ -759,17 +776,18 @@ bool sick_scansegment_xd::CompactDataParser::ParseSegment(const uint8_t* payload
         for(int module_idx = 0; module_idx < segment_data->segmentModules.size(); module_idx++)
         {
             const std::vector<ScanSegmentParserOutput::Scangroup>& scandata = segment_data->segmentModules[module_idx].moduleMeasurement.scandata;
+            const ScanSegmentParserOutput::SegmentPoints& points = segment_data->segmentModules[module_idx].moduleMeasurement.points;
             ROS_INFO_STREAM("    CompactDataParser (module " << module_idx << "): " << scandata.size() << " groups");
             for(int group_idx = 0; group_idx < scandata.size(); group_idx++)
             {
                 ROS_INFO_STREAM("        CompactDataParser (module " << module_idx << ", group " << group_idx << "): " << scandata[group_idx].scanlines.size() << " lines");
                 for(int line_idx = 0; line_idx < scandata[group_idx].scanlines.size(); line_idx++)
                 {
-                    const std::vector<ScanSegmentParserOutput::LidarPoint>& points = scandata[group_idx].scanlines[line_idx].points;
-                    ROS_INFO_STREAM("        CompactDataParser (module " << module_idx << ", group " << group_idx << ", line " << line_idx << "): " << points.size() << " points");
-                    for(int point_idx = 0; point_idx < points.size(); point_idx++)
+                    const ScanSegmentParserOutput::Scanline& scanline = scandata[group_idx].scanlines[line_idx];
+                    ROS_INFO_STREAM("        CompactDataParser (module " << module_idx << ", group " << group_idx << ", line " << line_idx << "): " << scanline.count << " points");
+                    for(size_t n = scanline.start; n < scanline.start + scanline.count; n++)
                     {
-                        ROS_INFO_STREAM("        [" << points[point_idx].x << "," << points[point_idx].y << "," << points[point_idx].z << "," << points[point_idx].range << "," << points[point_idx].azimuth << "," << points[point_idx].elevation << "," << points[point_idx].groupIdx << "," << points[point_idx].pointIdx << "]");
+                        ROS_INFO_STREAM("        [" << points.x[n] << "," << points.y[n] << "," << points.z[n] << "," << points.range[n] << "," << points.azimuth[n] << "," << points.elevation[n] << "," << points.layer[n] << "," << points.pointIdx[n] << "]");
                     }
                 }
             }
@@ -784,7 +802,7 @@ bool sick_scansegment_xd::CompactDataParser::ParseSegment(const uint8_t* payload
 * @brief Returns the max azimuth aperture (i.e. max - min azimuth) of all scan points within a cube, i.e. the max azimuth aperture of all points p
 *        with x_min <= p.x <= x_max && y_min <= p.y <= y_max && z_min <= p.z <= z_max && p.azimuth >= azimuth_min && p.azimuth <= azimuth_max
 */
-static bool getMaxAzimuthApertureWithinCube(const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::Scangroup>& scandata,
+static bool getMaxAzimuthApertureWithinCube(const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::Scangroup>& scandata, const sick_scansegment_xd::ScanSegmentParserOutput::SegmentPoints& points,
   float x_min, float x_max, float y_min, float y_max, float z_min, float z_max, float azimuth_min, float azimuth_max,
   double& azimuth_aperture, uint64_t& timestamp_microsec)
 {
@@ -798,9 +816,9 @@ static bool getMaxAzimuthApertureWithinCube(const std::vector<sick_scansegment_x
       uint64_t timestampStart_microsec = (uint64_t)scandata[group_idx].timestampStart_sec * 1000000UL + (uint64_t)scandata[group_idx].timestampStart_nsec / 1000;
       uint64_t timestampStop_microsec  = (uint64_t)scandata[group_idx].timestampStop_sec  * 1000000UL + (uint64_t)scandata[group_idx].timestampStop_nsec  / 1000;
       double point_azi_min = FLT_MAX, point_azi_max = -FLT_MAX;
-      for(int point_idx = 0; point_idx < scandata[group_idx].scanlines[line_idx].points.size(); point_idx++)
+      for(int point_idx = 0; point_idx < scandata[group_idx].scanlines[line_idx].count; point_idx++)
       {
-        const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& p = scandata[group_idx].scanlines[line_idx].points[point_idx];
+        const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint p = points.get(scandata[group_idx].scanlines[line_idx].start + point_idx);
         if (p.x >= x_min && p.x <= x_max && p.y >= y_min && p.y <= y_max && p.z >= z_min && p.z<= z_max && p.azimuth >= azimuth_min && p.azimuth <= azimuth_max)
         {
           point_azi_min = std::min(point_azi_min, (double)p.azimuth);
@@ -843,9 +861,14 @@ bool sick_scansegment_xd::CompactDataParser::Parse(const ScanSegmentParserConfig
     // Convert segment data to ScanSegmentParserOutput
     sick_scansegment_xd::CompactDataHeader& segmentHeader = segment_data.segmentHeader;
     result.scandata.clear();
+    result.points.clear();
     result.imudata = segment_data.segmentHeader.imudata;
     result.segmentIndex = 0;
     result.telegramCnt = segmentHeader.telegramCounter;
+    // Reorder lidar points by layer id (groupIdx) and echoIdx (identical to the msgpack scandata):
+    // result.scandata[groupIdx].scanlines[echoIdx] = all points of layer <groupIdx> and echo <echoIdx> in one contiguous index range of result.points.
+    // Pass 1: apply optional transform, count the points of each scanline and set the timestamps of each group
+    size_t total_point_count = 0;
     for (int module_idx = 0; module_idx < segment_data.segmentModules.size(); module_idx++)
     {
         sick_scansegment_xd::CompactModuleMetaData& moduleMetadata = segment_data.segmentModules[module_idx].moduleMetadata;
@@ -855,54 +878,36 @@ bool sick_scansegment_xd::CompactDataParser::Parse(const ScanSegmentParserConfig
             ROS_ERROR_STREAM("## ERROR CompactDataParser::Parse(): invalid moduleMeasurement (ignored)");
             continue;
         }
+        ScanSegmentParserOutput::SegmentPoints& points = moduleMeasurement.points;
+        add_transform_xyz_rpy.applyTransform(points.x.data(), points.y.data(), points.z.data(), points.size());
         for (int measurement_idx = 0; measurement_idx < moduleMeasurement.scandata.size(); measurement_idx++)
         {
-            ScanSegmentParserOutput::Scangroup& scandata = moduleMeasurement.scandata[measurement_idx];
-            // Apply optional range filter and optional transform
+            const ScanSegmentParserOutput::Scangroup& scandata = moduleMeasurement.scandata[measurement_idx];
             for(int line_idx = 0; line_idx < scandata.scanlines.size(); line_idx++)
             {
-                std::vector<ScanSegmentParserOutput::LidarPoint>& points_in = scandata.scanlines[line_idx].points;
-                std::vector<ScanSegmentParserOutput::LidarPoint> points_out;
-                points_out.reserve(points_in.size());
-                for(int point_idx = 0; point_idx < points_in.size(); point_idx++)
+                const ScanSegmentParserOutput::Scanline& scanline = scandata.scanlines[line_idx];
+                if (scanline.count == 0)
+                    continue;
+                int groupIdx = points.layer[scanline.start]; // all points of a module scanline have identical layer and echo
+                int echoIdx = points.echo[scanline.start];
+                while(result.scandata.size() <= groupIdx)
                 {
-                    add_transform_xyz_rpy.applyTransform(points_in[point_idx].x, points_in[point_idx].y, points_in[point_idx].z);
-                    points_out.push_back(points_in[point_idx]);
+                    result.scandata.push_back(ScanSegmentParserOutput::Scangroup());
                 }
-                scandata.scanlines[line_idx].points = points_out;
-            }
-            // result.scandata.push_back(scandata);
-            // Reorder lidar points by layer id (groupIdx) and echoIdx (identical to the msgpack scandata)
-            // result.scandata[groupIdx] = all scandata of layer <groupIdx> appended to one scanline
-            for(int line_idx = 0; line_idx < scandata.scanlines.size(); line_idx++)
-            {
-               std::vector<ScanSegmentParserOutput::LidarPoint>& points = scandata.scanlines[line_idx].points;
-                for(int point_idx = 0; point_idx < points.size(); point_idx++)
+                if (result.scandata[groupIdx].scanlines.empty())
                 {
-                    ScanSegmentParserOutput::LidarPoint& point = points[point_idx];
-                    int groupIdx = point.groupIdx;
-                    int echoIdx = point.echoIdx;
-                    while(result.scandata.size() <= groupIdx)
-                    {
-                      result.scandata.push_back(ScanSegmentParserOutput::Scangroup());
-                    }
-                    if (result.scandata[groupIdx].scanlines.empty())
-                    {
-                        result.scandata[groupIdx].timestampStart_sec = scandata.timestampStart_sec;
-                        result.scandata[groupIdx].timestampStart_nsec = scandata.timestampStart_nsec;
-                        result.scandata[groupIdx].timestampStop_sec = scandata.timestampStop_sec;
-                        result.scandata[groupIdx].timestampStop_nsec = scandata.timestampStop_nsec;
-                    }
-                    while(result.scandata[groupIdx].scanlines.size() <= echoIdx)
-                    {
-                      result.scandata[groupIdx].scanlines.push_back(ScanSegmentParserOutput::Scanline());
-                    }
-                    if (result.scandata[groupIdx].scanlines[echoIdx].points.empty())
-                    {
-                        result.scandata[groupIdx].scanlines[echoIdx].points.reserve(points.size());
-                    }
-                    result.scandata[groupIdx].scanlines[echoIdx].points.push_back(point);
+                    result.scandata[groupIdx].timestampStart_sec = scandata.timestampStart_sec;
+                    result.scandata[groupIdx].timestampStart_nsec = scandata.timestampStart_nsec;
+                    result.scandata[groupIdx].timestampStop_sec = scandata.timestampStop_sec;
+                    result.scandata[groupIdx].timestampStop_nsec = scandata.timestampStop_nsec;
+                    result.scandata[groupIdx].azimuthIncrement = scandata.azimuthIncrement;
+                }
+                while(result.scandata[groupIdx].scanlines.size() <= echoIdx)
+                {
+                    result.scandata[groupIdx].scanlines.push_back(ScanSegmentParserOutput::Scanline());
                 }
+                result.scandata[groupIdx].scanlines[echoIdx].count += scanline.count;
+                total_point_count += scanline.count;
             }
         }
         if (module_idx == 0)
@@ -915,6 +920,38 @@ bool sick_scansegment_xd::CompactDataParser::Parse(const ScanSegmentParserConfig
                 << " scandata of segment " << moduleMetadata.SegmentCounter << " appended to segment " << result.segmentIndex);
         }
     }
+    // Pass 2: assign the index range of each scanline and copy the module scanlines into result.points
+    size_t point_offset = 0;
+    for (int groupIdx = 0; groupIdx < result.scandata.size(); groupIdx++)
+    {
+        for (int echoIdx = 0; echoIdx < result.scandata[groupIdx].scanlines.size(); echoIdx++)
+        {
+            ScanSegmentParserOutput::Scanline& scanline = result.scandata[groupIdx].scanlines[echoIdx];
+            scanline.start = point_offset;
+            point_offset += scanline.count;
+            scanline.count = 0; // incremented while copying
+        }
+    }
+    result.points.resize(total_point_count);
+    for (int module_idx = 0; module_idx < segment_data.segmentModules.size(); module_idx++)
+    {
+        const sick_scansegment_xd::CompactModuleMeasurementData& moduleMeasurement = segment_data.segmentModules[module_idx].moduleMeasurement;
+        if (!moduleMeasurement.valid)
+            continue;
+        for (int measurement_idx = 0; measurement_idx < moduleMeasurement.scandata.size(); measurement_idx++)
+        {
+            const ScanSegmentParserOutput::Scangroup& scandata = moduleMeasurement.scandata[measurement_idx];
+            for(int line_idx = 0; line_idx < scandata.scanlines.size(); line_idx++)
+            {
+                const ScanSegmentParserOutput::Scanline& scanline_in = scandata.scanlines[line_idx];
+                if (scanline_in.count == 0)
+                    continue;
+                ScanSegmentParserOutput::Scanline& scanline_out = result.scandata[moduleMeasurement.points.layer[scanline_in.start]].scanlines[moduleMeasurement.points.echo[scanline_in.start]];
+                result.points.copy(scanline_out.start + scanline_out.count, moduleMeasurement.points, scanline_in.start, scanline_in.count);
+                scanline_out.count += scanline_in.count;
+            }
+        }
+    }
     if (result.scandata.empty() && !result.imudata.valid)
     {
         ROS_ERROR_STREAM("## ERROR CompactDataParser::Parse(): CompactDataParser::ParseSegment() failed (no scandata found)");
@@ -928,23 +965,14 @@ bool sick_scansegment_xd::CompactDataParser::Parse(const ScanSegmentParserConfig
         sensor_timeStamp = (uint64_t)result.scandata[0].timestampStart_sec * 1000000UL + (uint64_t)result.scandata[0].timestampStart_nsec / 1000; // i.e. start of scan in microseconds
     result.timestamp_sec = (sensor_timeStamp / 1000000);
     result.timestamp_nsec= 1000 * (sensor_timeStamp % 1000000);
-    if (use_software_pll)
-    {
-        SoftwarePLL& software_pll = SoftwarePLL::instance();
-        int64_t systemtime_nanoseconds = system_timestamp.time_since_epoch().count();
-        uint32_t systemtime_sec = (uint32_t)(systemtime_nanoseconds / 1000000000);  // seconds part of system timestamp
-        uint32_t systemtime_nsec = (uint32_t)(systemtime_nanoseconds % 1000000000); // nanoseconds part of system timestamp
-        uint32_t curtick = (uint32_t)(sensor_timeStamp & 0xFFFFFFFF);
-        software_pll.updatePLL(systemtime_sec, systemtime_nsec, curtick);
-        if (software_pll.IsInitialized())
-        {
-            uint32_t pll_sec = 0, pll_nsec = 0;
-            software_pll.getCorrectedTimeStamp(pll_sec, pll_nsec, curtick);
-            result.timestamp_sec = pll_sec;
-            result.timestamp_nsec = pll_nsec;
-        }
-    }
     result.timestamp = sick_scansegment_xd::Timestamp(result.timestamp_sec, result.timestamp_nsec);
+    result.sensorTicksValid = true;
+    result.sensorTicks = (uint32_t)(sensor_timeStamp & 0xFFFFFFFF);
+    result.scangroupTicksValid = false; // scangroup timestamps are sensor time
+    if (use_software_pll) // convert sensor ticks to system time
+    {
+        result.ApplySoftwarePLL(system_timestamp, verbose);
+    }
 
 #if EXPORT_MEASUREMENT_AZIMUTH_ACCELERATION_CSV // Measurement of IMU latency (development only): Export ticks (imu resp. lidar timestamp in micro seconds), imu acceleration and lidar max azimuth of board cube
     ROS_INFO_STREAM("CompactDataParser::Parse(): header = " << segmentHeader.to_string() << ", system timestamp = " << result.timestamp);
@@ -957,7 +985,7 @@ bool sick_scansegment_xd::CompactDataParser::Parse(const ScanSegmentParserConfig
     {
       uint64_t timestamp_microsec_azi = 0;
       double azimuth_aperture = 0;
-      if (getMaxAzimuthApertureWithinCube(result.scandata, 0.5f, 1.5f, -1.0f, +1.0f, -1.0f, +1.0f, -M_PI, +M_PI, azimuth_aperture, timestamp_microsec_azi))
+      if (getMaxAzimuthApertureWithinCube(result.scandata, result.points, 0.5f, 1.5f, -1.0f, +1.0f, -1.0f, +1.0f, -M_PI, +M_PI, azimuth_aperture, timestamp_microsec_azi))
       {
         std::ofstream csv_ostream("/tmp/imu_latency.csv", std::ios::app);
         csv_ostream << timestamp_microsec_azi << ";" << std::fixed << std::setprecision(3) << (azimuth_aperture * 180 / M_PI) << ";" << "\n";
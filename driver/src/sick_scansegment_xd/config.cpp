@@ -150,6 +150,10 @@ sick_scansegment_xd::Config::Config()
     publish_laserscan_fullframe_topic = "scan_fullframe"; //topic of ros Laserscan fullframe messages
     udp_input_fifolength = 20;             // max. udp input fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
     msgpack_output_fifolength = 20;        // max. msgpack output fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
+    udp_recv_batch_size = 0;               // max. number of udp datagrams received by one recvmmsg syscall using kernel receive timestamps (Linux only), default: 0 (one recv call per datagram)
+    io_reactor_threads = 0;                // number of epoll reactor threads receiving all sensor sockets (Linux only), default: 0 (one receiver thread per socket)
+    msgpack_converter_threads = 1;         // number of threads parsing udp payloads in parallel, segments are published in order of arrival (default: 1, i.e. one converter thread)
+    fifo_spin_count = 0;                   // number of busy-wait attempts before a thread waiting for udp or msgpack fifo data is parked (0: park immediately, default: 0)
     verbose_level = 1;                     // verbose_level <= 0: quiet mode, verbose_level == 1: print statistics, verbose_level == 2: print details incl. msgpack data, default: 1
     measure_timing = true;                 // measure_timing == true: duration and latency of msgpack conversion and export is measured, default: true
     export_csv = false;                    // export msgpack data to csv file, default: false
@@ -202,6 +206,9 @@ sick_scansegment_xd::Config::Config()
     // Use "0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0" to activate resp. "1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1" to activate laserscan messages for all 16 layers of the Multiscan136
     // Default is "0 0 0 0 0 1 0 0 0 0 0 0 0 0 0 0", i.e. laserscan messages for layer 5, (elevation -0.07 degree, max number of scan points)
     laserscan_layer_filter = { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    // Parameter "laserscan_angular_resolution" overwrites the angular resolution of laserscan messages in degree.
+    // Default is 0, i.e. the angular resolution transmitted by the lidar is used (or, if not available, equidistant scan points are assumed)
+    laserscan_angular_resolution = 0;
 
 }
 
@@ -223,6 +230,10 @@ void sick_scansegment_xd::Config::PrintHelp(void)
     ROS_INFO_STREAM("-udp_port=<port> : udp port for multiScan136 resp. multiScan136 emulator, default: " << udp_port);
     ROS_INFO_STREAM("-udp_input_fifolength=<size> : max. udp input fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length");
     ROS_INFO_STREAM("-msgpack_output_fifolength=<size> : max. msgpack output fifo length(-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length");
+    ROS_INFO_STREAM("-udp_recv_batch_size=<count> : max. number of udp datagrams received by one recvmmsg syscall using kernel receive timestamps (Linux only, 0: one recv call per datagram), default: " << udp_recv_batch_size);
+    ROS_INFO_STREAM("-io_reactor_threads=<count> : number of epoll reactor threads receiving all sensor sockets (Linux only, 0: one receiver thread per socket), default: " << io_reactor_threads);
+    ROS_INFO_STREAM("-msgpack_converter_threads=<count> : number of threads parsing udp payloads in parallel, segments are published in order of arrival, default: " << msgpack_converter_threads);
+    ROS_INFO_STREAM("-fifo_spin_count=<count> : number of busy-wait attempts before a thread waiting for udp or msgpack fifo data is parked (0: park immediately), default: " << fifo_spin_count);
     ROS_INFO_STREAM("-verbose_level=[0-2] : verbose_level <= 0: quiet mode, verbose_level == 1: print statistics, verbose_level == 2: print details incl. msgpack data, default: " << verbose_level);
     ROS_INFO_STREAM("-measure_timing=0|1 : measure_timing == true: duration and latency of msgpack conversion and export is measured, default: " << measure_timing);
     ROS_INFO_STREAM("-export_csv=0|1 : export msgpack data to csv file, default: false");
@@ -259,6 +270,10 @@ bool sick_scansegment_xd::Config::Init(rosNodePtr _node)
     ROS_DECL_GET_PARAMETER(node, "publish_laserscan_fullframe_topic", publish_laserscan_fullframe_topic);
     ROS_DECL_GET_PARAMETER(node, "udp_input_fifolength", udp_input_fifolength);
     ROS_DECL_GET_PARAMETER(node, "msgpack_output_fifolength", msgpack_output_fifolength);
+    ROS_DECL_GET_PARAMETER(node, "udp_recv_batch_size", udp_recv_batch_size);
+    ROS_DECL_GET_PARAMETER(node, "io_reactor_threads", io_reactor_threads);
+    ROS_DECL_GET_PARAMETER(node, "msgpack_converter_threads", msgpack_converter_threads);
+    ROS_DECL_GET_PARAMETER(node, "fifo_spin_count", fifo_spin_count);
     ROS_DECL_GET_PARAMETER(node, "verbose_level", verbose_level);
     ROS_DECL_GET_PARAMETER(node, "measure_timing", measure_timing);
     ROS_DECL_GET_PARAMETER(node, "export_csv", export_csv);
@@ -333,6 +348,7 @@ bool sick_scansegment_xd::Config::Init(rosNodePtr _node)
     std::string str_laserscan_layer_filter = "0 0 0 0 0 1 0 0 0 0 0 0 0 0 0 0";
     ROS_DECL_GET_PARAMETER(node, "laserscan_layer_filter", str_laserscan_layer_filter);
     sick_scansegment_xd::util::parseVector(str_laserscan_layer_filter, laserscan_layer_filter);
+    ROS_DECL_GET_PARAMETER(node, "laserscan_angular_resolution", laserscan_angular_resolution);
 
     if (imu_enable && scandataformat != 2)
     {
@@ -398,6 +414,10 @@ bool sick_scansegment_xd::Config::Init(int argc, char** argv)
     setOptionalArgument(cli_parameter_map, "publish_laserscan_fullframe_topic", publish_laserscan_fullframe_topic);
     setOptionalArgument(cli_parameter_map, "udp_input_fifolength", udp_input_fifolength);
     setOptionalArgument(cli_parameter_map, "msgpack_output_fifolength", msgpack_output_fifolength);
+    setOptionalArgument(cli_parameter_map, "udp_recv_batch_size", udp_recv_batch_size);
+    setOptionalArgument(cli_parameter_map, "io_reactor_threads", io_reactor_threads);
+    setOptionalArgument(cli_parameter_map, "msgpack_converter_threads", msgpack_converter_threads);
+    setOptionalArgument(cli_parameter_map, "fifo_spin_count", fifo_spin_count);
     setOptionalArgument(cli_parameter_map, "verbose_level", verbose_level);
     setOptionalArgument(cli_parameter_map, "measure_timing", measure_timing);
     setOptionalArgument(cli_parameter_map, "export_csv", export_csv);
@@ -449,6 +469,7 @@ bool sick_scansegment_xd::Config::Init(int argc, char** argv)
         sick_scansegment_xd::util::parseVector(cli_msgpack_validator_layer_filter, msgpack_validator_filter_settings.msgpack_validator_layer_filter);
     if (setOptionalArgument(cli_parameter_map, "laserscan_layer_filter", cli_laserscan_layer_filter))
         sick_scansegment_xd::util::parseVector(cli_laserscan_layer_filter, laserscan_layer_filter);
+    setOptionalArgument(cli_parameter_map, "laserscan_angular_resolution", laserscan_angular_resolution);
 
     PrintConfig();
 
@@ -477,6 +498,10 @@ void sick_scansegment_xd::Config::PrintConfig(void)
     ROS_INFO_STREAM("publish_laserscan_fullframe_topic:" << publish_laserscan_fullframe_topic);
     ROS_INFO_STREAM("udp_input_fifolength:             " << udp_input_fifolength);
     ROS_INFO_STREAM("msgpack_output_fifolength:        " << msgpack_output_fifolength);
+    ROS_INFO_STREAM("udp_recv_batch_size:              " << udp_recv_batch_size);
+    ROS_INFO_STREAM("io_reactor_threads:               " << io_reactor_threads);
+    ROS_INFO_STREAM("msgpack_converter_threads:        " << msgpack_converter_threads);
+    ROS_INFO_STREAM("fifo_spin_count:                  " << fifo_spin_count);
     ROS_INFO_STREAM("verbose_level:                    " << verbose_level);
     ROS_INFO_STREAM("measure_timing:                   " << measure_timing);
     ROS_INFO_STREAM("export_csv:                       " << export_csv);
@@ -506,6 +531,7 @@ void sick_scansegment_xd::Config::PrintConfig(void)
     ROS_INFO_STREAM("host_LFPlayerFilter:              " << host_LFPlayerFilter);
     ROS_INFO_STREAM("host_set_LFPlayerFilter:          " << host_set_LFPlayerFilter);
     ROS_INFO_STREAM("laserscan_layer_filter:           " << sick_scansegment_xd::util::printVector(laserscan_layer_filter));
+    ROS_INFO_STREAM("laserscan_angular_resolution:     " << laserscan_angular_resolution << " [deg]");
     ROS_INFO_STREAM("msgpack_validator_enabled:                         " << msgpack_validator_enabled);
     ROS_INFO_STREAM("msgpack_validator_verbose:                         " << msgpack_validator_verbose);
     ROS_INFO_STREAM("msgpack_validator_discard_msgpacks_out_of_bounds:  " << msgpack_validator_discard_msgpacks_out_of_bounds);
@@ -0,0 +1,313 @@
+/*
+ * @brief crc32 computes the zlib CRC32 checksum of scansegment payloads (multiScan, picoScan)
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <cstring>
+#include "sick_scansegment_xd/crc32.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SICK_SCANSEGMENT_XD_CRC32_PCLMUL 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SICK_SCANSEGMENT_XD_CRC32_ARMV8 1
+#endif
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SICK_SCANSEGMENT_XD_CRC32_BIG_ENDIAN 1
+#endif
+
+namespace sick_scansegment_xd
+{
+    /*
+     * Lookup tables for slice-by-8, table[0] is the common bytewise crc table.
+     */
+    class Crc32Tables
+    {
+    public:
+        Crc32Tables()
+        {
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t crc = n;
+                for (int k = 0; k < 8; k++)
+                    crc = crc & 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+                table[0][n] = crc;
+            }
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                for (int k = 1; k < 8; k++)
+                    table[k][n] = (table[k - 1][n] >> 8) ^ table[0][table[k - 1][n] & 0xff];
+            }
+        }
+        uint32_t table[8][256];
+    };
+
+    static const Crc32Tables& crc32Tables(void)
+    {
+        static const Crc32Tables s_crc32_tables; // initialized once on first call (thread safe since C++11)
+        return s_crc32_tables;
+    }
+
+    /*
+     * Slice-by-8 crc update, crc is the internal (inverted) crc state.
+     */
+    static uint32_t crc32UpdateSliceBy8(uint32_t crc, const uint8_t* buf, size_t len)
+    {
+        const uint32_t (&table)[8][256] = crc32Tables().table;
+#if !defined SICK_SCANSEGMENT_XD_CRC32_BIG_ENDIAN
+        while (len > 0 && (reinterpret_cast<uintptr_t>(buf) & 7) != 0) // bytewise until buf is 8 byte aligned
+        {
+            crc = table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+            len--;
+        }
+        while (len >= 8)
+        {
+            uint32_t lo, hi;
+            memcpy(&lo, buf, sizeof(lo));
+            memcpy(&hi, buf + 4, sizeof(hi));
+            lo ^= crc;
+            crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^ table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24]
+                ^ table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^ table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+            buf += 8;
+            len -= 8;
+        }
+#endif
+        while (len > 0)
+        {
+            crc = table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+            len--;
+        }
+        return crc;
+    }
+
+#if defined SICK_SCANSEGMENT_XD_CRC32_PCLMUL
+    /*
+     * Crc update by folding with carry-less multiplication, see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009).
+     * The constants are the bit-reflected folding constants k1 to k5 and the Barrett reduction constants for polynomial 0xedb88320.
+     * Processes len - len % 16 bytes (len >= 64 required), crc is the internal (inverted) crc state.
+     */
+    __attribute__((target("pclmul,sse4.1"))) static uint32_t crc32UpdatePclmul(uint32_t crc, const uint8_t* buf, size_t len)
+    {
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+        const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+        const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+        const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+        // Parallel fold blocks of 64 byte
+        __m128i x1 = _mm_loadu_si128((const __m128i*)(buf + 0x00));
+        __m128i x2 = _mm_loadu_si128((const __m128i*)(buf + 0x10));
+        __m128i x3 = _mm_loadu_si128((const __m128i*)(buf + 0x20));
+        __m128i x4 = _mm_loadu_si128((const __m128i*)(buf + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+        buf += 64;
+        len -= 64;
+        while (len >= 64)
+        {
+            __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(buf + 0x00)));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(buf + 0x10)));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(buf + 0x20)));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(buf + 0x30)));
+            buf += 64;
+            len -= 64;
+        }
+        // Fold 4 x 128 bit into 128 bit
+        __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), x5);
+        // Fold remaining blocks of 16 byte
+        while (len >= 16)
+        {
+            x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_loadu_si128((const __m128i*)buf)), x5);
+            buf += 16;
+            len -= 16;
+        }
+        // Fold 128 bit into 64 bit
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5k0, 0x00), x2);
+        // Barrett reduction to 32 bit
+        x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+        x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), poly, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return (uint32_t)_mm_extract_epi32(x1, 1);
+    }
+
+    static uint32_t crc32Pclmul(uint32_t crc, const uint8_t* buf, size_t len)
+    {
+        crc = ~crc;
+        if (len >= 64)
+        {
+            size_t len_folded = len & ~(size_t)15;
+            crc = crc32UpdatePclmul(crc, buf, len_folded);
+            buf += len_folded;
+            len -= len_folded;
+        }
+        return ~crc32UpdateSliceBy8(crc, buf, len);
+    }
+#endif // SICK_SCANSEGMENT_XD_CRC32_PCLMUL
+
+#if defined SICK_SCANSEGMENT_XD_CRC32_ARMV8
+    /*
+     * Crc update using the ARMv8 CRC32 instructions (crc32x/crc32b implement the zlib polynomial, crc32c* the Castagnoli polynomial)
+     */
+    static uint32_t crc32Armv8(uint32_t crc, const uint8_t* buf, size_t len)
+    {
+        crc = ~crc;
+        while (len > 0 && (reinterpret_cast<uintptr_t>(buf) & 7) != 0)
+        {
+            crc = __crc32b(crc, *buf++);
+            len--;
+        }
+        while (len >= 8)
+        {
+            uint64_t value;
+            memcpy(&value, buf, sizeof(value));
+            crc = __crc32d(crc, value);
+            buf += 8;
+            len -= 8;
+        }
+        while (len > 0)
+        {
+            crc = __crc32b(crc, *buf++);
+            len--;
+        }
+        return ~crc;
+    }
+#endif // SICK_SCANSEGMENT_XD_CRC32_ARMV8
+
+    typedef uint32_t(*Crc32Function)(uint32_t crc, const uint8_t* buf, size_t len);
+
+    /*
+     * Selects the crc implementation once at runtime
+     */
+    class Crc32Dispatcher
+    {
+    public:
+        Crc32Dispatcher() : compute(Crc32::ComputeSliceBy8), implementation("slice-by-8")
+        {
+#if defined SICK_SCANSEGMENT_XD_CRC32_PCLMUL
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+            {
+                compute = crc32Pclmul;
+                implementation = "pclmul";
+            }
+#elif defined SICK_SCANSEGMENT_XD_CRC32_ARMV8
+            compute = crc32Armv8;
+            implementation = "armv8-crc";
+#endif
+        }
+        Crc32Function compute;
+        const char* implementation;
+    };
+
+    static const Crc32Dispatcher& crc32Dispatcher(void)
+    {
+        static const Crc32Dispatcher s_crc32_dispatcher;
+        return s_crc32_dispatcher;
+    }
+
+} // namespace sick_scansegment_xd
+
+/*
+ * Computes the zlib CRC32 checksum using the fastest implementation available
+ */
+uint32_t sick_scansegment_xd::Crc32::Compute(uint32_t crc, const uint8_t* buf, size_t len)
+{
+    return crc32Dispatcher().compute(crc, buf, len);
+}
+
+/*
+ * Bitwise reference implementation, see https://stackoverflow.com/questions/15030011/same-crc32-for-python-and-c
+ */
+uint32_t sick_scansegment_xd::Crc32::ComputeBitwise(uint32_t crc, const uint8_t* buf, size_t len)
+{
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++)
+            crc = crc & 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+    }
+    return ~crc;
+}
+
+/*
+ * Table driven implementation (slice-by-8)
+ */
+uint32_t sick_scansegment_xd::Crc32::ComputeSliceBy8(uint32_t crc, const uint8_t* buf, size_t len)
+{
+    return ~crc32UpdateSliceBy8(~crc, buf, len);
+}
+
+/*
+ * Returns the name of the implementation selected by Compute()
+ */
+const char* sick_scansegment_xd::Crc32::Implementation(void)
+{
+    return crc32Dispatcher().implementation;
+}
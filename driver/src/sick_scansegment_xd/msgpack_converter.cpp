@@ -68,10 +68,15 @@
 #include "sick_scansegment_xd/udp_receiver.h"
 
 /*
- * @brief Default constructor.
+ * Max. time in seconds converter and parser threads wait for an udp payload before they check for shutdown
  */
-sick_scansegment_xd::MsgPackConverter::MsgPackConverter() : m_verbose(false), m_input_fifo(0), m_scandataformat(1), m_output_fifo(0), m_converter_thread(0), m_run_converter_thread(false)
+static const double s_input_pop_timeout_sec = 0.1;
 
+/*
+ * @brief Default constructor.
+ */
+sick_scansegment_xd::MsgPackConverter::MsgPackConverter() : m_verbose(false), m_input_fifo(0), m_scandataformat(1), m_output_fifo(0), m_converter_thread(0), m_run_converter_thread(false),
+    m_num_workers(1), m_next_input_seq(0), m_next_output_seq(0), m_msgpack_cnt(0)
 {
 }
 
@@ -85,9 +90,10 @@ sick_scansegment_xd::MsgPackConverter::MsgPackConverter() : m_verbose(false), m_
  * @param[in] verbose true: enable debug output, false: quiet mode (default)
  */
 sick_scansegment_xd::MsgPackConverter::MsgPackConverter(const ScanSegmentParserConfig& parser_config, const sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy, sick_scansegment_xd::PayloadFifo* input_fifo, int scandataformat, int msgpack_output_fifolength, bool verbose)
-    : m_parser_config(parser_config), m_verbose(verbose), m_input_fifo(input_fifo), m_scandataformat(scandataformat), m_converter_thread(0), m_run_converter_thread(false), m_msgpack_validator_enabled(false), m_discard_msgpacks_not_validated(false)
+    : m_parser_config(parser_config), m_verbose(verbose), m_input_fifo(input_fifo), m_scandataformat(scandataformat), m_converter_thread(0), m_run_converter_thread(false), m_msgpack_validator_enabled(false), m_discard_msgpacks_not_validated(false),
+    m_num_workers(1), m_next_input_seq(0), m_next_output_seq(0), m_msgpack_cnt(0)
 {
-    m_output_fifo = new sick_scansegment_xd::Fifo<ScanSegmentParserOutput>(msgpack_output_fifolength);
+    m_output_fifo = new sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>(msgpack_output_fifolength);
     m_add_transform_xyz_rpy = add_transform_xyz_rpy;
 }
 
@@ -106,7 +112,20 @@ sick_scansegment_xd::MsgPackConverter::~MsgPackConverter()
 bool sick_scansegment_xd::MsgPackConverter::Start(void)
 {
     m_run_converter_thread = true;
-    m_converter_thread = new std::thread(&sick_scansegment_xd::MsgPackConverter::Run, this);
+    if (m_num_workers <= 1)
+    {
+        m_converter_thread = new std::thread(&sick_scansegment_xd::MsgPackConverter::Run, this);
+        return true;
+    }
+    m_next_input_seq = 0;
+    m_next_output_seq = 0;
+    m_msgpack_cnt = 0;
+    m_reorder_slots = std::vector<ReorderSlot>(m_num_workers);
+    for (int n = 0; n < m_num_workers; n++)
+    {
+        m_worker_threads.push_back(new std::thread(&sick_scansegment_xd::MsgPackConverter::RunWorker, this));
+    }
+    ROS_INFO_STREAM("MsgPackConverter: " << m_num_workers << " parser threads started");
     return true;
 }
 
@@ -115,10 +134,11 @@ bool sick_scansegment_xd::MsgPackConverter::Start(void)
  */
 void sick_scansegment_xd::MsgPackConverter::Close(void)
 {
-    m_run_converter_thread = false;
-    if (m_output_fifo)
+    // Stop and join converter and parser threads. They pop from the input fifo with timeout and do not depend on the input fifo being shut down.
     {
-        m_output_fifo->Shutdown();
+        std::unique_lock<std::mutex> reorder_lock(m_reorder_mutex);
+        m_run_converter_thread = false;
+        m_reorder_cond.notify_all();
     }
     if (m_converter_thread)
     {
@@ -126,8 +146,15 @@ void sick_scansegment_xd::MsgPackConverter::Close(void)
         delete m_converter_thread;
         m_converter_thread = 0;
     }
+    for (size_t n = 0; n < m_worker_threads.size(); n++)
+    {
+        m_worker_threads[n]->join();
+        delete m_worker_threads[n];
+    }
+    m_worker_threads.clear();
     if (m_output_fifo)
     {
+        m_output_fifo->Shutdown();
         delete m_output_fifo;
         m_output_fifo = 0;
     }
@@ -149,6 +176,47 @@ void sick_scansegment_xd::MsgPackConverter::SetValidator(sick_scansegment_xd::Ms
 }
 
 
+/*
+ * @brief Parses one udp payload (msgpack or compact format). Returns true on success or false on parse error.
+ */
+bool sick_scansegment_xd::MsgPackConverter::ParsePayload(const std::vector<uint8_t>& input_payload, const fifo_timestamp& input_timestamp, sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy,
+    ScanSegmentParserOutput& msgpack_output, sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, bool use_software_pll)
+{
+    if (m_scandataformat == SCANDATA_MSGPACK)
+    {
+        return sick_scansegment_xd::MsgPackParser::Parse(input_payload, input_timestamp, add_transform_xyz_rpy, msgpack_output, msgpack_validator_data_collector, 
+            m_msgpack_validator, m_msgpack_validator_enabled, m_discard_msgpacks_not_validated, use_software_pll, m_verbose);
+    }
+    else if (m_scandataformat == SCANDATA_COMPACT)
+    {
+        return sick_scansegment_xd::CompactDataParser::Parse(m_parser_config, input_payload, input_timestamp, add_transform_xyz_rpy, msgpack_output, use_software_pll);
+    }
+    ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): invalid scandataformat configuration, unsupported scandataformat=" << m_scandataformat
+        << ", check configuration and use " << SCANDATA_MSGPACK << " for msgpack or " << SCANDATA_COMPACT << " for compact data");
+    return false;
+}
+
+/*
+ * @brief Validates the msgpack data collected so far, checks scandata out of bounds and, after every N msgpacks, missing scandata
+ */
+void sick_scansegment_xd::MsgPackConverter::ValidateCollectedData(sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, size_t& msgpack_cnt)
+{
+    msgpack_cnt++;
+    if (m_msgpack_validator.validateNotOutOfBound(msgpack_validator_data_collector) == false)
+        ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): msgpack out of bounds validation failed");
+    else if (m_verbose)
+        ROS_INFO_STREAM("MsgPackConverter::Run(): msgpack validation passed (no scandata out of bounds)");
+    if(msgpack_cnt >= m_msgpack_validator_check_missing_scandata_interval)
+    {
+        if (m_msgpack_validator.validateNoMissingScandata(msgpack_validator_data_collector) == false)
+            ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): msgpack validation failed (scandata missing)");
+        else if (m_verbose)
+            ROS_INFO_STREAM("MsgPackConverter::Run(): msgpack validation passed (no scandata missing)");
+        msgpack_cnt = 0; // reset counter for next interval
+        msgpack_validator_data_collector.reset(); // reset collected msgpack data, counters are reused
+    }
+}
+
 /*
  * @brief Thread callback, runs the converter. Pops msgpack data from the input fifo, converts them und pushes ScanSegmentParserOutput data to the output fifo.
  */
@@ -162,34 +230,22 @@ bool sick_scansegment_xd::MsgPackConverter::Run(void)
     try
     {
         sick_scansegment_xd::MsgPackValidatorData msgpack_validator_data_collector;
-        for (size_t msgpack_cnt = 1; m_run_converter_thread; msgpack_cnt++)
+        size_t msgpack_cnt = 0;
+        std::vector<uint8_t> input_payload;
+        sick_scansegment_xd::ScanSegmentParserOutput msgpack_output;
+        while (m_run_converter_thread)
         {
-            std::vector<uint8_t> input_payload;
             fifo_timestamp input_timestamp;
             size_t input_counter = 0;
-            if (m_input_fifo->Pop(input_payload, input_timestamp, input_counter))
+            if (m_input_fifo->Pop(input_payload, input_timestamp, input_counter, s_input_pop_timeout_sec))
             {
                 try
                 {
-                    sick_scansegment_xd::ScanSegmentParserOutput msgpack_output;
-                    bool parse_success = false;
-                    if (m_scandataformat == SCANDATA_MSGPACK)
-                    {
-                        parse_success = sick_scansegment_xd::MsgPackParser::Parse(input_payload, input_timestamp, m_add_transform_xyz_rpy, msgpack_output, msgpack_validator_data_collector, 
-                            m_msgpack_validator, m_msgpack_validator_enabled, m_discard_msgpacks_not_validated, true, m_verbose);
-                    }
-                    else if (m_scandataformat == SCANDATA_COMPACT)
-                    {
-                        parse_success = sick_scansegment_xd::CompactDataParser::Parse(m_parser_config, input_payload, input_timestamp, m_add_transform_xyz_rpy, msgpack_output);
-                    }
-                    else
-                    {
-                        ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): invalid scandataformat configuration, unsupported scandataformat=" << m_scandataformat
-                            << ", check configuration and use " << SCANDATA_MSGPACK << " for msgpack or " << SCANDATA_COMPACT << " for compact data");
-                    }
+                    bool parse_success = ParsePayload(input_payload, input_timestamp, m_add_transform_xyz_rpy, msgpack_output, msgpack_validator_data_collector, true);
                     if (parse_success)
                     {
-                        size_t fifo_length = m_output_fifo->Push(msgpack_output, input_timestamp, input_counter);
+                        size_t fifo_length = m_output_fifo->Push(std::move(msgpack_output), input_timestamp, input_counter);
+                        m_output_fifo->AcquireElement(msgpack_output); // continue with the buffers of an output released by the consumer
                         if (m_verbose)
                         {
                             ROS_INFO_STREAM("MsgPackConverter::Run(): " << m_input_fifo->Size() << " messages in input fifo, " << fifo_length << " messages in output fifo.");
@@ -205,25 +261,15 @@ bool sick_scansegment_xd::MsgPackConverter::Run(void)
                     }
                     if (m_msgpack_validator_enabled) // validate msgpack data
                     {
-                        if (m_msgpack_validator.validateNotOutOfBound(msgpack_validator_data_collector) == false)
-                            ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): msgpack out of bounds validation failed");
-                        else if (m_verbose)
-                            ROS_INFO_STREAM("MsgPackConverter::Run(): msgpack validation passed (no scandata out of bounds)");
-                        if(msgpack_cnt >= m_msgpack_validator_check_missing_scandata_interval)
-                        {
-                            if (m_msgpack_validator.validateNoMissingScandata(msgpack_validator_data_collector) == false)
-                                ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): msgpack validation failed (scandata missing)");
-                            else if (m_verbose)
-                                ROS_INFO_STREAM("MsgPackConverter::Run(): msgpack validation passed (no scandata missing)");
-                            msgpack_cnt = 0; // reset counter for next interval
-                            msgpack_validator_data_collector = sick_scansegment_xd::MsgPackValidatorData(); // reset collected msgpack data
-                        }
+                        ValidateCollectedData(msgpack_validator_data_collector, msgpack_cnt);
                     }
                 }
                 catch (std::exception & e)
                 {
                     ROS_ERROR_STREAM("## ERROR MsgPackConverter::Run(): parse error " << e.what());
                 }
+                msgpack_output.Clear(); // clear in place, the buffers are reused by the next payload
+                m_input_fifo->ReleaseBuffer(input_payload); // recycle the payload buffer
             }
         }
         m_run_converter_thread = false;
@@ -236,3 +282,101 @@ bool sick_scansegment_xd::MsgPackConverter::Run(void)
     m_run_converter_thread = false;
     return false;
 }
+
+/*
+ * @brief Thread callback for each parser thread if more than one worker is configured. Pops msgpack data from the input fifo, converts them
+ * and passes the results to the reorder stage, which pushes ScanSegmentParserOutput data to the output fifo in order of arrival.
+ */
+bool sick_scansegment_xd::MsgPackConverter::RunWorker(void)
+{
+    if (!m_input_fifo || !m_output_fifo)
+    {
+        ROS_ERROR_STREAM("## ERROR MsgPackConverter::RunWorker(): MsgPackConverter not initialized.");
+        return false;
+    }
+    sick_scan_xd::SickCloudTransform add_transform_xyz_rpy = m_add_transform_xyz_rpy; // each worker uses its own transform
+    std::vector<uint8_t> input_payload;
+    ReorderSlot result;
+    while (m_run_converter_thread)
+    {
+        size_t input_seq = 0;
+        {
+            std::unique_lock<std::mutex> input_lock(m_input_mutex);
+            if (!m_run_converter_thread || !m_input_fifo->Pop(input_payload, result.input_timestamp, result.input_counter, s_input_pop_timeout_sec))
+                continue;
+            input_seq = m_next_input_seq++; // payloads are numbered in order of arrival, segment and telegram counter may wrap around or be missing
+        }
+        result.parse_success = false;
+        try
+        {
+            // Software pll and msgpack validation depend on the order of the segments and run in the reorder stage
+            result.parse_success = ParsePayload(input_payload, result.input_timestamp, add_transform_xyz_rpy, result.output, result.validator_data, false);
+            if (!result.parse_success && m_verbose)
+            {
+                ROS_ERROR_STREAM("## ERROR MsgPackConverter::RunWorker(): MsgPackParser::Parse() failed on " << input_payload.size() << " byte input data: " << sick_scansegment_xd::UdpReceiver::ToPrintableString(input_payload, input_payload.size()));
+            }
+        }
+        catch (std::exception & e)
+        {
+            ROS_ERROR_STREAM("## ERROR MsgPackConverter::RunWorker(): parse error " << e.what());
+        }
+        m_input_fifo->ReleaseBuffer(input_payload); // recycle the payload buffer
+        Reorder(input_seq, result); // failed payloads are passed to the reorder stage, too, i.e. the sequence has no gaps
+    }
+    return true;
+}
+
+/*
+ * @brief Stores the parse result of the udp payload with sequence number input_seq in the reorder buffer. Then all results
+ * in order of arrival are passed to software pll and msgpack validation and pushed to the output fifo.
+ */
+void sick_scansegment_xd::MsgPackConverter::Reorder(size_t input_seq, ReorderSlot& result)
+{
+    std::unique_lock<std::mutex> reorder_lock(m_reorder_mutex);
+    // Wait until the slot for this payload is free, i.e. result input_seq - m_num_workers has been pushed
+    while (m_run_converter_thread && input_seq >= m_next_output_seq + m_reorder_slots.size())
+        m_reorder_cond.wait(reorder_lock);
+    if (input_seq >= m_next_output_seq + m_reorder_slots.size())
+        return; // shutdown
+    ReorderSlot& slot = m_reorder_slots[input_seq % m_reorder_slots.size()];
+    std::swap(slot, result); // result takes the previous slot buffers for reuse
+    slot.ready = true;
+    result.ready = false;
+    bool slots_released = false;
+    for (ReorderSlot* next_slot = &m_reorder_slots[m_next_output_seq % m_reorder_slots.size()]; next_slot->ready; next_slot = &m_reorder_slots[m_next_output_seq % m_reorder_slots.size()])
+    {
+        try
+        {
+            if (next_slot->parse_success)
+            {
+                next_slot->output.ApplySoftwarePLL(next_slot->input_timestamp, m_verbose);
+                size_t fifo_length = m_output_fifo->Push(std::move(next_slot->output), next_slot->input_timestamp, next_slot->input_counter);
+                m_output_fifo->AcquireElement(next_slot->output); // the slot continues with the buffers of an output released by the consumer
+                if (m_verbose)
+                {
+                    ROS_INFO_STREAM("MsgPackConverter::Reorder(): " << m_input_fifo->Size() << " messages in input fifo, " << fifo_length << " messages in output fifo.");
+                }
+            }
+            else
+            {
+                ROS_ERROR_STREAM("## ERROR MsgPackConverter::Reorder(): msgpack parse error");
+            }
+            if (m_msgpack_validator_enabled) // validate msgpack data
+            {
+                m_msgpack_validator_data_collector.update(next_slot->validator_data);
+                next_slot->validator_data.reset();
+                ValidateCollectedData(m_msgpack_validator_data_collector, m_msgpack_cnt);
+            }
+        }
+        catch (std::exception & e)
+        {
+            ROS_ERROR_STREAM("## ERROR MsgPackConverter::Reorder(): " << e.what());
+        }
+        next_slot->output.Clear(); // clear in place, the slot buffers (own or recycled) are reused by the next payload
+        next_slot->ready = false;
+        m_next_output_seq++;
+        slots_released = true;
+    }
+    if (slots_released)
+        m_reorder_cond.notify_all();
+}
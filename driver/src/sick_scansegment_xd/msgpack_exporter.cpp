@@ -72,7 +72,7 @@ sick_scansegment_xd::MsgPackExporter::MsgPackExporter() : m_udp_fifo(0), m_msgpa
  * @param[in] verbose true: enable debug output, false: quiet mode (default)
  * @param[in] measure_timing true: duration and latency of msgpack conversion and export is measured, default: false
  */
-sick_scansegment_xd::MsgPackExporter::MsgPackExporter(sick_scansegment_xd::PayloadFifo* udp_fifo, sick_scansegment_xd::Fifo<ScanSegmentParserOutput>* msgpack_fifo, const std::string& logfolder, bool export_csv, bool verbose, bool measure_timing)
+sick_scansegment_xd::MsgPackExporter::MsgPackExporter(sick_scansegment_xd::PayloadFifo* udp_fifo, sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>* msgpack_fifo, const std::string& logfolder, bool export_csv, bool verbose, bool measure_timing)
 : m_udp_fifo(udp_fifo), m_msgpack_fifo(msgpack_fifo), m_logfolder(logfolder), m_export_csv(export_csv), m_verbose(verbose), m_measure_timing(measure_timing), m_exporter_thread(0), m_run_exporter_thread(false)
 {
 }
@@ -230,6 +230,8 @@ bool sick_scansegment_xd::MsgPackExporter::RunCb(void)
                         ROS_INFO_STREAM("MsgPack/Compact-Exporter:   " << current_udp_fifo_size << " udp packages still in input fifo, " << current_output_fifo_size << " messages still in output fifo, current segment index: " << msgpack_output.segmentIndex);
                         ROS_INFO_STREAM("MsgPack/Compact-Exporter: " << msg_udp_received_counter << " udp scandata messages received, " << msg_exported_counter << " messages exported (scan+imu), " << (100.0 * packages_lost_rate) << "% package lost.");
                         ROS_INFO_STREAM("MsgPack/Compact-Exporter: max. " << max_count_udp_messages_in_fifo << " udp messages buffered, max " << max_count_output_messages_in_fifo << " export messages buffered.");
+                        ROS_INFO_STREAM("MsgPack/Compact-Exporter: udp payload buffer pool: " << m_udp_fifo->BufferPoolHits() << " hits, " << m_udp_fifo->BufferPoolMisses() << " misses, "
+                            << "output pool: " << m_msgpack_fifo->ElementPoolHits() << " hits, " << m_msgpack_fifo->ElementPoolMisses() << " misses.");
                         std::stringstream s;
                         s << "MsgPack/Compact-Exporter: " << msg_exported_counter << " messages exported at " << std::fixed << std::setprecision(3) << msg_exported_rate << " Hz, mean time: " 
                             << std::fixed << std::setprecision(3) << duration_datahandling_milliseconds.MeanMilliseconds() << " milliseconds/messages, " 
@@ -239,6 +241,7 @@ bool sick_scansegment_xd::MsgPackExporter::RunCb(void)
                         last_print_timestamp = fifo_clock::now();
                     }
                 }
+                m_msgpack_fifo->ReleaseElement(msgpack_output); // recycle the output buffers, the converter reuses them for the next payloads
             }
         }
         if (m_measure_timing && m_verbose)
@@ -248,7 +251,9 @@ bool sick_scansegment_xd::MsgPackExporter::RunCb(void)
             double msg_exported_rate = (double)msg_exported_counter / sick_scansegment_xd::Fifo<ScanSegmentParserOutput>::Seconds(recv_start_timestamp, fifo_clock::now());
             std::stringstream info1, info2;
             info1 << "MsgPack/Compact-Exporter: finished, " << current_udp_fifo_size << " udp packages still in input fifo, " << current_output_fifo_size << " messages still in output fifo"
-                << ", max. " << max_count_udp_messages_in_fifo << " udp messages buffered, max " << max_count_output_messages_in_fifo << " export messages buffered.";
+                << ", max. " << max_count_udp_messages_in_fifo << " udp messages buffered, max " << max_count_output_messages_in_fifo << " export messages buffered"
+                << ", udp payload buffer pool: " << m_udp_fifo->BufferPoolHits() << " hits, " << m_udp_fifo->BufferPoolMisses() << " misses"
+                << ", output pool: " << m_msgpack_fifo->ElementPoolHits() << " hits, " << m_msgpack_fifo->ElementPoolMisses() << " misses.";
             info2 << "MsgPack/Compact-Exporter: " << msg_exported_counter << " messages exported at " << msg_exported_rate << " Hz, mean time: " << duration_datahandling_milliseconds.MeanMilliseconds() << " milliseconds/messages, " 
                 << "stddev time: " << duration_datahandling_milliseconds.StddevMilliseconds() << ", " << "max time: " << duration_datahandling_milliseconds.MaxMilliseconds() << " milliseconds between udp receive and messages export, "
                 << "histogram=[" << duration_datahandling_milliseconds.PrintHistMilliseconds() << "]";
@@ -11,13 +11,13 @@
  *
  * for (int groupIdx = 0; groupIdx < msgpack_output.scandata.size(); groupIdx++)
  * {
- * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].size(); echoIdx++)
+ * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].scanlines.size(); echoIdx++)
  * 	 {
- * 	   std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = msgpack_output.scandata[groupIdx][echoIdx];
+ * 	   const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = msgpack_output.scandata[groupIdx].scanlines[echoIdx];
  * 	   std::cout << (groupIdx + 1) << ". group, " << (echoIdx + 1) << ". echo: ";
- * 	   for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+ * 	   for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
  * 	   {
- * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
+ * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = msgpack_output.points.get(scanline.start + pointIdx);
  * 		  std::cout << (pointIdx > 0 ? "," : "") << "(" << point.x << "," << point.y << "," << point.z << "," << point.i << ")";
  * 	   }
  * 	   std::cout << std::endl;
@@ -78,6 +78,7 @@
 #include <ctime>
 #include <fstream>
 #include <msgpack11.hpp>
+#include "sick_scan/sick_polar_to_cartesian.h"
 #include "sick_scan/softwarePLL.h"
 #include "sick_scansegment_xd/config.h"
 #include "sick_scansegment_xd/msgpack_parser.h"
@@ -95,8 +96,8 @@ static float normalizeAngle(float angle_rad)
  /*
   * @brief Counter for each message (each scandata decoded from msgpack data)
   */
-int sick_scansegment_xd::MsgPackParser::messageCount = 0;
-int sick_scansegment_xd::MsgPackParser::telegramCount = 0;
+std::atomic<int> sick_scansegment_xd::MsgPackParser::messageCount(0);
+std::atomic<int> sick_scansegment_xd::MsgPackParser::telegramCount(0);
 
 /*
  * @brief Returns the tokenized integer of a msgpack key.
@@ -289,13 +290,19 @@ static std::string printMsgPack(const msgpack11::MsgPack& msg)
 class MsgPackElement
 {
 public:
-	MsgPackElement() {}
-	MsgPackElement(const msgpack11::MsgPack::object& object_items)
+	MsgPackElement() : data(0), elemSz(0), elemTypes(0), endian(0) {}
+	MsgPackElement(const msgpack11::MsgPack::object& object_items) : data(0), elemSz(0), elemTypes(0), endian(0)
 	{
-		data = &object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_data])->second;
-		elemSz = &object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_elemSz])->second;
-		endian = &object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_endian])->second;
-		elemTypes = &object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_elemTypes])->second;
+		msgpack11::MsgPack::object::const_iterator data_iter = object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_data]);
+		msgpack11::MsgPack::object::const_iterator elemSz_iter = object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_elemSz]);
+		msgpack11::MsgPack::object::const_iterator endian_iter = object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_endian]);
+		msgpack11::MsgPack::object::const_iterator elemTypes_iter = object_items.find(s_msgpack_keys.values[MsgpackKeyToInt_elemTypes]);
+		if (data_iter == object_items.end() || elemSz_iter == object_items.end() || endian_iter == object_items.end() || elemTypes_iter == object_items.end())
+			return; // invalid element, data missing
+		data = &data_iter->second;
+		elemSz = &elemSz_iter->second;
+		endian = &endian_iter->second;
+		elemTypes = &elemTypes_iter->second;
 		if (elemTypes->is_array())
 			elemTypes = &elemTypes->array_items()[0];
 	}
@@ -306,121 +313,534 @@ public:
 };
 
 /*
- * @brief class MsgPackToFloat32VectorConverter decodes a MsgPackElement into an array of float data.
+ * @brief class MsgPackBinaryView references the binary data of a msgpack element (ChannelPhi, ChannelTheta, DistValues,
+ * RssiValues or PropertiesValues) together with its element size, element type and endianess. The binary data are not
+ * copied, i.e. the msgpack buffer resp. the msgpack11 objects must be valid while accessing a MsgPackBinaryView.
  */
-class MsgPackToFloat32VectorConverter
+class MsgPackBinaryView
 {
 public:
-	MsgPackToFloat32VectorConverter() {}
-	MsgPackToFloat32VectorConverter(const MsgPackElement& msgpack, bool dstIsBigEndian)
+	MsgPackBinaryView() : data(0), size(0), elemSz(0), elemType(0), srcIsBigEndian(false) {}
+	MsgPackBinaryView(const MsgPackElement& msgpack) : data(0), size(0), elemSz(0), elemType(0), srcIsBigEndian(false)
 	{
-		union FLOAT_4BYTE_UNION
+		if (msgpack.data && msgpack.elemSz && msgpack.elemTypes && msgpack.endian)
+		{
+			const msgpack11::MsgPack::binary& binary_items = msgpack.data->binary_items();
+			data = (binary_items.empty() ? 0 : binary_items.data());
+			size = binary_items.size();
+			elemSz = msgpack.elemSz->int_value();
+			elemType = msgpack.elemTypes->int_value();
+			srcIsBigEndian = (msgpack.endian->string_value() == "big");
+		}
+	}
+	/** Returns true, if the element contains float32 values (elemSz 4) or uint16 values (elemSz 2) */
+	bool isFloat32OrUint16(void) const
+	{
+		return data && size > 0 && ((elemSz == 4 && elemType == MsgpackKeyToInt_float32) || (elemSz == 2 && elemType == MsgpackKeyToInt_uint16)) && (size % elemSz) == 0;
+	}
+	/** Returns true, if the element contains uint8 values */
+	bool isUint8(void) const
+	{
+		return data && size > 0 && elemSz == 1 && elemType == MsgpackKeyToInt_uint8;
+	}
+	/** Returns the number of elements */
+	size_t numElems(void) const
+	{
+		return (elemSz > 0) ? (size / elemSz) : 0;
+	}
+	/** Decodes a float32 or uint16 element and returns its value as float. Note: isFloat32OrUint16() must be true. */
+	inline float floatValue(size_t idx, bool dstIsBigEndian) const
+	{
+		if (elemSz == 4) // Decode 4 bytes as float
 		{
-			uint8_t u8_bytes[4];
 			uint32_t u32_bytes;
+			memcpy(&u32_bytes, data + 4 * idx, 4);
+			if (srcIsBigEndian != dstIsBigEndian) // src and dst have different endianess: reorder 4 bytes
+				u32_bytes = ((u32_bytes & 0xFF) << 24) | ((u32_bytes & 0xFF00) << 8) | ((u32_bytes >> 8) & 0xFF00) | ((u32_bytes >> 24) & 0xFF);
 			float value;
-		};
+			memcpy(&value, &u32_bytes, 4);
+			return value;
+		}
+		uint16_t u16_bytes; // Decode 2 bytes as uint16 and convert to float
+		memcpy(&u16_bytes, data + 2 * idx, 2);
+		if (srcIsBigEndian != dstIsBigEndian) // src and dst have different endianess: reorder 2 bytes
+			u16_bytes = (uint16_t)((u16_bytes << 8) | (u16_bytes >> 8));
+		return (float)u16_bytes;
+	}
+	/** Prints all elements (debug output) */
+	std::string print(bool dstIsBigEndian, bool rad2deg = false) const
+	{
+		std::stringstream s;
+		for (size_t n = 0; n < numElems(); n++)
+			s << (n > 0 ? "," : "") << (rad2deg ? (floatValue(n, dstIsBigEndian) * (float)(180.0 / M_PI)) : floatValue(n, dstIsBigEndian));
+		return s.str();
+	}
+	const uint8_t* data; // pointer to binary data
+	size_t size;         // number of bytes
+	int elemSz;          // element size in byte
+	int elemType;        // element type, MsgpackKeyToInt_float32, MsgpackKeyToInt_uint16 or MsgpackKeyToInt_uint8
+	bool srcIsBigEndian; // endianess of binary data
+};
 
-		union UINT_2BYTE_UNION
-		{
-			uint8_t u8_bytes[2];
-			uint16_t u16_bytes;
-		};
-
-		assert(msgpack.data && msgpack.elemSz && msgpack.elemTypes && msgpack.endian
-			&& msgpack.elemSz->is_number()
-			&& msgpack.data->binary_items().size() > 0
-			&& ((msgpack.data->binary_items().size()) % (msgpack.elemSz->int_value())) == 0);
-		assert((msgpack.elemSz->int_value() == 4 && msgpack.elemTypes->int_value() == MsgpackKeyToInt_float32)
-			|| (msgpack.elemSz->int_value() == 2 && msgpack.elemTypes->int_value() == MsgpackKeyToInt_uint16));
-
-		bool srcIsBigEndian = (msgpack.endian->string_value() == "big");
-		const msgpack11::MsgPack::binary& binary_items = msgpack.data->binary_items();
-		int elem_size = msgpack.elemSz->int_value();
-		int binary_size = (int)(binary_items.size());
-		m_data.reserve(binary_size / elem_size);
-		if (msgpack.elemSz->int_value() == 4 && msgpack.elemTypes->int_value() == MsgpackKeyToInt_float32) // Decode 4 bytes as float
+/*
+ * @brief class MsgPackSegmentGroup references the data of one group (i.e. one layer) of a scan segment.
+ */
+class MsgPackSegmentGroup
+{
+public:
+	MsgPackSegmentGroup() : complete(false), echoCount(0), timestampStart(0), timestampStop(0) {}
+	bool complete;                                   // true, if EchoCount, ChannelPhi, ChannelTheta, DistValues, RssiValues, TimestampStart and TimestampStop found
+	int echoCount;                                   // EchoCount
+	uint32_t timestampStart;                         // TimestampStart in sensor ticks
+	uint32_t timestampStop;                          // TimestampStop in sensor ticks
+	MsgPackBinaryView channelPhi;                    // ChannelPhi (elevation, 1 element)
+	MsgPackBinaryView channelTheta;                  // ChannelTheta (azimuth, 1 element per point)
+	std::vector<MsgPackBinaryView> distValues;       // DistValues for each echo
+	std::vector<MsgPackBinaryView> rssiValues;       // RssiValues for each echo
+	std::vector<MsgPackBinaryView> propertyValues;   // optional PropertiesValues for each echo
+};
+
+namespace sick_scansegment_xd
+{
+	/*
+	 * @brief class MsgPackSegmentIndex references all data of a scan segment required for conversion into ScanSegmentParserOutput.
+	 * It's filled either by MsgPackStreamDecoder directly from the msgpack buffer, or from msgpack11 objects (fallback).
+	 */
+	class MsgPackSegmentIndex
+	{
+	public:
+		MsgPackSegmentIndex() : timestampTransmitValid(false), timestampTransmit(0), segmentCounter(0), telegramCounterValid(false), telegramCounter(0) {}
+		bool timestampTransmitValid;              // true, if TimestampTransmit is a number
+		uint32_t timestampTransmit;               // TimestampTransmit in sensor ticks
+		int32_t segmentCounter;                   // SegmentCounter
+		bool telegramCounterValid;                // true, if TelegramCounter available
+		int32_t telegramCounter;                  // TelegramCounter
+		std::vector<MsgPackSegmentGroup> groups;  // SegmentData
+	};
+}
+
+/*
+ * @brief class MsgPackStreamDecoder walks through binary msgpack data in place and decodes a scan segment into a
+ * MsgPackSegmentIndex without copying the msgpack data and without building msgpack11 objects. All binary data
+ * (ChannelPhi, ChannelTheta, DistValues, RssiValues and PropertiesValues) are referenced by MsgPackBinaryView.
+ * Decode() returns false on unexpected msgpack data, in this case MsgPackParser falls back to msgpack11.
+ */
+class MsgPackStreamDecoder
+{
+public:
+	MsgPackStreamDecoder(const uint8_t* data, size_t size) : m_pos(data), m_end(data + size) {}
+
+	/** Decodes a scan segment, returns false on unexpected msgpack data */
+	bool Decode(sick_scansegment_xd::MsgPackSegmentIndex& index)
+	{
+		uint32_t root_size = 0, data_size = 0, group_count = 0;
+		int64_t key = 0, value = 0;
+		const uint8_t* segment_data = 0;
+		bool segment_counter_found = false, timestamp_transmit_found = false;
+		if (!readMapSize(root_size))
+			return false;
+		for (uint32_t root_idx = 0; root_idx < root_size; root_idx++)
 		{
-			FLOAT_4BYTE_UNION elem_buffer;
-			if (srcIsBigEndian == dstIsBigEndian) // src and dst have identical endianess: reinterprete 4 bytes as float
+			if (!readInt(key))
+				return false;
+			if (key != MsgpackKeyToInt_data)
 			{
-				for (int n = 0; n < binary_size; n += 4)
-				{
-					elem_buffer.u32_bytes = *((uint32_t*)(&binary_items[n]));
-					m_data.push_back(elem_buffer.value);
-				}
+				if (!skip())
+					return false;
+				continue;
 			}
-			else // src and dst have different endianess: reorder 4 bytes and interprete as float
+			if (!readMapSize(data_size))
+				return false;
+			for (uint32_t data_idx = 0; data_idx < data_size; data_idx++)
 			{
-				for (int n = 0; n < binary_size; n += 4)
+				if (!readInt(key))
+					return false;
+				switch (key)
 				{
-					elem_buffer.u8_bytes[3] = binary_items[n + 0];
-					elem_buffer.u8_bytes[2] = binary_items[n + 1];
-					elem_buffer.u8_bytes[1] = binary_items[n + 2];
-					elem_buffer.u8_bytes[0] = binary_items[n + 3];
-					m_data.push_back(elem_buffer.value);
+				case MsgpackKeyToInt_SegmentData: // SegmentData is decoded after TimestampTransmit, which can follow SegmentData
+					segment_data = m_pos;
+					if (!skip())
+						return false;
+					break;
+				case MsgpackKeyToInt_TimestampTransmit:
+					timestamp_transmit_found = true;
+					index.timestampTransmitValid = isNumber(peek());
+					if (index.timestampTransmitValid ? !readInt(value) : !skip())
+						return false;
+					index.timestampTransmit = (uint32_t)value;
+					break;
+				case MsgpackKeyToInt_SegmentCounter:
+					if (!readInt(value))
+						return false;
+					index.segmentCounter = (int32_t)value;
+					segment_counter_found = true;
+					break;
+				case MsgpackKeyToInt_TelegramCounter:
+					if (!readInt(value))
+						return false;
+					index.telegramCounter = (int32_t)value;
+					index.telegramCounterValid = true;
+					break;
+				default:
+					if (!skip())
+						return false;
+					break;
 				}
 			}
 		}
-		else if (msgpack.elemSz->int_value() == 2 && msgpack.elemTypes->int_value() == MsgpackKeyToInt_uint16) // Decode 2 bytes as uint16 and convert to float
+		if (!segment_data || !timestamp_transmit_found || !segment_counter_found)
+			return false;
+		m_pos = segment_data;
+		if (!readArraySize(group_count))
+			return false;
+		index.groups.reserve(group_count);
+		for (uint32_t group_idx = 0; group_idx < group_count; group_idx++)
 		{
-			UINT_2BYTE_UNION elem_buffer;
-			if (srcIsBigEndian == dstIsBigEndian) // src and dst have identical endianess: reinterprete 2 bytes as uint16 and convert to float
+			if (!decodeGroup(index.groups))
+				return false;
+		}
+		return true;
+	}
+
+protected:
+
+	/** Decodes a group of SegmentData and appends it to groups (groups without "data" are skipped) */
+	bool decodeGroup(std::vector<MsgPackSegmentGroup>& groups)
+	{
+		uint32_t group_size = 0, data_size = 0;
+		int64_t key = 0, value = 0;
+		if (!readMapSize(group_size))
+			return false;
+		for (uint32_t group_idx = 0; group_idx < group_size; group_idx++)
+		{
+			if (!readInt(key))
+				return false;
+			if (key != MsgpackKeyToInt_data)
 			{
-				for (int n = 0; n < binary_size; n += 2)
-				{
-					elem_buffer.u16_bytes = *((uint16_t*)(&binary_items[n]));
-					m_data.push_back((float)elem_buffer.u16_bytes);
-				}
+				if (!skip())
+					return false;
+				continue;
 			}
-			else // src and dst have different endianess: reorder 2 bytes (uint16) and convert to float
+			if (!readMapSize(data_size))
+				return false;
+			groups.push_back(MsgPackSegmentGroup());
+			MsgPackSegmentGroup& group = groups.back();
+			uint32_t entries_found = 0; // bit mask of required entries
+			for (uint32_t data_idx = 0; data_idx < data_size; data_idx++)
 			{
-				for (int n = 0; n < binary_size; n += 2)
+				bool success = readInt(key);
+				switch (key)
 				{
-					elem_buffer.u8_bytes[1] = binary_items[n + 0];
-					elem_buffer.u8_bytes[0] = binary_items[n + 1];
-					m_data.push_back((float)elem_buffer.u16_bytes);
+				case MsgpackKeyToInt_EchoCount:
+					success = success && readInt(value);
+					group.echoCount = (int32_t)value;
+					entries_found |= 0x01;
+					break;
+				case MsgpackKeyToInt_ChannelPhi:
+					success = success && decodeElement(group.channelPhi);
+					entries_found |= 0x02;
+					break;
+				case MsgpackKeyToInt_ChannelTheta:
+					success = success && decodeElement(group.channelTheta);
+					entries_found |= 0x04;
+					break;
+				case MsgpackKeyToInt_DistValues:
+					success = success && decodeElementArray(group.distValues);
+					entries_found |= 0x08;
+					break;
+				case MsgpackKeyToInt_RssiValues:
+					success = success && decodeElementArray(group.rssiValues);
+					entries_found |= 0x10;
+					break;
+				case MsgpackKeyToInt_TimestampStart:
+					success = success && readInt(value);
+					group.timestampStart = (uint32_t)value;
+					entries_found |= 0x20;
+					break;
+				case MsgpackKeyToInt_TimestampStop:
+					success = success && readInt(value);
+					group.timestampStop = (uint32_t)value;
+					entries_found |= 0x40;
+					break;
+				case MsgpackKeyToInt_PropertiesValues:
+					success = success && decodeElementArray(group.propertyValues);
+					break;
+				default:
+					success = success && skip();
+					break;
 				}
+				if (!success)
+					return false;
 			}
+			group.complete = (entries_found == 0x7F);
 		}
-		else
+		return true;
+	}
+
+	/** Decodes an array of msgpack elements (DistValues, RssiValues or PropertiesValues) */
+	bool decodeElementArray(std::vector<MsgPackBinaryView>& elements)
+	{
+		uint32_t array_size = 0;
+		if (!readArraySize(array_size))
+			return false;
+		elements.resize(array_size);
+		for (uint32_t n = 0; n < array_size; n++)
 		{
-			std::cerr << "## ERROR MsgPackToFloat32VectorConverter: invalid or unsupported elemSz or elemTypes:" << std::endl
-				<< "    msgpack.data = " << (msgpack.data ? printMsgPack(*msgpack.data) : "NULL") << std::endl
-				<< "    msgpack.elemSz = " << (msgpack.elemSz ? printMsgPack(*msgpack.elemSz) : "NULL") << std::endl
-				<< "    msgpack.elemTypes = " << (msgpack.elemTypes ? printMsgPack(*msgpack.elemTypes) : "NULL") << std::endl
-				<< "    msgpack.endian = " << (msgpack.endian ? printMsgPack(*msgpack.endian) : "NULL") << std::endl;
+			if (!decodeElement(elements[n]))
+				return false;
 		}
+		return true;
 	}
-	std::string print(void)
+
+	/** Decodes data, elemSz, elemTypes and endian of a msgpack element */
+	bool decodeElement(MsgPackBinaryView& element)
 	{
-		std::stringstream s;
-		if (!m_data.empty())
+		uint32_t element_size = 0, array_size = 0;
+		int64_t key = 0, value = 0;
+		element = MsgPackBinaryView();
+		if (!readMapSize(element_size))
+			return false;
+		for (uint32_t element_idx = 0; element_idx < element_size; element_idx++)
 		{
-			s << m_data[0];
-			for(int n = 1; n < m_data.size(); n++)
-				s << "," << m_data[n];
+			bool success = readInt(key);
+			switch (key)
+			{
+			case MsgpackKeyToInt_data:
+				success = success && readBinary(element.data, element.size);
+				break;
+			case MsgpackKeyToInt_elemSz:
+				success = success && readInt(value);
+				element.elemSz = (int)value;
+				break;
+			case MsgpackKeyToInt_elemTypes: // elemTypes is either a single type or an array of types
+				if (isArray(peek()))
+				{
+					success = success && readArraySize(array_size) && array_size > 0 && readInt(value);
+					for (uint32_t n = 1; success && n < array_size; n++)
+						success = skip();
+				}
+				else
+				{
+					success = success && readInt(value);
+				}
+				element.elemType = (int)value;
+				break;
+			case MsgpackKeyToInt_endian: // endian is either a string ("little" or "big") or a tokenized key (MsgpackKeyToInt_little)
+				if (isString(peek()))
+				{
+					const uint8_t* str = 0;
+					size_t len = 0;
+					success = success && readString(str, len);
+					element.srcIsBigEndian = (success && len == 3 && memcmp(str, "big", 3) == 0);
+				}
+				else
+				{
+					success = success && skip();
+				}
+				break;
+			default:
+				success = success && skip();
+				break;
+			}
+			if (!success)
+				return false;
 		}
-		return s.str();
+		return true;
 	}
-    float rad2deg(float angle) const { return angle * (float)(180.0 / M_PI); }
-	std::string printRad2Deg(void)
+
+	/** Returns the type of the next msgpack object without reading it */
+	uint8_t peek(void) const { return (m_pos < m_end) ? (*m_pos) : 0xc1; }
+
+	static bool isNumber(uint8_t type) { return type <= 0x7f || type >= 0xe0 || (type >= 0xca && type <= 0xd3); }
+	static bool isString(uint8_t type) { return (type & 0xE0) == 0xA0 || (type >= 0xd9 && type <= 0xdb); }
+	static bool isArray(uint8_t type) { return (type & 0xF0) == 0x90 || type == 0xdc || type == 0xdd; }
+
+	bool readByte(uint8_t& value)
 	{
-		std::stringstream s;
-		if (!m_data.empty())
+		if (m_pos >= m_end)
+			return false;
+		value = *m_pos++;
+		return true;
+	}
+
+	/** Reads nbytes in big endian order (msgpack always encodes big endian) */
+	bool readBigEndian(size_t nbytes, uint64_t& value)
+	{
+		if ((size_t)(m_end - m_pos) < nbytes)
+			return false;
+		value = 0;
+		for (size_t n = 0; n < nbytes; n++)
+			value = (value << 8) | (*m_pos++);
+		return true;
+	}
+
+	bool readMapSize(uint32_t& size)
+	{
+		uint8_t type = 0;
+		uint64_t value = 0;
+		if (!readByte(type))
+			return false;
+		if ((type & 0xF0) == 0x80) // fixmap
+			value = (type & 0x0F);
+		else if (!((type == 0xde && readBigEndian(2, value)) || (type == 0xdf && readBigEndian(4, value)))) // map16, map32
+			return false;
+		size = (uint32_t)value;
+		return true;
+	}
+
+	bool readArraySize(uint32_t& size)
+	{
+		uint8_t type = 0;
+		uint64_t value = 0;
+		if (!readByte(type))
+			return false;
+		if ((type & 0xF0) == 0x90) // fixarray
+			value = (type & 0x0F);
+		else if (!((type == 0xdc && readBigEndian(2, value)) || (type == 0xdd && readBigEndian(4, value)))) // array16, array32
+			return false;
+		size = (uint32_t)value;
+		return true;
+	}
+
+	/** Reads an integer or a float number and returns its integer value */
+	bool readInt(int64_t& value)
+	{
+		uint8_t type = 0;
+		uint64_t u64 = 0;
+		if (!readByte(type))
+			return false;
+		if (type <= 0x7f) // positive fixint
 		{
-			s << rad2deg(m_data[0]);
-			for(int n = 1; n < m_data.size(); n++)
-				s << "," << rad2deg(m_data[n]);
+			value = type;
+			return true;
+		}
+		if (type >= 0xe0) // negative fixint
+		{
+			value = (int8_t)type;
+			return true;
+		}
+		switch (type)
+		{
+		case 0xcc: if (!readBigEndian(1, u64)) return false; value = (int64_t)u64; return true; // uint8
+		case 0xcd: if (!readBigEndian(2, u64)) return false; value = (int64_t)u64; return true; // uint16
+		case 0xce: if (!readBigEndian(4, u64)) return false; value = (int64_t)u64; return true; // uint32
+		case 0xcf: if (!readBigEndian(8, u64)) return false; value = (int64_t)u64; return true; // uint64
+		case 0xd0: if (!readBigEndian(1, u64)) return false; value = (int8_t)u64; return true;  // int8
+		case 0xd1: if (!readBigEndian(2, u64)) return false; value = (int16_t)u64; return true; // int16
+		case 0xd2: if (!readBigEndian(4, u64)) return false; value = (int32_t)u64; return true; // int32
+		case 0xd3: if (!readBigEndian(8, u64)) return false; value = (int64_t)u64; return true; // int64
+		case 0xca: // float32
+		{
+			if (!readBigEndian(4, u64)) return false;
+			uint32_t u32 = (uint32_t)u64;
+			float f32 = 0;
+			memcpy(&f32, &u32, 4);
+			value = (int64_t)f32;
+			return true;
+		}
+		case 0xcb: // float64
+		{
+			if (!readBigEndian(8, u64)) return false;
+			double f64 = 0;
+			memcpy(&f64, &u64, 8);
+			value = (int64_t)f64;
+			return true;
+		}
+		default:
+			return false;
 		}
-		return s.str();
 	}
-	std::vector<float>& data(void)
+
+	/** Reads binary data (bin8, bin16 or bin32) and returns a pointer to the data in the msgpack buffer */
+	bool readBinary(const uint8_t*& data, size_t& size)
 	{
-		return m_data;
+		uint8_t type = 0;
+		uint64_t len = 0;
+		if (!readByte(type))
+			return false;
+		if (!((type == 0xc4 && readBigEndian(1, len)) || (type == 0xc5 && readBigEndian(2, len)) || (type == 0xc6 && readBigEndian(4, len))))
+			return false;
+		if ((uint64_t)(m_end - m_pos) < len)
+			return false;
+		data = m_pos;
+		size = (size_t)len;
+		m_pos += len;
+		return true;
 	}
-protected:
-	std::vector<float> m_data;
+
+	/** Reads a string (fixstr, str8, str16 or str32) and returns a pointer to the characters in the msgpack buffer */
+	bool readString(const uint8_t*& str, size_t& size)
+	{
+		uint8_t type = 0;
+		uint64_t len = 0;
+		if (!readByte(type))
+			return false;
+		if ((type & 0xE0) == 0xA0) // fixstr
+			len = (type & 0x1F);
+		else if (!((type == 0xd9 && readBigEndian(1, len)) || (type == 0xda && readBigEndian(2, len)) || (type == 0xdb && readBigEndian(4, len))))
+			return false;
+		if ((uint64_t)(m_end - m_pos) < len)
+			return false;
+		str = m_pos;
+		size = (size_t)len;
+		m_pos += len;
+		return true;
+	}
+
+	/** Skips the next msgpack object incl. all nested objects */
+	bool skip(void)
+	{
+		uint64_t pending = 1; // number of msgpack objects still to skip
+		while (pending > 0)
+		{
+			uint8_t type = 0;
+			uint64_t len = 0; // number of bytes to skip
+			if (!readByte(type))
+				return false;
+			pending--;
+			if (type <= 0x7f || type >= 0xe0 || type == 0xc0 || type == 0xc2 || type == 0xc3) // fixint, nil, bool
+				len = 0;
+			else if ((type & 0xF0) == 0x80) // fixmap
+				pending += 2 * (type & 0x0F);
+			else if ((type & 0xF0) == 0x90) // fixarray
+				pending += (type & 0x0F);
+			else if ((type & 0xE0) == 0xA0) // fixstr
+				len = (type & 0x1F);
+			else
+			{
+				switch (type)
+				{
+				case 0xc4: case 0xd9: if (!readBigEndian(1, len)) return false; break; // bin8, str8
+				case 0xc5: case 0xda: if (!readBigEndian(2, len)) return false; break; // bin16, str16
+				case 0xc6: case 0xdb: if (!readBigEndian(4, len)) return false; break; // bin32, str32
+				case 0xc7: if (!readBigEndian(1, len)) return false; len += 1; break;  // ext8 incl. type
+				case 0xc8: if (!readBigEndian(2, len)) return false; len += 1; break;  // ext16 incl. type
+				case 0xc9: if (!readBigEndian(4, len)) return false; len += 1; break;  // ext32 incl. type
+				case 0xcc: case 0xd0: len = 1; break; // uint8, int8
+				case 0xcd: case 0xd1: len = 2; break; // uint16, int16
+				case 0xca: case 0xce: case 0xd2: len = 4; break; // float32, uint32, int32
+				case 0xcb: case 0xcf: case 0xd3: len = 8; break; // float64, uint64, int64
+				case 0xd4: len = 2; break;  // fixext1 incl. type
+				case 0xd5: len = 3; break;  // fixext2 incl. type
+				case 0xd6: len = 5; break;  // fixext4 incl. type
+				case 0xd7: len = 9; break;  // fixext8 incl. type
+				case 0xd8: len = 17; break; // fixext16 incl. type
+				case 0xdc: if (!readBigEndian(2, len)) return false; pending += len; len = 0; break;     // array16
+				case 0xdd: if (!readBigEndian(4, len)) return false; pending += len; len = 0; break;     // array32
+				case 0xde: if (!readBigEndian(2, len)) return false; pending += 2 * len; len = 0; break; // map16
+				case 0xdf: if (!readBigEndian(4, len)) return false; pending += 2 * len; len = 0; break; // map32
+				default: return false; // 0xc1: never used
+				}
+			}
+			if ((uint64_t)(m_end - m_pos) < len)
+				return false;
+			m_pos += len;
+		}
+		return true;
+	}
+
+	const uint8_t* m_pos; // current read position in msgpack buffer
+	const uint8_t* m_end; // end of msgpack buffer
 };
 
 /*
@@ -467,6 +887,9 @@ std::string sick_scansegment_xd::MsgPackParser::MsgpackToHexDump(const std::vect
  * sick_scansegment_xd::MsgPackParser::Parse(msgpack_data, msgpack_output);
  * sick_scansegment_xd::MsgPackParser::WriteCSV({ msgpack_output }, "polarscan_testdata_000.csv")
  *
+ * Note: msgpack_data are decoded in place by MsgPackStreamDecoder. If msgpack_data can not be decoded by MsgPackStreamDecoder,
+ * msgpack11 is used as fallback.
+ *
  * @param[in+out] msgpack_ifstream the binary input stream delivering the binary msgpack data
  * @param[in] msgpack_timestamp receive timestamp of msgpack_data
  * @param[in] add_transform_xyz_rpy Apply an additional transform to the cartesian pointcloud, default: "0,0,0,0,0,0" (i.e. no transform)
@@ -478,7 +901,7 @@ std::string sick_scansegment_xd::MsgPackParser::MsgpackToHexDump(const std::vect
  * @param[in] use_software_pll true (default): result timestamp from sensor ticks by software pll, false: result timestamp from msg receiving
  * @param[in] verbose true: enable debug output, false: quiet mode
  */
-bool sick_scansegment_xd::MsgPackParser::Parse(const std::vector<uint8_t>& msgpack_data, fifo_timestamp msgpack_timestamp, 
+bool sick_scansegment_xd::MsgPackParser::Parse(const std::vector<uint8_t>& msgpack_data, fifo_timestamp msgpack_timestamp,
     sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy, ScanSegmentParserOutput& result,
     sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, const sick_scansegment_xd::MsgPackValidator& msgpack_validator,
 	bool msgpack_validator_enabled, bool discard_msgpacks_not_validated,
@@ -493,6 +916,15 @@ bool sick_scansegment_xd::MsgPackParser::Parse(const std::vector<uint8_t>& msgpa
 	//     msgpack_dumpfile << msgpack_hexdump;
 	// std::string msgpack_hexdump = MsgpackToHexDump(msgpack_data, true);
 	// std::cout << std::endl << "MsgPack hexdump: " << std::endl << msgpack_hexdump << std::endl << std::endl;
+	sick_scansegment_xd::MsgPackSegmentIndex msgpack_index;
+	MsgPackStreamDecoder msgpack_decoder(msgpack_data.data(), msgpack_data.size());
+	if (msgpack_decoder.Decode(msgpack_index))
+	{
+		return ConvertSegment(msgpack_index, msgpack_timestamp, add_transform_xyz_rpy, result, msgpack_validator_data_collector, msgpack_validator, msgpack_validator_enabled, discard_msgpacks_not_validated, use_software_pll, verbose);
+	}
+	// Fallback: unpack with msgpack11
+	if (verbose)
+		ROS_INFO_STREAM("MsgPackParser::Parse(): MsgPackStreamDecoder failed, msgpack data parsed by msgpack11");
 	std::string msgpack_string((char*)msgpack_data.data(), msgpack_data.size());
 	std::istringstream msgpack_istream(msgpack_string);
 	return Parse(msgpack_istream, msgpack_timestamp, add_transform_xyz_rpy, result, msgpack_validator_data_collector, msgpack_validator, msgpack_validator_enabled, discard_msgpacks_not_validated, use_software_pll, verbose);
@@ -511,13 +943,13 @@ bool sick_scansegment_xd::MsgPackParser::Parse(const std::vector<uint8_t>& msgpa
  *
  * for (int groupIdx = 0; groupIdx < msgpack_output.scandata.size(); groupIdx++)
  * {
- * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].size(); echoIdx++)
+ * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].scanlines.size(); echoIdx++)
  * 	 {
- * 	   std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = msgpack_output.scandata[groupIdx][echoIdx];
+ * 	   const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = msgpack_output.scandata[groupIdx].scanlines[echoIdx];
  * 	   std::cout << (groupIdx + 1) << ". group, " << (echoIdx + 1) << ". echo: ";
- * 	   for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+ * 	   for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
  * 	   {
- * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
+ * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = msgpack_output.points.get(scanline.start + pointIdx);
  * 		  std::cout << (pointIdx > 0 ? "," : "") << "(" << point.x << "," << point.y << "," << point.z << "," << point.i << ")";
  * 	   }
  * 	   std::cout << std::endl;
@@ -535,21 +967,13 @@ bool sick_scansegment_xd::MsgPackParser::Parse(const std::vector<uint8_t>& msgpa
  * @param[in] use_software_pll true (default): result timestamp from sensor ticks by software pll, false: result timestamp from msg receiving
  * @param[in] verbose true: enable debug output, false: quiet mode
  */
-bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fifo_timestamp msgpack_timestamp, 
+bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fifo_timestamp msgpack_timestamp,
 	sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy, ScanSegmentParserOutput& result,
-    sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, 
+    sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector,
 	const sick_scansegment_xd::MsgPackValidator& msgpack_validator,
 	bool msgpack_validator_enabled, bool discard_msgpacks_not_validated,
 	bool use_software_pll, bool verbose)
 {
-	int64_t systemtime_nanoseconds = msgpack_timestamp.time_since_epoch().count();
-	uint32_t systemtime_sec = (uint32_t)(systemtime_nanoseconds / 1000000000);  // seconds part of timestamp
-	uint32_t systemtime_nsec = (uint32_t)(systemtime_nanoseconds % 1000000000); // nanoseconds part of timestamp
-	result.timestamp = sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec); // Timestamp(std::chrono::system_clock::now()); // default timestamp: msgpack receive time, overwritten by timestamp from msgpack data
-	result.timestamp_sec = systemtime_sec;
-	result.timestamp_nsec = systemtime_nsec;
-	int32_t segment_idx = messageCount++; // default value: counter for each message (each scandata decoded from msgpack data), overwritten by msgpack data
-	int32_t telegram_cnt = telegramCount++; // default value: counter for each message (each scandata decoded from msgpack data), overwritten by msgpack data
 	msgpack11::MsgPack msg_unpacked;
 	try
 	{
@@ -569,15 +993,12 @@ bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fi
 		return false;
 	}
 
-	// Get endianess of the system (destination target)
-	bool dstIsBigEndian = sick_scansegment_xd::Config::SystemIsBigEndian();
-
 	// Parse the unpacked msgpack data, see sick_scansegment_xd/python/polarscan_reader_test/polarscan_receiver_test.py for multiScan136 message format
     // and https://github.com/SICKAG/msgpack11/blob/master/msgpack11.hpp or https://github.com/SICKAG/msgpack11/blob/master/example.cpp
 	// for details about decoding and paring MsgPack data.
+	sick_scansegment_xd::MsgPackSegmentIndex msgpack_index;
 	try
 	{
-		sick_scansegment_xd::MsgPackValidatorData msgpack_validator_data;
 		// std::cout << "root_object_items: " << printMsgPack(msg_unpacked.object_items()) << std::endl;
 		msgpack11::MsgPack::object::const_iterator root_data_iter = msg_unpacked.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_data]);
 		if (root_data_iter == msg_unpacked.object_items().end())
@@ -595,47 +1016,25 @@ bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fi
 		}
 		const msgpack11::MsgPack& group_data = group_data_iter->second;
 		const msgpack11::MsgPack& timestamp_data = timestamp_data_iter->second;
-		if (use_software_pll && timestamp_data.is_number())
-		{
-			// result.timestamp = std::to_string(timestamp_data.int64_value());
-			// Calculate system time from sensor ticks using SoftwarePLL
-			// result.timestamp = std::to_string(timestamp_data.int64_value());
-			SoftwarePLL& software_pll = SoftwarePLL::instance();
-			uint32_t curtick = timestamp_data.int32_value();
-			software_pll.updatePLL(systemtime_sec, systemtime_nsec, curtick);
-			if (software_pll.IsInitialized())
-			{
-				uint32_t pll_sec = 0, pll_nsec = 0;
-				software_pll.getCorrectedTimeStamp(pll_sec, pll_nsec, curtick);
-				result.timestamp = sick_scansegment_xd::Timestamp(pll_sec, pll_nsec);
-				result.timestamp_sec = pll_sec;
-				result.timestamp_nsec = pll_nsec;
-				if (verbose)
-					ROS_INFO_STREAM("MsgPackParser::Parse(): sensor_ticks=" << curtick << ", system_time=" << sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec) << " sec, timestamp=" << result.timestamp << " sec");
-			}
-			else if (verbose)
-				ROS_INFO_STREAM("MsgPackParser::Parse(): sensor_ticks=" << curtick << ", system_time=" << sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec) << " sec, SoftwarePLL not yet initialized");
-		}
+		msgpack_index.timestampTransmitValid = timestamp_data.is_number();
+		msgpack_index.timestampTransmit = timestamp_data.int32_value();
 		msgpack11::MsgPack::object::const_iterator segment_counter_iter = root_data.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_SegmentCounter]);
 		if (segment_counter_iter == root_data.object_items().end())
 		{
 			ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): \"SegmentCounter\" not found");
 			return false;
 		}
-		const msgpack11::MsgPack& segment_idx_data = segment_counter_iter->second;
-		segment_idx = segment_idx_data.int32_value();
-
+		msgpack_index.segmentCounter = segment_counter_iter->second.int32_value();
 		msgpack11::MsgPack::object::const_iterator telegram_counter_iter = root_data.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_TelegramCounter]);
 		if (telegram_counter_iter != root_data.object_items().end())
 		{
-			const msgpack11::MsgPack& telegram_cnt_data = telegram_counter_iter->second;
-			telegramCount = telegram_cnt_data.int32_value();
-			telegram_cnt = telegramCount;
+			msgpack_index.telegramCounterValid = true;
+			msgpack_index.telegramCounter = telegram_counter_iter->second.int32_value();
 		}
 
 		// std::cout << "root_data: " << printMsgPack(root_data) << std::endl << "root_data.array_items().size(): " << root_data.array_items().size() << ", root_data.object_items().size(): " << root_data.object_items().size() << std::endl;
 		// std::cout << "group_data.array_items().size(): " << group_data.array_items().size() << ", group_data.object_items().size(): " << group_data.object_items().size() << std::endl;
-		result.scandata.reserve(group_data.array_items().size());
+		msgpack_index.groups.reserve(group_data.array_items().size());
 		for (int groupIdx = 0; groupIdx < group_data.array_items().size(); groupIdx++)
 		{
 			// Get ChannelPhi, ChannelTheta, DistValues and RssiValues for each group
@@ -646,6 +1045,8 @@ bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fi
 			{
 				continue; // ok if missing
 			}
+			msgpack_index.groups.push_back(MsgPackSegmentGroup());
+			MsgPackSegmentGroup& group = msgpack_index.groups.back();
 			msgpack11::MsgPack::object::const_iterator echoCountMsg = dataMsg->second.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_EchoCount]);
 			msgpack11::MsgPack::object::const_iterator channelPhiMsg = dataMsg->second.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_ChannelPhi]);
 			msgpack11::MsgPack::object::const_iterator channelThetaMsg = dataMsg->second.object_items().find(s_msgpack_keys.values[MsgpackKeyToInt_ChannelTheta]);
@@ -659,176 +1060,213 @@ bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fi
 				distValuesMsg == dataMsg->second.object_items().end() || rssiValuesMsg == dataMsg->second.object_items().end() ||
 				timestampStartMsg == dataMsg->second.object_items().end() || timestampStopMsg == dataMsg->second.object_items().end())
 			{
-				ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): Entries in data segment missing");
-				continue;
-			}
-			uint32_t u32TimestampStart = timestampStartMsg->second.uint32_value();
-			uint32_t u32TimestampStop = timestampStopMsg->second.uint32_value();
-			uint32_t u32TimestampStart_sec = 0, u32TimestampStart_nsec = 0;
-			uint32_t u32TimestampStop_sec = 0, u32TimestampStop_nsec = 0;
-			if (use_software_pll && SoftwarePLL::instance().IsInitialized())
-			{
-				SoftwarePLL& software_pll = SoftwarePLL::instance();
-				software_pll.getCorrectedTimeStamp(u32TimestampStart_sec, u32TimestampStart_nsec, u32TimestampStart);
-				software_pll.getCorrectedTimeStamp(u32TimestampStop_sec, u32TimestampStop_nsec, u32TimestampStop);
+				continue; // group.complete == false, entries in data segment missing
 			}
+			group.complete = true;
+			group.echoCount = echoCountMsg->second.int32_value();
+			group.timestampStart = timestampStartMsg->second.uint32_value();
+			group.timestampStop = timestampStopMsg->second.uint32_value();
 
 			// Get data, elemSz, elemTypes and endian for each MsgPack object
-			MsgPackElement channelPhiMsgElement(channelPhiMsg->second.object_items());
-			MsgPackElement channelThetaMsgElement(channelThetaMsg->second.object_items());
-			std::vector<MsgPackElement> distValuesDataMsg(distValuesMsg->second.array_items().size());
-			std::vector<MsgPackElement> rssiValuesDataMsg(rssiValuesMsg->second.array_items().size());
+			group.channelPhi = MsgPackBinaryView(MsgPackElement(channelPhiMsg->second.object_items()));
+			group.channelTheta = MsgPackBinaryView(MsgPackElement(channelThetaMsg->second.object_items()));
+			group.distValues.resize(distValuesMsg->second.array_items().size());
+			group.rssiValues.resize(rssiValuesMsg->second.array_items().size());
 			for (int n = 0; n < distValuesMsg->second.array_items().size(); n++)
-				distValuesDataMsg[n] = MsgPackElement(distValuesMsg->second.array_items()[n].object_items());
+				group.distValues[n] = MsgPackBinaryView(MsgPackElement(distValuesMsg->second.array_items()[n].object_items()));
 			for (int n = 0; n < rssiValuesMsg->second.array_items().size(); n++)
-				rssiValuesDataMsg[n] = MsgPackElement(rssiValuesMsg->second.array_items()[n].object_items());
-      
-			// Get optional property values
-      std::vector<std::vector<uint8_t>> propertyValues; // uint8_t property = propertyValues[echoIdx][pointIdx]
-			if (propertiesMsg != dataMsg->second.object_items().end()) // property values available
+				group.rssiValues[n] = MsgPackBinaryView(MsgPackElement(rssiValuesMsg->second.array_items()[n].object_items()));
+			if (propertiesMsg != dataMsg->second.object_items().end()) // optional property values available
 			{
-				propertyValues = std::vector<std::vector<uint8_t>>(propertiesMsg->second.array_items().size());
+				group.propertyValues.resize(propertiesMsg->second.array_items().size());
 				for (int n = 0; n < propertiesMsg->second.array_items().size(); n++)
-				{
-					const MsgPackElement& propertyMsgPackElement = MsgPackElement(propertiesMsg->second.array_items()[n].object_items());
-					propertyValues[n] = std::vector<uint8_t>(propertyMsgPackElement.data->binary_items().size(), 0);
-					if (propertyMsgPackElement.elemSz->int_value() == 1 && propertyMsgPackElement.elemTypes->int_value() == MsgpackKeyToInt_uint8 && propertyMsgPackElement.data->binary_items().size() > 0)
-					{
-						for(int m = 0; m < propertyValues[n].size(); m++)
-						{
-							propertyValues[n][m] = propertyMsgPackElement.data->binary_items()[m];
-						}
-					}
-					else
-					{
-						ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): invalid property array");
-					}
-				}
+					group.propertyValues[n] = MsgPackBinaryView(MsgPackElement(propertiesMsg->second.array_items()[n].object_items()));
+			}
+			if (!group.channelPhi.data || !group.channelTheta.data)
+			{
+				ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): invalid ChannelPhi " << printMsgPack(channelPhiMsg->second) << " or ChannelTheta " << printMsgPack(channelThetaMsg->second));
+			}
+		}
+	}
+	catch (const std::exception& exc)
+	{
+		ROS_ERROR_STREAM("## ERROR msgpack11::MsgPack::parse(): exception " << exc.what());
+		return false;
+	}
+	return ConvertSegment(msgpack_index, msgpack_timestamp, add_transform_xyz_rpy, result, msgpack_validator_data_collector, msgpack_validator, msgpack_validator_enabled, discard_msgpacks_not_validated, use_software_pll, verbose);
+}
+
+/*
+ * @brief converts a decoded scan segment to scanlines of type ScanSegmentParserOutput. The msgpack data referenced by
+ * msgpack_index must be valid while calling ConvertSegment.
+ */
+bool sick_scansegment_xd::MsgPackParser::ConvertSegment(const MsgPackSegmentIndex& msgpack_index, fifo_timestamp msgpack_timestamp,
+	sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy, ScanSegmentParserOutput& result,
+	sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector,
+	const sick_scansegment_xd::MsgPackValidator& msgpack_validator,
+	bool msgpack_validator_enabled, bool discard_msgpacks_not_validated,
+	bool use_software_pll, bool verbose)
+{
+	int64_t systemtime_nanoseconds = msgpack_timestamp.time_since_epoch().count();
+	uint32_t systemtime_sec = (uint32_t)(systemtime_nanoseconds / 1000000000);  // seconds part of timestamp
+	uint32_t systemtime_nsec = (uint32_t)(systemtime_nanoseconds % 1000000000); // nanoseconds part of timestamp
+	result.timestamp = sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec); // Timestamp(std::chrono::system_clock::now()); // default timestamp: msgpack receive time, overwritten by timestamp from msgpack data
+	result.timestamp_sec = systemtime_sec;
+	result.timestamp_nsec = systemtime_nsec;
+	int32_t segment_idx = messageCount++; // default value: counter for each message (each scandata decoded from msgpack data), overwritten by msgpack data
+	int32_t telegram_cnt = telegramCount++; // default value: counter for each message (each scandata decoded from msgpack data), overwritten by msgpack data
+
+	// Get endianess of the system (destination target)
+	bool dstIsBigEndian = sick_scansegment_xd::Config::SystemIsBigEndian();
+
+	try
+	{
+		// Scan points out of bounds are counted in msgpack_validator_data_collector, new points out of bounds fail the validation of this segment
+		if (msgpack_validator_enabled && !msgpack_validator_data_collector.initialized())
+			msgpack_validator.initValidatorData(msgpack_validator_data_collector); // allocates the validation counters once
+		size_t msgpack_validator_out_of_bounds_cnt = msgpack_validator_data_collector.getOutOfBoundsCount();
+		// Sensor ticks are converted to system time by the SoftwarePLL after parsing (ScanSegmentParserOutput::ApplySoftwarePLL)
+		result.sensorTicksValid = msgpack_index.timestampTransmitValid;
+		result.sensorTicks = msgpack_index.timestampTransmit;
+		result.scangroupTicksValid = true;
+		segment_idx = msgpack_index.segmentCounter;
+		if (msgpack_index.telegramCounterValid)
+		{
+			telegramCount = msgpack_index.telegramCounter;
+			telegram_cnt = msgpack_index.telegramCounter;
+		}
+
+		// Allocate the point arrays once for all groups and echos, points are written by index
+		size_t max_point_count = 0;
+		for (int groupIdx = 0; groupIdx < msgpack_index.groups.size(); groupIdx++)
+		{
+			const MsgPackSegmentGroup& group = msgpack_index.groups[groupIdx];
+			size_t group_echo_count = std::min((size_t)std::max(0, group.echoCount), std::min(group.distValues.size(), group.rssiValues.size()));
+			max_point_count += group_echo_count * group.channelTheta.numElems();
+		}
+		result.scandata.clear();
+		result.scandata.reserve(msgpack_index.groups.size());
+		result.points.resize(max_point_count);
+		size_t point_cnt = 0;
+		std::vector<float> azimuth_values, cos_azimuth, sin_azimuth; // azimuth lookup tables, reused for all groups
+		for (int groupIdx = 0; groupIdx < msgpack_index.groups.size(); groupIdx++)
+		{
+			const MsgPackSegmentGroup& group = msgpack_index.groups[groupIdx];
+			if (!group.complete)
+			{
+				ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): Entries in data segment missing");
+				continue;
+			}
+			uint32_t u32TimestampStart = group.timestampStart;
+			uint32_t u32TimestampStop = group.timestampStop;
+
+			// ChannelPhi, ChannelTheta, DistValues and RssiValues are decoded to float values, if they have type float32 or uint16
+			const MsgPackBinaryView& channelPhi = group.channelPhi;
+			const MsgPackBinaryView& channelTheta = group.channelTheta;
+			const std::vector<MsgPackBinaryView>& distValues = group.distValues;
+			const std::vector<MsgPackBinaryView>& rssiValues = group.rssiValues;
+			const std::vector<MsgPackBinaryView>& propertyValues = group.propertyValues; // uint8_t property = propertyValues[echoIdx].data[pointIdx]
+			int iEchoCount = group.echoCount;
+			iEchoCount = std::min((int)distValues.size(), iEchoCount);
+			iEchoCount = std::min((int)rssiValues.size(), iEchoCount);
+			int iPointCount = (int)channelTheta.numElems();
+			bool valid_elements = channelPhi.isFloat32OrUint16() && channelTheta.isFloat32OrUint16();
+			for (int echoIdx = 0; valid_elements && echoIdx < iEchoCount; echoIdx++)
+			{
+				valid_elements = distValues[echoIdx].isFloat32OrUint16() && rssiValues[echoIdx].isFloat32OrUint16()
+					&& (int)distValues[echoIdx].numElems() == iPointCount && (int)rssiValues[echoIdx].numElems() == iPointCount;
+			}
+			if (!valid_elements)
+			{
+				ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): invalid or unsupported elemSz or elemTypes, or invalid number of elements in ChannelPhi, ChannelTheta, DistValues or RssiValues");
+				continue;
 			}
 
-			// Convert all data to float values
-			int iEchoCount = echoCountMsg->second.int32_value();
-			MsgPackToFloat32VectorConverter channelPhi(channelPhiMsgElement, dstIsBigEndian);
-			MsgPackToFloat32VectorConverter channelTheta(channelThetaMsgElement, dstIsBigEndian);
-			std::vector<MsgPackToFloat32VectorConverter> distValues(distValuesDataMsg.size());
-			std::vector<MsgPackToFloat32VectorConverter> rssiValues(rssiValuesDataMsg.size());
-			for (int n = 0; n < distValuesDataMsg.size(); n++)
-				distValues[n] = MsgPackToFloat32VectorConverter(distValuesDataMsg[n], dstIsBigEndian);
-			for (int n = 0; n < rssiValuesDataMsg.size(); n++)
-				rssiValues[n] = MsgPackToFloat32VectorConverter(rssiValuesDataMsg[n], dstIsBigEndian);
-			assert(channelPhi.data().size() == 1 && channelTheta.data().size() > 0 && distValues.size() == iEchoCount && rssiValues.size() == iEchoCount);
-
-      // Check optional propertyValues: if available, we expect as many properties as we have points
-			for (int n = 0; n < propertyValues.size(); n++) 
+			// Check optional propertyValues: if available, we expect uint8 values and as many properties as we have points
+			for (int n = 0; n < propertyValues.size(); n++)
 			{
-			  // ROS_DEBUG_STREAM("MsgPackParser::Parse(): " << (distValues[n].data().size()) << " dist values, " << (rssiValues[n].data().size()) << " rssi values, " << (propertyValues[n].size()) << " property values (" << (n+1) << ". echo)");
-        if (propertyValues[n].size() != distValues[n].data().size())
+				if (!propertyValues[n].isUint8())
+					ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): invalid property array");
+				else if (n < distValues.size() && propertyValues[n].numElems() != distValues[n].numElems())
 					ROS_WARN_STREAM("## ERROR MsgPackParser::Parse(): invalid property values");
 			}
 
 			// Convert to cartesian coordinates
 			result.scandata.push_back(sick_scansegment_xd::ScanSegmentParserOutput::Scangroup());
-			result.scandata.back().timestampStart_sec = u32TimestampStart_sec;
-			result.scandata.back().timestampStart_nsec = u32TimestampStart_nsec;
-			result.scandata.back().timestampStop_sec = u32TimestampStop_sec;
-			result.scandata.back().timestampStop_nsec = u32TimestampStop_nsec;
-			iEchoCount = std::min((int)distValuesDataMsg.size(), iEchoCount);
-			iEchoCount = std::min((int)rssiValuesDataMsg.size(), iEchoCount);
+			result.scandata.back().timestampStart_ticks = u32TimestampStart; // converted to system time by ApplySoftwarePLL
+			result.scandata.back().timestampStop_ticks = u32TimestampStop;
+			if (iPointCount > 1) // angular resolution of the lidar: azimuth step between first and last beam
+				result.scandata.back().azimuthIncrement = std::fabs(channelTheta.floatValue(iPointCount - 1, dstIsBigEndian) - channelTheta.floatValue(0, dstIsBigEndian)) / (float)(iPointCount - 1);
 			std::vector<sick_scansegment_xd::ScanSegmentParserOutput::Scanline>& groupData = result.scandata.back().scanlines;
 			groupData.reserve(iEchoCount);
-			int iPointCount = (int)channelTheta.data().size();
 			// Precompute sin and cos values of azimuth and elevation
-			float elevation = -channelPhi.data()[0]; // elevation must be negated, a positive pitch-angle yields negative z-coordinates
+			float elevation = -channelPhi.floatValue(0, dstIsBigEndian); // elevation must be negated, a positive pitch-angle yields negative z-coordinates
 			float cos_elevation = std::cos(elevation);
 			float sin_elevation = std::sin(elevation);
-			std::vector<float> cos_azimuth(iPointCount);
-			std::vector<float> sin_azimuth(iPointCount);
+			azimuth_values.resize(iPointCount);
+			cos_azimuth.resize(iPointCount);
+			sin_azimuth.resize(iPointCount);
+			float azimuth_offset = add_transform_xyz_rpy.azimuthOffset(); // read once for all points
 			for (int pointIdx = 0; pointIdx < iPointCount; pointIdx++)
 			{
-				float azimuth = channelTheta.data()[pointIdx] + add_transform_xyz_rpy.azimuthOffset();
+				azimuth_values[pointIdx] = channelTheta.floatValue(pointIdx, dstIsBigEndian);
+				float azimuth = azimuth_values[pointIdx] + azimuth_offset;
 				cos_azimuth[pointIdx] = std::cos(azimuth);
 				sin_azimuth[pointIdx] = std::sin(azimuth);
-        // if (pointIdx > 0)
-				//     SCANSEGMENT_XD_DEBUG_STREAM("azimuth[" << pointIdx << "] = " << (azimuth * 180 / M_PI) << " [deg], delta_azimuth = " << ((channelTheta.data[pointIdx] - channelTheta.data[pointIdx-1]) * 180 / M_PI) << " [deg]");
 			}
 			for (int echoIdx = 0; echoIdx < iEchoCount; echoIdx++)
 			{
-				assert(iPointCount == channelTheta.data().size() && iPointCount == distValues[echoIdx].data().size() && iPointCount == rssiValues[echoIdx].data().size());
-				groupData.push_back(sick_scansegment_xd::ScanSegmentParserOutput::Scanline());
-				sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = groupData.back();
-				scanline.points.reserve(iPointCount);
+				const MsgPackBinaryView& distEchoValues = distValues[echoIdx];
+				const MsgPackBinaryView& rssiEchoValues = rssiValues[echoIdx];
+				size_t scanline_start = point_cnt;
+				groupData.push_back(sick_scansegment_xd::ScanSegmentParserOutput::Scanline(scanline_start, iPointCount));
 				for (int pointIdx = 0; pointIdx < iPointCount; pointIdx++)
 				{
 					uint8_t reflectorbit = 0;
 					for (int n = 0; n < propertyValues.size(); n++)
-					  if (pointIdx < propertyValues[n].size())
-					    reflectorbit |= ((propertyValues[n][pointIdx]) & 0x01); // reflector bit is set, if a reflector is detected on any number of echos
-					float dist = 0.001f * distValues[echoIdx].data()[pointIdx]; // convert distance to meter
-					float intensity = rssiValues[echoIdx].data()[pointIdx];
-					float x = dist * cos_azimuth[pointIdx] * cos_elevation;
-					float y = dist * sin_azimuth[pointIdx] * cos_elevation;
-					float z = dist * sin_elevation;
-					add_transform_xyz_rpy.applyTransform(x, y, z);
-					float azimuth = channelTheta.data()[pointIdx];
+					  if (pointIdx < propertyValues[n].numElems() && propertyValues[n].isUint8())
+					    reflectorbit |= ((propertyValues[n].data[pointIdx]) & 0x01); // reflector bit is set, if a reflector is detected on any number of echos
+					float dist = 0.001f * distEchoValues.floatValue(pointIdx, dstIsBigEndian); // convert distance to meter
+					float intensity = rssiEchoValues.floatValue(pointIdx, dstIsBigEndian);
+					float azimuth = azimuth_values[pointIdx];
 					float azimuth_norm = normalizeAngle(azimuth);
 					if (msgpack_validator_enabled)
-					{
-						msgpack_validator_data.update(echoIdx, segment_idx, azimuth_norm, elevation);
 						msgpack_validator_data_collector.update(echoIdx, segment_idx, azimuth_norm, elevation);
-					}
-					scanline.points.push_back(sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint(x, y, z, intensity, dist, azimuth, elevation, groupIdx, echoIdx, pointIdx, reflectorbit));
+					result.points.set(point_cnt++, 0, 0, 0, intensity, dist, azimuth, elevation, groupIdx, echoIdx, pointIdx, reflectorbit); // x, y, z converted below
 				}
+				sick_scan_xd::PolarToCartesian::convert(iPointCount, result.points.range.data() + scanline_start, cos_azimuth.data(), sin_azimuth.data(),
+					&cos_elevation, &sin_elevation, 0, 1.0f, &add_transform_xyz_rpy,
+					result.points.x.data() + scanline_start, result.points.y.data() + scanline_start, result.points.z.data() + scanline_start);
 			}
 
 			// debug output
 			if (verbose)
 			{
 				ROS_INFO_STREAM((groupIdx + 1) << ". group: EchoCount = " << iEchoCount);
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: phi (elevation, rad) = [" << channelPhi.print() << "], " << channelPhi.data().size() << " element");
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: phi (elevation, deg) = [" << channelPhi.printRad2Deg() << "], " << channelPhi.data().size() << " element");
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: theta (azimuth, rad) = [" << channelTheta.print() << "], " << channelTheta.data().size() << " elements");
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: theta (azimuth, deg) = [" << channelTheta.printRad2Deg() << "], " << channelTheta.data().size() << " elements");
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: timestampStart = " << u32TimestampStart << " = " << sick_scansegment_xd::Timestamp(u32TimestampStart_sec, u32TimestampStart_nsec));
-				ROS_INFO_STREAM((groupIdx + 1) << ". group: timestampStop = " << u32TimestampStop << " = " << sick_scansegment_xd::Timestamp(u32TimestampStop_sec, u32TimestampStop_nsec));
-				for (int n = 0; n < distValues.size(); n++)
-					ROS_INFO_STREAM((groupIdx + 1) << ". group: dist[" << n << "] = [" << distValues[n].print() << "], " << distValues[n].data().size() << " elements");
-				for (int n = 0; n < rssiValues.size(); n++)
-					ROS_INFO_STREAM((groupIdx + 1) << ". group: rssi[" << n << "] = [" << rssiValues[n].print() << "], " << rssiValues[n].data().size() << " elements");
-				// std::cout << (groupIdx + 1) << ". group: ChannelPhiMsg.data = " << printMsgPack(*channelPhiMsgElement.data) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelPhiMsg.elemSz = " << printMsgPack(*channelPhiMsgElement.elemSz) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelPhiMsg.elemType = " << printMsgPack(*channelPhiMsgElement.elemTypes) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelPhiMsg.endian = " << printMsgPack(*channelPhiMsgElement.endian) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelThetaMsg.data = " << printMsgPack(*channelThetaMsgElement.data) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelThetaMsg.elemSz = " << printMsgPack(*channelThetaMsgElement.elemSz) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelThetaMsg.elemType = " << printMsgPack(*channelThetaMsgElement.elemTypes) << std::endl;
-				// std::cout << (groupIdx + 1) << ". group: ChannelThetaMsg.endian = " << printMsgPack(*channelThetaMsgElement.endian) << std::endl;
-				// for (int n = 0; n < distValuesDataMsg.size(); n++)
-				// {
-				// 	 std::cout << (groupIdx + 1) << ". group: DistValuesDataMsg[" << n << "].data = " << printMsgPack(*distValuesDataMsg[n].data) << std::endl;
-				// 	 std::cout << (groupIdx + 1) << ". group: DistValuesDataMsg[" << n << "].elemSz = " << printMsgPack(*distValuesDataMsg[n].elemSz) << std::endl;
-				// 	 std::cout << (groupIdx + 1) << ". group: DistValuesDataMsg[" << n << "].elemTypes = " << printMsgPack(*distValuesDataMsg[n].elemTypes) << std::endl;
-				// 	 std::cout << (groupIdx + 1) << ". group: DistValuesDataMsg[" << n << "].endian = " << printMsgPack(*distValuesDataMsg[n].endian) << std::endl;
-				// }
-				// for (int n = 0; n < rssiValuesDataMsg.size(); n++)
-				// {
-				//	 std::cout << (groupIdx + 1) << ". group: RssiValuesDataMsg[" << n << "].data = " << printMsgPack(*rssiValuesDataMsg[n].data) << std::endl;
-				//	 std::cout << (groupIdx + 1) << ". group: RssiValuesDataMsg[" << n << "].elemSz = " << printMsgPack(*rssiValuesDataMsg[n].elemSz) << std::endl;
-				//	 std::cout << (groupIdx + 1) << ". group: RssiValuesDataMsg[" << n << "].elemTypes = " << printMsgPack(*rssiValuesDataMsg[n].elemTypes) << std::endl;
-				//	 std::cout << (groupIdx + 1) << ". group: RssiValuesDataMsg[" << n << "].endian = " << printMsgPack(*rssiValuesDataMsg[n].endian) << std::endl;
-				// }
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: phi (elevation, rad) = [" << channelPhi.print(dstIsBigEndian) << "], " << channelPhi.numElems() << " element");
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: phi (elevation, deg) = [" << channelPhi.print(dstIsBigEndian, true) << "], " << channelPhi.numElems() << " element");
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: theta (azimuth, rad) = [" << channelTheta.print(dstIsBigEndian) << "], " << channelTheta.numElems() << " elements");
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: theta (azimuth, deg) = [" << channelTheta.print(dstIsBigEndian, true) << "], " << channelTheta.numElems() << " elements");
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: timestampStart = " << u32TimestampStart << " ticks");
+				ROS_INFO_STREAM((groupIdx + 1) << ". group: timestampStop = " << u32TimestampStop << " ticks");
+				for (int n = 0; n < iEchoCount; n++)
+					ROS_INFO_STREAM((groupIdx + 1) << ". group: dist[" << n << "] = [" << distValues[n].print(dstIsBigEndian) << "], " << distValues[n].numElems() << " elements");
+				for (int n = 0; n < iEchoCount; n++)
+					ROS_INFO_STREAM((groupIdx + 1) << ". group: rssi[" << n << "] = [" << rssiValues[n].print(dstIsBigEndian) << "], " << rssiValues[n].numElems() << " elements");
 				ROS_INFO_STREAM("");
 			}
 		}
+		result.points.resize(point_cnt); // groups with invalid elements are skipped, shrinking does not reallocate
     	// msgpack validation
 		if(msgpack_validator_enabled)
 		{
 			if (verbose)
 			{
-				std::vector<std::string> messages = msgpack_validator_data.print();
+				std::vector<std::string> messages = msgpack_validator_data_collector.print();
 				for(int n = 0; n < messages.size(); n++)
 					ROS_INFO_STREAM(messages[n]);
 			}
-			if (msgpack_validator.validateNotOutOfBound(msgpack_validator_data) == false)
+			if (msgpack_validator.validateNotOutOfBound(msgpack_validator_data_collector, msgpack_validator_out_of_bounds_cnt) == false)
 			{
 				if (discard_msgpacks_not_validated)
 				{
@@ -845,14 +1283,15 @@ bool sick_scansegment_xd::MsgPackParser::Parse(std::istream& msgpack_istream, fi
 	}
 	catch (const std::exception& exc)
 	{
-		ROS_ERROR_STREAM("## ERROR msgpack11::MsgPack::parse(): exception " << exc.what());
+		ROS_ERROR_STREAM("## ERROR MsgPackParser::ConvertSegment(): exception " << exc.what());
 		return false;
 	}
 	result.segmentIndex = segment_idx;
 	result.telegramCnt = telegram_cnt;
+	if (use_software_pll) // calculate system time from sensor ticks using SoftwarePLL
+		result.ApplySoftwarePLL(msgpack_timestamp, verbose);
 	return true;
 }
-
 /*
  * @brief exports msgpack data to csv file.
  *
@@ -896,10 +1335,10 @@ bool sick_scansegment_xd::MsgPackParser::WriteCSV(const std::vector<ScanSegmentP
 		{
 			for (int echoIdx = 0; echoIdx < result.scandata[groupIdx].scanlines.size(); echoIdx++)
 			{
-				const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = result.scandata[groupIdx].scanlines[echoIdx].points;
-				for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+				const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = result.scandata[groupIdx].scanlines[echoIdx];
+				for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
 				{
-					const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
+					const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = result.points.get(scanline.start + pointIdx);
 					csv_ostream << std::setw(12) << result.segmentIndex;
 					csv_ostream << ";" << std::setw(24) << result.timestamp;
 					csv_ostream << ";" << std::setw(12) << point.groupIdx;
@@ -930,14 +1369,7 @@ bool sick_scansegment_xd::MsgPackParser::ExportXYZI(const std::vector<ScanSegmen
 {
 	if (results.empty())
 		return false;
-	size_t data_length = 0;
-	for (int groupIdx = 0; groupIdx < results[0].scandata.size(); groupIdx++)
-	{
-		for (int echoIdx = 0; echoIdx < results[0].scandata[groupIdx].scanlines.size(); echoIdx++)
-		{
-			data_length += results[0].scandata[groupIdx].scanlines[echoIdx].points.size();
-		}
-	}
+	size_t data_length = results[0].points.size();
 	x.reserve(data_length);
 	y.reserve(data_length);
 	z.reserve(data_length);
@@ -952,10 +1384,10 @@ bool sick_scansegment_xd::MsgPackParser::ExportXYZI(const std::vector<ScanSegmen
 		{
 			for (int echoIdx = 0; echoIdx < result.scandata[groupIdx].scanlines.size(); echoIdx++)
 			{
-				const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = result.scandata[groupIdx].scanlines[echoIdx].points;
-				for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+				const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = result.scandata[groupIdx].scanlines[echoIdx];
+				for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
 				{
-					const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
+					const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = result.points.get(scanline.start + pointIdx);
 					x.push_back(point.x);
 					y.push_back(point.y);
 					z.push_back(point.z);
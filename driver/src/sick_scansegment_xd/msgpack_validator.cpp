@@ -61,14 +61,17 @@
  *
  */
 #include <float.h>
+#include <algorithm>
 
 #include "sick_scansegment_xd/msgpack_validator.h"
 
 /*
  * @brief Default constructor. Class MsgPackValidatorData collects echo_idx, azimuth, elevation and segment_idx
- *        during msgpack parsing for msgpack validation.
+ *        during msgpack parsing for msgpack validation. Counters are allocated by init() or with the default
+ *        full range on the first update.
  */
 sick_scansegment_xd::MsgPackValidatorData::MsgPackValidatorData()
+: m_elevation_idx_valid_min(0), m_elevation_idx_valid_max(-1), m_elevation_idx_min(0), m_num_elevation_bins(0), m_azimuth_idx_min(0), m_num_azimuth_bins(0), m_num_layers(0), m_out_of_bounds_cnt(0)
 {
 }
 
@@ -79,12 +82,235 @@ sick_scansegment_xd::MsgPackValidatorData::~MsgPackValidatorData()
 {
 }
 
+/*
+ * @brief Allocates the counters for the configured echos, azimuth range, elevation range and segments, see MsgPackValidator for details
+ */
+void sick_scansegment_xd::MsgPackValidatorData::init(const std::vector<int>& echos, float azimuth_start, float azimuth_end, float elevation_start, float elevation_end, 
+    const std::vector<int>& segments, int num_layers)
+{
+    int echo_idx_max = 0, segment_idx_max = 0;
+    for (int n = 0; n < echos.size(); n++)
+        echo_idx_max = std::max(echo_idx_max, echos[n]);
+    for (int n = 0; n < segments.size(); n++)
+        segment_idx_max = std::max(segment_idx_max, segments[n]);
+    m_echo_valid.assign(echo_idx_max + 1, 0);
+    for (int n = 0; n < echos.size(); n++)
+        if (echos[n] >= 0)
+            m_echo_valid[echos[n]] = 1;
+    m_segment_valid.assign(segment_idx_max + 1, 0);
+    for (int n = 0; n < segments.size(); n++)
+        if (segments[n] >= 0)
+            m_segment_valid[segments[n]] = 1;
+    int elevation_idx_max = 0, azimuth_idx_max = 0;
+    angleIndexRange(elevation_start, elevation_end, true, m_elevation_idx_valid_min, m_elevation_idx_valid_max);
+    angleIndexRange((float)(-M_PI / 2), (float)(M_PI / 2), true, m_elevation_idx_min, elevation_idx_max);
+    if (m_elevation_idx_valid_min <= m_elevation_idx_valid_max)
+    {
+        m_elevation_idx_min = std::min(m_elevation_idx_min, m_elevation_idx_valid_min);
+        elevation_idx_max = std::max(elevation_idx_max, m_elevation_idx_valid_max);
+    }
+    angleIndexRange(azimuth_start, azimuth_end, false, m_azimuth_idx_min, azimuth_idx_max);
+    m_num_elevation_bins = std::max(0, elevation_idx_max - m_elevation_idx_min + 1);
+    m_num_azimuth_bins = std::max(0, azimuth_idx_max - m_azimuth_idx_min + 1);
+    m_num_layers = std::max(1, num_layers);
+    allocateCounters();
+}
+
+/*
+ * @brief Allocates and clears the counters for the configured counter layout
+ */
+void sick_scansegment_xd::MsgPackValidatorData::allocateCounters(void)
+{
+    int num_echos = 0;
+    for (int echo_idx = 0; echo_idx < m_echo_valid.size(); echo_idx++)
+        num_echos += m_echo_valid[echo_idx];
+    m_segment_point_cnt.assign(m_echo_valid.size() * m_segment_valid.size(), 0);
+    m_elevation_row.assign(m_echo_valid.size() * m_num_elevation_bins, -1);
+    m_histogram_rows.clear();
+    m_histogram_rows.reserve(num_echos * m_num_layers);
+    m_azimuth_counter.assign(num_echos * m_num_layers * m_num_azimuth_bins, 0);
+    m_out_of_bounds_cnt = 0;
+    m_out_of_bounds_records.clear();
+    m_out_of_bounds_records.reserve(MaxOutOfBoundsRecords);
+}
+
+/*
+ * @brief Clears all counters and out of bounds records. The allocated counters are kept for reuse.
+ */
+void sick_scansegment_xd::MsgPackValidatorData::reset(void)
+{
+    std::fill(m_azimuth_counter.begin(), m_azimuth_counter.begin() + m_histogram_rows.size() * m_num_azimuth_bins, 0);
+    for (int row_idx = 0; row_idx < m_histogram_rows.size(); row_idx++)
+        m_elevation_row[m_histogram_rows[row_idx].echo_idx * m_num_elevation_bins + m_histogram_rows[row_idx].elevation_idx - m_elevation_idx_min] = -1;
+    m_histogram_rows.clear();
+    std::fill(m_segment_point_cnt.begin(), m_segment_point_cnt.end(), 0);
+    m_out_of_bounds_cnt = 0;
+    m_out_of_bounds_records.clear();
+}
+
+/*
+ * @brief Returns the first and last azimuth resp. elevation index, with all angles of the indizes inbetween within the given limits
+ */
+void sick_scansegment_xd::MsgPackValidatorData::angleIndexRange(float angle_start, float angle_end, bool elevation, int& idx_min, int& idx_max) const
+{
+    angle_start = std::max(angle_start, (float)(-2 * M_PI)); // limits are [-PI,+PI] for azimuth and [-PI/2,+PI/2] for elevation
+    angle_end = std::min(angle_end, (float)(+2 * M_PI));
+    if (!(angle_start <= angle_end)) // i.e. no angle within limits (or limits not a number)
+    {
+        idx_min = 0;
+        idx_max = -1;
+        return;
+    }
+    idx_min = (elevation ? elevationToInt(angle_start) : azimuthToInt(angle_start));
+    idx_max = (elevation ? elevationToInt(angle_end) : azimuthToInt(angle_end));
+    float (MsgPackValidatorData::*idxToAngle)(int) const = (elevation ? &MsgPackValidatorData::intToElevation : &MsgPackValidatorData::intToAzimuth);
+    while ((this->*idxToAngle)(idx_min) < angle_start)
+        idx_min++;
+    while ((this->*idxToAngle)(idx_min - 1) >= angle_start)
+        idx_min--;
+    while ((this->*idxToAngle)(idx_max) > angle_end)
+        idx_max--;
+    while ((this->*idxToAngle)(idx_max + 1) <= angle_end)
+        idx_max++;
+}
+
+/*
+ * @brief Adds a record of scan points out of bounds
+ */
+void sick_scansegment_xd::MsgPackValidatorData::addOutOfBounds(OutOfBoundsReason reason, int echo_idx, int segment_idx, int elevation_idx, int azimuth_idx)
+{
+    if (!m_out_of_bounds_records.empty())
+    {
+        const OutOfBoundsRecord& last_record = m_out_of_bounds_records.back();
+        if (last_record.reason == reason && last_record.echo_idx == echo_idx && last_record.segment_idx == segment_idx 
+            && last_record.elevation_idx == elevation_idx && last_record.azimuth_idx == azimuth_idx)
+        {
+            m_out_of_bounds_cnt++; // same as last record
+            return;
+        }
+    }
+    if (m_out_of_bounds_records.size() < MaxOutOfBoundsRecords)
+    {
+        OutOfBoundsRecord record = { m_out_of_bounds_cnt, reason, echo_idx, segment_idx, elevation_idx, azimuth_idx };
+        m_out_of_bounds_records.push_back(record);
+    }
+    m_out_of_bounds_cnt++;
+}
+
+/*
+ * @brief Returns the azimuth histogram (i.e. the row of azimuth counters) for a given echo and elevation, allocates a new row on first use
+ */
+int sick_scansegment_xd::MsgPackValidatorData::histogramRow(int echo_idx, int elevation_bin)
+{
+    int& row_idx = m_elevation_row[echo_idx * m_num_elevation_bins + elevation_bin];
+    if (row_idx < 0)
+    {
+        row_idx = (int)m_histogram_rows.size();
+        HistogramRow row = { echo_idx, elevation_bin + m_elevation_idx_min };
+        m_histogram_rows.push_back(row);
+        if (m_azimuth_counter.size() < m_histogram_rows.size() * m_num_azimuth_bins) // more layers than expected
+            m_azimuth_counter.resize(m_histogram_rows.size() * m_num_azimuth_bins, 0);
+    }
+    return row_idx;
+}
+
 /*
  * @brief Updates the azimuth histogram
  */
 void sick_scansegment_xd::MsgPackValidatorData::update(int echo_idx, int segment_idx, float azimuth, float elevation) 
 { 
-    m_azimuth_histogram[echo_idx][segment_idx][elevationToInt(elevation)][azimuthToInt(azimuth)] += 1;
+    if (!initialized())
+        MsgPackValidator().initValidatorData(*this); // default full range validation
+    int elevation_idx = elevationToInt(elevation);
+    int azimuth_idx = azimuthToInt(azimuth);
+    if (echo_idx < 0 || echo_idx >= m_echo_valid.size() || !m_echo_valid[echo_idx])
+    {
+        addOutOfBounds(OUT_OF_BOUNDS_ECHO, echo_idx, segment_idx, elevation_idx, azimuth_idx);
+        return;
+    }
+    if (segment_idx < 0 || segment_idx >= m_segment_valid.size() || !m_segment_valid[segment_idx])
+    {
+        addOutOfBounds(OUT_OF_BOUNDS_SEGMENT, echo_idx, segment_idx, elevation_idx, azimuth_idx);
+        return;
+    }
+    m_segment_point_cnt[echo_idx * m_segment_valid.size() + segment_idx] += 1;
+    int azimuth_bin = azimuth_idx - m_azimuth_idx_min;
+    bool azimuth_valid = (azimuth_bin >= 0 && azimuth_bin < m_num_azimuth_bins);
+    if (elevation_idx < m_elevation_idx_valid_min || elevation_idx > m_elevation_idx_valid_max)
+        addOutOfBounds(OUT_OF_BOUNDS_ELEVATION, echo_idx, segment_idx, elevation_idx, azimuth_idx);
+    else if (!azimuth_valid)
+        addOutOfBounds(OUT_OF_BOUNDS_AZIMUTH, echo_idx, segment_idx, elevation_idx, azimuth_idx);
+    int elevation_bin = elevation_idx - m_elevation_idx_min;
+    if (azimuth_valid && elevation_bin >= 0 && elevation_bin < m_num_elevation_bins)
+        m_azimuth_counter[histogramRow(echo_idx, elevation_bin) * m_num_azimuth_bins + azimuth_bin] += 1;
+}
+
+/*
+ * @brief Adds the azimuth histogram of other data, e.g. data collected by another parser thread
+ */
+void sick_scansegment_xd::MsgPackValidatorData::update(const MsgPackValidatorData& other)
+{
+    if (!other.initialized())
+        return; // nothing collected
+    if (!initialized()) // use the counter layout of the other data
+    {
+        m_echo_valid = other.m_echo_valid;
+        m_segment_valid = other.m_segment_valid;
+        m_elevation_idx_valid_min = other.m_elevation_idx_valid_min;
+        m_elevation_idx_valid_max = other.m_elevation_idx_valid_max;
+        m_elevation_idx_min = other.m_elevation_idx_min;
+        m_num_elevation_bins = other.m_num_elevation_bins;
+        m_azimuth_idx_min = other.m_azimuth_idx_min;
+        m_num_azimuth_bins = other.m_num_azimuth_bins;
+        m_num_layers = other.m_num_layers;
+        allocateCounters();
+    }
+    if (m_echo_valid != other.m_echo_valid || m_segment_valid != other.m_segment_valid || m_elevation_idx_min != other.m_elevation_idx_min 
+        || m_elevation_idx_valid_min != other.m_elevation_idx_valid_min || m_elevation_idx_valid_max != other.m_elevation_idx_valid_max
+        || m_num_elevation_bins != other.m_num_elevation_bins || m_azimuth_idx_min != other.m_azimuth_idx_min || m_num_azimuth_bins != other.m_num_azimuth_bins)
+    {
+        ROS_WARN_STREAM("## WARNING MsgPackValidatorData::update(): msgpack validation data configured with different limits, data not added");
+        return;
+    }
+    for (int other_row_idx = 0; other_row_idx < other.m_histogram_rows.size(); other_row_idx++)
+    {
+        const HistogramRow& other_row = other.m_histogram_rows[other_row_idx];
+        uint32_t* azimuth_counter = &m_azimuth_counter[histogramRow(other_row.echo_idx, other_row.elevation_idx - m_elevation_idx_min) * m_num_azimuth_bins];
+        const uint32_t* other_azimuth_counter = &other.m_azimuth_counter[other_row_idx * m_num_azimuth_bins];
+        for (int azimuth_bin = 0; azimuth_bin < m_num_azimuth_bins; azimuth_bin++)
+            azimuth_counter[azimuth_bin] += other_azimuth_counter[azimuth_bin];
+    }
+    for (int n = 0; n < m_segment_point_cnt.size(); n++)
+        m_segment_point_cnt[n] += other.m_segment_point_cnt[n];
+    // Records of the other data are appended, their index is shifted by the number of scan points out of bounds collected so far
+    for (int n = 0; n < other.m_out_of_bounds_records.size() && m_out_of_bounds_records.size() < MaxOutOfBoundsRecords; n++)
+    {
+        const OutOfBoundsRecord& record = other.m_out_of_bounds_records[n];
+        if (n == 0 && !m_out_of_bounds_records.empty())
+        {
+            const OutOfBoundsRecord& last_record = m_out_of_bounds_records.back();
+            if (last_record.reason == record.reason && last_record.echo_idx == record.echo_idx && last_record.segment_idx == record.segment_idx 
+                && last_record.elevation_idx == record.elevation_idx && last_record.azimuth_idx == record.azimuth_idx)
+                continue; // same as last record
+        }
+        m_out_of_bounds_records.push_back(record);
+        m_out_of_bounds_records.back().out_of_bounds_idx += m_out_of_bounds_cnt;
+    }
+    m_out_of_bounds_cnt += other.m_out_of_bounds_cnt;
+}
+
+/*
+ * @brief Returns the number of scan points counted in the histogram for a given echo, i.e. all points of this echo within the configured limits
+ */
+size_t sick_scansegment_xd::MsgPackValidatorData::getPointCount(int echo_idx) const
+{
+    size_t point_cnt = 0;
+    if (echo_idx >= 0 && echo_idx < m_echo_valid.size())
+    {
+        for (int segment_idx = 0; segment_idx < m_segment_valid.size(); segment_idx++)
+            point_cnt += m_segment_point_cnt[echo_idx * m_segment_valid.size() + segment_idx];
+    }
+    return point_cnt;
 }
 
 /*
@@ -125,37 +351,48 @@ float sick_scansegment_xd::MsgPackValidatorData::getElevationHistogramResolution
 std::vector<std::string> sick_scansegment_xd::MsgPackValidatorData::print(void) const
 {
     std::vector<std::string> messages;
-    // Loop over Histogram of azimuth angles: azimuth_count = m_azimuth_histogram[echo_idx][segment_idx][elevationToInt(elevation)][azimuthToInt(azimuth)]
-    for(AzimuthHistogramPerElevationPerSegmentPerEcho::const_iterator iter_echos = m_azimuth_histogram.cbegin(); iter_echos != m_azimuth_histogram.cend(); iter_echos++)
+    for (int echo_idx = 0; echo_idx < m_echo_valid.size(); echo_idx++)
     {
-        int echo_idx = iter_echos->first;
-        const AzimuthHistogramPerElevationPerSegment& azimuth_histogram_elevation_segment = iter_echos->second;
-        for(AzimuthHistogramPerElevationPerSegment::const_iterator iter_segment = azimuth_histogram_elevation_segment.cbegin(); iter_segment != azimuth_histogram_elevation_segment.cend(); iter_segment++)
+        if (!m_echo_valid[echo_idx])
+            continue;
+        // Number of scan points per segment
+        std::stringstream s;
+        s << "MsgPackValidatorData[echo=" << echo_idx << "]: points per segment = [ ";
+        for (int segment_idx = 0; segment_idx < m_segment_valid.size(); segment_idx++)
+        {
+            if (m_segment_valid[segment_idx])
+                s << segment_idx << ":" << m_segment_point_cnt[echo_idx * m_segment_valid.size() + segment_idx] << " ";
+        }
+        s << "]";
+        messages.push_back(s.str());
+        // Azimuth range of each layer in order of elevation
+        for (int elevation_bin = 0; elevation_bin < m_num_elevation_bins; elevation_bin++)
         {
-            int segment_idx = iter_segment->first;
-            const AzimuthHistogramPerElevation& azimuth_histogram_elevation = iter_segment->second;
-            for(AzimuthHistogramPerElevation::const_iterator iter_elevation = azimuth_histogram_elevation.cbegin(); iter_elevation != azimuth_histogram_elevation.cend(); iter_elevation++)
+            int row_idx = m_elevation_row[echo_idx * m_num_elevation_bins + elevation_bin];
+            if (row_idx < 0)
+                continue;
+            const uint32_t* azimuth_counter = &m_azimuth_counter[row_idx * m_num_azimuth_bins];
+            float azimuth_min = FLT_MAX, azimuth_max = -FLT_MAX;
+            for (int azimuth_bin = 0; azimuth_bin < m_num_azimuth_bins; azimuth_bin++)
             {
-                float elevation_rad = intToElevation(iter_elevation->first);
-                const AzimuthHistogram& azimuth_histogram = iter_elevation->second;
-                float azimuth_min = azimuth_histogram.empty() ? 0 : FLT_MAX;
-                float azimuth_max = azimuth_histogram.empty() ? 0 : -FLT_MAX;
-                for(AzimuthHistogram::const_iterator iter_azimuth = azimuth_histogram.cbegin(); iter_azimuth != azimuth_histogram.cend(); iter_azimuth++)
+                if (azimuth_counter[azimuth_bin] > 0)
                 {
-                    float azimuth_rad = intToAzimuth(iter_azimuth->first);
-                    int azimuth_cnt = iter_azimuth->second;
-                    if(azimuth_cnt > 0)
-                    {
-                        azimuth_min = std::min(azimuth_min, azimuth_rad);
-                        azimuth_max = std::max(azimuth_max, azimuth_rad);
-                    }
+                    float azimuth_rad = intToAzimuth(azimuth_bin + m_azimuth_idx_min);
+                    azimuth_min = std::min(azimuth_min, azimuth_rad);
+                    azimuth_max = std::max(azimuth_max, azimuth_rad);
                 }
-                std::stringstream s;
-                s << "MsgPackValidatorData[echo=" << echo_idx << "][segment=" << segment_idx << "][elevation=" << rad2deg(elevation_rad) << "]: azimuth=[" << rad2deg(azimuth_min) << ", " << rad2deg(azimuth_max) << "] [deg]" ;
-                messages.push_back(s.str());
             }
+            std::stringstream s;
+            s << "MsgPackValidatorData[echo=" << echo_idx << "][elevation=" << rad2deg(intToElevation(elevation_bin + m_elevation_idx_min)) << "]: azimuth=[" << rad2deg(azimuth_min) << ", " << rad2deg(azimuth_max) << "] [deg]" ;
+            messages.push_back(s.str());
         }
     }
+    if (m_out_of_bounds_cnt > 0)
+    {
+        std::stringstream s;
+        s << "MsgPackValidatorData: " << m_out_of_bounds_cnt << " scan points out of bounds";
+        messages.push_back(s.str());
+    }
     return messages;
 }
 
@@ -199,116 +436,86 @@ sick_scansegment_xd::MsgPackValidator::~MsgPackValidator()
 {
 }
 
+/*
+ * @brief Allocates the counters of msgpack validation data for the configured echos, azimuth range, elevation range, segments and layers.
+ */
+void sick_scansegment_xd::MsgPackValidator::initValidatorData(MsgPackValidatorData& data) const
+{
+    int num_layers = 0;
+    for (int layer_idx = 0; layer_idx < m_layer_filter.size(); layer_idx++)
+    {
+        if(m_layer_filter[layer_idx])
+            num_layers++;
+    }
+    data.init(m_echos_required, m_azimuth_start, m_azimuth_end, m_elevation_start, m_elevation_end, m_valid_segments, num_layers);
+}
+
 /*
  * @brief Validates a received msgpack against the configured limits, i.e. checks that echo, segment and azimuth are
  *        within their configured range.
  *
  * @param[in] data_received echos, azimuth, elevation and segments collected during msgpack parsing
+ * @param[in] out_of_bounds_cnt_start number of scan points out of bounds already validated, i.e. only scan points out of bounds
+ *            collected after the first out_of_bounds_cnt_start points are validated, default: 0 (validate all data)
  *
  * @return true if validation passed successfully, false otherwise.
  */
-bool sick_scansegment_xd::MsgPackValidator::validateNotOutOfBound(const MsgPackValidatorData& msgpack_data_received) const
+bool sick_scansegment_xd::MsgPackValidator::validateNotOutOfBound(const MsgPackValidatorData& msgpack_data_received, size_t out_of_bounds_cnt_start) const
 {
-    // loop over histogram of azimuth angles: azimuth_count = getHistogram()[echo_idx][segment_idx][elevationToInt(elevation)][azimuthToInt(azimuth)]
-    // and check against configured limits
-    bool success = true;
-    const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho& azimuth_histogram = msgpack_data_received.getHistogram();
-    for(MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho::const_iterator iter_echos = azimuth_histogram.cbegin(); iter_echos != azimuth_histogram.cend(); iter_echos++)
+    // Scan points out of the configured limits have been recorded during msgpack parsing, 
+    // print the records with echo, segment, elevation and azimuth of these points
+    size_t out_of_bounds_cnt = msgpack_data_received.getOutOfBoundsCount();
+    bool success = (out_of_bounds_cnt <= out_of_bounds_cnt_start);
+    const std::vector<MsgPackValidatorData::OutOfBoundsRecord>& out_of_bounds_records = msgpack_data_received.getOutOfBoundsRecords();
+    std::vector<float> out_of_bounds_azimuth_angles;
+    for(int record_idx = 0; !success && record_idx <= out_of_bounds_records.size(); record_idx++)
     {
-        int echo_idx = iter_echos->first;
-        const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegment& azimuth_histogram_elevation_segment = iter_echos->second;
-        for(MsgPackValidatorData::AzimuthHistogramPerElevationPerSegment::const_iterator iter_segment = azimuth_histogram_elevation_segment.cbegin(); iter_segment != azimuth_histogram_elevation_segment.cend(); iter_segment++)
+        const MsgPackValidatorData::OutOfBoundsRecord* record = (record_idx < out_of_bounds_records.size() ? &out_of_bounds_records[record_idx] : 0);
+        if (record)
         {
-            int segment_idx = iter_segment->first;
-            const MsgPackValidatorData::AzimuthHistogramPerElevation& azimuth_histogram_elevation = iter_segment->second;
-            for(MsgPackValidatorData::AzimuthHistogramPerElevation::const_iterator iter_elevation = azimuth_histogram_elevation.cbegin(); iter_elevation != azimuth_histogram_elevation.cend(); iter_elevation++)
-            {
-                int elevation_idx = iter_elevation->first;
-                float elevation_rad = msgpack_data_received.elevationIndexToRad(elevation_idx);
-                const MsgPackValidatorData::AzimuthHistogram& azimuth_histogram = iter_elevation->second;
-                std::vector<float> out_of_bounds_azimuth_angles;
-                for(MsgPackValidatorData::AzimuthHistogram::const_iterator iter_azimuth = azimuth_histogram.cbegin(); iter_azimuth != azimuth_histogram.cend(); iter_azimuth++)
-                {
-                    float azimuth_rad = msgpack_data_received.azimuthIndexToRad(iter_azimuth->first);
-                    int azimuth_cnt = iter_azimuth->second;
-                    if(azimuth_cnt > 0)
-                    {
-                        if (std::find(m_echos_required.begin(), m_echos_required.end(), echo_idx) == m_echos_required.end())
-                        {
-                            success = false;
-			                ROS_WARN_STREAM("## WARNING MsgPackValidator: echo = " << echo_idx << " unexpected (expected echo: [ " 
-                                << listVector(m_echos_required) << " ]");
-                            break;
-                        }
-                        if (std::find(m_valid_segments.begin(), m_valid_segments.end(), segment_idx) == m_valid_segments.end())
-                        {
-                            success = false;
-			                ROS_WARN_STREAM("## WARNING MsgPackValidator: segment = " << segment_idx << " (echo " << echo_idx << ") unexpected (valid segments: [ " 
-                                << listVector(m_valid_segments) << " ]");
-                            break;
-                        }
-                        if (elevation_rad < m_elevation_start || elevation_rad > m_elevation_end)
-                        {
-                            success = false;
-			                ROS_WARN_STREAM("## WARNING MsgPackValidator: elevation = " << (elevation_rad * 180.0 / M_PI) << " deg (echo " << echo_idx << ", segment " << segment_idx 
-                                << ") out of limits [ " << (m_elevation_start * 180.0 / M_PI) << ", " << (m_elevation_end * 180.0 / M_PI) << " ] deg.");
-                            break;
-                        }
-                        if (azimuth_rad < m_azimuth_start || azimuth_rad > m_azimuth_end)
-                        {
-                            success = false;
-                            out_of_bounds_azimuth_angles.push_back(azimuth_rad * (float)(180.0 / M_PI));
-                        }
-                    }
-                }
-                if(!out_of_bounds_azimuth_angles.empty())
-                {
-			        ROS_WARN_STREAM("## WARNING MsgPackValidator: azimuth angles = [ " << listVector(out_of_bounds_azimuth_angles) << " ] deg (echo " << echo_idx << ", segment " << segment_idx << ", elevation " 
-                        << (elevation_rad * 180.0 / M_PI) << " deg) out of limits [ " << (m_azimuth_start * 180.0 / M_PI) << ", " << (m_azimuth_end * 180.0 / M_PI) << " ] deg.");
-                }
-            }
+            size_t record_end = (record_idx + 1 < out_of_bounds_records.size() ? out_of_bounds_records[record_idx + 1].out_of_bounds_idx : out_of_bounds_cnt);
+            if (record_end <= out_of_bounds_cnt_start)
+                continue; // already validated
+        }
+        // Azimuth angles out of bounds are listed for each echo, segment and elevation
+        const MsgPackValidatorData::OutOfBoundsRecord* azimuth_record = (record_idx > 0 ? &out_of_bounds_records[record_idx - 1] : 0);
+        if (!out_of_bounds_azimuth_angles.empty() && (!record || record->reason != MsgPackValidatorData::OUT_OF_BOUNDS_AZIMUTH 
+            || record->echo_idx != azimuth_record->echo_idx || record->segment_idx != azimuth_record->segment_idx || record->elevation_idx != azimuth_record->elevation_idx))
+        {
+            ROS_WARN_STREAM("## WARNING MsgPackValidator: azimuth angles = [ " << listVector(out_of_bounds_azimuth_angles) << " ] deg (echo " << azimuth_record->echo_idx << ", segment " << azimuth_record->segment_idx << ", elevation " 
+                << msgpack_data_received.elevationIndexToDeg(azimuth_record->elevation_idx) << " deg) out of limits [ " << (m_azimuth_start * 180.0 / M_PI) << ", " << (m_azimuth_end * 180.0 / M_PI) << " ] deg.");
+            out_of_bounds_azimuth_angles.clear();
+        }
+        if (!record)
+            break;
+        int echo_idx = record->echo_idx;
+        int segment_idx = record->segment_idx;
+        switch(record->reason)
+        {
+        case MsgPackValidatorData::OUT_OF_BOUNDS_ECHO:
+            ROS_WARN_STREAM("## WARNING MsgPackValidator: echo = " << echo_idx << " unexpected (expected echo: [ " 
+                << listVector(m_echos_required) << " ]");
+            break;
+        case MsgPackValidatorData::OUT_OF_BOUNDS_SEGMENT:
+            ROS_WARN_STREAM("## WARNING MsgPackValidator: segment = " << segment_idx << " (echo " << echo_idx << ") unexpected (valid segments: [ " 
+                << listVector(m_valid_segments) << " ]");
+            break;
+        case MsgPackValidatorData::OUT_OF_BOUNDS_ELEVATION:
+            ROS_WARN_STREAM("## WARNING MsgPackValidator: elevation = " << msgpack_data_received.elevationIndexToDeg(record->elevation_idx) << " deg (echo " << echo_idx << ", segment " << segment_idx 
+                << ") out of limits [ " << (m_elevation_start * 180.0 / M_PI) << ", " << (m_elevation_end * 180.0 / M_PI) << " ] deg.");
+            break;
+        case MsgPackValidatorData::OUT_OF_BOUNDS_AZIMUTH:
+            out_of_bounds_azimuth_angles.push_back(msgpack_data_received.azimuthIndexToDeg(record->azimuth_idx));
+            break;
         }
     }
     if (!success)
-        ROS_WARN_STREAM("## WARNING MsgPackValidator::validateNotOutOfBound() finished with error.");
+        ROS_WARN_STREAM("## WARNING MsgPackValidator::validateNotOutOfBound() finished with error (" << (out_of_bounds_cnt - out_of_bounds_cnt_start) << " scan points out of bounds).");
     else if (m_verbose > 1)
         ROS_INFO_STREAM("MsgPackValidator::validateNotOutOfBound() finished successful.");
     return success;
 }
 
-/** Returns the number of azimuth angles counted in the histogram for a given echo, segment, elevation and azimuth */
-int sick_scansegment_xd::MsgPackValidator::getAzimuthHistogramCount(const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho& azimuth_histogram,
-    int echo_idx, int segment_idx, int elevation_idx, int azimuth_idx) const
-{
-    MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho::const_iterator collected_echo = azimuth_histogram.find(echo_idx);
-    if (collected_echo != azimuth_histogram.cend())
-    {
-        int collected_echo_idx = collected_echo->first;
-        const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegment::const_iterator collected_segment = collected_echo->second.find(segment_idx);
-        if (collected_segment != collected_echo->second.cend())
-        {
-            int collected_segment_idx = collected_segment->first;
-            const MsgPackValidatorData::AzimuthHistogramPerElevation::const_iterator collected_elevation = collected_segment->second.find(elevation_idx);
-            if (collected_elevation != collected_segment->second.cend())
-            {
-                int collected_elevation_idx = collected_elevation->first;
-                const MsgPackValidatorData::AzimuthHistogram::const_iterator collected_azimuth = collected_elevation->second.find(azimuth_idx);
-                if (collected_azimuth != collected_elevation->second.cend())
-                {
-                    int collected_azimuth_idx = collected_azimuth->first;
-                    int collected_azimuth_hist_cnt = collected_azimuth->second;
-                    if(collected_echo_idx == echo_idx && collected_segment_idx == segment_idx && collected_elevation_idx == elevation_idx && collected_azimuth_idx == azimuth_idx)
-                    {
-                        return collected_azimuth_hist_cnt; // given echo, segment, elevation and azimuth found in histogram, return histogram counter
-                    }
-                }
-            }
-        }
-
-    }
-    return 0; // given echo, segment, elevation and azimuth not found in histogram
-}
-
 void sick_scansegment_xd::MsgPackValidator::printMissingHistogramData(const std::vector<std::string>& messages) const
 {
     if (m_verbose > 1)
@@ -335,63 +542,39 @@ bool sick_scansegment_xd::MsgPackValidator::validateNoMissingScandata(const MsgP
     // Thus the histogram is checked for azimuth angles -180, -179, -178, ...., 29, 30 [deg]
     // The azimuth histogram is checked with a given resolution. The check is passed, if the histogram counter is > 0 
     // for each azimuth angle within the expected range.
+    // The azimuth histograms of valid segments are collected in one histogram per echo and elevation.
 
     bool success = true;
     bool azimuth_values_missing = false;
     bool elevation_values_missing = false;
-    const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho& azimuth_histogram = msgpack_data_collected.getHistogram();
+    int num_layer_required = 0;
+    for (int layer_idx = 0; layer_idx < m_layer_filter.size(); layer_idx++)
+    {
+        if(m_layer_filter[layer_idx])
+            num_layer_required++;
+    }
+    float azimuth_res = msgpack_data_collected.getAzimuthHistogramResolutionRad();
+    int azimuth_idx_start = msgpack_data_collected.azimuthRadToIndex(m_azimuth_start + azimuth_res);
+    int azimuth_idx_end = msgpack_data_collected.azimuthRadToIndex(m_azimuth_end - azimuth_res);
     
     // Check all required echos
     for (std::vector<int>::const_iterator iter_echo = m_echos_required.cbegin(); iter_echo != m_echos_required.cend(); iter_echo++)
     {
         int echo_idx = (*iter_echo);
         // Check if required echo found in histogram
-        MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho::const_iterator collected_echo = azimuth_histogram.find(echo_idx);
-        if (collected_echo == azimuth_histogram.cend() || collected_echo->first != echo_idx || collected_echo->second.empty())
+        if (msgpack_data_collected.getPointCount(echo_idx) == 0)
         {
             ROS_WARN_STREAM("## WARNING MsgPackValidator::validateNoMissingScandata() failed: no scan data found in echo " << echo_idx << ":");
             printMissingHistogramData(msgpack_data_collected.print());
             return false;
         }
 
-        // Check all required segments and collect azimuth histograms over all segments
-        MsgPackValidatorData::AzimuthHistogramPerElevation collected_azimuth_histogram_per_elevation;
-        for (std::vector<int>::const_iterator iter_segment = m_valid_segments.cbegin(); iter_segment != m_valid_segments.cend(); iter_segment++)
-        {
-            int segment_idx = (*iter_segment);
-            const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegment::const_iterator collected_segment = collected_echo->second.find(segment_idx);
-            // Check if required segment found in histogram
-            if (collected_segment == collected_echo->second.cend() || collected_segment->first != segment_idx || collected_segment->second.empty())
-            {
-                /* ROS_WARN_STREAM("## WARNING MsgPackValidator::validateNoMissingScandata() failed: no scan data found in segment " << segment_idx << " (echo " << echo_idx << "):");
-                printMissingHistogramData(msgpack_data_collected.print());
-                return false; */
-                continue;
-            }
-            // Collect azimuth histograms over all segments
-            for(MsgPackValidatorData::AzimuthHistogramPerElevation::const_iterator collected_elevation = collected_segment->second.cbegin(); collected_elevation != collected_segment->second.cend(); collected_elevation++)
-            {
-                int collected_elevation_idx = collected_elevation->first;
-                for(MsgPackValidatorData::AzimuthHistogram::const_iterator collected_azimuth = collected_elevation->second.cbegin(); collected_azimuth != collected_elevation->second.cend(); collected_azimuth++)
-                {
-                    int collected_azimuth_idx = collected_azimuth->first;
-                    int collected_azimuth_hist_cnt = collected_azimuth->second;
-                    collected_azimuth_histogram_per_elevation[collected_elevation_idx][collected_azimuth_idx] += collected_azimuth_hist_cnt;
-                }
-            }
-        }
-
         // Check required layers
-        int num_layer_required = 0;
-        for (int layer_idx = 0; layer_idx < m_layer_filter.size(); layer_idx++)
-        {
-            if(m_layer_filter[layer_idx])
-                num_layer_required++;
-        }
         int num_layer_collected = 0;
-        for(MsgPackValidatorData::AzimuthHistogramPerElevation::const_iterator collected_elevation = collected_azimuth_histogram_per_elevation.begin(); collected_elevation != collected_azimuth_histogram_per_elevation.end(); collected_elevation++)
+        for (int histogram_idx = 0; histogram_idx < msgpack_data_collected.getNumAzimuthHistograms(); histogram_idx++)
         {
-            num_layer_collected++;
+            if (msgpack_data_collected.getAzimuthHistogramEcho(histogram_idx) == echo_idx)
+                num_layer_collected++;
         }
         if(num_layer_required != num_layer_collected)
         {
@@ -401,11 +584,18 @@ bool sick_scansegment_xd::MsgPackValidator::validateNoMissingScandata(const MsgP
         }
 
         // Check required azimuth angles in all layer
-        for(MsgPackValidatorData::AzimuthHistogramPerElevation::iterator collected_elevation = collected_azimuth_histogram_per_elevation.begin(); collected_elevation != collected_azimuth_histogram_per_elevation.end(); collected_elevation++)
+        for (int histogram_idx = 0; histogram_idx < msgpack_data_collected.getNumAzimuthHistograms(); histogram_idx++)
         {
-            int elevation_idx = collected_elevation->first;
-            MsgPackValidatorData::AzimuthHistogram& collected_azimuth_histogram = collected_elevation->second;
-            if (collected_azimuth_histogram.empty())
+            if (msgpack_data_collected.getAzimuthHistogramEcho(histogram_idx) != echo_idx)
+                continue;
+            int elevation_idx = msgpack_data_collected.getAzimuthHistogramElevation(histogram_idx);
+            int azimuth_cnt_missing = 0;
+            for (int azimuth_idx = azimuth_idx_start + 1; azimuth_idx < azimuth_idx_end; azimuth_idx++)
+            {
+                if(msgpack_data_collected.getAzimuthHistogramCount(histogram_idx, azimuth_idx) <= 0)
+                    azimuth_cnt_missing++;
+            }
+            if (azimuth_cnt_missing > 0 && azimuth_cnt_missing >= azimuth_idx_end - azimuth_idx_start - 1)
             {
                 // no scan data for this elevation
                 if (m_verbose > 1)
@@ -415,26 +605,17 @@ bool sick_scansegment_xd::MsgPackValidator::validateNoMissingScandata(const MsgP
                 success = false;
                 continue;
             }
-            // Check all required azimuth angles
-            float azimuth_res = msgpack_data_collected.getAzimuthHistogramResolutionRad();
-            int azimuth_idx_start = msgpack_data_collected.azimuthRadToIndex(m_azimuth_start + azimuth_res);
-            int azimuth_idx_end = msgpack_data_collected.azimuthRadToIndex(m_azimuth_end - azimuth_res);
-            for (int azimuth_idx = azimuth_idx_start + 1; azimuth_idx < azimuth_idx_end; azimuth_idx++)
+            if (azimuth_cnt_missing > 0)
             {
-                if(collected_azimuth_histogram[azimuth_idx] <= 0)
+                // no scan data for some azimuth angles
+                for (int azimuth_idx = azimuth_idx_start + 1; m_verbose > 1 && azimuth_idx < azimuth_idx_end; azimuth_idx++)
                 {
-                    // no scan data for this azimuth
-                    if (m_verbose > 1)
+                    if(msgpack_data_collected.getAzimuthHistogramCount(histogram_idx, azimuth_idx) <= 0)
                         ROS_WARN_STREAM("## WARNING MsgPackValidator::validateNoMissingScandata() failed: no scan data found for azimuth " << msgpack_data_collected.azimuthIndexToDeg(azimuth_idx) 
                             << " [deg] (echo " << echo_idx << ", elevation " << msgpack_data_collected.elevationIndexToDeg(elevation_idx) << ")");
-                    azimuth_values_missing = true;
-                    success = false;
                 }
-                // else
-                // {
-                //     ROS_INFO_STREAM("elevation " << msgpack_data_collected.elevationIndexToDeg(elevation_idx) << ", azimuth " << msgpack_data_collected.azimuthIndexToDeg(azimuth_idx) 
-                //         << " [deg] echo " << echo_idx <<  ": azimuth_hist_cnt = " << collected_azimuth_histogram[azimuth_idx]);
-                // }
+                azimuth_values_missing = true;
+                success = false;
             }
         }
     }
@@ -52,6 +52,7 @@
  *
  */
 #include <climits>
+#include <limits>
 
 #include <sick_scan/sick_generic_callback.h>
 #include "sick_scansegment_xd/compact_parser.h"
@@ -149,6 +150,70 @@ sick_scansegment_xd::CustomPointCloudConfiguration::CustomPointCloudConfiguratio
 				ROS_ERROR_STREAM("## ERROR CustomPointCloudConfiguration(name=" << cfg_name << ", value=" << cfg_str << "): topic and frameid required, pointcloud will not be published, check configuration");
 				m_publish = false;
 		}
+		initFieldLayout();
+}
+
+/*
+* Compiles the enabled fields and point filter once: the properties of the pointcloud fields, the packed layout to copy the fields
+* of a lidar point to the pointcloud data, and lookup tables for the echo, layer, reflector and infringed filter.
+*/
+void sick_scansegment_xd::CustomPointCloudConfiguration::initFieldLayout(void)
+{
+	sick_scansegment_xd::PointXYZRAEI32f dummy_lidar_point;
+	m_field_properties.clear();
+	m_field_properties.reserve(12);
+	if (fieldEnabled("x"))
+	  m_field_properties.push_back(PointCloudFieldProperty("x", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.x - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("y"))
+	  m_field_properties.push_back(PointCloudFieldProperty("y", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.y - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("z"))
+	  m_field_properties.push_back(PointCloudFieldProperty("z", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.z - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("i"))
+	  m_field_properties.push_back(PointCloudFieldProperty("i", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.i - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("range"))
+	  m_field_properties.push_back(PointCloudFieldProperty("range", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.range - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("azimuth"))
+	  m_field_properties.push_back(PointCloudFieldProperty("azimuth", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.azimuth - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("elevation"))
+	  m_field_properties.push_back(PointCloudFieldProperty("elevation", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.elevation - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("layer"))
+	  m_field_properties.push_back(PointCloudFieldProperty("layer", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.layer - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("echo"))
+	  m_field_properties.push_back(PointCloudFieldProperty("echo", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.echo - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("reflector"))
+	  m_field_properties.push_back(PointCloudFieldProperty("reflector", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.reflectorbit - (uint8_t*)&dummy_lidar_point));
+	if (fieldEnabled("infringed"))
+	  m_field_properties.push_back(PointCloudFieldProperty("infringed", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.infringed - (uint8_t*)&dummy_lidar_point));
+	// Packed layout: fields are copied in order of m_field_properties, fields adjacent in both source and destination are merged (e.g. x,y,z copied by one memcpy)
+	m_point_step = 0;
+	m_field_copies.clear();
+	for (int n = 0; n < m_field_properties.size(); n++)
+	{
+		const PointCloudFieldProperty& field = m_field_properties[n];
+		if (!m_field_copies.empty() && m_field_copies.back().src_offset + m_field_copies.back().size == field.fieldoffset && m_field_copies.back().dst_offset + m_field_copies.back().size == m_point_step)
+		{
+			m_field_copies.back().size += field.datasize;
+		}
+		else
+		{
+			FieldCopy field_copy = { field.fieldoffset, m_point_step, field.datasize };
+			m_field_copies.push_back(field_copy);
+		}
+		m_point_step += field.datasize;
+	}
+	// Lookup tables for the point filter
+	m_echo_lut.fill(false);
+	m_layer_lut.fill(false);
+	m_reflector_lut.fill(false);
+	m_infringed_lut.fill(false);
+	for (std::map<int8_t, bool>::const_iterator iter = m_echo_enabled.cbegin(); iter != m_echo_enabled.cend(); iter++)
+		m_echo_lut[(uint8_t)iter->first] = iter->second;
+	for (std::map<int8_t, bool>::const_iterator iter = m_layer_enabled.cbegin(); iter != m_layer_enabled.cend(); iter++)
+		m_layer_lut[(uint8_t)iter->first] = iter->second;
+	for (std::map<int8_t, bool>::const_iterator iter = m_reflector_enabled.cbegin(); iter != m_reflector_enabled.cend(); iter++)
+		m_reflector_lut[(uint8_t)iter->first] = iter->second;
+	for (std::map<int8_t, bool>::const_iterator iter = m_infringed_enabled.cbegin(); iter != m_infringed_enabled.cend(); iter++)
+		m_infringed_lut[(uint8_t)iter->first] = iter->second;
 }
 
 void sick_scansegment_xd::CustomPointCloudConfiguration::print(void) const
@@ -270,6 +335,7 @@ sick_scansegment_xd::RosMsgpackPublisher::RosMsgpackPublisher(const std::string&
   m_frame_id = config.publish_frame_id;
 	m_node = config.node;
 	m_laserscan_layer_filter = config.laserscan_layer_filter;
+	m_laserscan_azimuth_increment_cfg = (float)(std::max(0.0, config.laserscan_angular_resolution) * M_PI / 180.0);
 	// m_segment_count = config.segment_count;
 	m_all_segments_azimuth_min_deg = (float)config.all_segments_min_deg;
   m_all_segments_azimuth_max_deg = (float)config.all_segments_max_deg;
@@ -403,6 +469,7 @@ sick_scansegment_xd::RosMsgpackPublisher::RosMsgpackPublisher(const std::string&
 			m_custom_pointclouds_cfg.push_back(custom_pointcloud_cfg);
 		}
 	}
+	m_custom_pointclouds_msg.resize(m_custom_pointclouds_cfg.size());
 }
 
 /*
@@ -440,20 +507,18 @@ std::string sick_scansegment_xd::RosMsgpackPublisher::printElevationAzimuthTable
 
 
 /** Prints (elevation,azimuth) values of the coverage table of collected lidar points */
-std::string sick_scansegment_xd::RosMsgpackPublisher::printCoverageTable(const std::map<int, std::map<int, int>>& elevation_azimuth_histograms)
+std::string sick_scansegment_xd::RosMsgpackPublisher::printCoverageTable(const SegmentPointsCollector& points_collector)
 {
 	std::stringstream s;
 	s << "[";
-	for (std::map<int, std::map<int, int>>::const_iterator coverage_elevation_iter = elevation_azimuth_histograms.cbegin(); coverage_elevation_iter != elevation_azimuth_histograms.cend(); coverage_elevation_iter++)
+	for (int row = 0; row < points_collector.coverage_num_rows; row++)
 	{
-		int elevation_mdeg = coverage_elevation_iter->first;
-		const std::map<int, int>& azimuth_histogram = coverage_elevation_iter->second;
-		for (std::map<int, int>::const_iterator coverage_azimuth_iter = azimuth_histogram.cbegin(); coverage_azimuth_iter != azimuth_histogram.cend(); coverage_azimuth_iter++)
+		int elevation_mdeg = points_collector.segment_coverage[row].first;
+		const SegmentPointsCollector::AzimuthCoverage& azimuth_coverage = points_collector.segment_coverage[row].second;
+		for (int azimuth_idx = 0; azimuth_idx < SegmentPointsCollector::COVERAGE_AZIMUTH_BINS; azimuth_idx++)
 		{
-			const int& azimuth_ideg = coverage_azimuth_iter->first;
-			const int& azimuth_cnt = coverage_azimuth_iter->second;
-			if (azimuth_cnt > 0)
-				s << " (" << (elevation_mdeg/1000) << "," << azimuth_ideg << "),";
+			if (azimuth_coverage.test(azimuth_idx))
+				s << " (" << (elevation_mdeg/1000) << "," << (azimuth_idx - SegmentPointsCollector::COVERAGE_AZIMUTH_OFFSET) << "),";
 		}
 	}
 	s << " ]";
@@ -463,14 +528,14 @@ std::string sick_scansegment_xd::RosMsgpackPublisher::printCoverageTable(const s
 /** Shortcut to publish a PointCloud2Msg */
 void sick_scansegment_xd::RosMsgpackPublisher::publishPointCloud2Msg(rosNodePtr node, PointCloud2MsgPublisher& publisher, PointCloud2Msg& pointcloud_msg, int32_t num_echos, int32_t segment_idx, int coordinate_notation)
 {
-  if (coordinate_notation == 0) // coordinateNotation=0: cartesian (default, pointcloud has fields x,y,z,i) => notify cartesian pointcloud listener
+  if (coordinate_notation == 0 && sick_scan_xd::hasCartesianPointcloudListener(node)) // coordinateNotation=0: cartesian (default, pointcloud has fields x,y,z,i) => notify cartesian pointcloud listener
 	{
 		sick_scan_xd::PointCloud2withEcho cloud_msg_with_echo(&pointcloud_msg, num_echos, segment_idx);
 		notifyCartesianPointcloudListener(node, &cloud_msg_with_echo);
 	}
 #if defined RASPBERRY && RASPBERRY > 0 // polar pointcloud deactivated on Raspberry for performance reasons
 #else
-  if (coordinate_notation == 1) // coordinateNotation=1: polar (pointcloud has fields azimuth,elevation,r,i) => notify polar pointcloud listener
+  if (coordinate_notation == 1 && sick_scan_xd::hasPolarPointcloudListener(node)) // coordinateNotation=1: polar (pointcloud has fields azimuth,elevation,r,i) => notify polar pointcloud listener
 	{
 		sick_scan_xd::PointCloud2withEcho cloud_msg_with_echo(&pointcloud_msg, num_echos, segment_idx);
 		notifyPolarPointcloudListener(node, &cloud_msg_with_echo);
@@ -514,112 +579,119 @@ void sick_scansegment_xd::RosMsgpackPublisher::publishLaserScanMsg(rosNodePtr no
 }
 
 /*
-* Converts the lidarpoints to a customized PointCloud2Msg containing configured fields (e.g. x, y, z, i, range, azimuth, elevation, layer, echo, reflector).
+* Converts the lidarpoints to customized PointCloud2Msg containing configured fields (e.g. x, y, z, i, range, azimuth, elevation, layer, echo, reflector).
+* All customized pointclouds with a given update method (fullframe or segmented) are filled in one traversal of the lidar points.
 * @param[in] timestamp_sec seconds part of timestamp
 * @param[in] timestamp_nsec  nanoseconds part of timestamp
-* @param[in] last_timestamp_sec seconds part of last timestamp
-* @param[in] last_timestamp_nsec  nanoseconds part of last timestamp
 * @param[in] lidar_points list of PointXYZRAEI32f: lidar_points[echoIdx] are the points of one echo
-* @param[in] pointcloud_cfg configuration of customized pointcloud
-* @param[out] pointcloud_msg customized pointcloud message
+* @param[in] fullframe true: convert all fullframe pointclouds, false: convert all segmented pointclouds
+* @param[out] pointcloud_msgs customized pointcloud messages, pointcloud_msgs[n] is converted if m_custom_pointclouds_cfg[n] is published with the given update method
 */
-void sick_scansegment_xd::RosMsgpackPublisher::convertPointsToCustomizedFieldsCloud(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points,
-  CustomPointCloudConfiguration& pointcloud_cfg, PointCloud2Msg& pointcloud_msg)
+void sick_scansegment_xd::RosMsgpackPublisher::convertPointsToCustomizedFieldsClouds(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points,
+  bool fullframe, std::vector<PointCloud2Msg>& pointcloud_msgs)
 {
-  // set pointcloud header
-  pointcloud_msg.header.stamp.sec = timestamp_sec;
-#if defined __ROS_VERSION && __ROS_VERSION > 1
-  pointcloud_msg.header.stamp.nanosec = timestamp_nsec;
-#elif defined __ROS_VERSION && __ROS_VERSION > 0
-  pointcloud_msg.header.stamp.nsec = timestamp_nsec;
-#endif
-  pointcloud_msg.header.frame_id = pointcloud_cfg.frameid();
-  // set pointcloud field properties
-	sick_scansegment_xd::PointXYZRAEI32f dummy_lidar_point;
-  std::vector<PointCloudFieldProperty> field_properties;
-	field_properties.reserve(12);
-	if (pointcloud_cfg.fieldEnabled("x"))
-	  field_properties.push_back(PointCloudFieldProperty("x", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.x - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("y"))
-	  field_properties.push_back(PointCloudFieldProperty("y", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.y - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("z"))
-	  field_properties.push_back(PointCloudFieldProperty("z", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.z - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("i"))
-	  field_properties.push_back(PointCloudFieldProperty("i", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.i - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("range"))
-	  field_properties.push_back(PointCloudFieldProperty("range", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.range - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("azimuth"))
-	  field_properties.push_back(PointCloudFieldProperty("azimuth", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.azimuth - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("elevation"))
-	  field_properties.push_back(PointCloudFieldProperty("elevation", PointField::FLOAT32, sizeof(float), (uint8_t*)&dummy_lidar_point.elevation - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("layer"))
-	  field_properties.push_back(PointCloudFieldProperty("layer", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.layer - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("echo"))
-	  field_properties.push_back(PointCloudFieldProperty("echo", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.echo - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("reflector"))
-	  field_properties.push_back(PointCloudFieldProperty("reflector", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.reflectorbit - (uint8_t*)&dummy_lidar_point));
-	if (pointcloud_cfg.fieldEnabled("infringed"))
-	  field_properties.push_back(PointCloudFieldProperty("infringed", PointField::INT8, sizeof(int8_t), (uint8_t*)&dummy_lidar_point.infringed - (uint8_t*)&dummy_lidar_point));
-  int num_fields = field_properties.size();
   size_t max_number_of_points = 0;
   for (int echo_idx = 0; echo_idx < lidar_points.size(); echo_idx++)
   {
 		max_number_of_points += lidar_points[echo_idx].size();
 	}
-  pointcloud_msg.height = 1;
-  pointcloud_msg.width = max_number_of_points;
-  pointcloud_msg.is_bigendian = false;
-  pointcloud_msg.is_dense = true;
-  pointcloud_msg.point_step = 0;
-  pointcloud_msg.fields.resize(num_fields);
-  for (int i = 0; i < num_fields; i++)
+  // Initialize all pointclouds with the given update method
+  pointcloud_msgs.resize(m_custom_pointclouds_cfg.size());
+  std::vector<int>& cloud_indices = m_custom_pointclouds_active; // indices of the pointclouds to convert
+  std::vector<uint8_t*>& cloud_data = m_custom_pointclouds_data; // next destination point in pointcloud_msgs[cloud_indices[n]].data
+  cloud_indices.clear();
+  cloud_data.clear();
+  for (int cloud_cnt = 0; cloud_cnt < m_custom_pointclouds_cfg.size(); cloud_cnt++)
   {
-    pointcloud_msg.fields[i].count = 1;
-    pointcloud_msg.fields[i].name = field_properties[i].name;
-    pointcloud_msg.fields[i].datatype = field_properties[i].datatype;
-    pointcloud_msg.fields[i].offset = pointcloud_msg.point_step;
-		pointcloud_msg.point_step += field_properties[i].datasize;
+    const CustomPointCloudConfiguration& pointcloud_cfg = m_custom_pointclouds_cfg[cloud_cnt];
+    if (!pointcloud_cfg.publish() || pointcloud_cfg.fullframe() != fullframe)
+      continue;
+    PointCloud2Msg& pointcloud_msg = pointcloud_msgs[cloud_cnt];
+    // set pointcloud header
+    pointcloud_msg.header.stamp.sec = timestamp_sec;
+#if defined __ROS_VERSION && __ROS_VERSION > 1
+    pointcloud_msg.header.stamp.nanosec = timestamp_nsec;
+#elif defined __ROS_VERSION && __ROS_VERSION > 0
+    pointcloud_msg.header.stamp.nsec = timestamp_nsec;
+#endif
+    pointcloud_msg.header.frame_id = pointcloud_cfg.frameid();
+    // set pointcloud field properties
+    const std::vector<PointCloudFieldProperty>& field_properties = pointcloud_cfg.fieldProperties();
+    int num_fields = field_properties.size();
+    pointcloud_msg.height = 1;
+    pointcloud_msg.width = max_number_of_points;
+    pointcloud_msg.is_bigendian = false;
+    pointcloud_msg.is_dense = true;
+    pointcloud_msg.point_step = 0;
+    pointcloud_msg.fields.resize(num_fields);
+    for (int i = 0; i < num_fields; i++)
+    {
+      pointcloud_msg.fields[i].count = 1;
+      pointcloud_msg.fields[i].name = field_properties[i].name;
+      pointcloud_msg.fields[i].datatype = field_properties[i].datatype;
+      pointcloud_msg.fields[i].offset = pointcloud_msg.point_step;
+      pointcloud_msg.point_step += field_properties[i].datasize;
+    }
+    pointcloud_msg.row_step = pointcloud_msg.point_step * max_number_of_points;
+    pointcloud_msg.data.resize(pointcloud_msg.row_step * pointcloud_msg.height); // all bytes of a point are overwritten by the packed fields, no need to clear
+    cloud_indices.push_back(cloud_cnt);
+    cloud_data.push_back(pointcloud_msg.data.data());
   }
-  pointcloud_msg.row_step = pointcloud_msg.point_step * max_number_of_points;
-  pointcloud_msg.data.clear();
-  pointcloud_msg.data.resize(pointcloud_msg.row_step * pointcloud_msg.height, 0);
-  // fill pointcloud data
-	int point_cnt = 0;
+  if (cloud_indices.empty())
+    return;
+  // fill pointcloud data of all clouds in one traversal of the lidar points
   for (int echo_idx = 0; echo_idx < lidar_points.size(); echo_idx++)
   {
-    for (int point_idx = 0; point_cnt < max_number_of_points && point_idx < lidar_points[echo_idx].size(); point_idx++)
+    for (int point_idx = 0; point_idx < lidar_points[echo_idx].size(); point_idx++)
     {
-			sick_scansegment_xd::PointXYZRAEI32f cur_lidar_point = lidar_points[echo_idx][point_idx];
-			if (pointcloud_cfg.pointEnabled(cur_lidar_point))
-			{
-				size_t pointcloud_offset = point_cnt * pointcloud_msg.point_step; // offset in bytes in pointcloud_msg.data (destination)
-				const uint8_t* src_lidar_point = (const uint8_t*)(&cur_lidar_point); // pointer to source lidar point (type sick_scansegment_xd::PointXYZRAEI32f)
-				for(int field_idx = 0; field_idx < field_properties.size(); field_idx++)
-				{
-					size_t field_offset = field_properties[field_idx].fieldoffset;
-					for (int n = 0; n < field_properties[field_idx].datasize; n++, pointcloud_offset++, field_offset++)
-					{
-						pointcloud_msg.data[pointcloud_offset] = src_lidar_point[field_offset];
-					}
-				}
-				point_cnt++;
-			}
+      const sick_scansegment_xd::PointXYZRAEI32f& lidar_point = lidar_points[echo_idx][point_idx];
+      for (int n = 0; n < cloud_indices.size(); n++)
+      {
+        CustomPointCloudConfiguration& pointcloud_cfg = m_custom_pointclouds_cfg[cloud_indices[n]];
+        if (!pointcloud_cfg.pointPropertiesEnabled(lidar_point))
+          continue;
+        float range = lidar_point.range;
+        bool range_modified = false;
+        if (!pointcloud_cfg.rangeFilter().apply(range, range_modified))
+          continue;
+        if (range_modified) // range filter modifies range and x,y,z of this cloud only
+        {
+          sick_scansegment_xd::PointXYZRAEI32f modified_lidar_point = lidar_point;
+          modified_lidar_point.range = range;
+          pointcloud_cfg.rangeFilter().applyXYZ(modified_lidar_point.x, modified_lidar_point.y, modified_lidar_point.z, modified_lidar_point.azimuth, modified_lidar_point.elevation);
+          pointcloud_cfg.packPoint(modified_lidar_point, cloud_data[n]);
+        }
+        else
+        {
+          pointcloud_cfg.packPoint(lidar_point, cloud_data[n]);
+        }
+        cloud_data[n] += pointcloud_cfg.pointStep();
+      }
     }
   }
-	// resize pointcloud to actual number of points
-  pointcloud_msg.width = point_cnt;
-  pointcloud_msg.row_step = pointcloud_msg.point_step * point_cnt;
-  pointcloud_msg.data.resize(pointcloud_msg.row_step * pointcloud_msg.height);
-	ROS_DEBUG_STREAM("CustomPointCloudConfiguration " << pointcloud_cfg.cfgName() << ": " << point_cnt << " points per cloud, " << num_fields << " fields per point");
+	// resize pointclouds to actual number of points
+  for (int n = 0; n < cloud_indices.size(); n++)
+  {
+    PointCloud2Msg& pointcloud_msg = pointcloud_msgs[cloud_indices[n]];
+    size_t point_cnt = (pointcloud_msg.point_step > 0) ? ((cloud_data[n] - pointcloud_msg.data.data()) / pointcloud_msg.point_step) : 0;
+    pointcloud_msg.width = point_cnt;
+    pointcloud_msg.row_step = pointcloud_msg.point_step * point_cnt;
+    pointcloud_msg.data.resize(pointcloud_msg.row_step * pointcloud_msg.height);
+	  ROS_DEBUG_STREAM("CustomPointCloudConfiguration " << m_custom_pointclouds_cfg[cloud_indices[n]].cfgName() << ": " << point_cnt << " points per cloud, " << pointcloud_msg.fields.size() << " fields per point");
+  }
 }
 
 /*
  * Converts the lidarpoints from a msgpack to a LaserScan messages for each layer.
+ * The points of each echo and layer are ordered by their azimuth bin, i.e. no sorting is required. The azimuth bins have the
+ * angular resolution configured by parameter "laserscan_angular_resolution" resp. the angular resolution transmitted by the lidar.
+ * If no angular resolution is available, equidistant points are assumed. Points in the same azimuth bin are reported and not
+ * converted. Laserscan messages and their buffers are reused in the next call.
  * @param[in] timestamp_sec seconds part of timestamp
  * @param[in] timestamp_nsec  nanoseconds part of timestamp
  * @param[in] lidar_points list of PointXYZRAEI32f: lidar_points[echoIdx] are the points of one echo
  * @param[in] total_point_count total number of points in all echos
- * @param[out] laser_scan_msg_map laserscan message: ros_sensor_msgs::LaserScan for each echo and layer is laser_scan_msg_map[echo][layer]
+ * @param[out] laser_scan_msg_map laserscan message: ros_sensor_msgs::LaserScan for each echo and layer is laser_scan_msg_map[echo][layer], messages without points have empty ranges
  * @param[in] frame_id frame id of laserscan message, will be expanded to "<frame_id>_<layer_idx>"
  */
 void sick_scansegment_xd::RosMsgpackPublisher::convertPointsToLaserscanMsg(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points, size_t total_point_count,
@@ -627,197 +699,164 @@ void sick_scansegment_xd::RosMsgpackPublisher::convertPointsToLaserscanMsg(uint3
 {
 #if defined RASPBERRY && RASPBERRY > 0 // laserscan messages deactivated on Raspberry for performance reasons
 #else
-  // Split lidar points into echos, layers and segments
-	struct LaserScanMsgPoint
-	{
-	  LaserScanMsgPoint(float _range = 0, float _azimuth = 0, float _i = 0) : range(_range), azimuth(_azimuth), i(_i) {}
-	  LaserScanMsgPoint(const sick_scansegment_xd::PointXYZRAEI32f& lidar_point) : range(lidar_point.range), azimuth(lidar_point.azimuth), i(lidar_point.i) {}
-		float range;     // polar coordinate range in meter
-		float azimuth;   // polar coordinate azimuth in radians
-		float i;         // intensity
-	};
-	typedef std::vector<LaserScanMsgPoint> LaserScanMsgPoints; // list of laserscan points in one segment
-	typedef std::vector<LaserScanMsgPoints> LaserScanMsgSegments; // list of laserscan segments
-  typedef std::map<int,std::map<int,LaserScanMsgSegments>> LaserScanMsgEchoLayerSegments; // LaserScanMsgMap[echo][layer][segment] := laserscan points in one segment
-  typedef std::map<int,std::map<int,LaserScanMsgPoints>> LaserScanMsgEchoLayerSortedPoints; // LaserScanMsgEchoLayerSortedPoints[echo][layer] := sorted list of concatenated laserscan points
-	struct SortSegmentsAscendingAzimuth
-	{
-			bool operator()(const LaserScanMsgPoints& segment1, const LaserScanMsgPoints& segment2) { return !segment1.empty() && !segment2.empty() && segment1[0].azimuth < segment2[0].azimuth; }
-	};
-	struct SortSegmentsDescendingAzimuth
-	{
-			bool operator()(const LaserScanMsgPoints& segment1, const LaserScanMsgPoints& segment2) { return !segment1.empty() && !segment2.empty() && segment1[0].azimuth > segment2[0].azimuth; }
-	};
-	struct ScanPointPrinter
+	// Messages of the last call are reused, messages without points in this call are not published
+	for(LaserScanMsgMap::iterator laser_scan_echo_iter = laser_scan_msg_map.begin(); laser_scan_echo_iter != laser_scan_msg_map.end(); laser_scan_echo_iter++)
 	{
-		static std::string printAzimuthTable(const std::vector<sick_scansegment_xd::PointXYZRAEI32f>& points)
+		for(std::map<int,ros_sensor_msgs::LaserScan>::iterator laser_scan_msg_iter = laser_scan_echo_iter->second.begin(); laser_scan_msg_iter != laser_scan_echo_iter->second.end(); laser_scan_msg_iter++)
 		{
-			std::stringstream s;
-			for (int pointIdx = 0; pointIdx < points.size(); pointIdx++)
-				s << (pointIdx>0?",":"") << std::fixed << std::setprecision(1) << points[pointIdx].azimuth * 180.0 / M_PI;
-			return s.str();
+			laser_scan_msg_iter->second.ranges.clear();
+			laser_scan_msg_iter->second.intensities.clear();
 		}
-		static std::string printAzimuthTable(const LaserScanMsgPoints& points)
+	}
+	// Pass 1: azimuth limits for each echo and layer
+	std::vector<std::vector<LaserScanAccumulator>>& accumulators = m_laserscan_accumulators; // accumulators[echo][layer]
+	if (accumulators.size() < lidar_points.size())
+		accumulators.resize(lidar_points.size());
+	for (int echoIdx = 0; echoIdx < accumulators.size(); echoIdx++)
+	{
+		for (int layerIdx = 0; layerIdx < accumulators[echoIdx].size(); layerIdx++)
+			accumulators[echoIdx][layerIdx].reset();
+	}
+	for (int echoIdx = 0; echoIdx < lidar_points.size(); echoIdx++)
+	{
+		for (int pointIdx = 0; pointIdx < lidar_points[echoIdx].size(); pointIdx++)
 		{
-			std::stringstream s;
-			for (int pointIdx = 0; pointIdx < points.size(); pointIdx++)
-				s << (pointIdx>0?",":"") << std::fixed << std::setprecision(1) << points[pointIdx].azimuth * 180.0 / M_PI;
-			return s.str();
-		}
-	};
-
-  LaserScanMsgEchoLayerSegments points_echo_layer_segment_map;
-  for (int echoIdx = 0; echoIdx < lidar_points.size(); echoIdx++)
-  {
-		int last_layer = INT_MAX;
-		float last_azimuth = FLT_MAX;
-		// if (is_fullframe)
-    //   ROS_INFO_STREAM("convertPointsToLaserscanMsg(" << (is_fullframe ? "fullframe": "segment") << "): echo" << echoIdx << ", unsorted azimuth=[" << ScanPointPrinter::printAzimuthTable(lidar_points[echoIdx]) << "]");
-    for (int pointIdx = 0; pointIdx < lidar_points[echoIdx].size(); pointIdx++)
-    {
 			const sick_scansegment_xd::PointXYZRAEI32f& lidar_point = lidar_points[echoIdx][pointIdx];
 			bool layer_enabled = (m_laserscan_layer_filter.empty() ? 1 : (m_laserscan_layer_filter[lidar_point.layer]));
-			if (layer_enabled)
+			if (layer_enabled && lidar_point.echo >= 0 && lidar_point.layer >= 0 && std::isfinite(lidar_point.azimuth))
 			{
-				LaserScanMsgSegments& point_segment = points_echo_layer_segment_map[lidar_point.echo][lidar_point.layer];
-				if (point_segment.empty() || last_layer != lidar_point.layer || std::abs(last_azimuth - lidar_point.azimuth) > (2.0*M_PI/180.0)) // start of a new segment
-					point_segment.push_back(LaserScanMsgPoints());
-        point_segment.back().push_back(LaserScanMsgPoint(lidar_point)); // append lidar point to last segment
-				last_layer = lidar_point.layer;
-				last_azimuth = lidar_point.azimuth;
+				if (lidar_point.echo >= accumulators.size())
+					accumulators.resize(lidar_point.echo + 1);
+				if (lidar_point.layer >= accumulators[lidar_point.echo].size())
+					accumulators[lidar_point.echo].resize(lidar_point.layer + 1);
+				LaserScanAccumulator& accumulator = accumulators[lidar_point.echo][lidar_point.layer];
+				accumulator.point_cnt++;
+				accumulator.azimuth_min = std::min(accumulator.azimuth_min, lidar_point.azimuth);
+				accumulator.azimuth_max = std::max(accumulator.azimuth_max, lidar_point.azimuth);
 			}
 		}
 	}
-
-	// Sort segments and concatenate points sorted by azimuth
-	LaserScanMsgEchoLayerSortedPoints sorted_points_echo_layer_map;
-	for(std::map<int,std::map<int,LaserScanMsgSegments>>::iterator iter_echos = points_echo_layer_segment_map.begin(); iter_echos != points_echo_layer_segment_map.end(); iter_echos++)
+	// Azimuth bins for all echos and layers
+	for (int echoIdx = 0; echoIdx < accumulators.size(); echoIdx++)
 	{
-		const int& echo = iter_echos->first;
-		for(std::map<int,LaserScanMsgSegments>::iterator iter_layer = iter_echos->second.begin(); iter_layer != iter_echos->second.end(); iter_layer++)
+		for (int layerIdx = 0; layerIdx < accumulators[echoIdx].size(); layerIdx++)
 		{
-			const int& layer = iter_layer->first;
-			LaserScanMsgSegments& segments = iter_layer->second;
-			// All points within a segment should be ordered by ascending azimuth values. Now we have to sort the segments by ascending start azimuth
-			int segment_cnt_azimuth_ascending = 0, segment_cnt_azimuth_descending = 0;
-			for(int segment_cnt = 0; segment_cnt < segments.size(); segment_cnt++)
-			{
-				const LaserScanMsgPoints& segment_points = segments[segment_cnt];
-				segment_cnt_azimuth_ascending += ((segment_points.size() > 1 && segment_points[0].azimuth < segment_points[1].azimuth) ? 1 : 0);
-				segment_cnt_azimuth_descending += ((segment_points.size() > 1 && segment_points[0].azimuth > segment_points[1].azimuth) ? 1 : 0);
-		    // if (is_fullframe)
-    		//   ROS_INFO_STREAM("convertPointsToLaserscanMsg(" << (is_fullframe ? "fullframe": "segment") << "): echo" << echo << ", layer" << layer << ", segment" << segment_cnt << ", unsorted azimuth=[" << ScanPointPrinter::printAzimuthTable(segment_points) << "]");
-			}
-			if(segments.size() > 1)
-			{
-				if(segment_cnt_azimuth_ascending > 0 && segment_cnt_azimuth_descending > 0)
-				{
-					ROS_ERROR_STREAM("## ERROR convertPointsToLaserscanMsg(): " << segment_cnt_azimuth_ascending << " segments ordered by ascending azimuth, " << segment_cnt_azimuth_descending << " segments ordered by descending azimuth");
-					return; // scan points within a segment must be ordered by either ascending or descending azimuth values
-				}
-				if (segment_cnt_azimuth_ascending > 0)
-			    std::sort(segments.begin(), segments.end(), SortSegmentsAscendingAzimuth());
-				else if(segment_cnt_azimuth_descending > 0)
-					std::sort(segments.begin(), segments.end(), SortSegmentsDescendingAzimuth());
-				else
-				{
-					ROS_ERROR_STREAM("## ERROR convertPointsToLaserscanMsg(): " << segment_cnt_azimuth_ascending << " segments ordered by ascending azimuth, " << segment_cnt_azimuth_descending << " segments ordered by descending azimuth");
-					return; // scan points within a segment must be ordered by either ascending or descending azimuth values
-				}
-			}
-			for(int segment_cnt = 0; segment_cnt < segments.size(); segment_cnt++)
-			{
-				const LaserScanMsgPoints& segment_points = segments[segment_cnt];
-			  sorted_points_echo_layer_map[echo][layer].insert(sorted_points_echo_layer_map[echo][layer].end(), segment_points.begin(), segment_points.end());
-		    // if (is_fullframe)
-    		//   ROS_INFO_STREAM("convertPointsToLaserscanMsg(" << (is_fullframe ? "fullframe": "segment") << "): echo" << echo << ", layer" << layer << ", segment" << segment_cnt << ", sorted azimuth=[" << ScanPointPrinter::printAzimuthTable(segment_points) << "]");
-			}
-		  // Verify all points within the current segment have ascending or descending order (debug and verification only)
-			// for(int segment_cnt = 0; segment_cnt < iter_layer->second.size(); segment_cnt++)
-			// {
-			//   const LaserScanMsgPoints& segment_points = segments[segment_cnt];
-			//   bool azimuth_ascending = (segment_points.size() > 1 && segment_points[0].azimuth < segment_points[1].azimuth);
-			//   ROS_INFO_STREAM("convertPointsToLaserscanMsg(" << (is_fullframe ? "fullframe": "segment") << "): echo" << echo << ", layer" << layer << ", segment" << segment_cnt << ": " << segment_points.size() << " points, azimuth in " << (azimuth_ascending ? "ascending":"descending") << " order");
-			//   for(int point_cnt = 1; point_cnt < segment_points.size(); point_cnt++)
-			//   {
-			//   	bool ascending = segment_points[point_cnt - 1].azimuth < segment_points[point_cnt].azimuth;
-			// 	  if (azimuth_ascending != ascending)
-			//      ROS_ERROR_STREAM("## ERROR convertPointsToLaserscanMsg(): echo" << echo << ", layer" << layer << ", segment" << segment_cnt << ": points in segment not ordered by azimuth");
-			//   }
-			// }
-			// Convert to laserscan message, laser_scan_msg = laser_scan_msg_map[layer]
-			LaserScanMsgPoints sorted_points = sorted_points_echo_layer_map[echo][layer];
-			if (!sorted_points.empty())
+			LaserScanAccumulator& accumulator = accumulators[echoIdx][layerIdx];
+			if (accumulator.point_cnt < 2 || accumulator.azimuth_max <= accumulator.azimuth_min)
+				continue; // no laserscan message for this echo and layer
+			// Angular resolution: configuration, or transmitted by the lidar, or equidistant points
+			float azimuth_span = accumulator.azimuth_max - accumulator.azimuth_min;
+			if (m_laserscan_azimuth_increment_cfg > 0)
+				accumulator.azimuth_increment = m_laserscan_azimuth_increment_cfg;
+			else if (layerIdx < m_laserscan_azimuth_increment_lidar.size() && m_laserscan_azimuth_increment_lidar[layerIdx] > 0)
+				accumulator.azimuth_increment = m_laserscan_azimuth_increment_lidar[layerIdx];
+			if (accumulator.azimuth_increment < 1.0e-5f) // no or implausible angular resolution: equidistant points
+				accumulator.azimuth_increment = azimuth_span / (float)(accumulator.point_cnt - 1);
+			accumulator.full_circle = (azimuth_span > (float)(2.0 * M_PI) - 0.5f * accumulator.azimuth_increment);
+			if (accumulator.full_circle) // 360 degree, points beyond azimuth_min + 360 degree wrap around
+				accumulator.num_bins = std::max<int>(2, (int)std::lround((float)(2.0 * M_PI) / accumulator.azimuth_increment));
+			else
+				accumulator.num_bins = std::max<int>(2, (int)std::lround(azimuth_span / accumulator.azimuth_increment) + 1);
+			accumulator.bin_range.resize(accumulator.num_bins);
+			accumulator.bin_intensity.resize(accumulator.num_bins);
+			accumulator.bin_azimuth.resize(accumulator.num_bins);
+			accumulator.bin_used.assign(accumulator.num_bins, 0);
+		}
+	}
+	// Pass 2: write range, intensity and azimuth of all points into their azimuth bin
+	float bin_collision_azimuth_increment = 0;
+	for (int echoIdx = 0; echoIdx < lidar_points.size(); echoIdx++)
+	{
+		for (int pointIdx = 0; pointIdx < lidar_points[echoIdx].size(); pointIdx++)
+		{
+			const sick_scansegment_xd::PointXYZRAEI32f& lidar_point = lidar_points[echoIdx][pointIdx];
+			if (lidar_point.echo < 0 || lidar_point.echo >= accumulators.size() || lidar_point.layer < 0 || lidar_point.layer >= accumulators[lidar_point.echo].size())
+				continue;
+			LaserScanAccumulator& accumulator = accumulators[lidar_point.echo][lidar_point.layer];
+			if (accumulator.num_bins <= 0 || !std::isfinite(lidar_point.azimuth))
+				continue; // layer disabled or no laserscan message for this echo and layer
+			int bin = (int)std::lround((lidar_point.azimuth - accumulator.azimuth_min) / accumulator.azimuth_increment);
+			if (bin >= accumulator.num_bins)
+				bin = (accumulator.full_circle ? (bin % accumulator.num_bins) : (accumulator.num_bins - 1));
+			bin = std::max<int>(0, bin);
+			if (accumulator.bin_used[bin]) // azimuth bin already occupied, the first point is kept
 			{
-				ros_sensor_msgs::LaserScan& laser_scan_msg = laser_scan_msg_map[echo][layer];
-				laser_scan_msg.ranges.clear();
-				laser_scan_msg.intensities.clear();
-				laser_scan_msg.ranges.reserve(sorted_points.size());
-				laser_scan_msg.intensities.reserve(sorted_points.size());
-				laser_scan_msg.angle_min = sorted_points.front().azimuth;
-				laser_scan_msg.angle_max = sorted_points.back().azimuth;
-				laser_scan_msg.range_min = sorted_points.front().range;
-				laser_scan_msg.range_max = sorted_points.front().range;
-				float delta_azimuth_expected = (laser_scan_msg.angle_max - laser_scan_msg.angle_min) / std::max(1.0f, (float)sorted_points.size() - 1.0f);
-				for(int point_cnt = 0; point_cnt < sorted_points.size(); point_cnt++)
-				{
-					laser_scan_msg.ranges.push_back(sorted_points[point_cnt].range);
-				  laser_scan_msg.intensities.push_back(sorted_points[point_cnt].i);
-					laser_scan_msg.range_min = std::min(sorted_points[point_cnt].range, laser_scan_msg.range_min);
-					laser_scan_msg.range_max = std::max(sorted_points[point_cnt].range, laser_scan_msg.range_max);
-		      // Verify all azimuth values monotonously ordered (debug and verification only)
-					// if (point_cnt > 0)
-					// {
-					// 	float delta_azimuth = sorted_points[point_cnt].azimuth - sorted_points[point_cnt - 1].azimuth;
-					// 	if (std::abs(delta_azimuth - delta_azimuth_expected) > 0.1 * M_PI / 180.0)
-					// 	  ROS_ERROR_STREAM("## ERROR convertPointsToLaserscanMsg(): delta_azimuth: " << (delta_azimuth * 180.0 / M_PI) << ", expected: " << (delta_azimuth_expected * 180.0 / M_PI) << ", " << point_cnt << ". point of " << sorted_points.size() << " points");
-					// }
-				}
+				m_laserscan_bin_collisions++;
+				bin_collision_azimuth_increment = accumulator.azimuth_increment;
+				continue;
 			}
+			accumulator.bin_used[bin] = 1;
+			accumulator.bin_range[bin] = lidar_point.range;
+			accumulator.bin_intensity[bin] = lidar_point.i;
+			accumulator.bin_azimuth[bin] = lidar_point.azimuth;
 		}
 	}
-
-  // Create laserscan messages for all echos and layers
+	if (bin_collision_azimuth_increment > 0 && std::chrono::steady_clock::now() - m_laserscan_bin_collisions_warning_time > std::chrono::seconds(10)) // warn at most every 10 seconds
+	{
+		ROS_WARN_STREAM("## WARNING convertPointsToLaserscanMsg(" << (is_fullframe ? "fullframe" : "segment") << "): " << m_laserscan_bin_collisions << " scan points with identical azimuth bin not converted"
+			<< " (angular resolution " << (bin_collision_azimuth_increment * 180.0 / M_PI) << " deg), check parameter laserscan_angular_resolution");
+		m_laserscan_bin_collisions = 0;
+		m_laserscan_bin_collisions_warning_time = std::chrono::steady_clock::now();
+	}
+	// Pass 3: copy the occupied bins in ascending azimuth order to the laserscan messages
 	int num_echos = (int)lidar_points.size();
-	for(LaserScanMsgMap::iterator laser_scan_echo_iter = laser_scan_msg_map.begin(); laser_scan_echo_iter != laser_scan_msg_map.end(); laser_scan_echo_iter++)
+	for (int echoIdx = 0; echoIdx < accumulators.size(); echoIdx++)
 	{
-		int echo_idx = laser_scan_echo_iter->first;
-		std::map<int,ros_sensor_msgs::LaserScan>& laser_scan_layer_map = laser_scan_echo_iter->second;
-		for(std::map<int,ros_sensor_msgs::LaserScan>::iterator laser_scan_msg_iter = laser_scan_layer_map.begin(); laser_scan_msg_iter != laser_scan_layer_map.end(); laser_scan_msg_iter++)
+		for (int layerIdx = 0; layerIdx < accumulators[echoIdx].size(); layerIdx++)
 		{
-			int layer_idx = laser_scan_msg_iter->first;
-			ros_sensor_msgs::LaserScan& laser_scan_msg = laser_scan_msg_iter->second;
-			if (laser_scan_msg.ranges.size() > 1 && laser_scan_msg.angle_max > laser_scan_msg.angle_min)
+			const LaserScanAccumulator& accumulator = accumulators[echoIdx][layerIdx];
+			if (accumulator.num_bins <= 0)
+				continue; // no laserscan message for this echo and layer
+			ros_sensor_msgs::LaserScan& laser_scan_msg = laser_scan_msg_map[echoIdx][layerIdx];
+			laser_scan_msg.ranges.resize(accumulator.point_cnt); // shrinking and clear() do not reallocate
+			laser_scan_msg.intensities.resize(accumulator.point_cnt);
+			size_t point_cnt = 0;
+			float range_min = FLT_MAX, range_max = -FLT_MAX;
+			for (int bin = 0; bin < accumulator.num_bins; bin++)
 			{
-				float angle_diff = laser_scan_msg.angle_max - laser_scan_msg.angle_min;
-				while (angle_diff > (float)(2.0 * M_PI))
-					angle_diff -= (float)(2.0 * M_PI);
-				while (angle_diff < 0)
-					angle_diff += (float)(2.0 * M_PI);
-				laser_scan_msg.angle_increment = angle_diff / (float)(laser_scan_msg.ranges.size() - 1);
-				laser_scan_msg.range_min -= 1.0e-03f;
-				laser_scan_msg.range_max += 1.0e-03f;
-				laser_scan_msg.range_min = std::max(0.0f, laser_scan_msg.range_min);
-				laser_scan_msg.header.stamp.sec = timestamp_sec;
-#if defined __ROS_VERSION && __ROS_VERSION > 1
-				laser_scan_msg.header.stamp.nanosec = timestamp_nsec;
-#elif defined __ROS_VERSION && __ROS_VERSION > 0
-				laser_scan_msg.header.stamp.nsec = timestamp_nsec;
-#endif
-				laser_scan_msg.header.frame_id = frame_id + "_" + std::to_string(layer_idx + 1);
-				if (num_echos > 1)
-				  laser_scan_msg.header.frame_id = laser_scan_msg.header.frame_id + "_" + std::to_string(echo_idx);
-				// scan_time = 1 / scan_frequency = time for a full 360-degree rotation of the sensor
-				laser_scan_msg.scan_time = m_scan_time;
-				// time_increment = 1 / measurement_frequency = scan_time / (number of scan points in a full 360-degree rotation of the sensor)
-				laser_scan_msg.time_increment = laser_scan_msg.scan_time / (float)(laser_scan_msg.ranges.size() * 2.0 * M_PI / angle_diff);
-				// ROS_INFO_STREAM("convert to LaserScan: frame_id=" << laser_scan_msg.header.frame_id << ", num_points=" << laser_scan_msg.ranges.size() << ", angle_min=" << (laser_scan_msg.angle_min * 180.0 / M_PI) << ", angle_max=" << (laser_scan_msg.angle_max * 180.0 / M_PI));
+				if (!accumulator.bin_used[bin])
+					continue;
+				if (point_cnt == 0)
+					laser_scan_msg.angle_min = accumulator.bin_azimuth[bin];
+				laser_scan_msg.angle_max = accumulator.bin_azimuth[bin];
+				laser_scan_msg.ranges[point_cnt] = accumulator.bin_range[bin];
+				laser_scan_msg.intensities[point_cnt] = accumulator.bin_intensity[bin];
+				range_min = std::min(range_min, accumulator.bin_range[bin]);
+				range_max = std::max(range_max, accumulator.bin_range[bin]);
+				point_cnt++;
 			}
-			else
+			laser_scan_msg.ranges.resize(point_cnt);
+			laser_scan_msg.intensities.resize(point_cnt);
+			if (point_cnt < 2 || laser_scan_msg.angle_max <= laser_scan_msg.angle_min)
 			{
 				laser_scan_msg.ranges.clear();
 				laser_scan_msg.intensities.clear();
+				continue;
 			}
+			float angle_diff = laser_scan_msg.angle_max - laser_scan_msg.angle_min;
+			while (angle_diff > (float)(2.0 * M_PI))
+				angle_diff -= (float)(2.0 * M_PI);
+			while (angle_diff < 0)
+				angle_diff += (float)(2.0 * M_PI);
+			laser_scan_msg.angle_increment = angle_diff / (float)(point_cnt - 1);
+			laser_scan_msg.range_min = std::max(0.0f, range_min - 1.0e-03f);
+			laser_scan_msg.range_max = range_max + 1.0e-03f;
+			laser_scan_msg.header.stamp.sec = timestamp_sec;
+#if defined __ROS_VERSION && __ROS_VERSION > 1
+			laser_scan_msg.header.stamp.nanosec = timestamp_nsec;
+#elif defined __ROS_VERSION && __ROS_VERSION > 0
+			laser_scan_msg.header.stamp.nsec = timestamp_nsec;
+#endif
+			m_laserscan_frame_id.assign(frame_id);
+			m_laserscan_frame_id += "_" + std::to_string(layerIdx + 1);
+			if (num_echos > 1)
+				m_laserscan_frame_id += "_" + std::to_string(echoIdx);
+			if (laser_scan_msg.header.frame_id != m_laserscan_frame_id)
+				laser_scan_msg.header.frame_id = m_laserscan_frame_id;
+			// scan_time = 1 / scan_frequency = time for a full 360-degree rotation of the sensor
+			laser_scan_msg.scan_time = m_scan_time;
+			// time_increment = 1 / measurement_frequency = scan_time / (number of scan points in a full 360-degree rotation of the sensor)
+			laser_scan_msg.time_increment = laser_scan_msg.scan_time / (float)(laser_scan_msg.ranges.size() * 2.0 * M_PI / angle_diff);
 		}
 	}
 #endif // !RASPBERRY
@@ -876,38 +915,64 @@ void sick_scansegment_xd::RosMsgpackPublisher::HandleMsgPackData(const sick_scan
 	}
 	// Reorder points in consecutive lidarpoints for echo 0, echo 1 and echo 2 as described in https://github.com/michael1309/sick_lidar3d_pretest/issues/5
 	size_t echo_count = 0;           // number of echos (multiScan136: 1 or 3 echos)
-	size_t point_count_per_echo = 0; // number of points per echo
 	size_t total_point_count = 0;    // total number of points in all echos
 	int32_t segment_idx = msgpack_data.segmentIndex;
 	int32_t telegram_cnt = msgpack_data.telegramCnt;
+	const sick_scansegment_xd::ScanSegmentParserOutput::SegmentPoints& points = msgpack_data.points;
 	for (int groupIdx = 0; groupIdx < msgpack_data.scandata.size(); groupIdx++)
 	{
 		echo_count = std::max(msgpack_data.scandata[groupIdx].scanlines.size(), echo_count);
+	}
+	std::vector<size_t> point_count_echo(echo_count, 0); // number of points per echo
+	for (int groupIdx = 0; groupIdx < msgpack_data.scandata.size(); groupIdx++)
+	{
 		for (int echoIdx = 0; echoIdx < msgpack_data.scandata[groupIdx].scanlines.size(); echoIdx++)
 		{
-			total_point_count += msgpack_data.scandata[groupIdx].scanlines[echoIdx].points.size();
-			point_count_per_echo = std::max(msgpack_data.scandata[groupIdx].scanlines[echoIdx].points.size(), point_count_per_echo);
+			point_count_echo[echoIdx] += msgpack_data.scandata[groupIdx].scanlines[echoIdx].count;
 		}
 	}
+	for (int groupIdx = 0; groupIdx < msgpack_data.scandata.size(); groupIdx++) // angular resolution transmitted by the lidar, kept for the next scans
+	{
+		if (msgpack_data.scandata[groupIdx].azimuthIncrement > 0)
+		{
+			if (groupIdx >= m_laserscan_azimuth_increment_lidar.size())
+				m_laserscan_azimuth_increment_lidar.resize(groupIdx + 1, 0.0f);
+			m_laserscan_azimuth_increment_lidar[groupIdx] = msgpack_data.scandata[groupIdx].azimuthIncrement;
+		}
+	}
+	total_point_count = points.size();
 	float lidar_points_min_azimuth = +2.0f * (float)M_PI, lidar_points_max_azimuth = -2.0f * (float)M_PI;
+	for (size_t n = 0; n < points.size(); n++)
+	{
+		lidar_points_min_azimuth = std::min(lidar_points_min_azimuth, points.azimuth[n]);
+		lidar_points_max_azimuth = std::max(lidar_points_max_azimuth, points.azimuth[n]);
+	}
 	std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>> lidar_points(echo_count);
 	for (int echoIdx = 0; echoIdx < echo_count; echoIdx++)
 	{
-		lidar_points[echoIdx].reserve(point_count_per_echo);
+		lidar_points[echoIdx].resize(point_count_echo[echoIdx]);
+		point_count_echo[echoIdx] = 0;
 	}
 	for (int groupIdx = 0; groupIdx < msgpack_data.scandata.size(); groupIdx++)
 	{
 		for (int echoIdx = 0; echoIdx < msgpack_data.scandata[groupIdx].scanlines.size(); echoIdx++)
 		{
-			const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = msgpack_data.scandata[groupIdx].scanlines[echoIdx].points;
-			for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+			const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = msgpack_data.scandata[groupIdx].scanlines[echoIdx];
+			sick_scansegment_xd::PointXYZRAEI32f* dst = lidar_points[echoIdx].data() + point_count_echo[echoIdx];
+			for (size_t n = scanline.start, n_end = scanline.start + scanline.count; n < n_end; n++, dst++)
 			{
-				const sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
-				lidar_points[echoIdx].push_back(sick_scansegment_xd::PointXYZRAEI32f(point.x, point.y, point.z, point.range,
-				   point.azimuth, point.elevation, point.i, point.groupIdx, point.echoIdx, point.reflectorbit));
-				lidar_points_min_azimuth = std::min(lidar_points_min_azimuth, point.azimuth);
-				lidar_points_max_azimuth = std::max(lidar_points_max_azimuth, point.azimuth);
+				dst->x = points.x[n];
+				dst->y = points.y[n];
+				dst->z = points.z[n];
+				dst->range = points.range[n];
+				dst->azimuth = points.azimuth[n];
+				dst->elevation = points.elevation[n];
+				dst->i = points.i[n];
+				dst->layer = points.layer[n];
+				dst->echo = points.echo[n];
+				dst->reflectorbit = (points.flags[n] & sick_scansegment_xd::ScanSegmentParserOutput::SegmentPoints::FLAG_REFLECTOR);
 			}
+			point_count_echo[echoIdx] += scanline.count;
 		}
 	}
 
@@ -944,28 +1009,27 @@ void sick_scansegment_xd::RosMsgpackPublisher::HandleMsgPackData(const sick_scan
 				// publish 360 degree point cloud
 				// scan_time = 1 / scan_frequency = time for a full 360-degree rotation of the sensor
 				m_scan_time = (msgpack_data.timestamp_sec + 1.0e-9 * msgpack_data.timestamp_nsec) - (m_points_collector.timestamp_sec + 1.0e-9 * m_points_collector.timestamp_nsec);
+				convertPointsToCustomizedFieldsClouds(m_points_collector.timestamp_sec, m_points_collector.timestamp_nsec, m_points_collector.lidar_points, true, m_custom_pointclouds_msg);
 				for (int cloud_cnt = 0; cloud_cnt < m_custom_pointclouds_cfg.size(); cloud_cnt++)
 				{
 					CustomPointCloudConfiguration& custom_pointcloud_cfg = m_custom_pointclouds_cfg[cloud_cnt];
 					if (custom_pointcloud_cfg.publish() && custom_pointcloud_cfg.fullframe())
 					{
-						PointCloud2Msg pointcloud_msg_custom_fields;
-						convertPointsToCustomizedFieldsCloud(m_points_collector.timestamp_sec, m_points_collector.timestamp_nsec, m_points_collector.lidar_points, custom_pointcloud_cfg, pointcloud_msg_custom_fields);
+						PointCloud2Msg& pointcloud_msg_custom_fields = m_custom_pointclouds_msg[cloud_cnt];
 						publishPointCloud2Msg(m_node, custom_pointcloud_cfg.publisher(), pointcloud_msg_custom_fields, std::max(1, (int)echo_count), -1, custom_pointcloud_cfg.coordinateNotation());
 						// ROS_INFO_STREAM("RosMsgpackPublisher::HandleMsgPackData(): published " << pointcloud_msg_custom_fields.width << "x" << pointcloud_msg_custom_fields.height << " pointcloud, " << pointcloud_msg_custom_fields.fields.size() << " fields/point, " << pointcloud_msg_custom_fields.data.size() << " bytes");
 					}
 				}
 				// publish 360 degree Laserscan message
-				LaserScanMsgMap laser_scan_msg_map; // laser_scan_msg_map[echo][layer] := LaserScan message given echo (Multiscan136: max 3 echos) and layer index (Multiscan136: 16 layer)
-				convertPointsToLaserscanMsg(m_points_collector.timestamp_sec, m_points_collector.timestamp_nsec, m_points_collector.lidar_points, m_points_collector.total_point_count, laser_scan_msg_map, m_frame_id, true);
-				publishLaserScanMsg(m_node, m_publisher_laserscan_360, laser_scan_msg_map, std::max(1, (int)echo_count), -1);
+				convertPointsToLaserscanMsg(m_points_collector.timestamp_sec, m_points_collector.timestamp_nsec, m_points_collector.lidar_points, m_points_collector.total_point_count, m_laser_scan_msg_map_fullframe, m_frame_id, true);
+				publishLaserScanMsg(m_node, m_publisher_laserscan_360, m_laser_scan_msg_map_fullframe, std::max(1, (int)echo_count), -1);
 			}
 			// Start a new 360 degree collection
-			m_points_collector = SegmentPointsCollector(telegram_cnt);
+			m_points_collector.reset(telegram_cnt);
 			m_points_collector.timestamp_sec = msgpack_data.timestamp_sec;
 			m_points_collector.timestamp_nsec = msgpack_data.timestamp_nsec;
 			m_points_collector.total_point_count = total_point_count;
-			m_points_collector.lidar_points = std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>(lidar_points.size());
+			m_points_collector.lidar_points.resize(lidar_points.size());
 			for (int echoIdx = 0; echoIdx < lidar_points.size(); echoIdx++)
 				m_points_collector.lidar_points[echoIdx].reserve(12 * lidar_points[echoIdx].size());
 			m_points_collector.appendLidarPoints(lidar_points, segment_idx, telegram_cnt);
@@ -975,7 +1039,7 @@ void sick_scansegment_xd::RosMsgpackPublisher::HandleMsgPackData(const sick_scan
 		  // ROS_INFO_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, lidar_points_min_azimuth=" << (lidar_points_min_azimuth * 180.0f / M_PI) << ", lidar_points_max_azimuth=" << (lidar_points_max_azimuth* 180.0f / M_PI));
   		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, azimuth table = " << printElevationAzimuthTable(lidar_points));
     	// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected azimuth table = " << printElevationAzimuthTable(m_points_collector.lidar_points));
-  		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected coverage table = " << printCoverageTable(m_points_collector.segment_coverage));
+  		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected coverage table = " << printCoverageTable(m_points_collector));
 		}
 		else if (telegram_cnt > m_points_collector.telegram_cnt) // append lidar points to m_points_collector
 		{
@@ -990,7 +1054,7 @@ void sick_scansegment_xd::RosMsgpackPublisher::HandleMsgPackData(const sick_scan
 		  // ROS_INFO_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, lidar_points_min_azimuth=" << (lidar_points_min_azimuth * 180.0f / M_PI) << ", lidar_points_max_azimuth=" << (lidar_points_max_azimuth* 180.0f / M_PI));
   		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, azimuth table = " << printElevationAzimuthTable(lidar_points));
     	// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected azimuth table = " << printElevationAzimuthTable(m_points_collector.lidar_points));
-  		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected coverage table = " << printCoverageTable(m_points_collector.segment_coverage));
+  		// ROS_DEBUG_STREAM("    RosMsgpackPublisher::HandleMsgPackData(): appendLidarPoints, collected coverage table = " << printCoverageTable(m_points_collector));
 		}
 		else
 		{
@@ -1014,28 +1078,27 @@ void sick_scansegment_xd::RosMsgpackPublisher::HandleMsgPackData(const sick_scan
 					}
 					last_print_timestamp = fifo_clock::now();
 			}
-			m_points_collector = SegmentPointsCollector(telegram_cnt); // reset pointcloud collector
+			m_points_collector.reset(telegram_cnt); // reset pointcloud collector
 		}
 		// ROS_INFO_STREAM("RosMsgpackPublisher::HandleMsgPackData(): segment_idx " << segment_idx << " of " << m_segment_count << ", " << m_points_collector.total_point_count << " points in collector");
 	}
 
 	// Publish PointCloud2 message for the current segment
+	convertPointsToCustomizedFieldsClouds(msgpack_data.timestamp_sec, msgpack_data.timestamp_nsec, lidar_points, false, m_custom_pointclouds_msg);
 	for (int cloud_cnt = 0; cloud_cnt < m_custom_pointclouds_cfg.size(); cloud_cnt++)
 	{
 		CustomPointCloudConfiguration& custom_pointcloud_cfg = m_custom_pointclouds_cfg[cloud_cnt];
 		if (custom_pointcloud_cfg.publish() && !custom_pointcloud_cfg.fullframe())
 		{
-			PointCloud2Msg pointcloud_msg_custom_fields;
-			convertPointsToCustomizedFieldsCloud(msgpack_data.timestamp_sec, msgpack_data.timestamp_nsec, lidar_points, custom_pointcloud_cfg, pointcloud_msg_custom_fields);
+			PointCloud2Msg& pointcloud_msg_custom_fields = m_custom_pointclouds_msg[cloud_cnt];
 			publishPointCloud2Msg(m_node, custom_pointcloud_cfg.publisher(), pointcloud_msg_custom_fields, std::max(1, (int)echo_count), segment_idx, custom_pointcloud_cfg.coordinateNotation());
 			ROS_DEBUG_STREAM("publishPointCloud2Msg: " << pointcloud_msg_custom_fields.width << "x" << pointcloud_msg_custom_fields.height << " pointcloud, " << pointcloud_msg_custom_fields.fields.size() << " fields/point, " << pointcloud_msg_custom_fields.data.size() << " bytes");
 		}
 	}
 #if defined RASPBERRY && RASPBERRY > 0 // laserscan messages deactivated on Raspberry for performance reasons
 #else
-	LaserScanMsgMap laser_scan_msg_map; // laser_scan_msg_map[echo][layer] := LaserScan message given echo (Multiscan136: max 3 echos) and layer index (Multiscan136: 16 layer)
-	convertPointsToLaserscanMsg(msgpack_data.timestamp_sec, msgpack_data.timestamp_nsec, lidar_points, total_point_count, laser_scan_msg_map, m_frame_id, false);
-	publishLaserScanMsg(m_node, m_publisher_laserscan_segment, laser_scan_msg_map, std::max(1, (int)echo_count), segment_idx);
+	convertPointsToLaserscanMsg(msgpack_data.timestamp_sec, msgpack_data.timestamp_nsec, lidar_points, total_point_count, m_laser_scan_msg_map_segment, m_frame_id, false);
+	publishLaserScanMsg(m_node, m_publisher_laserscan_segment, m_laser_scan_msg_map_segment, std::max(1, (int)echo_count), segment_idx);
 #endif
 }
 
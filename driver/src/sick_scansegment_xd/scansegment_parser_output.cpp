@@ -13,13 +13,13 @@
  *
  * for (int groupIdx = 0; groupIdx < scansegment_output.scandata.size(); groupIdx++)
  * {
- * 	 for (int echoIdx = 0; echoIdx < scansegment_output.scandata[groupIdx].size(); echoIdx++)
+ * 	 for (int echoIdx = 0; echoIdx < scansegment_output.scandata[groupIdx].scanlines.size(); echoIdx++)
  * 	 {
- * 	   std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = scansegment_output.scandata[groupIdx][echoIdx];
+ * 	   const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = scansegment_output.scandata[groupIdx].scanlines[echoIdx];
  * 	   std::cout << (groupIdx + 1) << ". group, " << (echoIdx + 1) << ". echo: ";
- * 	   for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+ * 	   for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
  * 	   {
- * 		  sick_scansegment_xd::ScanSegmentParserOutput::PointXYZI& point = scanline[pointIdx];
+ * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = scansegment_output.points.get(scanline.start + pointIdx);
  * 		  std::cout << (pointIdx > 0 ? "," : "") << "(" << point.x << "," << point.y << "," << point.z << "," << point.i << ")";
  * 	   }
  * 	   std::cout << std::endl;
@@ -80,6 +80,7 @@
 #include "sick_scan/sick_ros_wrapper.h"
 #include "sick_scansegment_xd/common.h"
 #include "sick_scansegment_xd/scansegment_parser_output.h"
+#include "sick_scan/softwarePLL.h"
 
 /*
 * @brief Default constructor of class ScanSegmentParserOutput. 
@@ -87,10 +88,68 @@
 * In case of multiScan136, ScanSegmentParserOutput has 16 groups (layers), each group has 3 echos, each echo has a list of LidarPoint data in catesian coordinates
 * (x, y, z in meter and intensity). In case of picoScan, ScanSegmentParserOutput has 1 layer.
 */
-sick_scansegment_xd::ScanSegmentParserOutput::ScanSegmentParserOutput() : timestamp(""), timestamp_sec(0), timestamp_nsec(0), segmentIndex(0), telegramCnt(0) 
+sick_scansegment_xd::ScanSegmentParserOutput::ScanSegmentParserOutput() : timestamp(""), timestamp_sec(0), timestamp_nsec(0), segmentIndex(0), telegramCnt(0), sensorTicksValid(false), sensorTicks(0), scangroupTicksValid(false)
 {
 }
 
+/*
+ * @brief Removes all scandata and points and resets timestamps and counters. The point arrays keep their capacity for reuse.
+ */
+void sick_scansegment_xd::ScanSegmentParserOutput::Clear(void)
+{
+	scandata.clear();
+	points.clear();
+	imudata = CompactImuData();
+	timestamp.clear();
+	timestamp_sec = 0;
+	timestamp_nsec = 0;
+	segmentIndex = 0;
+	telegramCnt = 0;
+	sensorTicksValid = false;
+	sensorTicks = 0;
+	scangroupTicksValid = false;
+}
+
+/*
+ * @brief Updates the software pll with the sensor ticks and converts the sensor ticks to system time. The software pll has to be
+ * updated in order of arrival, i.e. ApplySoftwarePLL is called by the parser (use_software_pll = true) or, if segments are
+ * parsed in parallel, by MsgPackConverter in order of arrival.
+ */
+bool sick_scansegment_xd::ScanSegmentParserOutput::ApplySoftwarePLL(const std::chrono::system_clock::time_point& system_timestamp, bool verbose)
+{
+	SoftwarePLL& software_pll = SoftwarePLL::instance();
+	int64_t systemtime_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(system_timestamp.time_since_epoch()).count();
+	uint32_t systemtime_sec = (uint32_t)(systemtime_nanoseconds / 1000000000);  // seconds part of system timestamp
+	uint32_t systemtime_nsec = (uint32_t)(systemtime_nanoseconds % 1000000000); // nanoseconds part of system timestamp
+	if (sensorTicksValid)
+	{
+		software_pll.updatePLL(systemtime_sec, systemtime_nsec, sensorTicks);
+	}
+	if (!software_pll.IsInitialized())
+	{
+		if (verbose && sensorTicksValid)
+			ROS_INFO_STREAM("ScanSegmentParserOutput::ApplySoftwarePLL(): sensor_ticks=" << sensorTicks << ", system_time=" << sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec) << " sec, SoftwarePLL not yet initialized");
+		return false;
+	}
+	if (sensorTicksValid)
+	{
+		software_pll.getCorrectedTimeStamp(timestamp_sec, timestamp_nsec, sensorTicks);
+		timestamp = sick_scansegment_xd::Timestamp(timestamp_sec, timestamp_nsec);
+		if (verbose)
+			ROS_INFO_STREAM("ScanSegmentParserOutput::ApplySoftwarePLL(): sensor_ticks=" << sensorTicks << ", system_time=" << sick_scansegment_xd::Timestamp(systemtime_sec, systemtime_nsec) << " sec, timestamp=" << timestamp << " sec");
+	}
+	if (scangroupTicksValid)
+	{
+		for (size_t groupIdx = 0; groupIdx < scandata.size(); groupIdx++)
+		{
+			Scangroup& scangroup = scandata[groupIdx];
+			software_pll.getCorrectedTimeStamp(scangroup.timestampStart_sec, scangroup.timestampStart_nsec, scangroup.timestampStart_ticks);
+			software_pll.getCorrectedTimeStamp(scangroup.timestampStop_sec, scangroup.timestampStop_nsec, scangroup.timestampStop_ticks);
+		}
+	}
+	return true;
+}
+
 /*
  * @brief return a formatted timestamp "<sec>.<millisec>".
  * @param[in] sec second part of timestamp
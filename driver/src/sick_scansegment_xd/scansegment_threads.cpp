@@ -62,6 +62,7 @@
 #include "sick_scansegment_xd/scansegment_parser_output.h"
 #include "sick_scansegment_xd/udp_receiver.h"
 #include "sick_scan/sick_scan_services.h"
+#include "sick_scan/sick_socket_reactor.h"
 
 #define DELETE_PTR(p) do{if(p){delete(p);(p)=0;}}while(false)
 
@@ -199,7 +200,7 @@ bool sick_scansegment_xd::MsgPackThreads::runThreadCb(void)
         while(udp_receiver == 0)
         {
             udp_receiver = new sick_scansegment_xd::UdpReceiver();
-            if(udp_receiver->Init(m_config.udp_sender, m_config.udp_port, m_config.udp_input_fifolength, m_config.verbose_level > 1, m_config.export_udp_msg, m_config.scandataformat, 0))
+            if(udp_receiver->Init(m_config.udp_sender, m_config.udp_port, m_config.udp_input_fifolength, m_config.verbose_level > 1, m_config.export_udp_msg, m_config.scandataformat, 0, m_config.udp_recv_batch_size))
             {
                 ROS_INFO_STREAM("sick_scansegment_xd: udp socket to " << m_config.udp_sender << ":" << m_config.udp_port << " initialized");
             }
@@ -217,7 +218,7 @@ bool sick_scansegment_xd::MsgPackThreads::runThreadCb(void)
         while(m_config.imu_enable && m_config.scandataformat == SCANDATA_COMPACT && udp_receiver_imu == 0)
         {
             udp_receiver_imu = new sick_scansegment_xd::UdpReceiver();
-            if(udp_receiver_imu->Init(m_config.udp_sender, m_config.imu_udp_port, m_config.udp_input_fifolength, m_config.verbose_level > 1, m_config.export_udp_msg, m_config.scandataformat, udp_receiver->Fifo())) // udp receiver for scan and imu data share the same fifo
+            if(udp_receiver_imu->Init(m_config.udp_sender, m_config.imu_udp_port, m_config.udp_input_fifolength, m_config.verbose_level > 1, m_config.export_udp_msg, m_config.scandataformat, udp_receiver->Fifo(), m_config.udp_recv_batch_size)) // udp receiver for scan and imu data share the same fifo
             {
                 // m_config.imu_latency_microsec
                 ROS_INFO_STREAM("sick_scansegment_xd: udp socket to " << m_config.udp_sender << ":" << m_config.imu_udp_port << " initialized");
@@ -237,6 +238,9 @@ bool sick_scansegment_xd::MsgPackThreads::runThreadCb(void)
         sick_scansegment_xd::MsgPackConverter msgpack_converter(scansegment_parser_config, m_config.add_transform_xyz_rpy, udp_receiver->Fifo(), m_config.scandataformat, m_config.msgpack_output_fifolength, m_config.verbose_level > 1);
         assert(udp_receiver->Fifo());
         assert(msgpack_converter.Fifo());
+        udp_receiver->Fifo()->SetSpinCount(m_config.fifo_spin_count);
+        msgpack_converter.Fifo()->SetSpinCount(m_config.fifo_spin_count);
+        msgpack_converter.SetNumWorkers(m_config.msgpack_converter_threads);
 
         // Initialize msgpack exporter and publisher
         sick_scansegment_xd::MsgPackExporter msgpack_exporter(udp_receiver->Fifo(), msgpack_converter.Fifo(), m_config.logfolder, m_config.export_csv, m_config.verbose_level > 0, m_config.measure_timing);
@@ -244,6 +248,11 @@ bool sick_scansegment_xd::MsgPackThreads::runThreadCb(void)
         msgpack_exporter.AddExportListener(ros_msgpack_publisher->ExportListener());
         sick_scansegment_xd::MsgPackExportListenerIF* listener = ros_msgpack_publisher->ExportListener();
 
+        // Optionally receive udp packages by the process-wide socket reactor (default: one background thread per udp receiver)
+        udp_receiver->SetSocketReactor(sick_scan_xd::SocketReactor::sharedInstance(m_config.io_reactor_threads));
+        if (udp_receiver_imu)
+            udp_receiver_imu->SetSocketReactor(sick_scan_xd::SocketReactor::sharedInstance(m_config.io_reactor_threads));
+
         // Run udp receiver, msgpack converter and msgpack exporter in background tasks
         if (msgpack_converter.Start() && udp_receiver->Start() && msgpack_exporter.Start())
         {
@@ -57,33 +57,21 @@
 
 #include "sick_scansegment_xd/config.h"
 #include "sick_scansegment_xd/compact_parser.h"
+#include "sick_scansegment_xd/crc32.h"
 #include "sick_scansegment_xd/fifo.h"
 #include "sick_scansegment_xd/udp_receiver.h"
 #include "sick_scansegment_xd/udp_sockets.h"
-
-/*
- * Computes the zlib CRC32 checksum, see https://stackoverflow.com/questions/15030011/same-crc32-for-python-and-c
- */
-static uint32_t crc32(uint32_t crc, const uint8_t* buf, size_t len)
-{
-    crc = ~crc;
-    while (len--)
-    {
-        crc ^= *buf++;
-        for (int k = 0; k < 8; k++)
-            crc = crc & 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
-    }
-    return ~crc;
-}
-
-
+#include "sick_scan/sick_socket_reactor.h"
 
 /*
  * @brief Default constructor.
  */
 sick_scansegment_xd::UdpReceiver::UdpReceiver() : m_verbose(false), m_export_udp_msg(false), m_socket_impl(0), m_fifo_impl(0), m_fifo_impl_created(false), m_receiver_thread(0), m_run_receiver_thread(false),
-    m_udp_recv_buffer_size(0), m_udp_timeout_recv_nonblocking(0), m_udp_sender_timeout(0)
+    m_udp_recv_buffer_size(0), m_udp_timeout_recv_nonblocking(0), m_udp_sender_timeout(0), m_udp_recv_counter(0), m_reactor(0), m_reactor_registered(false), m_frame_bytes(0)
 {
+    m_timestamp_last_print = chrono_system_clock::now();
+    m_timestamp_last_print_crc_error = m_timestamp_last_print;
+    m_frame_timestamp = m_timestamp_last_print;
 }
 
 /*
@@ -102,8 +90,10 @@ sick_scansegment_xd::UdpReceiver::~UdpReceiver()
  * @param[in] verbose true: enable debug output, false: quiet mode (default)
  * @param[in] export_udp_msg: true: export binary udp and msgpack data to file (*.udp and *.msg), default: false
  * @param[in] scandataformat ScanDataFormat: 1 for msgpack or 2 for compact scandata, default: 1
+ * @param[in] PayloadFifo* fifo: Fifo to handle payload data
+ * @param[in] udp_recv_batch_size max. number of udp datagrams received by one recvmmsg syscall using kernel receive timestamps (Linux only), default: 0 (one recv call per datagram)
  */
-bool sick_scansegment_xd::UdpReceiver::Init(const std::string& udp_sender, int udp_port, int udp_input_fifolength, bool verbose, bool export_udp_msg, int scandataformat, PayloadFifo* fifo)
+bool sick_scansegment_xd::UdpReceiver::Init(const std::string& udp_sender, int udp_port, int udp_input_fifolength, bool verbose, bool export_udp_msg, int scandataformat, PayloadFifo* fifo, int udp_recv_batch_size)
 {
     if (m_socket_impl || m_fifo_impl || m_receiver_thread)
         Close();
@@ -141,6 +131,10 @@ bool sick_scansegment_xd::UdpReceiver::Init(const std::string& udp_sender, int u
         ROS_ERROR_STREAM("## ERROR UdpReceiver::Init(): UdpReceiverSocketImpl::Init(" << udp_sender << "," << udp_port << ") failed.");
         return false;
     }
+    if (udp_recv_batch_size > 1 && !m_socket_impl->InitBatchReceive(udp_recv_batch_size, m_udp_recv_buffer_size))
+    {
+        ROS_WARN_STREAM("## WARNING UdpReceiver::Init(): batched udp receive not supported, udp_recv_batch_size=" << udp_recv_batch_size << " ignored");
+    }
     return true;
 }
 
@@ -150,6 +144,15 @@ bool sick_scansegment_xd::UdpReceiver::Init(const std::string& udp_sender, int u
 bool sick_scansegment_xd::UdpReceiver::Start(void)
 {
     m_run_receiver_thread = true;
+    if (m_reactor && m_socket_impl && !m_reactor_registered)
+    {
+        m_reactor_datagram.resize(m_udp_recv_buffer_size);
+        m_frame_bytes = 0;
+        m_reactor_registered = m_reactor->addSocket((int)m_socket_impl->SocketHandle(), std::bind(&sick_scansegment_xd::UdpReceiver::OnSocketReadable, this));
+        if (m_reactor_registered)
+            return true;
+        ROS_WARN_STREAM("## WARNING UdpReceiver::Start(): SocketReactor::addSocket() failed, receiving udp packages on port " << m_socket_impl->port() << " in a background thread");
+    }
     m_receiver_thread = new std::thread(&sick_scansegment_xd::UdpReceiver::Run, this);
     return true;
 }
@@ -160,6 +163,7 @@ bool sick_scansegment_xd::UdpReceiver::Start(void)
 void sick_scansegment_xd::UdpReceiver::Stop(bool do_join)
 {
     m_run_receiver_thread = false;
+    RemoveFromReactor();
     if (do_join && m_receiver_thread && m_receiver_thread->joinable())
         m_receiver_thread->join();
 }
@@ -170,6 +174,7 @@ void sick_scansegment_xd::UdpReceiver::Stop(bool do_join)
 void sick_scansegment_xd::UdpReceiver::Close(void)
 {
     m_run_receiver_thread = false;
+    RemoveFromReactor();
     if (m_fifo_impl && m_fifo_impl_created)
     {
         m_fifo_impl->Shutdown();
@@ -206,23 +211,19 @@ bool sick_scansegment_xd::UdpReceiver::Run(void)
     }
     try
     {
-        size_t udp_recv_counter = 0;
         std::vector<uint8_t> udp_payload(m_udp_recv_buffer_size, 0);
+        std::vector<uint8_t> chunk_payload(m_udp_recv_buffer_size, 0);
         double udp_recv_timeout = -1; // initial timeout: block until first datagram received
-        chrono_system_time timestamp_last_print = chrono_system_clock::now();
-        chrono_system_time timestamp_last_print_crc_error = chrono_system_clock::now();
         chrono_system_time timestamp_last_udp_recv = chrono_system_clock::now();
         while (m_run_receiver_thread)
         {
             size_t bytes_received = m_socket_impl->Receive(udp_payload, udp_recv_timeout, m_udp_msg_start_seq);
-            bool do_print = (sick_scansegment_xd::Seconds(timestamp_last_print, chrono_system_clock::now()) > 1.0); // avoid printing with more than 1 Hz
-            bool do_print_crc_error = (sick_scansegment_xd::Seconds(timestamp_last_print_crc_error, chrono_system_clock::now()) > 1.0); // avoid printing crc errors with more than 1 Hz
+            bool do_print = (sick_scansegment_xd::Seconds(m_timestamp_last_print, chrono_system_clock::now()) > 1.0); // avoid printing with more than 1 Hz
             // std::cout << "UdpReceiver::Run(): " << bytes_received << " bytes received" << std::endl;
             ROS_DEBUG_STREAM("UdpReceiver::Run(): " << bytes_received << " bytes received (port " << m_socket_impl->port() << ", udp_receiver.cpp:" << __LINE__ << ")");
             if(bytes_received > m_udp_msg_start_seq.size() + 8 && std::equal(udp_payload.begin(), udp_payload.begin() + m_udp_msg_start_seq.size(), m_udp_msg_start_seq.begin()))
             {
                 // Received \x02\x02\x02\x02 | 4Bytes payload length | Payload | CRC32
-                bool crc_error = false, check_crc = true;
                 uint32_t payload_length_bytes = 0;
                 uint32_t bytes_to_receive = 0;
                 uint32_t udp_payload_offset = 0;
@@ -254,11 +255,12 @@ bool sick_scansegment_xd::UdpReceiver::Run(void)
                         while(m_run_receiver_thread && bytes_received < num_bytes_required  + sizeof(uint32_t) && // payload + 4 byte CRC required
                         (udp_recv_timeout < 0 || sick_scansegment_xd::Seconds(recv_start_timestamp, chrono_system_clock::now()) < udp_recv_timeout)) // read blocking (udp_recv_timeout < 0) or udp_recv_timeout in seconds
                         {
-                            std::vector<uint8_t> chunk_payload(m_udp_recv_buffer_size, 0);
                             size_t chunk_bytes_received = m_socket_impl->Receive(chunk_payload);
                             if (m_verbose)
                                 ROS_INFO_STREAM("UdpReceiver::Run(): chunk of " << chunk_bytes_received << " bytes received (udp_receiver.cpp:" << __LINE__ << ")");
-                            udp_payload.insert(udp_payload.begin() + bytes_received, chunk_payload.begin(), chunk_payload.begin() + chunk_bytes_received);
+                            if (udp_payload.size() < bytes_received + chunk_bytes_received)
+                                udp_payload.resize(bytes_received + chunk_bytes_received);
+                            std::copy(chunk_payload.begin(), chunk_payload.begin() + chunk_bytes_received, udp_payload.begin() + bytes_received);
                             bytes_received += chunk_bytes_received;
                         }
                     }
@@ -278,67 +280,9 @@ bool sick_scansegment_xd::UdpReceiver::Run(void)
                     m_run_receiver_thread = false;
                     return false;
                 }
-                if (bytes_received != bytes_to_receive)
-                {
-                    if (bytes_received < bytes_to_receive)
-                    {
-                        ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): " << bytes_received << " bytes received, " << bytes_to_receive << " bytes expected, payload_length=" << payload_length_bytes << " bytes");
-                        timestamp_last_print = chrono_system_clock::now();
-                    }
-                    else if(m_verbose)
-                    {
-                        ROS_INFO_STREAM("UdpReceiver::Run(): " << bytes_received << " bytes received, " << bytes_to_receive << " bytes expected, payload_length=" << payload_length_bytes << " bytes");
-                        timestamp_last_print = chrono_system_clock::now();
-                    }
-                }
-                // std::cout << "UdpReceiver: payload_length_bytes = " << payload_length_bytes << " byte" << std::endl;
-                // CRC check
-                size_t bytes_valid = std::min<size_t>(bytes_received, (size_t)bytes_to_receive);
-                uint32_t u32PayloadCRC = Convert4Byte(udp_payload.data() + bytes_valid - sizeof(uint32_t)); // last 4 bytes are CRC
-                std::vector<uint8_t> msgpack_payload(udp_payload.begin() + udp_payload_offset, udp_payload.begin() + bytes_valid - sizeof(uint32_t));
-                uint32_t u32MsgPackCRC = crc32(0, msgpack_payload.data(), msgpack_payload.size());
-                if (check_crc && u32PayloadCRC != u32MsgPackCRC)
-                {
-                    crc_error = true;
-                    if (do_print_crc_error)
-                    {
-                        ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): CRC 0x" << std::setfill('0') << std::setw(2) << std::hex << u32PayloadCRC
-                            << " received from " << std::dec << (bytes_valid - sizeof(uint32_t)) << " udp bytes different to CRC 0x"
-                            << std::setfill('0') << std::setw(2) << std::hex << u32MsgPackCRC << " computed from "
-                            << std::dec << (msgpack_payload.size()) << " byte payload, message dropped");
-                        ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): decoded payload size: " << payload_length_bytes << " bytes, bytes_to_receive (expected udp message length): "
-                            << bytes_to_receive << " byte, bytes_valid (received udp message length): " << bytes_valid << " byte");
-                        timestamp_last_print_crc_error = chrono_system_clock::now();
-                    }
-                    continue;
-                }
-                if (payload_length_bytes != msgpack_payload.size() && do_print)
-                {
-                    ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): payload_length_bytes=" << payload_length_bytes << " different to decoded payload size " << msgpack_payload.size());
-                    timestamp_last_print = chrono_system_clock::now();
-                }
-                // Push msgpack_payload to input fifo
-                if (!crc_error)
-                {
-                    size_t fifo_length = m_fifo_impl->Push(msgpack_payload, fifo_clock::now(), udp_recv_counter);
-                    udp_recv_counter++;
-                    if (m_verbose && do_print)
-                    {
-                        ROS_INFO_STREAM("UdpReceiver::Run(): " << bytes_received << " bytes received: " << ToPrintableString(udp_payload, bytes_received));
-                        ROS_INFO_STREAM("UdpReceiver::Run(): " << fifo_length << " messages currently in paylod buffer, totally received " << udp_recv_counter << " udp packages");
-                        timestamp_last_print = chrono_system_clock::now();
-                    }
-                }
-                if (m_export_udp_msg) // || crc_error
-                {
-                    std::ofstream udp_ostream(std::string("udp_received_bin_") + sick_scansegment_xd::FormatNumber(udp_recv_counter, 3, true, false, -1) + ".udp", std::ofstream::binary);
-                    std::ofstream msg_ostream(std::string("udp_received_msg_") + sick_scansegment_xd::FormatNumber(udp_recv_counter, 3, true, false, -1) + ".msg", std::ofstream::binary);
-                    if (udp_ostream.is_open() && msg_ostream.is_open())
-                    {
-                        udp_ostream.write((const char*)udp_payload.data(), bytes_received);
-                        msg_ostream.write((const char*)msgpack_payload.data(), msgpack_payload.size());
-                    }
-                }
+                fifo_timestamp recv_timestamp = m_socket_impl->BatchReceiveEnabled() ? m_socket_impl->MessageTimestamp() : fifo_clock::now(); // kernel receive timestamp in batched receive mode
+                if (!PushMessage(udp_payload, bytes_received, bytes_to_receive, payload_length_bytes, udp_payload_offset, recv_timestamp))
+                    continue; // CRC error, message dropped
             }
             else if(bytes_received > 0)
             {
@@ -347,7 +291,7 @@ bool sick_scansegment_xd::UdpReceiver::Run(void)
                     ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): Received " << bytes_received << " unexpected bytes");
                     if(m_verbose)
                         ROS_ERROR_STREAM(ToHexString(udp_payload, bytes_received));
-                    timestamp_last_print = chrono_system_clock::now();
+                    m_timestamp_last_print = chrono_system_clock::now();
                 }
             }
             if(bytes_received > 0)
@@ -368,6 +312,176 @@ bool sick_scansegment_xd::UdpReceiver::Run(void)
     return false;
 }
 
+/*
+ * @brief Checks the CRC of a received message and pushes its payload to the fifo. Returns false in case of CRC errors.
+ */
+bool sick_scansegment_xd::UdpReceiver::PushMessage(const std::vector<uint8_t>& udp_payload, size_t bytes_received, uint32_t bytes_to_receive, uint32_t payload_length_bytes, uint32_t udp_payload_offset, const fifo_timestamp& recv_timestamp)
+{
+    bool do_print = (sick_scansegment_xd::Seconds(m_timestamp_last_print, chrono_system_clock::now()) > 1.0); // avoid printing with more than 1 Hz
+    bool do_print_crc_error = (sick_scansegment_xd::Seconds(m_timestamp_last_print_crc_error, chrono_system_clock::now()) > 1.0); // avoid printing crc errors with more than 1 Hz
+    if (bytes_received != bytes_to_receive)
+    {
+        if (bytes_received < bytes_to_receive)
+        {
+            ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): " << bytes_received << " bytes received, " << bytes_to_receive << " bytes expected, payload_length=" << payload_length_bytes << " bytes");
+            m_timestamp_last_print = chrono_system_clock::now();
+        }
+        else if(m_verbose)
+        {
+            ROS_INFO_STREAM("UdpReceiver::Run(): " << bytes_received << " bytes received, " << bytes_to_receive << " bytes expected, payload_length=" << payload_length_bytes << " bytes");
+            m_timestamp_last_print = chrono_system_clock::now();
+        }
+    }
+    // CRC check
+    size_t bytes_valid = std::min<size_t>(bytes_received, (size_t)bytes_to_receive);
+    uint32_t u32PayloadCRC = Convert4Byte(udp_payload.data() + bytes_valid - sizeof(uint32_t)); // last 4 bytes are CRC
+    size_t msgpack_payload_size = bytes_valid - sizeof(uint32_t) - udp_payload_offset;
+    uint32_t u32MsgPackCRC = sick_scansegment_xd::Crc32::Compute(0, udp_payload.data() + udp_payload_offset, msgpack_payload_size); // checksum the received buffer in place
+    if (u32PayloadCRC != u32MsgPackCRC)
+    {
+        if (do_print_crc_error)
+        {
+            ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): CRC 0x" << std::setfill('0') << std::setw(2) << std::hex << u32PayloadCRC
+                << " received from " << std::dec << (bytes_valid - sizeof(uint32_t)) << " udp bytes different to CRC 0x"
+                << std::setfill('0') << std::setw(2) << std::hex << u32MsgPackCRC << " computed from "
+                << std::dec << msgpack_payload_size << " byte payload, message dropped");
+            ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): decoded payload size: " << payload_length_bytes << " bytes, bytes_to_receive (expected udp message length): "
+                << bytes_to_receive << " byte, bytes_valid (received udp message length): " << bytes_valid << " byte");
+            m_timestamp_last_print_crc_error = chrono_system_clock::now();
+        }
+        return false;
+    }
+    std::vector<uint8_t> msgpack_payload = m_fifo_impl->AcquireBuffer(msgpack_payload_size); // recycled payload buffer, released by the msgpack converter after parsing
+    msgpack_payload.assign(udp_payload.begin() + udp_payload_offset, udp_payload.begin() + udp_payload_offset + msgpack_payload_size);
+    if (payload_length_bytes != msgpack_payload.size() && do_print)
+    {
+        ROS_ERROR_STREAM("## ERROR UdpReceiver::Run(): payload_length_bytes=" << payload_length_bytes << " different to decoded payload size " << msgpack_payload.size());
+        m_timestamp_last_print = chrono_system_clock::now();
+    }
+    // Move msgpack_payload to input fifo
+    size_t fifo_length = m_fifo_impl->Push(std::move(msgpack_payload), recv_timestamp, m_udp_recv_counter);
+    m_udp_recv_counter++;
+    if (m_verbose && do_print)
+    {
+        ROS_INFO_STREAM("UdpReceiver::Run(): " << bytes_received << " bytes received: " << ToPrintableString(udp_payload, bytes_received));
+        ROS_INFO_STREAM("UdpReceiver::Run(): " << fifo_length << " messages currently in paylod buffer, totally received " << m_udp_recv_counter << " udp packages");
+        m_timestamp_last_print = chrono_system_clock::now();
+    }
+    if (m_export_udp_msg)
+    {
+        std::ofstream udp_ostream(std::string("udp_received_bin_") + sick_scansegment_xd::FormatNumber(m_udp_recv_counter, 3, true, false, -1) + ".udp", std::ofstream::binary);
+        std::ofstream msg_ostream(std::string("udp_received_msg_") + sick_scansegment_xd::FormatNumber(m_udp_recv_counter, 3, true, false, -1) + ".msg", std::ofstream::binary);
+        if (udp_ostream.is_open() && msg_ostream.is_open())
+        {
+            udp_ostream.write((const char*)udp_payload.data(), bytes_received);
+            msg_ostream.write((const char*)udp_payload.data() + udp_payload_offset, msgpack_payload_size);
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief Reactor callback, called by the socket reactor thread if the udp socket is readable.
+ * Receives the available datagram(s) without blocking and appends them to the current message.
+ */
+void sick_scansegment_xd::UdpReceiver::OnSocketReadable(void)
+{
+    if (!m_socket_impl || !m_run_receiver_thread)
+        return;
+    try
+    {
+        do // receive the next datagram and all datagrams pending from the last recvmmsg call (batched receive mode)
+        {
+            chrono_system_time datagram_timestamp;
+            int64_t bytes_received = m_socket_impl->ReceiveNonBlocking(m_reactor_datagram, datagram_timestamp);
+            if (bytes_received <= 0)
+                break;
+            AppendDatagram(m_reactor_datagram.data(), (size_t)bytes_received, datagram_timestamp);
+        } while (m_run_receiver_thread && m_socket_impl->DatagramPending());
+    }
+    catch (std::exception & e)
+    {
+        ROS_ERROR_STREAM("## ERROR UdpReceiver::OnSocketReadable(): " << e.what());
+        m_frame_bytes = 0;
+    }
+}
+
+/*
+ * @brief Incremental message framing in reactor mode: appends a received datagram to the current message
+ * and pushes the message to the fifo after all bytes have been received.
+ */
+void sick_scansegment_xd::UdpReceiver::AppendDatagram(const uint8_t* datagram, size_t datagram_size, const chrono_system_time& datagram_timestamp)
+{
+    size_t headerlength = m_udp_msg_start_seq.size() + sizeof(uint32_t); // 8 byte header: 0x02020202 + payload length
+    if (datagram_size > headerlength && std::equal(m_udp_msg_start_seq.begin(), m_udp_msg_start_seq.end(), datagram)) // start of a new message
+    {
+        if (m_frame_bytes > 0 && m_verbose)
+            ROS_WARN_STREAM("UdpReceiver::AppendDatagram(): incomplete message of " << m_frame_bytes << " bytes dropped (port " << m_socket_impl->port() << ")");
+        m_frame_bytes = 0;
+        m_frame_timestamp = datagram_timestamp;
+    }
+    else if (m_frame_bytes == 0) // continuation without start of message
+    {
+        if (sick_scansegment_xd::Seconds(m_timestamp_last_print, chrono_system_clock::now()) > 1.0)
+        {
+            ROS_ERROR_STREAM("## ERROR UdpReceiver::AppendDatagram(): Received " << datagram_size << " unexpected bytes");
+            m_timestamp_last_print = chrono_system_clock::now();
+        }
+        return;
+    }
+    if (m_frame_buffer.size() < m_frame_bytes + datagram_size)
+        m_frame_buffer.resize(m_frame_bytes + datagram_size);
+    memcpy(m_frame_buffer.data() + m_frame_bytes, datagram, datagram_size);
+    m_frame_bytes += datagram_size;
+    // Check if the message is complete
+    uint32_t payload_length_bytes = 0, bytes_to_receive = 0, udp_payload_offset = 0;
+    if (m_scandataformat == SCANDATA_MSGPACK)
+    {
+        // msgpack data (default): UDP message := (4 byte \x02\x02\x02\x02) + (4 byte payload length) + payload + (4 byte CRC)
+        payload_length_bytes = Convert4Byte(m_frame_buffer.data() + m_udp_msg_start_seq.size());
+        bytes_to_receive = (uint32_t)(payload_length_bytes + headerlength + sizeof(uint32_t));
+        udp_payload_offset = (uint32_t)headerlength;
+        if (bytes_to_receive > 1024 * 1024)
+        {
+            ROS_ERROR_STREAM("## ERROR UdpReceiver::AppendDatagram(): unexpected payloadlength " << payload_length_bytes << " byte incl CRC received");
+            m_frame_bytes = 0;
+            return;
+        }
+    }
+    else // SCANDATA_COMPACT
+    {
+        uint32_t num_bytes_required = 0;
+        if (!sick_scansegment_xd::CompactDataParser::ParseSegment(m_frame_buffer.data(), m_frame_bytes, 0, payload_length_bytes, num_bytes_required))
+        {
+            if (num_bytes_required > 1024 * 1024)
+            {
+                ROS_ERROR_STREAM("## ERROR UdpReceiver::AppendDatagram(): " << m_frame_bytes << " bytes received (compact), " << (num_bytes_required + sizeof(uint32_t)) << " bytes or more required, probably incorrect payload");
+                m_frame_bytes = 0;
+            }
+            return; // wait for more datagrams
+        }
+        bytes_to_receive = (uint32_t)(payload_length_bytes + sizeof(uint32_t)); // payload + (4 byte CRC)
+        udp_payload_offset = 0; // compact format calculates CRC over complete message (incl. header)
+    }
+    if (m_frame_bytes < bytes_to_receive)
+        return; // wait for more datagrams
+    fifo_timestamp recv_timestamp = m_socket_impl->BatchReceiveEnabled() ? m_frame_timestamp : fifo_clock::now(); // kernel receive timestamp in batched receive mode
+    PushMessage(m_frame_buffer, m_frame_bytes, bytes_to_receive, payload_length_bytes, udp_payload_offset, recv_timestamp);
+    m_frame_bytes = 0;
+}
+
+/*
+ * @brief Unregisters the udp socket from the socket reactor (if registered)
+ */
+void sick_scansegment_xd::UdpReceiver::RemoveFromReactor(void)
+{
+    if (m_reactor && m_reactor_registered && m_socket_impl)
+    {
+        m_reactor->removeSocket((int)m_socket_impl->SocketHandle()); // waits until a running callback has finished
+    }
+    m_reactor_registered = false;
+}
+
 /*
  * @brief Converts a payload to a hex string
  * param[in] payload payload buffer
@@ -0,0 +1,308 @@
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <sick_scan/sick_socket_reactor.h>
+
+#if defined __linux__
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+/*
+* Constructor, starts the reactor threads
+* @param[in] num_threads number of reactor threads
+*/
+sick_scan_xd::SocketReactor::SocketReactor(int num_threads) : m_run_threads(true)
+{
+#if defined __linux__
+  for (int n = 0; n < std::max(1, num_threads); n++)
+  {
+    ReactorThread* reactor_thread = new ReactorThread();
+    reactor_thread->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    reactor_thread->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (reactor_thread->epoll_fd < 0 || reactor_thread->wakeup_fd < 0)
+    {
+      ROS_ERROR_STREAM("## ERROR SocketReactor: epoll_create1() or eventfd() failed: " << strerror(errno));
+      if (reactor_thread->epoll_fd >= 0)
+        close(reactor_thread->epoll_fd);
+      if (reactor_thread->wakeup_fd >= 0)
+        close(reactor_thread->wakeup_fd);
+      delete reactor_thread;
+      continue;
+    }
+    struct epoll_event wakeup_event;
+    memset(&wakeup_event, 0, sizeof(wakeup_event));
+    wakeup_event.events = EPOLLIN;
+    wakeup_event.data.fd = reactor_thread->wakeup_fd;
+    epoll_ctl(reactor_thread->epoll_fd, EPOLL_CTL_ADD, reactor_thread->wakeup_fd, &wakeup_event);
+    reactor_thread->thread = new std::thread(&sick_scan_xd::SocketReactor::runReactorThread, this, reactor_thread);
+    reactor_thread->thread_id = reactor_thread->thread->get_id();
+    m_threads.push_back(reactor_thread);
+  }
+  ROS_INFO_STREAM("SocketReactor: " << m_threads.size() << " reactor threads started");
+#endif
+}
+
+/*
+* Destructor, stops the reactor threads
+*/
+sick_scan_xd::SocketReactor::~SocketReactor()
+{
+  stop();
+}
+
+/*
+* Returns the process wide SocketReactor, which is created with num_threads reactor threads on first call.
+* Returns 0, if num_threads <= 0 (i.e. reactor not configured) or if the SocketReactor is not supported on this system.
+*/
+sick_scan_xd::SocketReactor* sick_scan_xd::SocketReactor::sharedInstance(int num_threads)
+{
+  static std::mutex s_shared_instance_mutex;
+  static SocketReactor* s_shared_instance = 0; // process wide reactor, shared by all lidars, never deleted (sockets may be deregistered at exit)
+  if (num_threads <= 0)
+    return 0;
+  if (!isSupported())
+  {
+    ROS_WARN_STREAM("## WARNING SocketReactor not supported on this system, io_reactor_threads=" << num_threads << " ignored, using one receive thread per connection");
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(s_shared_instance_mutex);
+  if (!s_shared_instance)
+    s_shared_instance = new SocketReactor(num_threads);
+  else if (s_shared_instance->numThreads() != num_threads)
+    ROS_WARN_STREAM("## WARNING SocketReactor already running with " << s_shared_instance->numThreads() << " threads, io_reactor_threads=" << num_threads << " ignored");
+  return s_shared_instance;
+}
+
+/*
+* Returns true, if the SocketReactor is supported on this system (Linux: epoll available)
+*/
+bool sick_scan_xd::SocketReactor::isSupported(void)
+{
+#if defined __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*
+* Registers a socket. The read callback is called by a reactor thread whenever data can be read from the socket.
+* The read callback should read the available data without blocking. Returns false on error.
+*/
+bool sick_scan_xd::SocketReactor::addSocket(int socket_fd, const ReadCallback& read_callback)
+{
+#if defined __linux__
+  if (socket_fd < 0 || m_threads.empty() || !m_run_threads)
+    return false;
+  std::lock_guard<std::mutex> lock(m_socket_threads_mutex);
+  if (m_socket_threads.find(socket_fd) != m_socket_threads.end())
+  {
+    ROS_ERROR_STREAM("## ERROR SocketReactor::addSocket(): socket " << socket_fd << " already registered");
+    return false;
+  }
+  // Serve the new socket by the thread with the least number of sockets
+  ReactorThread* reactor_thread = m_threads[0];
+  for (size_t n = 1; n < m_threads.size(); n++)
+  {
+    std::lock_guard<std::mutex> lock1(m_threads[n]->registrations_mutex);
+    std::lock_guard<std::mutex> lock2(reactor_thread->registrations_mutex);
+    if (m_threads[n]->registrations.size() < reactor_thread->registrations.size())
+      reactor_thread = m_threads[n];
+  }
+  {
+    std::lock_guard<std::mutex> lock_registrations(reactor_thread->registrations_mutex);
+    reactor_thread->registrations[socket_fd] = std::make_shared<Registration>(socket_fd, read_callback);
+  }
+  struct epoll_event socket_event;
+  memset(&socket_event, 0, sizeof(socket_event));
+  socket_event.events = EPOLLIN | EPOLLRDHUP; // level triggered: the read callback is called again, as long as data are available
+  socket_event.data.fd = socket_fd;
+  if (epoll_ctl(reactor_thread->epoll_fd, EPOLL_CTL_ADD, socket_fd, &socket_event) != 0)
+  {
+    ROS_ERROR_STREAM("## ERROR SocketReactor::addSocket(): epoll_ctl() failed for socket " << socket_fd << ": " << strerror(errno));
+    std::lock_guard<std::mutex> lock_registrations(reactor_thread->registrations_mutex);
+    reactor_thread->registrations.erase(socket_fd);
+    return false;
+  }
+  m_socket_threads[socket_fd] = reactor_thread;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*
+* Deregisters a socket. After removeSocket returned, the read callback is not running and will not be called again.
+* Call removeSocket before closing the socket. removeSocket can be called by the read callback itself.
+*/
+void sick_scan_xd::SocketReactor::removeSocket(int socket_fd)
+{
+#if defined __linux__
+  ReactorThread* reactor_thread = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_socket_threads_mutex);
+    std::map<int, ReactorThread*>::iterator iter = m_socket_threads.find(socket_fd);
+    if (iter == m_socket_threads.end())
+      return;
+    reactor_thread = iter->second;
+    m_socket_threads.erase(iter);
+  }
+  epoll_ctl(reactor_thread->epoll_fd, EPOLL_CTL_DEL, socket_fd, 0);
+  std::shared_ptr<Registration> registration;
+  {
+    std::lock_guard<std::mutex> lock_registrations(reactor_thread->registrations_mutex);
+    std::map<int, std::shared_ptr<Registration>>::iterator iter = reactor_thread->registrations.find(socket_fd);
+    if (iter != reactor_thread->registrations.end())
+    {
+      registration = iter->second;
+      reactor_thread->registrations.erase(iter);
+    }
+  }
+  if (registration)
+  {
+    if (std::this_thread::get_id() == reactor_thread->thread_id) // called by a read callback of the reactor thread serving this socket, i.e. its read callback is not running concurrently
+    {
+      registration->removed = true;
+    }
+    else // wait until a running read callback has finished
+    {
+      std::lock_guard<std::mutex> lock_callback(registration->callback_mutex);
+      registration->removed = true;
+    }
+  }
+#endif
+}
+
+/*
+* Stops all reactor threads and deregisters all sockets
+*/
+void sick_scan_xd::SocketReactor::stop(void)
+{
+#if defined __linux__
+  m_run_threads = false;
+  for (size_t n = 0; n < m_threads.size(); n++)
+  {
+    uint64_t wakeup = 1;
+    if (write(m_threads[n]->wakeup_fd, &wakeup, sizeof(wakeup)) < 0)
+      ROS_WARN_STREAM("## WARNING SocketReactor::stop(): write(eventfd) failed: " << strerror(errno));
+  }
+  for (size_t n = 0; n < m_threads.size(); n++)
+  {
+    if (m_threads[n]->thread && m_threads[n]->thread->joinable())
+      m_threads[n]->thread->join();
+    delete m_threads[n]->thread;
+    close(m_threads[n]->epoll_fd);
+    close(m_threads[n]->wakeup_fd);
+    delete m_threads[n];
+  }
+  m_threads.clear();
+  std::lock_guard<std::mutex> lock(m_socket_threads_mutex);
+  m_socket_threads.clear();
+#endif
+}
+
+/*
+* Returns the number of registered sockets
+*/
+size_t sick_scan_xd::SocketReactor::numSockets(void)
+{
+  std::lock_guard<std::mutex> lock(m_socket_threads_mutex);
+  return m_socket_threads.size();
+}
+
+/*
+* Thread function of a reactor thread: waits for readable sockets and calls their read callbacks
+*/
+void sick_scan_xd::SocketReactor::runReactorThread(ReactorThread* reactor_thread)
+{
+#if defined __linux__
+  const int max_events = 64;
+  struct epoll_event events[max_events];
+  while (m_run_threads)
+  {
+    int num_events = epoll_wait(reactor_thread->epoll_fd, events, max_events, 1000);
+    if (num_events < 0 && errno != EINTR)
+    {
+      ROS_ERROR_STREAM("## ERROR SocketReactor: epoll_wait() failed: " << strerror(errno));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (int n = 0; m_run_threads && n < num_events; n++)
+    {
+      if (events[n].data.fd == reactor_thread->wakeup_fd)
+        continue;
+      std::shared_ptr<Registration> registration;
+      {
+        std::lock_guard<std::mutex> lock_registrations(reactor_thread->registrations_mutex);
+        std::map<int, std::shared_ptr<Registration>>::iterator iter = reactor_thread->registrations.find(events[n].data.fd);
+        if (iter != reactor_thread->registrations.end())
+          registration = iter->second;
+      }
+      if (registration)
+      {
+        std::lock_guard<std::mutex> lock_callback(registration->callback_mutex);
+        if (!registration->removed)
+          registration->read_callback();
+      }
+    }
+  }
+#endif
+}
@@ -4,6 +4,7 @@ File: softwarePLL.cpp
 ====================================================================================================
 */
 #include "softwarePLL.h"
+#include "sick_scan/sick_ros_wrapper.h"
 #include <algorithm>
 #include <iostream>
 // #include <chrono>
@@ -18,6 +19,25 @@ File: softwarePLL.cpp
 
 
 const double SoftwarePLL::MaxAllowedTimeDeviation = 0.1;
+
+SoftwarePLL &SoftwarePLL::instance()
+{
+  SoftwarePLL* bound_instance = boundInstance();
+  if (bound_instance)
+    return *bound_instance;
+  if (numLidarInstances() > 1)
+  {
+    static thread_local bool s_unbound_warning_printed = false;
+    if (!s_unbound_warning_printed)
+    {
+      ROS_WARN_STREAM("## WARNING SoftwarePLL::instance(): called on a thread without a bound lidar while " << numLidarInstances()
+        << " lidars are running, the process wide default SoftwarePLL is used. Bind the lidar by SickScanCommon::ScopedLidarInstance.");
+      s_unbound_warning_printed = true;
+    }
+  }
+  static SoftwarePLL _instance;
+  return _instance;
+}
 const uint32_t SoftwarePLL::MaxExtrapolationCounter = 20;
 
 // Helper class for reading csv file with test data
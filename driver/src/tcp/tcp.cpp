@@ -8,6 +8,7 @@
 #include "sick_scan/tcp/errorhandler.hpp"
 #include "sick_scan/tcp/toolbox.hpp"
 #include "sick_scan/tcp/wsa_init.hpp"
+#include "sick_scan/sick_socket_reactor.h"
 #include <stdio.h>      // for sprintf()
 
 #ifdef _MSC_VER
@@ -22,6 +23,8 @@
 #ifndef _MSC_VER
 #include <sys/poll.h>
 #include <poll.h>
+#include <errno.h>
+#include <time.h>
 #endif
 
 Tcp::Tcp()
@@ -38,6 +41,10 @@ Tcp::Tcp()
 	m_readFunctionObjPtr = NULL;
 
     m_last_tcp_msg_received_nsec = 0; // no message received
+    m_recv_timestamp = rosTimeNow();
+    m_kernel_timestamps = false;
+    m_reactor = 0;
+    m_reactor_registered = false;
 }
 
 //
@@ -212,9 +219,22 @@ bool Tcp::open(std::string ipAddress, UINT16 port, bool enableVerboseDebugOutput
 
 	printInfoMessage("Tcp::open: Connection established. Now starting read thread.", m_beVerbose);
 
-	// Empfangsthread starten
-	m_readThread = new SickThread<Tcp, &Tcp::readThreadFunction>("TcpRecvThread");
-	m_readThread->run(this);
+	// Enable kernel receive timestamps, i.e. datagrams are stamped by the network stack instead of the read thread
+	m_kernel_timestamps = false;
+#if defined SO_TIMESTAMPNS
+	int enable_timestamps = 1;
+	m_kernel_timestamps = (setsockopt(m_connectionSocket, SOL_SOCKET, SO_TIMESTAMPNS, &enable_timestamps, sizeof(enable_timestamps)) == 0);
+	if (!m_kernel_timestamps)
+		ROS_WARN_STREAM("Tcp::open: kernel receive timestamps (SO_TIMESTAMPNS) not supported, using system time of recv calls");
+#endif
+
+	// Empfangsthread starten, or receive by the socket reactor threads (optional)
+	m_reactor_registered = (m_reactor != 0 && m_reactor->addSocket((int)m_connectionSocket, [this](){ readReactorEvent(); }));
+	if (!m_reactor_registered)
+	{
+		m_readThread = new SickThread<Tcp, &Tcp::readThreadFunction>("TcpRecvThread");
+		m_readThread->run(this);
+	}
 	
 	ROS_INFO_STREAM("sick_scan_xd Tcp::open: connected to " << ipAddress << ":"  << port);
 	printInfoMessage("Tcp::open: Done, leaving now.", m_beVerbose);
@@ -257,6 +277,47 @@ void Tcp::readThreadFunction(bool& endThread, UINT16& waitTimeMs)
 	}
 }
 
+#ifndef _MSC_VER
+//
+// Receives data and sets m_recv_timestamp to the kernel receive timestamp of the last received segment (or the current time, if kernel timestamps are not available)
+//
+INT32 Tcp::recvWithTimestamp(UINT8* buffer, UINT32 bufferLen, int flags)
+{
+	struct iovec iov;
+	iov.iov_base = buffer;
+	iov.iov_len = bufferLen;
+	union { char buf[CMSG_SPACE(sizeof(struct timespec))]; struct cmsghdr align; } control;
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+	INT32 recvMsgSize = (INT32)recvmsg(m_connectionSocket, &msg, flags);
+	m_recv_timestamp = rosTimeNow();
+#if defined SO_TIMESTAMPNS
+	if (recvMsgSize > 0 && m_kernel_timestamps)
+	{
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+		{
+			if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+			{
+				// The kernel timestamp is system time (CLOCK_REALTIME). Subtract the delay between kernel receive and recvmsg from ros time, which can be simulation time.
+				struct timespec kernel_time, system_time;
+				memcpy(&kernel_time, CMSG_DATA(cmsg), sizeof(kernel_time));
+				clock_gettime(CLOCK_REALTIME, &system_time);
+				double recv_delay = (double)(system_time.tv_sec - kernel_time.tv_sec) + 1.0e-9 * (double)(system_time.tv_nsec - kernel_time.tv_nsec);
+				if (recv_delay >= 0 && recv_delay < 1.0 && recv_delay < rosTimeToSeconds(m_recv_timestamp))
+					m_recv_timestamp = m_recv_timestamp - rosDurationFromSec(recv_delay);
+				break;
+			}
+		}
+	}
+#endif
+	return recvMsgSize;
+}
+#endif
+
 //
 // Read some data from the TCP connection.
 //
@@ -280,6 +341,7 @@ INT32 Tcp::readInputData()
 	// Read some data, if any
 #ifdef _MSC_VER
 	recvMsgSize = recv(m_connectionSocket, (char *)inBuffer, max_length, 0);
+	m_recv_timestamp = rosTimeNow();
 #else
 	{
 		int ret = -1;
@@ -297,7 +359,7 @@ INT32 Tcp::readInputData()
 					// Timeout
 					break;
 				default:
-					recvMsgSize = recv(m_connectionSocket, inBuffer, max_length, 0);
+					recvMsgSize = recvWithTimestamp(inBuffer, max_length);
 					break;
 			}
 			if (!m_readThread || m_readThread->m_threadShouldRun == false)
@@ -308,6 +370,35 @@ INT32 Tcp::readInputData()
 		} while (ret == 0);
 	}
 #endif
+	return processInputData(inBuffer, recvMsgSize);
+}
+
+//
+// Called by the socket reactor if data can be read from the TCP connection (reactor mode only).
+//
+void Tcp::readReactorEvent()
+{
+	const UINT16 max_length = 8192;
+	UINT8 inBuffer[max_length];
+	INT32 recvMsgSize = 0;
+	if (isOpen() == false)
+		return;
+#ifdef _MSC_VER
+	recvMsgSize = recv(m_connectionSocket, (char *)inBuffer, max_length, 0);
+	m_recv_timestamp = rosTimeNow();
+#else
+	recvMsgSize = recvWithTimestamp(inBuffer, max_length, MSG_DONTWAIT);
+	if (recvMsgSize < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+		return; // spurious wakeup, nothing to read
+#endif
+	processInputData(inBuffer, recvMsgSize);
+}
+
+//
+// Passes received data to the read callback, or handles errors and disconnects (recvMsgSize <= 0).
+//
+INT32 Tcp::processInputData(UINT8* inBuffer, INT32 recvMsgSize)
+{
 	if (recvMsgSize < 0)
 	{
 		// Fehler
@@ -315,7 +406,6 @@ INT32 Tcp::readInputData()
   		ROS_ERROR("Tcp::readInputData: Failed to read data from socket, aborting!");
 		else
   		ROS_INFO("Tcp::readInputData: Failed to read data from socket, aborting!");
-		ScopedLock lock(&m_socketMutex);
 		closeSocket(); // otherwise the driver can terminate with broken pipe in next call to Tcp::write()
 	}
 	else if (recvMsgSize > 0)
@@ -357,8 +447,6 @@ INT32 Tcp::readInputData()
 			m_disconnectFunction(m_disconnectFunctionObjPtr);
 		}
 		
-		// Mutex setzen
-		ScopedLock lock(&m_socketMutex);
 		closeSocket(); // otherwise the driver can terminate with broken pipe in next call to Tcp::write()
 		// m_connectionSocket = -1;	// Keine Verbindung mehr
 	}
@@ -395,23 +483,40 @@ void Tcp::close()
 }
 
 /**
- * Closes the tcp connection (if it's currently open)
+ * Closes the tcp connection (if it's currently open). Thread safe: close() and the read thread (or reactor read callback)
+ * can call closeSocket concurrently, the socket is claimed under m_socketMutex and closed exactly once.
+ * The socket is deregistered and closed after releasing m_socketMutex, since removeSocket waits for a running read
+ * callback, which locks m_socketMutex itself on read errors.
  */
 void Tcp::closeSocket()
 {
-	// Close TCP socket
-	if (isOpen() == true)
-	{
-		// Verbindung schliessen
 #ifdef _MSC_VER
-		::shutdown(m_connectionSocket, SD_BOTH);
-		closesocket(m_connectionSocket);  // waere evtl. auch fuer Linux korrekt
+	SOCKET connectionSocket;
 #else
-		::shutdown(m_connectionSocket, SHUT_RDWR);
-		::close(m_connectionSocket);
+	INT32 connectionSocket;
 #endif
+	bool reactor_registered;
+	{
+		ScopedLock lock(&m_socketMutex);
+		if (isOpen() == false)
+			return;
+		connectionSocket = m_connectionSocket;
+		reactor_registered = m_reactor_registered;
 		m_connectionSocket = -1;	// Keine Verbindung mehr
+		m_reactor_registered = false;
+	}
+	// Verbindung schliessen
+#ifdef _MSC_VER
+	::shutdown(connectionSocket, SD_BOTH);
+	closesocket(connectionSocket);  // waere evtl. auch fuer Linux korrekt
+#else
+	if (reactor_registered)
+	{
+		m_reactor->removeSocket(connectionSocket); // deregister before closing, the socket can be reused by the next connection
 	}
+	::shutdown(connectionSocket, SHUT_RDWR);
+	::close(connectionSocket);
+#endif
 }
 
 /**
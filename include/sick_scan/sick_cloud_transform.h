@@ -67,7 +67,12 @@
 #define SICK_CLOUD_TRANSFORM_H_
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <sick_scan/sick_ros_wrapper.h>
@@ -81,11 +86,30 @@ namespace sick_scan_xd
     * add_transform_xyz_rpy := T[world,cloud] with parent "world" and child "cloud", i.e. P_world = T[world,cloud] * P_cloud
     * The additional transform applies to cartesian lidar pointclouds and visualization marker (fields)
     * It is NOT applied to polar pointclouds, radarscans, ldmrs objects or other messages
+    * If add_transform_check_dynamic_updates is true, parameter "add_transform_xyz_rpy" is checked by a low-rate watcher thread,
+    * which swaps the transform snapshot after parameter changes. applyTransform() just reads the current snapshot.
     */
     class SickCloudTransform
     {
     public:
 
+        typedef std::array<float, 3> Vector3D; // 3D translation vector
+        typedef std::array<std::array<float, 3>, 3> Matrix3x3; // 3x3 rotation matrix
+
+        /*
+        * class TransformSnapshot contains the precomputed transform for a given 6D pose configuration
+        */
+        class TransformSnapshot
+        {
+        public:
+            std::string add_transform_xyz_rpy = "";                     // ros parameter "add_transform_xyz_rpy" of this transform
+            bool apply_3x3_rotation = false;                            // true, if the 3x3 rotation_matrix has to be applied, otherwise false (default)
+            Vector3D translation_vector = { 0, 0, 0 };                  // translational part x,y,z of the 6D pose, default: 0
+            Matrix3x3 rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };  // rotational part roll,pitch,yaw by 3x3 rotation matrix, default: 3x3 identity
+            float azimuth_offset = 0; // azimuth offset, i.e. yaw in [rad], if only yaw is configured (in this case an offset can be added to the lidar azimuth before conversion to cartesian pointcloud, which is faster than a 3x3 matrix multiplication)
+        };
+        typedef std::shared_ptr<const TransformSnapshot> TransformSnapshotPtr;
+
         SickCloudTransform();
         SickCloudTransform(rosNodePtr nh, bool cartesian_input_only /* = false */);
         SickCloudTransform(rosNodePtr nh, const std::string& add_transform_xyz_rpy, bool cartesian_input_only /* = false */, bool add_transform_check_dynamic_updates /* = false */);
@@ -97,34 +121,40 @@ namespace sick_scan_xd
         * @param[in+out] y input y in child coordinates, output y in parent coordinates
         * @param[in+out] z input z in child coordinates, output z in parent coordinates
         */
-        template<typename float_type> inline void applyTransform(float_type& x, float_type& y, float_type& z)
+        template<typename float_type> inline void applyTransform(float_type& x, float_type& y, float_type& z) const
         {
-            // Check parameter and re-init if parameter "add_transform_xyz_rpy" changed
-            if (m_add_transform_check_dynamic_updates && m_nh)
-            {
-                std::string add_transform_xyz_rpy = m_add_transform_xyz_rpy;
-                rosGetParam(m_nh, "add_transform_xyz_rpy", add_transform_xyz_rpy);
-                if (m_add_transform_xyz_rpy != add_transform_xyz_rpy)
-                {
-                    if (!init(add_transform_xyz_rpy, m_cartesian_input_only, m_add_transform_check_dynamic_updates))
-                    {
-                        ROS_ERROR_STREAM("## ERROR SickCloudTransform(): Re-Initialization by \"" << add_transform_xyz_rpy << "\" failed, use 6D pose \"x,y,z,roll,pitch,yaw\" in [m] resp. [rad]");
-                    }
-                }
-            }
-            // Apply transform
-            if (m_apply_3x3_rotation)
-            {
-                float_type u = x * m_rotation_matrix[0][0] + y * m_rotation_matrix[0][1] + z * m_rotation_matrix[0][2];
-                float_type v = x * m_rotation_matrix[1][0] + y * m_rotation_matrix[1][1] + z * m_rotation_matrix[1][2];
-                float_type w = x * m_rotation_matrix[2][0] + y * m_rotation_matrix[2][1] + z * m_rotation_matrix[2][2];
-                x = u;
-                y = v;
-                z = w;
-            }
-            x += m_translation_vector[0];
-            y += m_translation_vector[1];
-            z += m_translation_vector[2];
+            applyTransform(*snapshot(), x, y, z);
+        }
+
+        /*
+        * Apply an optional transform to n points given by x, y, z triples, i.e. xyz[3*i+0] = x[i], xyz[3*i+1] = y[i], xyz[3*i+2] = z[i].
+        * The transform snapshot is read once for all points.
+        */
+        inline void applyTransform(float* xyz, size_t n) const
+        {
+            TransformSnapshotPtr transform = snapshot();
+            for (size_t i = 0; i < n; i++, xyz += 3)
+                applyTransform(*transform, xyz[0], xyz[1], xyz[2]);
+        }
+
+        /*
+        * Apply an optional transform to n points given by separate x, y, z arrays (struct of arrays, vectorized by the compiler).
+        * The transform snapshot is read once for all points.
+        */
+        inline void applyTransform(float* x, float* y, float* z, size_t n) const
+        {
+            TransformSnapshotPtr transform = snapshot();
+            for (size_t i = 0; i < n; i++)
+                applyTransform(*transform, x[i], y[i], z[i]);
+        }
+
+        /*
+        * Returns the current transform snapshot. With add_transform_check_dynamic_updates enabled, the snapshot is swapped
+        * by the watcher thread if parameter "add_transform_xyz_rpy" changed. A snapshot is released after the last reader dropped it.
+        */
+        inline TransformSnapshotPtr snapshot(void) const
+        {
+            return m_watcher ? m_watcher->current() : m_snapshot;
         }
 
         /*
@@ -132,17 +162,86 @@ namespace sick_scan_xd
         */
         inline float azimuthOffset(void) const
         {
-            return m_azimuth_offset;
+            return snapshot()->azimuth_offset;
+        }
+
+        /*
+        * Return true, if the 3x3 rotation matrix has to be applied, otherwise false (default)
+        */
+        inline bool applyRotation(void) const
+        {
+            return snapshot()->apply_3x3_rotation;
+        }
+
+        /*
+        * Return the rotational part of the transform (3x3 identity by default)
+        */
+        inline Matrix3x3 rotationMatrix(void) const
+        {
+            return snapshot()->rotation_matrix;
+        }
+
+        /*
+        * Return the translational part of the transform (0,0,0 by default)
+        */
+        inline Vector3D translationVector(void) const
+        {
+            return snapshot()->translation_vector;
         }
 
     protected:
 
-        typedef std::array<float, 3> Vector3D; // 3D translation vector
-        typedef std::array<std::array<float, 3>, 3> Matrix3x3; // 3x3 rotation matrix
+        /*
+        * class DynamicUpdateWatcher runs a low-rate thread checking parameter "add_transform_xyz_rpy". After a parameter change,
+        * a new transform snapshot is computed and swapped atomically. Previous snapshots are released as soon as applyTransform()
+        * and all other readers dropped them. The watcher is shared by all copies of a SickCloudTransform.
+        */
+        class DynamicUpdateWatcher
+        {
+        public:
+            DynamicUpdateWatcher(rosNodePtr nh, const TransformSnapshotPtr& snapshot, bool cartesian_input_only);
+            ~DynamicUpdateWatcher();
+            inline TransformSnapshotPtr current(void) const
+            {
+                return std::atomic_load(&m_current);
+            }
+        protected:
+            void runWatcherThreadCb(void);
+            rosNodePtr m_nh = 0;
+            bool m_cartesian_input_only = false;
+            int m_check_interval_millisec = 100;          // parameter "add_transform_xyz_rpy" is checked every 100 milliseconds
+            std::string m_invalid_add_transform_xyz_rpy;  // last invalid parameter (error is reported once)
+            TransformSnapshotPtr m_current;               // current snapshot, read and swapped by std::atomic_load and std::atomic_store
+            bool m_run_watcher_thread = false;
+            std::mutex m_watcher_mutex;
+            std::condition_variable m_watcher_cond;
+            std::thread* m_watcher_thread = 0;
+        };
+
+        // Applies a given transform to point (x, y, z)
+        template<typename float_type> static inline void applyTransform(const TransformSnapshot& transform, float_type& x, float_type& y, float_type& z)
+        {
+            if (transform.apply_3x3_rotation)
+            {
+                const Matrix3x3& rot = transform.rotation_matrix;
+                float_type u = x * rot[0][0] + y * rot[0][1] + z * rot[0][2];
+                float_type v = x * rot[1][0] + y * rot[1][1] + z * rot[1][2];
+                float_type w = x * rot[2][0] + y * rot[2][1] + z * rot[2][2];
+                x = u;
+                y = v;
+                z = w;
+            }
+            x += transform.translation_vector[0];
+            y += transform.translation_vector[1];
+            z += transform.translation_vector[2];
+        }
 
         // Initializes rotation matrix and translation vector from a 6D pose configuration (x,y,z,roll,pitch,yaw) in [m] resp. [rad]
         bool init(const std::string& add_transform_xyz_rpy, bool cartesian_input_only, bool add_transform_check_dynamic_updates);
 
+        // Computes the transform snapshot from a 6D pose configuration (x,y,z,roll,pitch,yaw) in [m] resp. [rad]
+        static bool parse(const std::string& add_transform_xyz_rpy, bool cartesian_input_only, TransformSnapshot& snapshot);
+
         // Converts roll (rotation about X), pitch (rotation about Y), yaw (rotation about Z) to 3x3 rotation matrix
         static Matrix3x3 eulerToRot3x3(float roll, float pitch, float yaw);
 
@@ -150,13 +249,10 @@ namespace sick_scan_xd
         static Matrix3x3 multiply3x3(const Matrix3x3& a, const Matrix3x3& b);
 
         rosNodePtr m_nh = 0; // ros node handle
-        std::string m_add_transform_xyz_rpy = "";                     // currently configured ros parameter "add_transform_xyz_rpy"
         bool m_add_transform_check_dynamic_updates = false;           // True: ros parameter "add_transform_xyz_rpy" can be updated during runtime by "rosparam set", False: parameter "add_transform_xyz_rpy" configured by launchfile only
         bool m_cartesian_input_only = false;                          // currently configured parameter cartesian_input_only
-        bool m_apply_3x3_rotation = false;                            // true, if the 3x3 rotation_matrix has to be applied, otherwise false (default)
-        Vector3D m_translation_vector = { 0, 0, 0 };                  // translational part x,y,z of the 6D pose, default: 0
-        Matrix3x3 m_rotation_matrix = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };  // rotational part roll,pitch,yaw by 3x3 rotation matrix, default: 3x3 identity
-        float m_azimuth_offset = 0; // azimuth offset, i.e. yaw in [rad], if only yaw is configured (in this case an offset can be added to the lidar azimuth before conversion to cartesian pointcloud, which is faster than a 3x3 matrix multiplication)
+        TransformSnapshotPtr m_snapshot = std::make_shared<const TransformSnapshot>(); // transform configured at initialization
+        std::shared_ptr<DynamicUpdateWatcher> m_watcher;              // watcher thread for dynamic updates of parameter "add_transform_xyz_rpy" (if add_transform_check_dynamic_updates is true)
 
     }; // class SickCloudTransform
 } // namespace sick_scan_xd
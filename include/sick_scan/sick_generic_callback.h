@@ -57,6 +57,7 @@
 #define __SICK_GENERIC_CALLBACK_H_INCLUDED
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -73,15 +74,47 @@
 
 namespace sick_scan_xd
 {
+    /*
+    * PointCloud2withEcho holds a ROS PointCloud2 with number of echos and segment index for listener notification.
+    * Constructed from a pointcloud pointer, it just borrows the pointcloud without copying (i.e. the pointcloud must be valid
+    * while the listeners are notified). Copies of a PointCloud2withEcho own resp. share a copy of the pointcloud
+    * (e.g. a message stored by SickWaitForMessageHandler).
+    */
     struct PointCloud2withEcho
     {
-        PointCloud2withEcho(const ros_sensor_msgs::PointCloud2* msg = 0, int32_t _num_echos = 0, int32_t _segment_idx = 0) : num_echos(_num_echos), segment_idx(_segment_idx) 
+        PointCloud2withEcho(const ros_sensor_msgs::PointCloud2* msg = 0, int32_t _num_echos = 0, int32_t _segment_idx = 0) : num_echos(_num_echos), segment_idx(_segment_idx), m_pointcloud(msg)
+        {
+        }
+        PointCloud2withEcho(const PointCloud2withEcho& other)
+        {
+            *this = other;
+        }
+        PointCloud2withEcho& operator=(const PointCloud2withEcho& other)
+        {
+            if (this != &other)
+            {
+                num_echos = other.num_echos;
+                segment_idx = other.segment_idx;
+                if (other.m_shared_pointcloud) // other owns its pointcloud: share it
+                    m_shared_pointcloud = other.m_shared_pointcloud;
+                else if (other.m_pointcloud) // other borrows a pointcloud: copy it
+                    m_shared_pointcloud = std::make_shared<const ros_sensor_msgs::PointCloud2>(*other.m_pointcloud);
+                else
+                    m_shared_pointcloud = 0;
+                m_pointcloud = m_shared_pointcloud.get();
+            }
+            return *this;
+        }
+        const ros_sensor_msgs::PointCloud2& pointcloud(void) const // ROS PointCloud2
         {
-            pointcloud = ((msg) ? (*msg) : (ros_sensor_msgs::PointCloud2()));
+            static const ros_sensor_msgs::PointCloud2 s_empty_pointcloud;
+            return m_pointcloud ? (*m_pointcloud) : s_empty_pointcloud;
         }
-        ros_sensor_msgs::PointCloud2 pointcloud; // ROS PointCloud2
         int32_t num_echos;                       // number of echos
         int32_t segment_idx;                     // segment index (or -1 if pointcloud contains data from multiple segments)
+    protected:
+        const ros_sensor_msgs::PointCloud2* m_pointcloud = 0;                        // borrowed or shared pointcloud
+        std::shared_ptr<const ros_sensor_msgs::PointCloud2> m_shared_pointcloud = 0; // pointcloud owned by copies of a PointCloud2withEcho
     };
 
     typedef void(* PointCloud2Callback)(rosNodePtr handle, const PointCloud2withEcho* msg);
@@ -97,11 +130,13 @@ namespace sick_scan_xd
     void notifyCartesianPointcloudListener(rosNodePtr handle, const PointCloud2withEcho* msg);
     void removeCartesianPointcloudListener(rosNodePtr handle, PointCloud2Callback listener);
     bool isCartesianPointcloudListenerRegistered(rosNodePtr handle, PointCloud2Callback listener);
+    bool hasCartesianPointcloudListener(rosNodePtr handle); // returns true, if any listener is registered for a handle (otherwise notification can be skipped)
 
     void addPolarPointcloudListener(rosNodePtr handle, PointCloud2Callback listener);
     void notifyPolarPointcloudListener(rosNodePtr handle, const PointCloud2withEcho* msg);
     void removePolarPointcloudListener(rosNodePtr handle, PointCloud2Callback listener);
     bool isPolarPointcloudListenerRegistered(rosNodePtr handle, PointCloud2Callback listener);
+    bool hasPolarPointcloudListener(rosNodePtr handle); // returns true, if any listener is registered for a handle (otherwise notification can be skipped)
 
     void addImuListener(rosNodePtr handle, ImuCallback listener);
     void notifyImuListener(rosNodePtr handle, const ros_sensor_msgs::Imu* msg);
@@ -141,11 +176,11 @@ namespace sick_scan_xd
     /*
     *  Callback template for registration and deregistration of callbacks incl. notification of listeners
     */
-    template<typename HandleType, class MsgType> class SickCallbackHandler
+    template<typename HandleType, class MsgType, typename CallbackType = void(*)(HandleType handle, const MsgType* msg)> class SickCallbackHandler
     {
     public:
         
-        typedef void(* callbackFunctionPtr)(HandleType handle, const MsgType* msg);
+        typedef CallbackType callbackFunctionPtr;
 
         void addListener(HandleType handle, callbackFunctionPtr listener)
         {
@@ -158,6 +193,8 @@ namespace sick_scan_xd
 
         void notifyListener(HandleType handle, const MsgType* msg)
         {
+            if (!hasListeners(handle))
+                return;
             std::list<callbackFunctionPtr> listeners = getListener(handle);
             for(typename std::list<callbackFunctionPtr>::iterator iter_listener = listeners.begin(); iter_listener != listeners.end(); iter_listener++)
             {
@@ -214,20 +251,27 @@ namespace sick_scan_xd
             return false;
         }
 
+        bool hasListeners(HandleType handle)
+        {
+            std::unique_lock<std::mutex> lock(m_listeners_mutex);
+            typename std::map<HandleType, std::list<callbackFunctionPtr>>::const_iterator iter_listeners = m_listeners.find(handle);
+            return iter_listeners != m_listeners.end() && !iter_listeners->second.empty();
+        }
+
         void clear()
         {
             std::unique_lock<std::mutex> lock(m_listeners_mutex);
             m_listeners.clear();
         }
 
-    protected:
-
         std::list<callbackFunctionPtr> getListener(HandleType handle)
         {
             std::unique_lock<std::mutex> lock(m_listeners_mutex);
             return m_listeners[handle];
         }
 
+    protected:
+
         std::map<HandleType, std::list<callbackFunctionPtr>> m_listeners; // list of listeners
         std::mutex m_listeners_mutex; // mutex to protect access to m_listeners
 
@@ -155,16 +155,26 @@ namespace sick_scan_xd
     /* Here will be the instance stored. */
     static SickScanFieldMonSingleton *instance;
 
-    /* Private constructor to prevent instancing. */
-    SickScanFieldMonSingleton();
-
     std::vector<SickScanMonField>monFields;
     int active_mon_fieldset;
 
   public:
-    /* Static access method. */
+    /* Constructor of a field monitoring instance owned by a lidar (SickScanCommon), use getInstance() otherwise. */
+    SickScanFieldMonSingleton();
+
+    /* Static access method: returns the instance bound to the current thread (see ScopedInstance), or the process wide instance. */
     static SickScanFieldMonSingleton *getInstance();
 
+    /* Binds a field monitoring instance to the current thread while the ScopedInstance exists, i.e. getInstance() returns the instance of the lidar processed by this thread. */
+    class ScopedInstance
+    {
+    public:
+      ScopedInstance(SickScanFieldMonSingleton* field_mon);
+      ~ScopedInstance();
+    private:
+      SickScanFieldMonSingleton* m_prev_instance;
+    };
+
     const std::vector<SickScanMonField>& getMonFields(void) const { return monFields; }
 
     void setActiveFieldset(int active_fieldset) { active_mon_fieldset = active_fieldset; }
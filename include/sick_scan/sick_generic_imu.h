@@ -193,6 +193,11 @@ namespace sick_scan_xd
     {
       commonPtr = commonPtr_;
       nh = nh_;
+      emul = false;
+      lastRoll = 0.0;
+      lastPitch = 0.0;
+      lastYaw = 0.0;
+      firstTime = true;
     }
 
     bool isImuDatagram(char *datagram, size_t datagram_length);
@@ -219,6 +224,11 @@ namespace sick_scan_xd
     SickScanCommon *commonPtr;
     rosNodePtr nh;
     bool emul;
+    rosTime lastTimeStamp; // timestamp, roll, pitch and yaw of the last imu message for angular velocity
+    double lastRoll;
+    double lastPitch;
+    double lastYaw;
+    bool firstTime;
   };
 
 } /* namespace sick_scan_xd */
@@ -31,5 +31,9 @@ bool parseLaunchfileSetParameter(rosNodePtr nhPriv, int argc, char **argv);
 
 bool stopScannerAndExit(bool force_immediate_shutdown = false);
 
+bool stopScannerAndExit(rosNodePtr nhPriv, bool force_immediate_shutdown); // stops and joins the lidar of a node handle, other lidars continue
+
+size_t numberOfGenericLaserThreads(void); // number of lidars started by startGenericLaser and not yet joined
+
 #endif
 
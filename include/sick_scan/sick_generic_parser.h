@@ -275,6 +275,9 @@ namespace sick_scan_xd
     int checkForDistAndRSSI(std::vector<char *> &fields, int expected_number_of_data, int &distNum, int &rssiNum,
                             std::vector<float> &distVal, std::vector<float> &rssiVal, int &distMask);
 
+    /* TiM240 only: Cola dialect after restart (true: Cola-B, false: Cola-A), toggled by SickScanCommon::checkColaTypeAndSwitchToConfigured. Stored by the parser, which persists when the lidar is reconnected. */
+    void setTim240BinaryMode(bool binary_mode) { m_tim240_binary_mode = (binary_mode ? 1 : 0); }
+    bool getTim240BinaryMode(bool default_binary_mode) const { return (m_tim240_binary_mode < 0) ? default_binary_mode : (m_tim240_binary_mode > 0); }
 
   private:
     float override_range_min_, override_range_max_;
@@ -284,6 +287,7 @@ namespace sick_scan_xd
     std::vector<ScannerBasicParam> basicParams;
     ScannerBasicParam *currentParamSet = 0;
     RangeFilterResultHandling m_range_filter_handling = RANGE_FILTER_DEACTIVATED;
+    int m_tim240_binary_mode = -1; // TiM240 Cola dialect after restart: 1 = Cola-B, 0 = Cola-A, -1 = not yet set (use configured dialect)
   };
 
 } /* namespace sick_scan_xd */
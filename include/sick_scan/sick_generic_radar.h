@@ -173,9 +173,6 @@ namespace sick_scan_xd
     /* Here will be the instance stored. */
     static SickScanRadarSingleton *instance;
 
-    /* Private constructor to prevent instancing. */
-    SickScanRadarSingleton(rosNodePtr nh);
-
     void simulateAsciiDatagramFromFile(unsigned char *receiveBuffer, int *actual_length, std::string filePattern);
 
     bool emul = false;
@@ -192,9 +189,22 @@ namespace sick_scan_xd
     sick_scan_xd::SickRangeFilter m_range_filter;
 
   public:
-    /* Static access method. */
+    /* Constructor of a radar instance owned by a lidar (SickScanCommon), use getInstance() otherwise. */
+    SickScanRadarSingleton(rosNodePtr nh);
+
+    /* Static access method: returns the instance bound to the current thread (see ScopedInstance), or the process wide instance. */
     static SickScanRadarSingleton *getInstance(rosNodePtr nh);
 
+    /* Binds a radar instance to the current thread while the ScopedInstance exists, i.e. getInstance() returns the instance of the lidar processed by this thread. */
+    class ScopedInstance
+    {
+    public:
+      ScopedInstance(SickScanRadarSingleton* radar);
+      ~ScopedInstance();
+    private:
+      SickScanRadarSingleton* m_prev_instance;
+    };
+
     void setEmulation(bool _emul);
 
     bool getEmulation(void);
@@ -0,0 +1,207 @@
+#include "sick_scan/sick_scan_base.h" /* Base definitions included in all header files, added by add_sick_scan_base_header.py. Do not edit this line. */
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+
+
+#ifndef SICK_POLAR_TO_CARTESIAN_H_
+#define SICK_POLAR_TO_CARTESIAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sick_scan/sick_cloud_transform.h>
+#include <sick_scan/sick_range_filter.h>
+
+namespace sick_scan_xd
+{
+    /*
+    * class PolarToCartesian converts blocks of polar scan points to cartesian coordinates.
+    * It is the common conversion kernel of SickScanCommon::loopOnce (LMS/MRS/TiM etc.), CompactDataParser and MsgPackParser.
+    * Sin and cos of azimuth and elevation are given by precomputed tables, i.e. the kernel itself has no trigonometric functions:
+    *
+    *   x[n] = range[n] * cos_elevation[k] * cos_azimuth[n] * scale
+    *   y[n] = range[n] * cos_elevation[k] * sin_azimuth[n] * scale
+    *   z[n] = range[n] * sin_elevation[k] * scale
+    *
+    * with k = n * elevation_stride (i.e. elevation_stride = 0 for a constant elevation, elevation_stride = 1 for an elevation table).
+    * The optional additional transform (3x3 rotation and translation configured by add_transform_xyz_rpy) is applied afterwards.
+    * The kernel is vectorized using AVX2, SSE2 or NEON (whatever is enabled by the compiler settings) with a scalar fallback.
+    */
+    class PolarToCartesian
+    {
+    public:
+
+        /*
+        * Converts num_points polar points to cartesian points.
+        * @param[in] num_points number of points
+        * @param[in] range range in meter, num_points values
+        * @param[in] cos_azimuth cos of azimuth (incl. azimuth offset), num_points values
+        * @param[in] sin_azimuth sin of azimuth (incl. azimuth offset), num_points values
+        * @param[in] cos_elevation cos of elevation, 1 value (elevation_stride = 0) or num_points values (elevation_stride = 1)
+        * @param[in] sin_elevation sin of elevation, 1 value (elevation_stride = 0) or num_points values (elevation_stride = 1)
+        * @param[in] elevation_stride 0 (constant elevation) or 1 (elevation table)
+        * @param[in] scale scaling factor applied to x, y and z, e.g. -1 for mirrored scans (NAV-3xx), otherwise 1
+        * @param[in] transform optional additional transform (or 0, if not required)
+        * @param[out] x cartesian x in meter, num_points values
+        * @param[out] y cartesian y in meter, num_points values
+        * @param[out] z cartesian z in meter, num_points values
+        */
+        static void convert(size_t num_points, const float* range, const float* cos_azimuth, const float* sin_azimuth,
+            const float* cos_elevation, const float* sin_elevation, size_t elevation_stride, float scale,
+            SickCloudTransform* transform, float* x, float* y, float* z);
+
+        /*
+        * Applies an optional range filter and converts num_points polar points to cartesian points.
+        * The range filter is applied in place, i.e. range values are modified depending on the range filter settings
+        * (e.g. set to 0, range_max, FLT_MAX or NaN) and converted afterwards.
+        * @param[in+out] range range in meter, num_points values, modified by the range filter
+        * @param[in] range_filter range filter
+        * @param[out] point_valid point_valid[n] = 0 if point n has been dropped by the range filter, otherwise 1
+        * @param[out] x, y, z cartesian points, num_points values each, or 0 to apply the range filter only (e.g. if only a polar pointcloud is required)
+        * @return number of valid points, i.e. number of points not dropped by the range filter
+        * See convert() above for the other parameter.
+        */
+        static size_t convert(size_t num_points, float* range, const SickRangeFilter& range_filter, uint8_t* point_valid,
+            const float* cos_azimuth, const float* sin_azimuth, const float* cos_elevation, const float* sin_elevation, size_t elevation_stride,
+            float scale, SickCloudTransform* transform, float* x, float* y, float* z);
+
+        /*
+        * Returns the instruction set used by convert(): "avx2", "sse2", "neon" or "scalar"
+        */
+        static const char* simdInstructionSet(void);
+
+    }; // class PolarToCartesian
+
+    /*
+    * class PolarToCartesianTable contains the azimuth and elevation lookup tables for PolarToCartesian::convert()
+    * and the scan configuration (angle start, increment, number of points, mirror factor, azimuth offset and elevation)
+    * they have been computed for.
+    */
+    class PolarToCartesianTable
+    {
+    public:
+
+        /*
+        * Returns true, if the tables have been computed for the given scan configuration, otherwise false
+        */
+        bool matches(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset, const float* elevation_key, size_t elevation_key_size) const;
+
+        /*
+        * Sets the scan configuration and resizes the tables. The tables have to be filled by the caller afterwards.
+        * @param[in] elevation_stride 0 (constant elevation, i.e. 1 elevation value) or 1 (elevation table with num_points values)
+        */
+        void reset(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset, const float* elevation_key, size_t elevation_key_size, size_t elevation_stride);
+
+        std::vector<float> azimuth;       // azimuth in radians (polar pointcloud), num_points values
+        std::vector<float> cos_azimuth;   // cos of azimuth incl. azimuth offset and mirror factor, num_points values
+        std::vector<float> sin_azimuth;   // sin of azimuth incl. azimuth offset and mirror factor, num_points values
+        std::vector<float> elevation;     // elevation in radians (polar pointcloud), 1 value (elevation_stride = 0) or num_points values (elevation_stride = 1)
+        std::vector<float> cos_elevation; // cos of elevation, 1 or num_points values
+        std::vector<float> sin_elevation; // sin of elevation incl. mirror factor, 1 or num_points values
+        size_t elevation_stride = 0;      // 0 (constant elevation) or 1 (elevation table)
+        uint64_t last_used = 0;           // time of last usage (counter of PolarToCartesianTableCache::lookup calls)
+
+    protected:
+
+        bool m_valid = false;
+        float m_angle_start = 0;
+        float m_angle_increment = 0;
+        size_t m_num_points = 0;
+        float m_mirror_factor = 1;
+        float m_azimuth_offset = 0;
+        std::vector<float> m_elevation_key;
+
+    }; // class PolarToCartesianTable
+
+    /*
+    * class PolarToCartesianTableCache caches the lookup tables of a device. The azimuth and elevation grid of LMS/MRS/TiM scans
+    * is identical from scan to scan, i.e. sin and cos tables have to be recomputed only if the scan configuration changes.
+    * Multiple tables are cached for lidars with multiple layers and different start angles (e.g. MRS-1xxx and LMS-1xxx).
+    */
+    class PolarToCartesianTableCache
+    {
+    public:
+
+        PolarToCartesianTableCache(size_t max_num_tables = 32) : m_max_num_tables(max_num_tables) {}
+
+        /*
+        * Returns the lookup table for a given scan configuration. If no cached table matches, the least recently used table
+        * is reset to the new scan configuration and table_valid is set to false, i.e. the caller has to fill the tables.
+        * @param[in] elevation_key elevation value(s) identifying the elevation table, e.g. the elevation angle of the layer or the elevation angles of all points
+        * @param[in] elevation_stride 0 (constant elevation) or 1 (elevation table), used if a new table is initialized
+        * @param[out] table_valid true, if the returned table is valid, or false, if the table has to be filled by the caller
+        */
+        PolarToCartesianTable& lookup(float angle_start, float angle_increment, size_t num_points, float mirror_factor, float azimuth_offset,
+            const float* elevation_key, size_t elevation_key_size, size_t elevation_stride, bool& table_valid);
+
+        /*
+        * Clears all cached tables, e.g. after (re-)initialization of the lidar
+        */
+        void clear(void)
+        {
+            m_tables.clear();
+        }
+
+    protected:
+
+        size_t m_max_num_tables;
+        uint64_t m_lookup_cnt = 0;
+        std::vector<PolarToCartesianTable> m_tables;
+
+    }; // class PolarToCartesianTableCache
+} // namespace sick_scan_xd
+#endif // SICK_POLAR_TO_CARTESIAN_H_
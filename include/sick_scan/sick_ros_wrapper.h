@@ -200,6 +200,11 @@ template <typename T> rosPublisher<T> rosAdvertise(rosNodePtr nh, const std::str
 }
 template <typename T> void rosPublish(rosPublisher<T>& publisher, const T& msg) { publisher.publish(msg); }
 template <typename T> std::string rosTopicName(rosPublisher<T>& publisher) { return publisher.getTopic(); }
+#if __ROS_VERSION == 0
+template <typename T> size_t rosNumSubscribers(rosPublisher<T>& publisher) { return 0; } // ros simu: messages are never published, API listener are notified by callbacks
+#else
+template <typename T> size_t rosNumSubscribers(rosPublisher<T>& publisher) { return (publisher ? publisher.getNumSubscribers() : 0); }
+#endif
 
 inline bool rosOk(void) { return !ros::isShuttingDown() && ros::ok() && !shutdownSignalReceived(); }
 inline void rosSpin(rosNodePtr nh) { ros::spin(); }
@@ -392,6 +397,7 @@ template <class T> rosPublisher<T> rosAdvertise(rosNodePtr nh, const std::string
 }
 template <typename T> void rosPublish(rosPublisher<T>& publisher, const T& msg) { publisher->publish(msg); }
 template <typename T> std::string rosTopicName(rosPublisher<T>& publisher) { return publisher->get_topic_name(); }
+template <typename T> size_t rosNumSubscribers(rosPublisher<T>& publisher) { return (publisher ? publisher->get_subscription_count() : 0); }
 
 inline bool rosOk(void) { return !shutdownSignalReceived() && rclcpp::ok(); }
 inline void rosSpin(rosNodePtr nh) { rclcpp::spin(nh); }
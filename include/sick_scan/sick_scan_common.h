@@ -77,6 +77,9 @@
 #include <mutex>
 
 #include <sick_scan/sick_cloud_transform.h>
+#include <sick_scan/sick_polar_to_cartesian.h>
+#include <sick_scan/sick_scan_decode_buffer.h>
+#include <sick_scan/sick_scan_publish_pipeline.h>
 #include <sick_scan/sick_range_filter.h>
 #include <sick_scan/sick_scan_common_nw.h>
 #include <sick_scan/helper/angle_compensator.h>
@@ -85,6 +88,8 @@
 #include "sick_scan/sick_nav_scandata_parser.h"
 #include "sick_scan/sick_scan_common_nw.h"
 #include "sick_scan/sick_generic_field_mon.h"
+#include "sick_scan/sick_generic_radar.h"
+#include "sick_scan/softwarePLL.h"
 #include "sick_scan/sick_scan_marker.h"
 
 /*
@@ -98,6 +103,7 @@ void swap_endian(unsigned char *ptr, int numBytes);
 
 namespace sick_scan_xd
 {
+  class SickScanImu;
 
   class SickScanCommon
   {
@@ -235,6 +241,23 @@ namespace sick_scan_xd
 
     virtual ~SickScanCommon();
 
+    SoftwarePLL& getSoftwarePLL(void) { return m_software_pll; } // software pll of this lidar
+
+    /*
+    * Binds the SoftwarePLL, field monitoring and radar instance of a lidar to the current thread while the ScopedLidarInstance exists,
+    * i.e. SoftwarePLL::instance(), SickScanFieldMonSingleton::getInstance() and SickScanRadarSingleton::getInstance() return the
+    * instances of this lidar. Multiple lidars can run in one process, each processed with its own state.
+    */
+    class ScopedLidarInstance
+    {
+    public:
+      ScopedLidarInstance(SickScanCommon* lidar) : m_pll(&lidar->m_software_pll), m_field_mon(lidar->m_field_mon), m_radar(lidar->m_radar) {}
+    private:
+      SoftwarePLL::ScopedInstance m_pll;
+      SickScanFieldMonSingleton::ScopedInstance m_field_mon;
+      SickScanRadarSingleton::ScopedInstance m_radar;
+    };
+
     int setParticleFilter(bool _active, int _particleThreshold);//actualy only 500 mm is working.
     /*! Changes the Identifier of a commandstr. to its expected answer counterpart
      *
@@ -363,6 +386,21 @@ namespace sick_scan_xd
 
     static bool dumpDatagramForDebugging(unsigned char *buffer, int bufLen, bool isBinary = true);
 
+    /*!
+    \brief Clamps the sectors of partial pointclouds (cloud_output_mode 2) to the number of shots per scan,
+           i.e. sector_size * sector_count must not exceed num_shots (ignored if num_shots <= 0).
+    \return true if sector_size and sector_count have not been changed, false otherwise
+    */
+    static bool clampCloudOutputSectors(int num_shots, int& sector_size, int& sector_count);
+
+    /*!
+    \brief Slices sector sector_idx of a partial pointcloud (cloud_output_mode 2) from the layers accumulated in cloud.
+           Shots [j * sector_size * sector_count + sector_idx * sector_size, + sector_size) of the 4 layers j are copied
+           from row 1 + layer_seq[(j + layer_cnt) % 4] of cloud, clamped to the cloud width and height. Width, point_step,
+           row_step and data of partial_cloud are set to the copied points, header and fields are not modified.
+    */
+    static void slicePartialCloud(const ros_sensor_msgs::PointCloud2& cloud, const int layer_seq[4], int layer_cnt, int sector_size, int sector_count, int sector_idx, ros_sensor_msgs::PointCloud2& partial_cloud);
+
     //////
     // Dynamic Reconfigure
     SickScanConfig config_;
@@ -532,6 +570,31 @@ namespace sick_scan_xd
 
     sick_scan_xd::SickCloudTransform m_add_transform_xyz_rpy;
 
+    sick_scan_xd::PolarToCartesianTableCache m_polar_to_cartesian_tables; // cached azimuth and elevation lookup tables for LMDscandata
+
+    sick_scan_xd::ScanDecodeBuffer m_scan_decode_buffer; // reusable buffers to decode LMDscandata telegrams, no allocations after the first telegrams
+
+    sick_scan_xd::SickScanPublishPipeline* m_publish_pipeline; // publish thread in pipeline mode (pipeline_mode=true), or 0 if scan data are published by loopOnce (default)
+
+    // State of this lidar, formerly process wide singletons and static variables
+    SoftwarePLL m_software_pll;                       // software pll of this lidar, see ScopedLidarInstance
+    sick_scan_xd::SickScanFieldMonSingleton* m_field_mon; // field monitoring of this lidar, see ScopedLidarInstance
+    sick_scan_xd::SickScanRadarSingleton* m_radar;    // radar of this lidar, see ScopedLidarInstance, or 0 if this lidar is not a radar
+    sick_scan_xd::SickScanImu* m_scan_imu;            // imu parser, created on first call of loopOnce
+    bool m_loop_first_time_called;                    // true until slam parameter have been read by loopOnce
+    bool m_slam_bundle;                               // parameter "slam_bundle"
+    std::string m_echo_for_slam;                      // parameter "slam_echo"
+    unsigned int m_loop_iteration_count;              // number of scans processed by loopOnce, used to skip scans (parameter "skip")
+    int m_layer_cnt;                                  // number of layers received (cloud_output_mode > 0)
+    int m_layer_seq[4];                               // last 4 received layers (cloud_output_mode > 0)
+    int m_cloud_output_sector_size;                   // number of shots per partial pointcloud (cloud_output_mode 2), parameter "cloud_output_sector_size"
+    int m_cloud_output_sector_count;                  // number of partial pointclouds per scan (cloud_output_mode 2), parameter "cloud_output_sector_count"
+    std::vector<ros_sensor_msgs::PointCloud2> m_partial_clouds; // preallocated partial pointclouds (cloud_output_mode 2), reused from scan to scan
+    bool m_field_evaluation_active;                   // FieldEvaluationActive as reported by the lidar
+    bool m_cloud_frame_start;                         // true if the next scan starts a new pointcloud (i.e. the previous pointcloud has been published)
+    bool m_cartesian_cloud_required;                  // cartesian pointcloud required for the current pointcloud, latched at the start of each pointcloud
+    bool m_polar_cloud_required;                      // polar pointcloud required for the current pointcloud, latched at the start of each pointcloud
+
     struct ScanLayerFilterCfg // Optional ScanLayerFilter setting
     {
       ScanLayerFilterCfg(const std::string& parameter = "") // parameter for ScanLayerFilter, e.g. "4 1 1 1 1"
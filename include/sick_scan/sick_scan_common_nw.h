@@ -73,6 +73,12 @@ public:
   // Returns a timestamp in nanoseconds of the last received tcp message (or 0 if no message received)
 	uint64_t getNanosecTimestampLastTcpMessageReceived(void);
 
+  // Returns the receive timestamp of the data passed to the read callback (kernel receive timestamp if supported)
+  rosTime getReceiveTimestamp(void);
+
+  // Optional socket reactor receiving data from all connections, must be set before connect() (default: 0, i.e. one read thread per connection)
+  void setSocketReactor(sick_scan_xd::SocketReactor* reactor) { m_tcp.setSocketReactor(reactor); }
+
 private:
   // TCP
   bool openTcpConnection();
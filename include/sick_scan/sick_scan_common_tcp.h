@@ -60,6 +60,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #undef NOMINMAX // to get rid off warning C4005: "NOMINMAX": Makro-Neudefinition
 
@@ -77,7 +78,7 @@ namespace sick_scan_xd
     DatagramWithTimeStamp(rosTime timeStamp_, std::vector<unsigned char> datagram_)
     {
       timeStamp = timeStamp_;
-      datagram = datagram_;
+      datagram = std::move(datagram_);
     }
 
     virtual std::vector<unsigned char> & data(void) { return datagram; }
@@ -88,6 +89,40 @@ namespace sick_scan_xd
   };
 
 
+  /*
+  * class SopasFrameAssembler buffers the bytes received by tcp and extracts CoLa-A and CoLa-B frames.
+  * Frames are returned as views into the receive buffer, i.e. frames are not copied and the remaining bytes are not moved after each frame.
+  * The buffer is compacted only if the free space behind the received bytes is too small, and it grows for frames larger than its capacity
+  * (e.g. large MRS-6124 or NAV-350 telegrams) up to a max. capacity.
+  */
+  class SopasFrameAssembler
+  {
+  public:
+
+    SopasFrameAssembler(size_t initial_capacity = 64 * 1024, size_t max_capacity = 4 * 1024 * 1024);
+
+    /** Appends received bytes. Frames returned by nextFrame() before are invalid after append(). Returns false, if the max. capacity is exceeded. */
+    bool append(const UINT8* data, size_t length);
+
+    /** Returns and consumes the next complete frame, or an empty frame (size 0) if no complete frame has been received. The frame is valid until the next call of append(). */
+    SopasEventMessage nextFrame(SopasProtocol protocol, bool verbose);
+
+    /** Removes all bytes from the buffer */
+    void clear(void);
+
+    /** Returns the number of bytes in the buffer */
+    size_t size(void) const { return m_end - m_begin; }
+
+  protected:
+
+    std::vector<UINT8> m_buffer; ///< receive buffer, bytes m_buffer[m_begin] to m_buffer[m_end-1] are valid
+    size_t m_begin;              ///< start of the next frame
+    size_t m_end;                ///< end of received bytes
+    size_t m_search_pos;         ///< CoLa-A: ETX not found in m_buffer[m_begin+1] to m_buffer[m_search_pos-1]
+    size_t m_max_capacity;       ///< max. size of m_buffer
+  };
+
+
   class SickScanCommonTcp : public SickScanCommon
   {
   public:
@@ -173,8 +208,7 @@ namespace sick_scan_xd
     Mutex m_receiveDataMutex; ///< Access mutex for buffer
 
     // Receive buffer
-    UINT32 m_numberOfBytesInReceiveBuffer; ///< Number of bytes in buffer
-    UINT8 m_receiveBuffer[480000]; ///< Low-Level receive buffer for all data
+    SopasFrameAssembler m_receiveBuffer; ///< Low-Level receive buffer for all data
 
     bool m_beVerbose;
     bool m_emulSensor;
@@ -0,0 +1,128 @@
+#include "sick_scan/sick_scan_base.h" /* Base definitions included in all header files, added by add_sick_scan_base_header.py. Do not edit this line. */
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+
+
+#ifndef SICK_SCAN_DECODE_BUFFER_H_
+#define SICK_SCAN_DECODE_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sick_scan/sick_ros_wrapper.h"
+#include "sick_scan/sick_polar_to_cartesian.h"
+
+namespace sick_scan_xd
+{
+    /*
+    * class ScanDecodeBuffer holds the reusable decoding storage of a lidar for LMDscandata telegrams in SickScanCommon::loopOnce.
+    * Ranges, intensities and elevation angles of all echos are decoded into these buffers. The LaserScan message of each echo
+    * and the point cloud rows are filled from slices of these buffers. All vectors keep their capacity from telegram to telegram,
+    * i.e. after the first telegrams no memory is allocated for decoding.
+    */
+    class ScanDecodeBuffer
+    {
+    public:
+
+        /*
+        * Prepares the decoding of a new telegram and returns the LaserScan message to decode into.
+        * Scalar fields are reset to default, ranges and intensities are cleared (capacity is kept).
+        */
+        ros_sensor_msgs::LaserScan& beginTelegram(void);
+
+        /*
+        * Moves the decoded ranges and intensities of all echos from the LaserScan message into the telegram buffers
+        * ranges_all_echos and intensities_all_echos (swap, no copy). The message is filled by sliceEcho afterwards.
+        */
+        void takeEchos(ros_sensor_msgs::LaserScan& msg);
+
+        /*
+        * Sets ranges and intensities of a LaserScan message to the values of echo echo_idx, i.e. to the slice
+        * [echo_idx * num_values, (echo_idx + 1) * num_values) of the telegram buffers. Intensities are set to 0,
+        * if the telegram does not contain intensity values for this echo.
+        */
+        void sliceEcho(size_t echo_idx, size_t num_values, ros_sensor_msgs::LaserScan& msg) const;
+
+        /*
+        * Resizes the point buffers for one echo (range, valid flag and cartesian coordinates) to num_points
+        */
+        void resizeEchoPoints(size_t num_points);
+
+        /*
+        * Copies the range values of echo echo_idx, i.e. the slice [echo_idx * num_points, (echo_idx + 1) * num_points) of ranges_all_echos,
+        * into echo_range, applies the range filter and converts the points to cartesian coordinates echo_x, echo_y and echo_z
+        * (if cartesian is true) using the lookup tables. The point buffers must have been resized by resizeEchoPoints(num_points).
+        * Returns the number of points not dropped by the range filter.
+        */
+        size_t convertEcho(size_t echo_idx, size_t num_points, const SickRangeFilter& range_filter, const PolarToCartesianTable& table, SickCloudTransform* transform, bool cartesian);
+
+        ros_sensor_msgs::LaserScan scan;          // LaserScan message: decoded telegram, then message of the current echo
+        std::vector<float> ranges_all_echos;      // range values of all echos of the current telegram
+        std::vector<float> intensities_all_echos; // intensity values of all echos of the current telegram
+        std::vector<float> vang;                  // elevation angles of all points (VANG channel, MRS-6xxx) or empty
+
+        std::vector<float> echo_range;            // range values of the current echo, modified by the range filter
+        std::vector<uint8_t> echo_valid;          // echo_valid[n] := 0, if point n has been dropped by the range filter, otherwise 1
+        std::vector<float> echo_x;                // cartesian x of the current echo
+        std::vector<float> echo_y;                // cartesian y of the current echo
+        std::vector<float> echo_z;                // cartesian z of the current echo
+
+    }; // class ScanDecodeBuffer
+
+} // namespace sick_scan_xd
+#endif // SICK_SCAN_DECODE_BUFFER_H_
@@ -0,0 +1,179 @@
+#include "sick_scan/sick_scan_base.h" /* Base definitions included in all header files, added by add_sick_scan_base_header.py. Do not edit this line. */
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+
+
+#ifndef SICK_SCAN_PUBLISH_PIPELINE_H_
+#define SICK_SCAN_PUBLISH_PIPELINE_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "sick_scan/sick_ros_wrapper.h"
+
+namespace sick_scan_xd
+{
+    /*
+    * class PipelineStageStatistics counts the latency of a pipeline stage in milliseconds (number of measurements, mean and max latency).
+    */
+    class PipelineStageStatistics
+    {
+    public:
+        PipelineStageStatistics() : m_cnt(0), m_sum_msec(0), m_max_msec(0) {}
+        void add(double latency_msec) { m_cnt++; m_sum_msec += latency_msec; m_max_msec = std::max(m_max_msec, latency_msec); }
+        size_t count(void) const { return m_cnt; }
+        double meanMilliseconds(void) const { return (m_cnt > 0) ? (m_sum_msec / m_cnt) : 0; }
+        double maxMilliseconds(void) const { return m_max_msec; }
+        std::string print(void) const;
+    protected:
+        size_t m_cnt;
+        double m_sum_msec;
+        double m_max_msec;
+    };
+
+    /*
+    * class SickScanPublishPipeline decouples parsing and publishing of scan data (pipeline mode).
+    * SickScanCommon::loopOnce receives and parses datagrams and converts them to LaserScan and PointCloud2 messages.
+    * In pipeline mode, the publish and notify functions for these messages are pushed to a bounded queue and run by a separate
+    * publish thread in the order they were pushed. A slow publisher or API listener then no longer stalls parsing.
+    * Datagrams are received by the tcp read thread and its receive queue, i.e. the pipeline has three stages:
+    * receive (tcp thread) -> parse and convert (loopOnce) -> publish and notify (publish thread)
+    * If the publish queue is full, the oldest publish job is dropped.
+    */
+    class SickScanPublishPipeline
+    {
+    public:
+
+        typedef std::function<void(void)> PublishFunction;
+
+        /*
+        * Constructor, starts the publish thread
+        * @param[in] max_queue_size max. number of publish jobs waiting for the publish thread
+        */
+        SickScanPublishPipeline(size_t max_queue_size = 16);
+
+        /*
+        * Destructor, publishes all pending jobs and stops the publish thread
+        */
+        ~SickScanPublishPipeline();
+
+        /*
+        * Pushes a publish job to the queue of the publish thread.
+        * @param[in] publish_function function publishing and notifying messages, runs in the publish thread
+        * @param[in] receive_timestamp_nsec system time in nanoseconds when the datagram was received
+        * @param[in] parse_start_timestamp_nsec system time in nanoseconds when parsing of the datagram started
+        */
+        void push(PublishFunction&& publish_function, uint64_t receive_timestamp_nsec, uint64_t parse_start_timestamp_nsec);
+
+        /*
+        * Publishes all pending jobs and stops the publish thread
+        */
+        void stop(void);
+
+        /*
+        * Returns the number of publish jobs dropped because of a full queue
+        */
+        size_t getNumberOfDroppedJobs(void);
+
+        /*
+        * Prints the latency statistics of all pipeline stages
+        */
+        std::string printStatistics(void);
+
+    protected:
+
+        /*
+        * Publish job with timestamps in nanoseconds for latency statistics
+        */
+        struct PublishJob
+        {
+            PublishFunction publish_function;
+            uint64_t receive_timestamp_nsec;
+            uint64_t parse_start_timestamp_nsec;
+            uint64_t push_timestamp_nsec;
+        };
+
+        /*
+        * Thread function: runs all publish jobs in the order they were pushed
+        */
+        void runPublishThread(void);
+
+        size_t m_max_queue_size;                // max. number of publish jobs waiting in m_queue
+        std::deque<PublishJob> m_queue;         // publish jobs waiting for the publish thread
+        std::mutex m_queue_mutex;               // lock for m_queue and statistics
+        std::condition_variable m_queue_cond;   // notifies the publish thread about new jobs
+        bool m_run_publish_thread;              // false: publish thread stops after the queue is empty
+        std::thread* m_publish_thread;          // publish thread
+        size_t m_num_dropped_jobs;              // number of jobs dropped because of a full queue
+        PipelineStageStatistics m_receive_latency;  // latency between datagram receive and start of parsing (receive queue)
+        PipelineStageStatistics m_parse_latency;    // duration of parsing and conversion
+        PipelineStageStatistics m_queue_latency;    // latency between push and start of publishing (publish queue)
+        PipelineStageStatistics m_publish_latency;  // duration of publishing and notification
+        PipelineStageStatistics m_total_latency;    // latency between datagram receive and end of publishing
+        uint64_t m_last_print_timestamp_nsec;   // system time of last statistics printed in debug mode
+
+    }; // class SickScanPublishPipeline
+
+} // namespace sick_scan_xd
+
+#endif // SICK_SCAN_PUBLISH_PIPELINE_H_
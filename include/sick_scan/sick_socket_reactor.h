@@ -0,0 +1,179 @@
+#include "sick_scan/sick_scan_base.h" /* Base definitions included in all header files, added by add_sick_scan_base_header.py. Do not edit this line. */
+/*
+* Copyright (C) 2017, Ing.-Buero Dr. Michael Lehning, Hildesheim
+* Copyright (C) 2017, SICK AG, Waldkirch
+* All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*       http://www.apache.org/licenses/LICENSE-2.0
+*
+*   Unless required by applicable law or agreed to in writing, software
+*   distributed under the License is distributed on an "AS IS" BASIS,
+*   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*   See the License for the specific language governing permissions and
+*   limitations under the License.
+*
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of Osnabrueck University nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission.
+*     * Neither the name of SICK AG nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+*       contributors may be used to endorse or promote products derived from
+*       this software without specific prior written permission
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  Created on: 17.10.2026
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ */
+
+
+#ifndef SICK_SOCKET_REACTOR_H_
+#define SICK_SOCKET_REACTOR_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sick_scan/sick_ros_wrapper.h"
+
+namespace sick_scan_xd
+{
+    /*
+    * class SocketReactor receives data from many sockets (tcp and udp connections of multiple lidars) with a fixed number of threads.
+    * By default, each tcp connection and each udp receiver runs its own receive thread. If parameter io_reactor_threads > 0,
+    * all sockets are registered at one process wide SocketReactor instead. Its threads wait for incoming data using epoll
+    * and dispatch ready sockets to the read callback of their connection. The number of threads is independent of the number of lidars.
+    * Each socket is served by one reactor thread, i.e. read callbacks of a socket are never called concurrently and in order of arrival.
+    * The SocketReactor requires epoll (Linux). On other systems, isSupported() returns false and connections use their own receive threads.
+    */
+    class SocketReactor
+    {
+    public:
+
+        typedef std::function<void(void)> ReadCallback; // called by a reactor thread when a socket is readable, closed or in error state
+
+        /*
+        * Constructor, starts the reactor threads
+        * @param[in] num_threads number of reactor threads
+        */
+        SocketReactor(int num_threads = 1);
+
+        /*
+        * Destructor, stops the reactor threads
+        */
+        ~SocketReactor();
+
+        /*
+        * Returns the process wide SocketReactor, which is created with num_threads reactor threads on first call.
+        * Returns 0, if num_threads <= 0 (i.e. reactor not configured) or if the SocketReactor is not supported on this system.
+        */
+        static SocketReactor* sharedInstance(int num_threads);
+
+        /*
+        * Returns true, if the SocketReactor is supported on this system (Linux: epoll available)
+        */
+        static bool isSupported(void);
+
+        /*
+        * Registers a socket. The read callback is called by a reactor thread whenever data can be read from the socket.
+        * The read callback should read the available data without blocking. Returns false on error.
+        */
+        bool addSocket(int socket_fd, const ReadCallback& read_callback);
+
+        /*
+        * Deregisters a socket. After removeSocket returned, the read callback is not running and will not be called again.
+        * Call removeSocket before closing the socket. removeSocket can be called by the read callback itself.
+        */
+        void removeSocket(int socket_fd);
+
+        /*
+        * Stops all reactor threads and deregisters all sockets
+        */
+        void stop(void);
+
+        /*
+        * Returns the number of reactor threads
+        */
+        int numThreads(void) const { return (int)m_threads.size(); }
+
+        /*
+        * Returns the number of registered sockets
+        */
+        size_t numSockets(void);
+
+    protected:
+
+        /*
+        * Registration of a socket and its read callback
+        */
+        class Registration
+        {
+        public:
+            Registration(int _socket_fd, const ReadCallback& _read_callback) : socket_fd(_socket_fd), read_callback(_read_callback), removed(false) {}
+            int socket_fd;
+            ReadCallback read_callback;
+            std::mutex callback_mutex; // locked while the read callback is running
+            bool removed;              // true after the socket has been deregistered
+        };
+
+        /*
+        * A reactor thread with its epoll instance and all sockets served by this thread
+        */
+        class ReactorThread
+        {
+        public:
+            ReactorThread() : epoll_fd(-1), wakeup_fd(-1), thread(0) {}
+            int epoll_fd;  // epoll instance of this thread
+            int wakeup_fd; // eventfd to wake up the thread on stop
+            std::thread* thread;
+            std::thread::id thread_id;
+            std::mutex registrations_mutex;
+            std::map<int, std::shared_ptr<Registration>> registrations; // all sockets served by this thread, key: socket
+        };
+
+        /*
+        * Thread function of a reactor thread: waits for readable sockets and calls their read callbacks
+        */
+        void runReactorThread(ReactorThread* reactor_thread);
+
+        std::vector<ReactorThread*> m_threads;          // all reactor threads
+        std::map<int, ReactorThread*> m_socket_threads; // thread serving a socket, key: socket
+        std::mutex m_socket_threads_mutex;              // protects m_socket_threads
+        bool m_run_threads;                             // flag to stop the reactor threads
+    };
+
+} // namespace sick_scan_xd
+#endif // SICK_SOCKET_REACTOR_H_
@@ -6,6 +6,7 @@
 #pragma warning(disable : 4996)
 #endif
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <iostream>
@@ -20,10 +21,34 @@
 class SoftwarePLL
 {
 public:
-  static SoftwarePLL &instance()
+  // Returns the SoftwarePLL of the lidar processed by the current thread (see SoftwarePLL::ScopedInstance),
+  // or the process wide default instance if no instance is bound to the current thread. A warning is printed once per thread,
+  // if the default instance is used on an unbound thread while multiple lidars are running.
+  static SoftwarePLL &instance();
+
+  // Number of lidars running with their own SoftwarePLL in this process (i.e. number of SickScanCommon instances)
+  static std::atomic<int>& numLidarInstances()
+  {
+    static std::atomic<int> s_num_lidar_instances(0);
+    return s_num_lidar_instances;
+  }
+
+  // Binds a SoftwarePLL to the current thread while the ScopedInstance exists, i.e. SoftwarePLL::instance() returns
+  // the SoftwarePLL of the lidar processed by this thread. Used to run multiple lidars with their own SoftwarePLL in one process.
+  class ScopedInstance
+  {
+  public:
+    ScopedInstance(SoftwarePLL* pll) : m_prev_instance(boundInstance()) { boundInstance() = pll; }
+    ~ScopedInstance() { boundInstance() = m_prev_instance; }
+  private:
+    SoftwarePLL* m_prev_instance;
+  };
+
+  SoftwarePLL()
   {
-    static SoftwarePLL _instance;
-    return _instance;
+    AllowedTimeDeviation(SoftwarePLL::MaxAllowedTimeDeviation); // 1 ms
+    numberValInFifo = 0;
+    isInitialized = false;
   }
 
   ~SoftwarePLL()
@@ -85,6 +110,7 @@ public:
   size_t packets_dropped = 0;    // just for printing statusmessages when dropping packets
   size_t packets_received = 0;   // just for printing statusmessages when dropping packets
   double max_abs_delta_time = 0; // just for printing statusmessages when dropping packets
+  uint32_t lastSystemCountScan = 0; // used to ensure that only the first time stamp of an multi layer scan is used for PLL updating
 
 private:
   int numberValInFifo;
@@ -112,11 +138,10 @@ private:
 
   uint32_t extrapolationDivergenceCounter;
 
-  SoftwarePLL()
+  static SoftwarePLL*& boundInstance()
   {
-    AllowedTimeDeviation(SoftwarePLL::MaxAllowedTimeDeviation); // 1 ms
-    numberValInFifo = 0;
-    isInitialized = false;
+    static thread_local SoftwarePLL* s_bound_instance = 0;
+    return s_bound_instance;
   }
 
   // verhindert, dass ein Objekt von au�erhalb von N erzeugt wird.
@@ -29,6 +29,7 @@
 #include "sick_scan/tcp/SickThread.hpp"
 #include <list>
 
+namespace sick_scan_xd { class SocketReactor; }
 
 //
 // Sender and receiver for data over a TCP connection. Client!
@@ -60,6 +61,10 @@ public:
 	void setDisconnectCallbackFunction(DisconnectFunction discFunction, void* obj);
 
 	uint64_t getNanosecTimestampLastTcpMessageReceived(void) { return m_last_tcp_msg_received_nsec; } // Returns a timestamp in nanoseconds of the last received tcp message (or 0 if no message received)
+	rosTime getReceiveTimestamp(void) { return m_recv_timestamp; } // Returns the receive timestamp of the data passed to the read callback, i.e. the kernel receive timestamp if supported (Linux), or the time of the recv call otherwise
+
+	// Optional socket reactor: if set before open(), data are received by the reactor threads instead of a read thread of this connection
+	void setSocketReactor(sick_scan_xd::SocketReactor* reactor) { m_reactor = reactor; }
 
 private:
 	bool m_longStringWarningPrinted;
@@ -82,6 +87,11 @@ private:
 	void readThreadFunction(bool& endThread, UINT16& waitTimeMs);
 	SickThread<Tcp, &Tcp::readThreadFunction>* m_readThread;
 	INT32 readInputData();
+	INT32 processInputData(UINT8* inBuffer, INT32 recvMsgSize);
+	void readReactorEvent();
+#ifndef _MSC_VER
+	INT32 recvWithTimestamp(UINT8* buffer, UINT32 bufferLen, int flags = 0);
+#endif
 	
 	ReadFunction m_readFunction;		// Receive callback
 	void* m_readFunctionObjPtr;			// Object of the Receive callback
@@ -89,6 +99,10 @@ private:
 	void* m_disconnectFunctionObjPtr;	// Object of the Disconect callback
 
 	uint64_t m_last_tcp_msg_received_nsec; // timestamp in nanoseconds of the last received tcp message (or 0 if no message received)
+	rosTime m_recv_timestamp;              // receive timestamp of the last received tcp message
+	bool m_kernel_timestamps;              // true if kernel receive timestamps are enabled (SO_TIMESTAMPNS, Linux only)
+	sick_scan_xd::SocketReactor* m_reactor; // optional socket reactor receiving data from all connections (or 0: receive by m_readThread)
+	bool m_reactor_registered;             // true if the socket is registered at m_reactor
 };
 
 #endif // TCP_HPP
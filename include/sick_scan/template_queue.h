@@ -2,18 +2,83 @@
 #ifndef TEMPLATE_QUEUE_H
 #define TEMPLATE_QUEUE_H
 
-#include <queue>
-#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <list>
 #include <thread>
 #include <iostream>
 #include <mutex>
 #include <condition_variable>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+\brief Datagram types of the receive queue. Datagrams are classified once on push and buffered in one ring for each type.
+*/
+enum QueueDatagramType
+{
+  QUEUE_DATAGRAM_LMDSCANDATAMON = 0,   // "LMDscandatamon"
+  QUEUE_DATAGRAM_LMDSCANDATA,          // "LMDscandata"
+  QUEUE_DATAGRAM_LMDRADARDATA,         // "LMDradardata"
+  QUEUE_DATAGRAM_IMU,                  // "InertialMeasurementUnit"
+  QUEUE_DATAGRAM_LIDOUTPUTSTATE,       // "LIDoutputstate"
+  QUEUE_DATAGRAM_LIDINPUTSTATE,        // "LIDinputstate"
+  QUEUE_DATAGRAM_LFEREC,               // "LFErec"
+  QUEUE_DATAGRAM_MNPOSGETDATA,         // "mNPOSGetData"
+  QUEUE_DATAGRAM_SOPAS_REPLY,          // all other datagrams, i.e. replies to sopas requests
+  QUEUE_DATAGRAM_SOPAS_ERROR,          // "sFA" error replies, returned on any request
+  QUEUE_DATAGRAM_NUM_TYPES
+};
 
+/*!
+\brief Drop policy of a ring, if the max. number of entries is exceeded
+*/
+enum QueueDropPolicy
+{
+  QUEUE_DROP_OLDEST = 0, // drop the oldest entry, i.e. keep the most recent datagrams (default for streaming data like scandata)
+  QUEUE_DROP_NEWEST = 1  // drop the new entry, i.e. keep pending datagrams (default for sopas replies)
+};
+
+/*!
+\brief Receive queue for datagrams. Each datagram is classified by its keyword once on push and appended to a bounded ring for its type.
+Datagrams are classified by their complete keyword token (terminated by a space or ETX), i.e. a "sRA LMDscandatacfg" reply is a sopas reply, not a "LMDscandata" datagram.
+waitForIncomingObject and pop look up the rings of the requested keywords, i.e. they do not rescan the queue.
+Datagrams are returned in order of arrival across all requested types.
+T requires a method std::vector<unsigned char>& data() returning the datagram.
+*/
 template<typename T>
 class Queue
 {
 public:
 
+  Queue() : num_entries_(0), next_seq_(0)
+  {
+    const char* keywords[QUEUE_DATAGRAM_NUM_TYPES] = { "LMDscandatamon", "LMDscandata", "LMDradardata", "InertialMeasurementUnit",
+      "LIDoutputstate", "LIDinputstate", "LFErec", "mNPOSGetData", "", "sFA" };
+    for (int type = 0; type < QUEUE_DATAGRAM_NUM_TYPES; type++)
+    {
+      rings_[type].keyword = keywords[type];
+      rings_[type].max_entries = 256;
+      rings_[type].drop_policy = QUEUE_DROP_OLDEST;
+      rings_[type].num_dropped = 0;
+      num_waiting_[type] = 0;
+    }
+    rings_[QUEUE_DATAGRAM_SOPAS_REPLY].drop_policy = QUEUE_DROP_NEWEST;
+    rings_[QUEUE_DATAGRAM_SOPAS_ERROR].drop_policy = QUEUE_DROP_NEWEST;
+    // A requested keyword matches all types starting with this keyword, e.g. "LMDscandata" matches "LMDscandata" and "LMDscandatamon"
+    for (int type = 0; type < QUEUE_DATAGRAM_SOPAS_REPLY; type++)
+    {
+      for (int type_matched = 0; type_matched < QUEUE_DATAGRAM_SOPAS_REPLY; type_matched++)
+      {
+        if (rings_[type_matched].keyword.compare(0, rings_[type].keyword.size(), rings_[type].keyword) == 0)
+          keyword_types_[rings_[type].keyword].push_back(type_matched);
+      }
+    }
+  }
+
   /*!
   \brief get number of entries in queue
   \return Number of entries in queue
@@ -21,114 +86,270 @@ public:
   */
   int getNumberOfEntriesInQueue()
   {
-    int retVal = 0;
     std::unique_lock<std::mutex> mlock(mutex_);
-    retVal = queue_.size();
-    return (retVal);
+    return (int)num_entries_;
   }
 
   bool isQueueEmpty()
   {
-    bool retVal = false;
     std::unique_lock<std::mutex> mlock(mutex_);
-    retVal = queue_.empty();
-    return (retVal);
+    return num_entries_ == 0;
+  }
+
+  /*!
+  \brief sets the max. number of entries and the drop policy of a ring
+  */
+  void setMaxEntries(QueueDatagramType type, size_t max_entries, QueueDropPolicy drop_policy)
+  {
+    std::unique_lock<std::mutex> mlock(mutex_);
+    rings_[type].max_entries = std::max<size_t>(1, max_entries);
+    rings_[type].drop_policy = drop_policy;
+  }
+
+  /*!
+  \brief returns the number of datagrams dropped by a ring since start
+  */
+  size_t getNumberOfDroppedEntries(QueueDatagramType type)
+  {
+    std::unique_lock<std::mutex> mlock(mutex_);
+    return rings_[type].num_dropped;
   }
 
   bool waitForIncomingObject(int timeOutInMs, const std::vector<std::string>& datagram_keywords)
   {
     std::unique_lock<std::mutex> mlock(mutex_);
+    RequestedTypes requested;
+    getRequestedTypes(datagram_keywords, requested);
+    Ring* ring_found = 0;
+    typename std::deque<Entry>::iterator datagram_found;
     bool ret = true;
-    typename std::list<T>::iterator datagram_found;
-    while (findFirstByKeyword(datagram_keywords, datagram_found) == false && (ret == true))
+    if (!findFirstByKeyword(requested, ring_found, datagram_found))
     {
-      ret = (cond_.wait_for(mlock, std::chrono::milliseconds(timeOutInMs)) == std::cv_status::no_timeout);
+      std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeOutInMs);
+      setWaiting(requested, +1);
+      while (ret && !findFirstByKeyword(requested, ring_found, datagram_found))
+      {
+        ret = (cond_.wait_until(mlock, deadline) == std::cv_status::no_timeout);
+      }
+      setWaiting(requested, -1);
     }
-    return (ret);
+    return ret;
   }
 
   T pop(const std::vector<std::string>& datagram_keywords) // T pop(const std::vector<std::string>& datagram_keywords = {})
   {
     std::unique_lock<std::mutex> mlock(mutex_);
-    typename std::list<T>::iterator datagram_found;
-    while (findFirstByKeyword(datagram_keywords, datagram_found) == false)
+    RequestedTypes requested;
+    getRequestedTypes(datagram_keywords, requested);
+    Ring* ring_found = 0;
+    typename std::deque<Entry>::iterator datagram_found;
+    if (!findFirstByKeyword(requested, ring_found, datagram_found))
     {
-      cond_.wait(mlock);
+      setWaiting(requested, +1);
+      while (!findFirstByKeyword(requested, ring_found, datagram_found))
+      {
+        cond_.wait(mlock);
+      }
+      setWaiting(requested, -1);
     }
-    T item = *datagram_found;
-    queue_.erase(datagram_found);
+    T item = std::move(datagram_found->item);
+    ring_found->entries.erase(datagram_found);
+    num_entries_--;
     return item;
   }
 
   void push(const T &item)
   {
+    push(T(item));
+  }
+
+  void push(T &&item)
+  {
+    bool notify = false;
     {
       std::unique_lock<std::mutex> mlock(mutex_);
-      queue_.push_back(item);
+      Entry entry(std::move(item), next_seq_++);
+      int type = classifyDatagram(entry);
+      Ring& ring = rings_[type];
+      if (ring.entries.size() >= ring.max_entries)
+      {
+        ring.num_dropped++;
+        if ((ring.num_dropped % 100) == 1)
+          ROS_WARN_STREAM("## WARNING Queue::push(): receive queue for \"" << (ring.keyword.empty() ? "sopas replies" : ring.keyword) << "\" datagrams full (" << ring.max_entries << " entries), "
+            << ring.num_dropped << " datagrams dropped since start");
+        if (ring.drop_policy == QUEUE_DROP_NEWEST)
+          return;
+        ring.entries.pop_front();
+        num_entries_--;
+      }
+      ring.entries.push_back(std::move(entry));
+      num_entries_++;
+      notify = (num_waiting_[type] > 0); // only wake up consumers waiting for this type
     }
-    cond_.notify_all(); // cond_.notify_one();
+    if (notify)
+      cond_.notify_all();
   }
 
 
 protected:
-  
-  bool findFirstByKeyword(const std::vector<std::string>& keywords, typename std::list<T>::iterator & iter)
+
+  /*!
+  \brief queue entry: datagram, sequence number (order of arrival) and keyword position within the datagram
+  */
+  class Entry
+  {
+  public:
+    Entry(T&& item_, uint64_t seq_) : item(std::move(item_)), seq(seq_), keyword_offset(0), keyword_maxlen(-1), keyword_len(0) {}
+    T item;
+    uint64_t seq;
+    size_t keyword_offset; // datagram keyword starts at item.data()[keyword_offset]
+    int keyword_maxlen;    // max. length of the datagram keyword, or -1 if the datagram has no keyword
+    int keyword_len;       // length of the datagram keyword token, i.e. number of bytes up to the first space or ETX
+  };
+
+  /*!
+  \brief bounded ring of datagrams of one type
+  */
+  class Ring
+  {
+  public:
+    std::string keyword;
+    std::deque<Entry> entries;
+    size_t max_entries;
+    QueueDropPolicy drop_policy;
+    size_t num_dropped;
+  };
+
+  /*!
+  \brief types and keywords of a request: types[n] is true, if datagrams of type n are requested. Keywords of sopas replies are compared to the datagrams in the reply ring.
+  */
+  class RequestedTypes
+  {
+  public:
+    RequestedTypes() : any(false) { for (int type = 0; type < QUEUE_DATAGRAM_NUM_TYPES; type++) types[type] = false; }
+    bool any; // empty keyword list, i.e. any datagram requested
+    bool types[QUEUE_DATAGRAM_NUM_TYPES];
+    std::vector<const std::string*> reply_keywords;
+  };
+
+  /*!
+  \brief sets the keyword position and returns the datagram type
+  */
+  int classifyDatagram(Entry& entry)
+  {
+    std::vector<unsigned char>& datagram = entry.item.data();
+    uint32_t cola_b_start = 0x02020202;
+    int commandIdOffset = 1;
+    if(datagram.size() > 12 && memcmp(datagram.data(),&cola_b_start, sizeof(cola_b_start)) == 0)
+    {
+      commandIdOffset = 8; // command id behind 0x02020202 + { 4 byte payload length }
+      entry.keyword_offset = 12; // 0x02020202 + { 4 byte payload length } + { 4 byte command id incl. space }
+      entry.keyword_maxlen = (int)datagram.size() - 12;
+    }
+    else if(datagram.size() > 5)
+    {
+      commandIdOffset = 1;
+      entry.keyword_offset = 5; // 0x02 + { 4 byte command id incl. space }
+      entry.keyword_maxlen = (int)datagram.size() - 5;
+    }
+    else
+    {
+      return QUEUE_DATAGRAM_SOPAS_REPLY; // no keyword, returned on requests without keywords only
+    }
+    const unsigned char* keyword_start = datagram.data() + entry.keyword_offset;
+    while (entry.keyword_len < entry.keyword_maxlen && keyword_start[entry.keyword_len] != ' ' && keyword_start[entry.keyword_len] != 0x03)
+      entry.keyword_len++;
+    const std::string& errorIdentifier = rings_[QUEUE_DATAGRAM_SOPAS_ERROR].keyword;
+    if (datagram.size() >= (commandIdOffset + errorIdentifier.length()) && memcmp(datagram.data() + commandIdOffset, errorIdentifier.data(), errorIdentifier.length()) == 0)
+    {
+      ROS_DEBUG_STREAM("Queue::classifyDatagram(): error identifier sFA found in datagram");
+      return QUEUE_DATAGRAM_SOPAS_ERROR;
+    }
+    for (int type = 0; type < QUEUE_DATAGRAM_SOPAS_REPLY; type++)
+    {
+      const std::string& keyword = rings_[type].keyword;
+      if ((int)keyword.size() == entry.keyword_len && memcmp(keyword_start, keyword.data(), keyword.size()) == 0)
+        return type;
+    }
+    return QUEUE_DATAGRAM_SOPAS_REPLY;
+  }
+
+  bool matchesKeyword(Entry& entry, const std::string& keyword)
+  {
+    return (int)keyword.size() <= entry.keyword_maxlen && memcmp(entry.item.data().data() + entry.keyword_offset, keyword.data(), keyword.size()) == 0;
+  }
+
+  void getRequestedTypes(const std::vector<std::string>& keywords, RequestedTypes& requested)
   {
-    iter = queue_.begin();
     if(keywords.empty())
     {
-      return !queue_.empty();
+      requested.any = true;
+      for (int type = 0; type < QUEUE_DATAGRAM_NUM_TYPES; type++)
+        requested.types[type] = true;
+      return;
     }
-    for( ; iter != queue_.end(); iter++)
+    for(size_t keyword_idx = 0; keyword_idx < keywords.size(); keyword_idx++)
     {
-      std::vector<unsigned char>& datagram = iter->data();
-      uint32_t cola_b_start = 0x02020202;
-      uint8_t* datagram_keyword_start = 0;
-      int datagram_keyword_maxlen = (int)datagram.size();
-      int commandIdOffset = 1;
-      if(datagram.size() > 12 && memcmp(datagram.data(),&cola_b_start, sizeof(cola_b_start)) == 0)
-      {
-        commandIdOffset = 8; // command id behind 0x02020202 + { 4 byte payload length }
-        datagram_keyword_start = datagram.data() + 12; // 0x02020202 + { 4 byte payload length } + { 4 byte command id incl. space }
-        datagram_keyword_maxlen -= 12;
-      }
-      else if(datagram.size() > 5)
+      typename std::unordered_map<std::string, std::vector<int>>::const_iterator iter_types = keyword_types_.find(keywords[keyword_idx]);
+      if (iter_types != keyword_types_.end())
       {
-        commandIdOffset = 1;
-        datagram_keyword_start = datagram.data() + 5; // 0x02 + { 4 byte command id incl. space }
-        datagram_keyword_maxlen -= 5;
+        for (size_t n = 0; n < iter_types->second.size(); n++)
+          requested.types[iter_types->second[n]] = true;
       }
       else
-        continue;
-      
-      for(int keyword_idx = 0; keyword_idx < keywords.size(); keyword_idx++)
       {
-        const std::string& keyword = keywords[keyword_idx];
-        if(keyword.size() <= datagram_keyword_maxlen && memcmp(datagram_keyword_start, keyword.data(), keyword.size()) == 0)
-        {
-          // ROS_DEBUG_STREAM("Queue::findFirstByKeyword(): keyword_start=\"" << std::string((char*)datagram_keyword_start, keyword.size()) << "\", keyword=\"" << keyword << "\"");
-          return true;
-        }
+        requested.types[QUEUE_DATAGRAM_SOPAS_REPLY] = true;
+        requested.reply_keywords.push_back(&keywords[keyword_idx]);
       }
+    }
+    requested.types[QUEUE_DATAGRAM_SOPAS_ERROR] = true; // sFA error replies are returned on any request
+  }
 
-      // keyword not found.
-      // Check for possible sFA command as an error reply
-      std::string errorIdentifier = "sFA";
-      if (datagram.size() >= (commandIdOffset + errorIdentifier.length()))
+  void setWaiting(const RequestedTypes& requested, int delta)
+  {
+    for (int type = 0; type < QUEUE_DATAGRAM_NUM_TYPES; type++)
+    {
+      if (requested.types[type])
+        num_waiting_[type] += delta;
+    }
+  }
+
+  /*!
+  \brief returns the oldest datagram of all requested types
+  */
+  bool findFirstByKeyword(RequestedTypes& requested, Ring*& ring_found, typename std::deque<Entry>::iterator & iter_found)
+  {
+    ring_found = 0;
+    for (int type = 0; type < QUEUE_DATAGRAM_NUM_TYPES; type++)
+    {
+      Ring& ring = rings_[type];
+      if (!requested.types[type] || ring.entries.empty() || (ring_found && ring.entries.front().seq > iter_found->seq))
+        continue;
+      typename std::deque<Entry>::iterator iter = ring.entries.begin();
+      if (type == QUEUE_DATAGRAM_SOPAS_REPLY && !requested.any) // sopas replies: search for the first datagram matching a requested keyword
       {
-        const char* errorIdentifierPtr = errorIdentifier.c_str();
-        const char* cmpPtr = (const char *)(datagram.data() + commandIdOffset);
-        if (memcmp(cmpPtr, errorIdentifierPtr, errorIdentifier.length() )== 0)
+        for ( ; iter != ring.entries.end(); iter++)
         {
-          ROS_DEBUG_STREAM("Queue::findFirstByKeyword(): error identifier sFA found in datagram");
-          return true;
+          bool matched = false;
+          for (size_t keyword_idx = 0; !matched && keyword_idx < requested.reply_keywords.size(); keyword_idx++)
+            matched = matchesKeyword(*iter, *requested.reply_keywords[keyword_idx]);
+          if (matched)
+            break;
         }
+        if (iter == ring.entries.end() || (ring_found && iter->seq > iter_found->seq))
+          continue;
       }
+      ring_found = &ring;
+      iter_found = iter;
     }
-    return false; // keyword not found, iter == queue_.end()
+    return ring_found != 0;
   }
 
-  std::list<T> queue_;
+  Ring rings_[QUEUE_DATAGRAM_NUM_TYPES];
+  int num_waiting_[QUEUE_DATAGRAM_NUM_TYPES]; // number of consumers waiting for a datagram type
+  std::unordered_map<std::string, std::vector<int>> keyword_types_; // maps a requested keyword to datagram types
+  size_t num_entries_;
+  uint64_t next_seq_;
   std::mutex mutex_;
   std::condition_variable cond_;
 };
@@ -450,6 +450,7 @@ typedef struct SickScanDiagnosticMsgType // general diagnostic message
 
 typedef void* SickScanApiHandle;
 typedef void(* SickScanPointCloudMsgCallback)(SickScanApiHandle apiHandle, const SickScanPointCloudMsg* msg);
+typedef void(* SickScanPointCloudMsgZeroCopyCallback)(SickScanApiHandle apiHandle, const SickScanPointCloudMsg* msg, uint64_t buffer_handle);
 typedef void(* SickScanImuMsgCallback)(SickScanApiHandle apiHandle, const SickScanImuMsg* msg);
 typedef void(* SickScanLFErecMsgCallback)(SickScanApiHandle apiHandle, const SickScanLFErecMsg* msg);
 typedef void(* SickScanLIDoutputstateMsgCallback)(SickScanApiHandle apiHandle, const SickScanLIDoutputstateMsg* msg);
@@ -501,6 +502,21 @@ SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiDeregisterCartesianPointCloudMs
 SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiRegisterPolarPointCloudMsg(SickScanApiHandle apiHandle, SickScanPointCloudMsgCallback callback);
 SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiDeregisterPolarPointCloudMsg(SickScanApiHandle apiHandle, SickScanPointCloudMsgCallback callback);
 
+// Register / deregister a zero-copy callback for cartesian resp. polar PointCloud messages. The pointcloud is copied once into a ring of
+// reference counted buffers. The callback receives a view of the buffer, i.e. msg->data.buffer and msg->fields.buffer are borrowed (not allocated).
+// The buffer stays valid after the callback returns until it is released by SickScanApiReleasePointCloudBuffer, i.e. the data can be used
+// (e.g. mapped to a numpy array) without copying. The callback receives the handle of the buffer in parameter buffer_handle.
+// Each zero-copy callback has to release each buffer_handle exactly once.
+// If all buffers are in use (i.e. not yet released), the pointcloud is dropped for zero-copy callbacks.
+SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiRegisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiRegisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiDeregisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+
+// Release a pointcloud buffer received by a zero-copy callback (buffer_handle is the handle received by the callback).
+// A stale or repeated release of a buffer returns SICK_SCAN_API_ERROR.
+SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiReleasePointCloudBuffer(SickScanApiHandle apiHandle, uint64_t buffer_handle);
+
 // Register / deregister a callback for Imu messages
 SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiRegisterImuMsg(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback);
 SICK_SCAN_API_DECLSPEC_EXPORT int32_t SickScanApiDeregisterImuMsg(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback);
@@ -115,7 +115,8 @@ namespace sick_scansegment_xd
     class CompactModuleMeasurementData
     {
     public:
-        std::vector<ScanSegmentParserOutput::Scangroup> scandata;  // measurement data converted to ScanSegmentParserOutput scanlines
+        std::vector<ScanSegmentParserOutput::Scangroup> scandata;  // measurement data converted to ScanSegmentParserOutput scanlines, scandata[layer_idx].scanlines[echo_idx] is an index range into points
+        ScanSegmentParserOutput::SegmentPoints points;             // all points of the module, ordered by layer, echo and beam
         bool valid = false;                                    // valid flag set true after successful parsing
         std::string to_string() const;                         // returns a human readable description of the module measurement data
     }; // class CompactModuleMeasurementData
@@ -136,6 +136,10 @@ namespace sick_scansegment_xd
         std::string publish_laserscan_fullframe_topic; //topic of ros Laserscan fullframe messages
         int udp_input_fifolength;                   // = 20; // max. udp input fifo length(-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
         int msgpack_output_fifolength;              // = 20; // max. msgpack output fifo length(-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
+        int udp_recv_batch_size;                    // = 0; // max. number of udp datagrams received by one recvmmsg syscall using kernel receive timestamps (Linux only), default: 0 (one recv call per datagram)
+        int io_reactor_threads;                     // = 0; // number of epoll reactor threads receiving all sensor sockets (Linux only), default: 0 (one receiver thread per socket)
+        int msgpack_converter_threads;              // = 1; // number of threads parsing udp payloads in parallel, segments are published in order of arrival (default: 1, i.e. one converter thread)
+        int fifo_spin_count;                        // = 0; // number of busy-wait attempts before a thread waiting for udp or msgpack fifo data is parked (0: park immediately, default: 0)
         int verbose_level;                          // = 1; // verbose_level <= 0: quiet mode, verbose_level == 1: print statistics, verbose_level == 2: print details incl. msgpack data, default: 1
         bool measure_timing;                        // = true; // measure_timing == true: duration and latency of msgpack conversion and export is measured, default: true
         bool export_csv;                            // = false; // export msgpack data to csv file, default: false
@@ -183,6 +187,7 @@ namespace sick_scansegment_xd
 
         // Configuration of laserscan messages (ROS only), activate/deactivate laserscan messages for each layer
         std::vector<int> laserscan_layer_filter; // Default: { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }, i.e. laserscan messages for layer 5 activated (elevation -0.07 degree, max number of scan points)
+        double laserscan_angular_resolution;     // Angular resolution of laserscan messages in degree, default: 0 (angular resolution transmitted by the lidar)
 
         rosNodePtr node; // NodePtr node; // ROS node handle (always 0 on non-ros-targets)
 
@@ -0,0 +1,99 @@
+#include "sick_scan/sick_scan_base.h" /* Base definitions included in all header files, added by add_sick_scan_base_header.py. Do not edit this line. */
+/*
+ * @brief crc32 computes the zlib CRC32 checksum of scansegment payloads (multiScan, picoScan)
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#ifndef __SICK_SCANSEGMENT_XD_CRC32_H
+#define __SICK_SCANSEGMENT_XD_CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sick_scansegment_xd
+{
+    /*
+     * class Crc32 computes the zlib CRC32 checksum (polynomial 0xedb88320, identical to python zlib.crc32).
+     * Compute() selects the fastest implementation available at runtime:
+     * carry-less multiplication (PCLMULQDQ) on x86_64, ARMv8 CRC32 instructions on aarch64 if enabled by the compiler, slice-by-8 tables otherwise.
+     */
+    class Crc32
+    {
+    public:
+
+        /*
+         * Computes the zlib CRC32 checksum of len bytes, see https://stackoverflow.com/questions/15030011/same-crc32-for-python-and-c
+         * @param[in] crc initial crc (0 for a new checksum, or the crc of the previous block to continue a checksum)
+         * @param[in] buf data to checksum
+         * @param[in] len number of bytes
+         */
+        static uint32_t Compute(uint32_t crc, const uint8_t* buf, size_t len);
+
+        /*
+         * Bitwise reference implementation of Compute() (one bit per iteration), used for tests only.
+         */
+        static uint32_t ComputeBitwise(uint32_t crc, const uint8_t* buf, size_t len);
+
+        /*
+         * Table driven implementation of Compute() (slice-by-8), used as fallback if no hardware acceleration is available.
+         */
+        static uint32_t ComputeSliceBy8(uint32_t crc, const uint8_t* buf, size_t len);
+
+        /*
+         * Returns the name of the implementation selected by Compute(), i.e. "pclmul", "armv8-crc" or "slice-by-8".
+         */
+        static const char* Implementation(void);
+
+    }; // class Crc32
+
+}   // namespace sick_scansegment_xd
+#endif // __SICK_SCANSEGMENT_XD_CRC32_H
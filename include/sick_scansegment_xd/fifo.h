@@ -56,11 +56,16 @@
 #ifndef __SICK_SCANSEGMENT_XD_FIFO_H
 #define __SICK_SCANSEGMENT_XD_FIFO_H
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 /*
  * Shortcuts to use either std::chrono::high_resolution_clock or std::chrono::system_clock
@@ -102,6 +107,21 @@ namespace sick_scansegment_xd
             return m_queue.size();
         }
 
+        /*
+         * @brief Moves an element to the end of the fifo and returns the new number of elements in the fifo.
+         */
+        virtual size_t Push(T&& element, const fifo_timestamp timestamp = fifo_clock::now(), size_t counter = 0)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queue.push(std::make_tuple(std::move(element), timestamp, counter));
+            m_num_messages_received++;
+            m_timestamp_last_msg_received = timestamp;
+            while(m_fifo_length > 0 && m_queue.size() > m_fifo_length)
+                m_queue.pop();
+            m_cond.notify_all();
+            return m_queue.size();
+        }
+
         /*
          * @brief Pops an element from the front of the fifo.
          */
@@ -114,8 +134,31 @@ namespace sick_scansegment_xd
             }
             if (m_shutdown || m_queue.empty())
                 return false;
-            const fifo_element& queue_front = m_queue.front();
-            element = std::get<0>(queue_front);
+            fifo_element& queue_front = m_queue.front();
+            element = std::move(std::get<0>(queue_front));
+            timestamp = std::get<1>(queue_front);
+            counter = std::get<2>(queue_front);
+            m_queue.pop();
+            return true;
+        }
+
+        /*
+         * @brief Pops an element from the front of the fifo. Waits at most timeout_sec seconds for an element,
+         * returns false if no element is available after timeout_sec seconds or if the fifo has been shut down.
+         */
+        virtual bool Pop(T& element, fifo_timestamp& timestamp, size_t& counter, double timeout_sec)
+        {
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(timeout_sec * 1.0e6));
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_shutdown && m_queue.empty())
+            {
+                if (m_cond.wait_until(lock, deadline) == std::cv_status::timeout)
+                    break;
+            }
+            if (m_shutdown || m_queue.empty())
+                return false;
+            fifo_element& queue_front = m_queue.front();
+            element = std::move(std::get<0>(queue_front));
             timestamp = std::get<1>(queue_front);
             counter = std::get<2>(queue_front);
             m_queue.pop();
@@ -182,16 +225,444 @@ namespace sick_scansegment_xd
     };
 
     /*
-     * Fifo for any payload, i.e. a chunk of bytes
+     * @brief SpscFifo implements a bounded lock-free ring buffer for one consumer thread. Elements are moved in and out of
+     * preallocated slots, i.e. Push and Pop do not allocate and do not lock a mutex. If the fifo is full, Push drops the oldest
+     * element (same semantic as Fifo with fifo_length > 0). Pushes from different threads (e.g. udp receiver for scan and imu data
+     * sharing one fifo) are serialized by a spin lock, which is uncontended with just one producer.
+     * A consumer waiting for data busy-waits for max. spin_count attempts and is then parked on a condition variable until
+     * the next Push. With fifo_length <= 0 (unlimited), SpscFifo falls back to the mutex based Fifo implementation.
+     * The ring buffer is designed for one consumer. Concurrent Pop calls are nevertheless safe: each slot is claimed by
+     * compare-exchange of the read position, and a Push wakes up all parked consumers.
+     */
+    template <typename T> class SpscFifo : public Fifo<T>
+    {
+    public:
+
+        /*
+         * @brief SpscFifo default constructor
+         * @param[in] fifo_length max. fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
+         * @param[in] spin_count number of busy-wait attempts before a consumer waiting for data is parked (default: 0, i.e. park immediately)
+         */
+        SpscFifo(int fifo_length = 20, int spin_count = 0) : Fifo<T>(fifo_length), m_capacity(fifo_length > 0 ? fifo_length : 0), m_spin_count(spin_count),
+            m_write_pos(0), m_read_pos(0), m_producer_lock(false), m_consumers_parked(0), m_ring_shutdown(false), m_num_pushed(0), m_num_dropped(0), m_last_push_nanosec(0)
+        {
+            if (m_capacity > 0)
+            {
+                m_slots.reset(new RingSlot[m_capacity]);
+                for (size_t n = 0; n < m_capacity; n++)
+                    m_slots[n].seq.store(2 * n, std::memory_order_relaxed);
+            }
+        }
+
+        /*
+         * @brief SpscFifo destructor
+         */
+        virtual ~SpscFifo() {}
+
+        /*
+         * @brief Sets the number of busy-wait attempts before a consumer waiting for data is parked (0: park immediately)
+         */
+        void SetSpinCount(int spin_count) { m_spin_count = spin_count; }
+
+        /*
+         * @brief Copies an element to the end of the fifo and returns the new number of elements in the fifo.
+         */
+        virtual size_t Push(const T& element, const fifo_timestamp timestamp = fifo_clock::now(), size_t counter = 0)
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::Push(element, timestamp, counter);
+            T element_copy(element);
+            return PushRing(element_copy, timestamp, counter);
+        }
+
+        /*
+         * @brief Moves an element to the end of the fifo and returns the new number of elements in the fifo.
+         */
+        virtual size_t Push(T&& element, const fifo_timestamp timestamp = fifo_clock::now(), size_t counter = 0)
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::Push(std::move(element), timestamp, counter);
+            return PushRing(element, timestamp, counter);
+        }
+
+        /*
+         * @brief Pops an element from the front of the fifo. Blocks until an element is available or the fifo has been shut down.
+         */
+        virtual bool Pop(T& element, fifo_timestamp& timestamp, size_t& counter)
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::Pop(element, timestamp, counter);
+            int spin_cnt = 0;
+            while (!m_ring_shutdown.load())
+            {
+                if (TryPopRing(element, timestamp, counter))
+                    return true;
+                if (spin_cnt < m_spin_count)
+                {
+                    spin_cnt++;
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                m_consumers_parked.fetch_add(1);
+                while (!m_ring_shutdown.load() && m_read_pos.load() == m_write_pos.load())
+                    this->m_cond.wait(lock);
+                m_consumers_parked.fetch_sub(1);
+                spin_cnt = 0;
+            }
+            return false;
+        }
+
+        /*
+         * @brief Pops an element from the front of the fifo. Waits at most timeout_sec seconds for an element,
+         * returns false if no element is available after timeout_sec seconds or if the fifo has been shut down.
+         */
+        virtual bool Pop(T& element, fifo_timestamp& timestamp, size_t& counter, double timeout_sec)
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::Pop(element, timestamp, counter, timeout_sec);
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(timeout_sec * 1.0e6));
+            int spin_cnt = 0;
+            while (!m_ring_shutdown.load())
+            {
+                if (TryPopRing(element, timestamp, counter))
+                    return true;
+                if (spin_cnt < m_spin_count)
+                {
+                    spin_cnt++;
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (std::chrono::steady_clock::now() >= deadline)
+                    return false;
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                m_consumers_parked.fetch_add(1);
+                while (!m_ring_shutdown.load() && m_read_pos.load() == m_write_pos.load())
+                {
+                    if (this->m_cond.wait_until(lock, deadline) == std::cv_status::timeout)
+                        break;
+                }
+                m_consumers_parked.fetch_sub(1);
+                spin_cnt = 0;
+            }
+            return false;
+        }
+
+        /*
+         * @brief Returns the number of elements in the fifo.
+         */
+        virtual size_t Size(void)
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::Size();
+            size_t read_pos = m_read_pos.load(); // read position first, write position is always >= read position
+            size_t write_pos = m_write_pos.load();
+            return std::min<size_t>(write_pos - read_pos, m_capacity);
+        }
+
+        /*
+         * @brief Sets the fifo in shutdown mode and interrupts a waiting Pop() call.
+         * After Shutdown(), any Pop() will return immediately with false.
+         */
+        virtual void Shutdown(void)
+        {
+            Fifo<T>::Shutdown();
+            std::unique_lock<std::mutex> lock(this->m_mutex);
+            m_ring_shutdown.store(true);
+            this->m_cond.notify_all();
+        }
+
+        /*
+         * @brief Returns the total number of messages pushed to fifo since constructed
+         */
+        virtual size_t TotalMessagesPushed()
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::TotalMessagesPushed();
+            return m_num_pushed.load();
+        }
+
+        /*
+         * @brief Returns the total number of messages dropped because the fifo was full (ring buffer mode only)
+         */
+        size_t TotalMessagesDropped()
+        {
+            return m_num_dropped.load();
+        }
+
+        /*
+         * @brief Returns the time in seconds since the last message has been pushed (i.e. since last message received from lidar)
+         */
+        virtual double SecondsSinceLastPush()
+        {
+            if (m_capacity == 0)
+                return Fifo<T>::SecondsSinceLastPush();
+            fifo_timestamp timestamp_last_push(std::chrono::duration_cast<fifo_clock::duration>(std::chrono::nanoseconds(m_last_push_nanosec.load())));
+            return Fifo<T>::Seconds(timestamp_last_push, fifo_clock::now());
+        }
+
+    protected:
+
+        /*
+         * @brief Called by Push for the oldest element, if it is dropped because the fifo is full. The element is overwritten afterwards.
+         * Derived classes can recycle resources of the dropped element.
+         */
+        virtual void DropElement(T& element) {}
+
+        /*
+         * @brief Ring buffer slot. seq == 2 * pos: slot is free for the producer at position pos,
+         * seq == 2 * pos + 1: slot holds the element pushed at position pos.
+         */
+        struct RingSlot
+        {
+            std::atomic<size_t> seq;
+            T element;
+            fifo_timestamp timestamp;
+            size_t counter;
+        };
+
+        /*
+         * @brief Spin lock serializing Push calls, uncontended in case of a single producer
+         */
+        class ProducerLock
+        {
+        public:
+            ProducerLock(std::atomic<bool>& lock) : m_lock(lock) { while (m_lock.exchange(true, std::memory_order_acquire)) std::this_thread::yield(); }
+            ~ProducerLock() { m_lock.store(false, std::memory_order_release); }
+        protected:
+            std::atomic<bool>& m_lock;
+        };
+
+        /*
+         * @brief Moves an element into the next free slot. If the fifo is full, the oldest element is dropped.
+         */
+        size_t PushRing(T& element, const fifo_timestamp& timestamp, size_t counter)
+        {
+            ProducerLock producer_lock(m_producer_lock);
+            size_t write_pos = m_write_pos.load(std::memory_order_relaxed);
+            RingSlot& slot = m_slots[write_pos % m_capacity];
+            while (true)
+            {
+                size_t slot_seq = slot.seq.load(std::memory_order_acquire);
+                if (slot_seq == 2 * write_pos) // slot is free
+                    break;
+                size_t oldest_pos = write_pos - m_capacity;
+                if (slot_seq == 2 * oldest_pos + 1 && m_read_pos.compare_exchange_strong(oldest_pos, oldest_pos + 1))
+                {
+                    m_num_dropped.fetch_add(1, std::memory_order_relaxed); // fifo full, oldest element dropped and overwritten
+                    DropElement(slot.element);
+                    break;
+                }
+                std::this_thread::yield(); // consumer is just moving the oldest element out of this slot
+            }
+            slot.element = std::move(element);
+            slot.timestamp = timestamp;
+            slot.counter = counter;
+            slot.seq.store(2 * write_pos + 1, std::memory_order_release);
+            m_write_pos.store(write_pos + 1);
+            m_num_pushed.fetch_add(1, std::memory_order_relaxed);
+            m_last_push_nanosec.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count(), std::memory_order_relaxed);
+            if (m_consumers_parked.load() > 0) // wakeup all parked consumers, m_write_pos and m_consumers_parked are sequentially consistent
+            {
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                this->m_cond.notify_all();
+            }
+            return Size();
+        }
+
+        /*
+         * @brief Moves the oldest element out of the ring buffer. Returns false, if the fifo is empty.
+         */
+        bool TryPopRing(T& element, fifo_timestamp& timestamp, size_t& counter)
+        {
+            size_t read_pos = m_read_pos.load();
+            while (true)
+            {
+                RingSlot& slot = m_slots[read_pos % m_capacity];
+                if (slot.seq.load(std::memory_order_acquire) == 2 * read_pos + 1)
+                {
+                    if (m_read_pos.compare_exchange_weak(read_pos, read_pos + 1)) // claim the slot, fails if the producer dropped it concurrently
+                    {
+                        element = std::move(slot.element);
+                        timestamp = slot.timestamp;
+                        counter = slot.counter;
+                        slot.seq.store(2 * (read_pos + m_capacity), std::memory_order_release); // release the slot for the next round
+                        return true;
+                    }
+                }
+                else
+                {
+                    size_t current_read_pos = m_read_pos.load();
+                    if (current_read_pos == read_pos)
+                        return false; // fifo empty
+                    read_pos = current_read_pos;
+                }
+            }
+            return false;
+        }
+
+        size_t m_capacity;                            // number of ring buffer slots, i.e. max. fifo length (0: unlimited, fallback to Fifo)
+        int m_spin_count;                             // number of busy-wait attempts before a waiting consumer is parked
+        std::unique_ptr<RingSlot[]> m_slots;          // preallocated ring buffer slots
+        std::atomic<size_t> m_write_pos;              // next position to push (producer)
+        std::atomic<size_t> m_read_pos;               // next position to pop (consumer, or producer dropping the oldest element)
+        std::atomic<bool> m_producer_lock;            // spin lock serializing Push calls
+        std::atomic<int> m_consumers_parked;          // number of consumers waiting on m_cond
+        std::atomic<bool> m_ring_shutdown;            // if true, fifo is in shutdown mode and Pop returns immediately
+        std::atomic<size_t> m_num_pushed;             // total number of messages pushed to fifo
+        std::atomic<size_t> m_num_dropped;            // total number of messages dropped because the fifo was full
+        std::atomic<int64_t> m_last_push_nanosec;     // timestamp of last message pushed to fifo in nanoseconds since epoch
+    };
+
+    /*
+     * Fifo for any payload, i.e. a chunk of bytes. PayloadFifo includes a pool of payload buffers:
+     * The producer (udp receiver) acquires a buffer from the pool, fills and pushes it to the fifo. The consumer
+     * (msgpack converter) pops the buffer and releases it to the pool after parsing. Buffers are moved, not copied,
+     * i.e. after a warm-up phase, the payload buffers are recycled and no heap allocation is required.
      */
-    class PayloadFifo : public Fifo<std::vector<uint8_t>>  
+    class PayloadFifo : public SpscFifo<std::vector<uint8_t>>
     { 
     public:
         /*
          * @brief PayloadFifo default constructor
          * @param[in] fifo_length max. fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
+         * @param[in] spin_count number of busy-wait attempts before a consumer waiting for data is parked (default: 0, i.e. park immediately)
+         */
+        PayloadFifo(int fifo_length = 20, int spin_count = 0) : SpscFifo<std::vector<uint8_t>>(fifo_length, spin_count), m_buffer_pool_hits(0), m_buffer_pool_misses(0)
+        {
+            m_buffer_pool_size = (fifo_length > 0 ? fifo_length : 20) + 3; // buffers in the fifo + buffers in use by udp receivers (scan and imu) and msgpack converter
+            m_buffer_pool.reserve(m_buffer_pool_size);
+        }
+
+        /*
+         * @brief Returns an empty payload buffer with a capacity of at least buffer_capacity bytes. Recycled buffers are taken
+         * from the pool (pool hit). If the pool is empty or the recycled buffer is too small, the buffer is allocated (pool miss).
+         */
+        std::vector<uint8_t> AcquireBuffer(size_t buffer_capacity)
+        {
+            std::vector<uint8_t> buffer;
+            {
+                std::unique_lock<std::mutex> lock(m_buffer_pool_mutex);
+                if (!m_buffer_pool.empty())
+                {
+                    buffer = std::move(m_buffer_pool.back());
+                    m_buffer_pool.pop_back();
+                }
+            }
+            if (buffer.capacity() >= buffer_capacity)
+                m_buffer_pool_hits.fetch_add(1, std::memory_order_relaxed);
+            else
+                m_buffer_pool_misses.fetch_add(1, std::memory_order_relaxed);
+            buffer.clear();
+            buffer.reserve(buffer_capacity);
+            return buffer;
+        }
+
+        /*
+         * @brief Returns a payload buffer to the pool for recycling. The buffer is empty after release.
+         */
+        void ReleaseBuffer(std::vector<uint8_t>& buffer)
+        {
+            std::unique_lock<std::mutex> lock(m_buffer_pool_mutex);
+            if (buffer.capacity() > 0 && m_buffer_pool.size() < m_buffer_pool_size)
+                m_buffer_pool.push_back(std::move(buffer));
+            buffer.clear();
+        }
+
+        /*
+         * @brief Returns the number of buffers recycled from the pool (pool hits)
+         */
+        size_t BufferPoolHits(void) { return m_buffer_pool_hits.load(); }
+
+        /*
+         * @brief Returns the number of buffers allocated because no recycled buffer was available (pool misses)
+         */
+        size_t BufferPoolMisses(void) { return m_buffer_pool_misses.load(); }
+
+    protected:
+
+        /*
+         * @brief Payloads dropped because the fifo is full are returned to the buffer pool
+         */
+        virtual void DropElement(std::vector<uint8_t>& element) { ReleaseBuffer(element); }
+
+        std::vector<std::vector<uint8_t>> m_buffer_pool; // released payload buffers for recycling
+        size_t m_buffer_pool_size;                       // max. number of buffers in the pool
+        std::mutex m_buffer_pool_mutex;                  // protects the buffer pool, buffers are acquired by udp receivers and released by the msgpack converter
+        std::atomic<size_t> m_buffer_pool_hits;          // number of buffers recycled from the pool
+        std::atomic<size_t> m_buffer_pool_misses;        // number of buffers allocated because no recycled buffer was available
+    };
+
+    /*
+     * SpscFifo with a pool of recycled elements, e.g. for ScanSegmentParserOutput: The consumer releases popped elements
+     * to the pool after use, the producer acquires a recycled element for the next result after pushing. Elements are moved,
+     * not copied, i.e. the buffers of the elements keep their capacity and no heap allocation is required after a warm-up phase.
+     */
+    template <typename T> class RecyclingFifo : public SpscFifo<T>
+    {
+    public:
+        /*
+         * @brief RecyclingFifo default constructor
+         * @param[in] fifo_length max. fifo length (-1: unlimited, default: 20 for buffering 1 second at 20 Hz), elements will be removed from front if number of elements exceeds the fifo_length
+         * @param[in] spin_count number of busy-wait attempts before a consumer waiting for data is parked (default: 0, i.e. park immediately)
+         * @param[in] pool_size max. number of elements in the pool (default: fifo_length + 4)
+         */
+        RecyclingFifo(int fifo_length = 20, int spin_count = 0, int pool_size = -1) : SpscFifo<T>(fifo_length, spin_count), m_element_pool_hits(0), m_element_pool_misses(0)
+        {
+            m_element_pool_size = (pool_size > 0 ? pool_size : ((fifo_length > 0 ? fifo_length : 20) + 4));
+            m_element_pool.reserve(m_element_pool_size);
+        }
+
+        /*
+         * @brief Moves a recycled element from the pool into element (pool hit) and returns true. Returns false and leaves element
+         * unchanged, if the pool is empty (pool miss). A recycled element still contains the data of its previous use.
          */
-        PayloadFifo(int fifo_length = 20) : Fifo<std::vector<uint8_t>>(fifo_length) {}
+        bool AcquireElement(T& element)
+        {
+            std::unique_lock<std::mutex> lock(m_element_pool_mutex);
+            if (m_element_pool.empty())
+            {
+                m_element_pool_misses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            element = std::move(m_element_pool.back());
+            m_element_pool.pop_back();
+            m_element_pool_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /*
+         * @brief Returns an element to the pool for recycling. The element must not be used after release.
+         */
+        void ReleaseElement(T& element)
+        {
+            std::unique_lock<std::mutex> lock(m_element_pool_mutex);
+            if (m_element_pool.size() < m_element_pool_size)
+                m_element_pool.push_back(std::move(element));
+        }
+
+        /*
+         * @brief Returns the number of elements recycled from the pool (pool hits)
+         */
+        size_t ElementPoolHits(void) { return m_element_pool_hits.load(); }
+
+        /*
+         * @brief Returns the number of elements not available in the pool (pool misses)
+         */
+        size_t ElementPoolMisses(void) { return m_element_pool_misses.load(); }
+
+    protected:
+
+        /*
+         * @brief Elements dropped because the fifo is full are returned to the pool
+         */
+        virtual void DropElement(T& element) { ReleaseElement(element); }
+
+        std::vector<T> m_element_pool;                   // released elements for recycling
+        size_t m_element_pool_size;                      // max. number of elements in the pool
+        std::mutex m_element_pool_mutex;                 // protects the pool, elements are acquired by the producer and released by the consumer
+        std::atomic<size_t> m_element_pool_hits;         // number of elements recycled from the pool
+        std::atomic<size_t> m_element_pool_misses;       // number of acquire calls without a recycled element
     };
 
 } // namespace sick_scansegment_xd
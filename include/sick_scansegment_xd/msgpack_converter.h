@@ -73,6 +73,8 @@
 #include "sick_scansegment_xd/fifo.h"
 #include "sick_scansegment_xd/msgpack_parser.h"
 #include "sick_scansegment_xd/msgpack_validator.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace sick_scansegment_xd
 {
@@ -80,6 +82,10 @@ namespace sick_scansegment_xd
      * @brief class MsgPackConverter runs a background thread to unpack and parses msgpack data for the sick 3D lidar multiScan136.
      * msgpack_converter pops binary msgpack data from an input fifo, converts the data to scanlines using MsgPackParser::Parse()
      * and pushes the ScanSegmentParserOutput to an output fifo.
+     * Optionally, msgpack_converter runs a pool of N parser threads. Each worker pops the next udp payload, parses it and
+     * stores the result in a reorder buffer. Results are then pushed to the output fifo in the order of their arrival, i.e.
+     * the publisher receives the segments in the same order as with a single converter thread. Software pll and msgpack
+     * validation depend on the order of the segments and run in this in-order stage.
      */
 	class MsgPackConverter
 	{
@@ -126,10 +132,16 @@ namespace sick_scansegment_xd
          */
         void SetValidator(sick_scansegment_xd::MsgPackValidator& msgpack_validator, bool msgpack_validator_enabled, bool discard_msgpacks_not_validated, int msgpack_validator_check_missing_scandata_interval); 
 
+        /*
+         * @brief Sets the number of parser threads, must be called before Start().
+         * @param[in] num_workers number of threads parsing udp payloads in parallel (default: 1, i.e. one converter thread)
+         */
+        void SetNumWorkers(int num_workers) { m_num_workers = std::max<int>(1, num_workers); }
+
         /*
          * @brief Returns the output fifo storing the multiScan136 scanlines.
          */
-        sick_scansegment_xd::Fifo<ScanSegmentParserOutput>* Fifo(void) { return m_output_fifo; }
+        sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>* Fifo(void) { return m_output_fifo; }
 
    protected:
 
@@ -138,6 +150,43 @@ namespace sick_scansegment_xd
         */
        bool Run(void);
 
+       /*
+        * @brief Thread callback for each parser thread if more than one worker is configured. Pops msgpack data from the input fifo, converts them
+        * and passes the results to the reorder stage, which pushes ScanSegmentParserOutput data to the output fifo in order of arrival.
+        */
+       bool RunWorker(void);
+
+       /*
+        * @brief Parses one udp payload (msgpack or compact format). Returns true on success or false on parse error.
+        */
+       bool ParsePayload(const std::vector<uint8_t>& input_payload, const fifo_timestamp& input_timestamp, sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy,
+           ScanSegmentParserOutput& msgpack_output, sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, bool use_software_pll);
+
+       /*
+        * @brief Validates the msgpack data collected so far, checks scandata out of bounds and, after every N msgpacks, missing scandata
+        */
+       void ValidateCollectedData(sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, size_t& msgpack_cnt);
+
+       /*
+        * @brief Parse result of one udp payload waiting in the reorder buffer
+        */
+       struct ReorderSlot
+       {
+           ReorderSlot() : ready(false), parse_success(false), input_counter(0) {}
+           bool ready;                                              // true: result available, false: slot free or payload still parsed by a worker
+           bool parse_success;                                      // result of the parser
+           ScanSegmentParserOutput output;                          // converted segment
+           fifo_timestamp input_timestamp;                          // receive timestamp of the udp payload
+           size_t input_counter;                                    // counter of the udp payload
+           sick_scansegment_xd::MsgPackValidatorData validator_data;  // msgpack validation data of this payload
+       };
+
+       /*
+        * @brief Stores the parse result of the udp payload with sequence number input_seq in the reorder buffer. Then all results
+        * in order of arrival are passed to software pll and msgpack validation and pushed to the output fifo.
+        */
+       void Reorder(size_t input_seq, ReorderSlot& result);
+
        /*
         * Configuration and parameter
         */
@@ -149,7 +198,7 @@ namespace sick_scansegment_xd
          */
        PayloadFifo* m_input_fifo;                               // input fifo for msgpack data
        int m_scandataformat;                                    // ScanDataFormat: 1 for msgpack or 2 for compact scandata, default: 1
-       sick_scansegment_xd::Fifo<ScanSegmentParserOutput>* m_output_fifo;  // output fifo for ScanSegmentParserOutput data converted from  msgpack data
+       sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>* m_output_fifo;  // output fifo for ScanSegmentParserOutput data converted from  msgpack data, consumers release popped outputs for recycling
        std::thread* m_converter_thread;                         // background thread to convert msgpack to ScanSegmentParserOutput data
        bool m_run_converter_thread;                             // flag to start and stop the udp converter thread
        bool m_msgpack_validator_enabled;                        // true: check msgpack data for out of bounds and missing scan data, false: no msgpack validation
@@ -157,6 +206,20 @@ namespace sick_scansegment_xd
        bool m_discard_msgpacks_not_validated;                   // true: msgpacks are discarded if scan data out of bounds detected, false: error message if a msgpack is not validated
        int m_msgpack_validator_check_missing_scandata_interval; // check msgpack for missing scandata after collecting N msgpacks, default: N = 12 segments. Increase this value to tolerate udp packet drops. Use 12 to check each full scan.
        sick_scan_xd::SickCloudTransform m_add_transform_xyz_rpy;   // Apply an additional transform to the cartesian pointcloud, default: "0,0,0,0,0,0" (i.e. no transform)
+
+       /*
+        * Parser threads and reorder buffer, used in case of more than one worker
+        */
+       int m_num_workers;                                       // number of parser threads (default: 1, i.e. one converter thread)
+       std::vector<std::thread*> m_worker_threads;              // parser threads
+       std::mutex m_input_mutex;                                // serializes Pop from the input fifo, i.e. the input fifo has still just one consumer at a time
+       size_t m_next_input_seq;                                 // sequence number of the next udp payload popped from the input fifo
+       std::mutex m_reorder_mutex;                              // protects the reorder buffer
+       std::condition_variable m_reorder_cond;                  // signaled when results have been pushed and reorder slots are free again
+       std::vector<ReorderSlot> m_reorder_slots;                // reorder buffer, the result of payload input_seq is stored in slot input_seq % m_num_workers
+       size_t m_next_output_seq;                                // sequence number of the next result pushed to the output fifo
+       sick_scansegment_xd::MsgPackValidatorData m_msgpack_validator_data_collector;  // collects msgpack validation data in the reorder stage
+       size_t m_msgpack_cnt;                                    // number of msgpacks collected for validation in the reorder stage
 	};  // class MsgPackConverter
 
 }   // namespace sick_scansegment_xd
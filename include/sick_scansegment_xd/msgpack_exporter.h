@@ -102,7 +102,7 @@ namespace sick_scansegment_xd
          * @param[in] verbose true: enable debug output, false: quiet mode (default)
          * @param[in] measure_timing true: duration and latency of msgpack conversion and export is measured, default: false
          */
-         MsgPackExporter(sick_scansegment_xd::PayloadFifo* udp_fifo, sick_scansegment_xd::Fifo<ScanSegmentParserOutput>* msgpack_fifo, const std::string& logfolder, bool export_csv, bool verbose = false, bool measure_timing = false);
+         MsgPackExporter(sick_scansegment_xd::PayloadFifo* udp_fifo, sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>* msgpack_fifo, const std::string& logfolder, bool export_csv, bool verbose = false, bool measure_timing = false);
 
         /*
          * @brief Default destructor.
@@ -164,7 +164,7 @@ namespace sick_scansegment_xd
         * Member data to run the exporter
         */
        sick_scansegment_xd::PayloadFifo* m_udp_fifo;                         // fifo buffering udp packages (for informational messages only)
-       sick_scansegment_xd::Fifo<ScanSegmentParserOutput>* m_msgpack_fifo;       // input fifo buffering ScanSegmentParserOutput data from multiScan136 (for csv export and visualization)
+       sick_scansegment_xd::RecyclingFifo<ScanSegmentParserOutput>* m_msgpack_fifo; // input fifo buffering ScanSegmentParserOutput data from multiScan136 (for csv export and visualization), outputs are released for recycling after export
        std::thread* m_exporter_thread;                                // background thread to export ScanSegmentParserOutput data
        bool m_run_exporter_thread;                                    // flag to start and stop the exporter thread
        std::list< sick_scansegment_xd::MsgPackExportListenerIF*> m_listener; // list of export listener, which will be notified calling listener->HandleMsgPackData() after successful conversion of received msgpack data
@@ -12,13 +12,13 @@
  *
  * for (int groupIdx = 0; groupIdx < msgpack_output.scandata.size(); groupIdx++)
  * {
- * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].size(); echoIdx++)
+ * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].scanlines.size(); echoIdx++)
  * 	 {
- * 	   std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = msgpack_output.scandata[groupIdx][echoIdx];
+ * 	   const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = msgpack_output.scandata[groupIdx].scanlines[echoIdx];
  * 	   std::cout << (groupIdx + 1) << ". group, " << (echoIdx + 1) << ". echo: ";
- * 	   for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+ * 	   for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
  * 	   {
- * 		  sick_scansegment_xd::ScanSegmentParserOutput::PointXYZI& point = scanline[pointIdx];
+ * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = msgpack_output.points.get(scanline.start + pointIdx);
  * 		  std::cout << (pointIdx > 0 ? "," : "") << "(" << point.x << "," << point.y << "," << point.z << "," << point.i << ")";
  * 	   }
  * 	   std::cout << std::endl;
@@ -89,6 +89,8 @@
 
 namespace sick_scansegment_xd
 {
+    class MsgPackSegmentIndex; // scan segment decoded from msgpack data, implemented in msgpack_parser.cpp
+
 	/*
      * @brief class MsgPackParser unpacks and parses msgpack data for the sick 3D lidar multiScan136.
      */
@@ -113,6 +115,8 @@ namespace sick_scansegment_xd
          * sick_scansegment_xd::MsgPackParser::Parse(msgpack_data, msgpack_output);
          * sick_scansegment_xd::MsgPackParser::WriteCSV({ msgpack_output }, "polarscan_testdata_000.csv")
          *
+         * Note: msgpack_data are decoded in place without copying. msgpack11 is used as fallback, if msgpack_data can not be decoded in place.
+         *
          * @param[in+out] msgpack_ifstream the binary input stream delivering the binary msgpack data
          * @param[in] msgpack_timestamp receive timestamp of msgpack_data
          * @param[in] add_transform_xyz_rpy Apply an additional transform to the cartesian pointcloud, default: "0,0,0,0,0,0" (i.e. no transform)
@@ -141,13 +145,13 @@ namespace sick_scansegment_xd
          *
 		 * for (int groupIdx = 0; groupIdx < msgpack_output.scandata.size(); groupIdx++)
 		 * {
-		 * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].size(); echoIdx++)
+		 * 	 for (int echoIdx = 0; echoIdx < msgpack_output.scandata[groupIdx].scanlines.size(); echoIdx++)
 		 * 	 {
-		 * 	   std::vector<sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint>& scanline = msgpack_output.scandata[groupIdx][echoIdx];
+		 * 	   const sick_scansegment_xd::ScanSegmentParserOutput::Scanline& scanline = msgpack_output.scandata[groupIdx].scanlines[echoIdx];
 		 * 	   std::cout << (groupIdx + 1) << ". group, " << (echoIdx + 1) << ". echo: ";
-		 * 	   for (int pointIdx = 0; pointIdx < scanline.size(); pointIdx++)
+		 * 	   for (int pointIdx = 0; pointIdx < scanline.count; pointIdx++)
 		 * 	   {
-		 * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint& point = scanline[pointIdx];
+		 * 		  sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint point = msgpack_output.points.get(scanline.start + pointIdx);
 		 * 		  std::cout << (pointIdx > 0 ? "," : "") << "(" << point.x << "," << point.y << "," << point.z << "," << point.i << ")";
 		 * 	   }
 		 * 	   std::cout << std::endl;
@@ -230,10 +234,19 @@ namespace sick_scansegment_xd
     protected:
 
         /*
-         * @brief Counter for each message (each scandata decoded from msgpack data)
+         * @brief converts a decoded scan segment to scanlines of type ScanSegmentParserOutput.
+         * The msgpack data referenced by msgpack_index must be valid while calling ConvertSegment.
+         * See Parse() for a description of all other parameters.
+         */
+        static bool ConvertSegment(const MsgPackSegmentIndex& msgpack_index, fifo_timestamp msgpack_timestamp, sick_scan_xd::SickCloudTransform& add_transform_xyz_rpy, ScanSegmentParserOutput& result,
+            sick_scansegment_xd::MsgPackValidatorData& msgpack_validator_data_collector, const sick_scansegment_xd::MsgPackValidator& msgpack_validator,
+            bool msgpack_validator_enabled, bool discard_msgpacks_not_validated, bool use_software_pll, bool verbose);
+
+        /*
+         * @brief Counter for each message (each scandata decoded from msgpack data), atomic since segments can be parsed in parallel (see MsgPackConverter)
          */
-        static int messageCount;
-        static int telegramCount;
+        static std::atomic<int> messageCount;
+        static std::atomic<int> telegramCount;
 
 	};  // class MsgPackParser
 
@@ -70,7 +70,7 @@
 #define _USE_MATH_DEFINES
 #endif
 #include <math.h>
-#include <map>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -82,13 +82,20 @@ namespace sick_scansegment_xd
 	/*
      * @brief class MsgPackValidatorData collects echo_idx, azimuth, elevation and segment_idx
      *        during msgpack parsing for msgpack validation.
+     *
+     * Azimuth angles are counted in flat counter arrays, which are preallocated by init() from the configured echos, segments,
+     * elevation and azimuth range. Each layer (i.e. each elevation) of an echo uses one row of azimuth counters.
+     * Scan points out of the configured ranges are recorded as out of bounds with the reason (unexpected echo,
+     * unexpected segment, elevation or azimuth out of limits). Like all layers, layers out of the configured
+     * elevation range are counted in azimuth histograms. After init(), update() and reset()
+     * do not allocate memory and the validation can be enabled permanently.
      */
 	class MsgPackValidatorData
 	{
 	public:
 
           /*
-          * @brief Default constructor.
+          * @brief Default constructor. Counters are allocated by init() or with the default full range on the first update.
           */
           MsgPackValidatorData();
 
@@ -97,11 +104,40 @@ namespace sick_scansegment_xd
           */
           ~MsgPackValidatorData();
 
+          /*
+          * @brief Allocates the counters for the configured echos, azimuth range, elevation range and segments, see MsgPackValidator for details
+          *
+          * @param[in] echos indizes of expected echos
+          * @param[in] azimuth_start start azimuth in radians
+          * @param[in] azimuth_end end azimuth in radians
+          * @param[in] elevation_start start elevation in radians
+          * @param[in] elevation_end end elevation in radians
+          * @param[in] segments indizes of expected segments
+          * @param[in] num_layers number of expected layers, used to preallocate the azimuth counters
+          */
+          void init(const std::vector<int>& echos, float azimuth_start, float azimuth_end, float elevation_start, float elevation_end, 
+               const std::vector<int>& segments, int num_layers);
+
+          /*
+          * @brief Returns true, if the counters have been allocated by init()
+          */
+          bool initialized(void) const { return !m_echo_valid.empty(); }
+
+          /*
+          * @brief Clears all counters and out of bounds records. The allocated counters are kept for reuse.
+          */
+          void reset(void);
+
           /*
           * @brief Updates the azimuth histogram
           */
           void update(int echo_idx, int segment_idx, float azimuth, float elevation);
 
+          /*
+          * @brief Adds the azimuth histogram of other data, e.g. data collected by another parser thread
+          */
+          void update(const MsgPackValidatorData& other);
+
           /*
           * @brief Returns the resolution of azimuth histogram in degree (i.e. 1.0 degree)
           */
@@ -127,20 +163,54 @@ namespace sick_scansegment_xd
           */
           std::vector<std::string> print(void) const;
 
-          // Histogram of azimuth angles: azimuth_count = AzimuthHistogram[azimuth_idx]
-          typedef std::map<int, int> AzimuthHistogram; 
+          /*
+          * @brief Reason of a scan point out of bounds
+          */
+          typedef enum OutOfBoundsReasonEnum
+          {
+               OUT_OF_BOUNDS_ECHO = 0,      // echo unexpected
+               OUT_OF_BOUNDS_SEGMENT = 1,   // segment unexpected
+               OUT_OF_BOUNDS_ELEVATION = 2, // elevation out of limits
+               OUT_OF_BOUNDS_AZIMUTH = 3    // azimuth out of limits
+          } OutOfBoundsReason;
+
+          /*
+          * @brief Record of scan points out of bounds. Consecutive points with identical reason, echo, segment, elevation and azimuth share one record.
+          */
+          typedef struct OutOfBoundsRecordStruct
+          {
+               size_t out_of_bounds_idx;    // index of the first scan point out of bounds of this record, i.e. getOutOfBoundsCount() before this record
+               OutOfBoundsReason reason;
+               int echo_idx;
+               int segment_idx;
+               int elevation_idx;
+               int azimuth_idx;
+          } OutOfBoundsRecord;
+
+          // Returns the total number of scan points out of bounds
+          size_t getOutOfBoundsCount(void) const { return m_out_of_bounds_cnt; }
+
+          // Returns the records of scan points out of bounds, limited to the first MaxOutOfBoundsRecords records
+          const std::vector<OutOfBoundsRecord>& getOutOfBoundsRecords(void) const { return m_out_of_bounds_records; }
 
-          // AzimuthHistogram per elevation: azimuth_count = AzimuthHistogramPerElevation[elevation_idx][azimuth_idx]
-          typedef std::map<int, AzimuthHistogram> AzimuthHistogramPerElevation; 
+          // Returns the number of scan points counted in the histogram for a given echo, i.e. all points of this echo within the configured limits
+          size_t getPointCount(int echo_idx) const;
 
-          // AzimuthHistogramPerElevation per segment: azimuth_count = AzimuthHistogramPerElevationPerSegment[segment_idx][elevation_idx][azimuth_idx]
-          typedef std::map<int, AzimuthHistogramPerElevation> AzimuthHistogramPerElevationPerSegment; 
+          // Returns the number of azimuth histograms, i.e. the number of layers collected over all echos
+          int getNumAzimuthHistograms(void) const { return (int)m_histogram_rows.size(); }
 
-          // AzimuthHistogramPerElevationPerSegment per per echo: azimuth_count = AzimuthHistogramPerElevationPerSegmentPerEcho[echo_idx][segment_idx][elevation_idx][azimuth_idx]
-          typedef std::map<int, AzimuthHistogramPerElevationPerSegment> AzimuthHistogramPerElevationPerSegmentPerEcho; 
+          // Returns the echo index of an azimuth histogram
+          int getAzimuthHistogramEcho(int histogram_idx) const { return m_histogram_rows[histogram_idx].echo_idx; }
 
-          // Returns the Histogram of azimuth angles: azimuth_count = getHistogram()[echo_idx][segment_idx][elevationToInt(elevation)][azimuthToInt(azimuth)]
-          const AzimuthHistogramPerElevationPerSegmentPerEcho& getHistogram(void) const { return m_azimuth_histogram; }
+          // Returns the elevation index of an azimuth histogram
+          int getAzimuthHistogramElevation(int histogram_idx) const { return m_histogram_rows[histogram_idx].elevation_idx; }
+
+          // Returns the number of azimuth angles counted in an azimuth histogram for a given azimuth index, or 0 if the azimuth index is out of the configured range
+          uint32_t getAzimuthHistogramCount(int histogram_idx, int azimuth_idx) const
+          {
+               int azimuth_bin = azimuth_idx - m_azimuth_idx_min;
+               return (azimuth_bin >= 0 && azimuth_bin < m_num_azimuth_bins) ? m_azimuth_counter[histogram_idx * m_num_azimuth_bins + azimuth_bin] : 0;
+          }
 
           // Converts the azimuth index of the azimuth histogram to the azimuth angle in radians
           float azimuthIndexToRad(int azimuth_idx) const { return intToAzimuth(azimuth_idx); }
@@ -164,6 +234,7 @@ namespace sick_scansegment_xd
 
         #define AzimuthHistogramResolution (1.0f) // Histogram of azimuth angles in 1.0 degrees
         #define ElevationHistogramResolution (1.0f) // Histogram of elevation angles in 1.0 degrees
+        #define MaxOutOfBoundsRecords (64) // Max. number of out of bounds records, further scan points out of bounds are counted only
 
         float deg2rad(float angle) const { return angle * (float)(M_PI / 180.0); }
         float rad2deg(float angle) const { return angle * (float)(180.0 / M_PI); }
@@ -176,12 +247,47 @@ namespace sick_scansegment_xd
         int elevationToInt(float elevation_rad) const { return (int)std::round(rad2deg(elevation_rad) / ElevationHistogramResolution); }
         float intToElevation(int elevation_idx) const { return  deg2rad(elevation_idx * ElevationHistogramResolution); }
 
+        /** Returns the first and last azimuth resp. elevation index, with all angles of the indizes inbetween within the given limits */
+        void angleIndexRange(float angle_start, float angle_end, bool elevation, int& idx_min, int& idx_max) const;
+
+        /** Adds a record of scan points out of bounds */
+        void addOutOfBounds(OutOfBoundsReason reason, int echo_idx, int segment_idx, int elevation_idx, int azimuth_idx);
+
+        /** Returns the azimuth histogram (i.e. the row of azimuth counters) for a given echo and elevation, allocates a new row on first use */
+        int histogramRow(int echo_idx, int elevation_bin);
+
+        /** Allocates and clears the counters for the configured counter layout */
+        void allocateCounters(void);
+
         /*
          * Member data
          */
 
-        // Histogram of azimuth angles: azimuth_count = m_azimuth_histogram[echo_idx][segment_idx][elevationToInt(elevation)][azimuthToInt(azimuth)]
-        AzimuthHistogramPerElevationPerSegmentPerEcho m_azimuth_histogram;
+        // Echo and azimuth histogram of one layer, the azimuth counters of histogram row n are m_azimuth_counter[n * m_num_azimuth_bins + azimuth_idx - m_azimuth_idx_min]
+        typedef struct HistogramRowStruct
+        {
+            int echo_idx;
+            int elevation_idx;
+        } HistogramRow;
+
+        // Counter layout configured by init()
+        std::vector<uint8_t> m_echo_valid;               // m_echo_valid[echo_idx] is 1 for expected echos, 0 otherwise
+        std::vector<uint8_t> m_segment_valid;            // m_segment_valid[segment_idx] is 1 for expected segments, 0 otherwise
+        int m_elevation_idx_valid_min;                   // elevation index of the first elevation within limits
+        int m_elevation_idx_valid_max;                   // elevation index of the last elevation within limits
+        int m_elevation_idx_min;                         // elevation index of the first azimuth histogram, azimuth angles are counted for all elevations within -90 and +90 degree
+        int m_num_elevation_bins;                        // number of elevation indizes with azimuth histogram
+        int m_azimuth_idx_min;                           // azimuth index of the first azimuth within limits
+        int m_num_azimuth_bins;                          // number of azimuth indizes within limits
+        int m_num_layers;                                // number of expected layers, the azimuth counters are preallocated for all expected echos and layers
+
+        // Counters
+        std::vector<size_t> m_segment_point_cnt;         // number of scan points per echo and segment, m_segment_point_cnt[echo_idx * m_segment_valid.size() + segment_idx]
+        std::vector<int> m_elevation_row;                // azimuth histogram of an echo and elevation, m_elevation_row[echo_idx * m_num_elevation_bins + elevation_bin] or -1 if not yet used
+        std::vector<HistogramRow> m_histogram_rows;      // echo and elevation of all azimuth histograms in use
+        std::vector<uint32_t> m_azimuth_counter;         // azimuth counters of all azimuth histograms
+        size_t m_out_of_bounds_cnt;                      // number of scan points out of bounds
+        std::vector<OutOfBoundsRecord> m_out_of_bounds_records; // records of scan points out of bounds
 
 	};  // class MsgPackValidatorData
 
@@ -227,15 +333,24 @@ namespace sick_scansegment_xd
          */
         ~MsgPackValidator();
 
+        /*
+         * @brief Allocates the counters of msgpack validation data for the configured echos, azimuth range, elevation range, segments and layers.
+         *
+         * @param[in+out] data msgpack validation data to be collected during msgpack parsing
+         */
+        void initValidatorData(MsgPackValidatorData& data) const;
+
         /*
          * @brief Validates a received msgpack against the configured limits, i.e. checks that echo, segment and azimuth are
          *        within their configured range.
          *
          * @param[in] data_received echos, azimuth, elevation and segments collected during msgpack parsing
+         * @param[in] out_of_bounds_cnt_start number of scan points out of bounds already validated, i.e. only scan points out of bounds
+         *            collected after the first out_of_bounds_cnt_start points are validated, default: 0 (validate all data)
          *
          * @return true if validation passed successfully, false otherwise.
          */
-        bool validateNotOutOfBound(const MsgPackValidatorData& data_received) const;
+        bool validateNotOutOfBound(const MsgPackValidatorData& data_received, size_t out_of_bounds_cnt_start = 0) const;
 
         /*
          * @brief Validates a received msgpack, i.e. checks that the required number of echos, segments and azimuth values have been received.
@@ -257,9 +372,6 @@ namespace sick_scansegment_xd
                return s.str();
           }
 
-          /** Returns the number of azimuth angles counted in the histogram for a given echo, segment, elevation and azimuth */
-          int getAzimuthHistogramCount(const MsgPackValidatorData::AzimuthHistogramPerElevationPerSegmentPerEcho& azimuth_histogram, int echo_idx, int segment_idx, int elevation_idx, int azimuth_idx) const;
-
           void printMissingHistogramData(const std::vector<std::string>& messages) const;
 
           /*
@@ -60,6 +60,11 @@
 #include "sick_scan/sick_ros_wrapper.h"
 #include "sick_scansegment_xd/config.h"
 #include "sick_scansegment_xd/msgpack_exporter.h"
+#include <array>
+#include <bitset>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
 
 namespace sick_scansegment_xd
 {
@@ -117,10 +122,7 @@ namespace sick_scansegment_xd
         inline bool pointEnabled(sick_scansegment_xd::PointXYZRAEI32f& lidar_point) // returns true, if a point is enabled (i.e. properties echo, layer, reflectorbit etc. are activated in the launchfile), otherwise false
         {
             bool range_modified = false;
-	        bool point_enabled = m_echo_enabled[lidar_point.echo] 
-                && m_layer_enabled[lidar_point.layer] 
-                && m_reflector_enabled[lidar_point.reflectorbit] 
-                && m_infringed_enabled[lidar_point.infringed]
+	        bool point_enabled = pointPropertiesEnabled(lidar_point)
                 && m_range_filter.apply(lidar_point.range, range_modified); // note: range can be set depending on filter settings
             if (range_modified)
             {
@@ -128,10 +130,30 @@ namespace sick_scansegment_xd
             }
             return point_enabled;
         }
+        inline bool pointPropertiesEnabled(const sick_scansegment_xd::PointXYZRAEI32f& lidar_point) const // returns true, if echo, layer, reflectorbit and infringed bit of a point are enabled, otherwise false (range filter not applied)
+        {
+            return m_echo_lut[(uint8_t)lidar_point.echo] && m_layer_lut[(uint8_t)lidar_point.layer] && m_reflector_lut[lidar_point.reflectorbit] && m_infringed_lut[lidar_point.infringed];
+        }
+        sick_scan_xd::SickRangeFilter& rangeFilter(void) { return m_range_filter; } // optional range filter
+        const std::vector<PointCloudFieldProperty>& fieldProperties(void) const { return m_field_properties; } // properties of enabled fields in order of the pointcloud fields
+        uint32_t pointStep(void) const { return m_point_step; }                              // number of bytes per point in the pointcloud
+        inline void packPoint(const sick_scansegment_xd::PointXYZRAEI32f& lidar_point, uint8_t* dst) const // copies all enabled fields of a lidar point to the pointcloud data
+        {
+            const uint8_t* src = (const uint8_t*)(&lidar_point);
+            for (size_t n = 0; n < m_field_copies.size(); n++)
+                memcpy(dst + m_field_copies[n].dst_offset, src + m_field_copies[n].src_offset, m_field_copies[n].size);
+        }
         void print(void) const;
     protected:
         static std::string printValuesEnabled(const std::map<std::string,bool>& mapped_values, const std::string& delim = ",");
         static std::string printValuesEnabled(const std::map<int8_t,bool>& mapped_values, const std::string& delim = ",");
+        void initFieldLayout(void); // compiles enabled fields and point filter into m_field_properties, m_field_copies and lookup tables
+        struct FieldCopy // contiguous bytes copied from a lidar point to the pointcloud data, adjacent fields (e.g. x,y,z) are merged into one copy
+        {
+            size_t src_offset; // offset in bytes in structure PointXYZRAEI32f
+            size_t dst_offset; // offset in bytes in a pointcloud point
+            size_t size;       // number of bytes
+        };
         std::string m_cfg_name = "";   // name of configuration, e.g. custom_pointcloud_cartesian_segmented
         bool m_publish = false;        // if true, pointcloud will be published (otherwise not)
         std::string m_topic = "";      // ros topic to publish the pointcloud
@@ -144,6 +166,13 @@ namespace sick_scansegment_xd
         std::map<int8_t, bool> m_layer_enabled; // enabled layers (i.e. point inserted in pointcloud, if m_layer_enabled[layer_idx]==true)
         std::map<int8_t, bool> m_reflector_enabled; // enabled reflectors (i.e. point inserted in pointcloud, if m_reflector_enabled[reflector_bit]==true)
         std::map<int8_t, bool> m_infringed_enabled; // enabled infringments (i.e. point inserted in pointcloud, if m_infringed_enabled[infringed_bit]==true)
+        std::array<bool, 256> m_echo_lut = {};      // m_echo_enabled as lookup table indexed by (uint8_t)echo_idx
+        std::array<bool, 256> m_layer_lut = {};     // m_layer_enabled as lookup table indexed by (uint8_t)layer_idx
+        std::array<bool, 256> m_reflector_lut = {}; // m_reflector_enabled as lookup table indexed by reflector_bit
+        std::array<bool, 256> m_infringed_lut = {}; // m_infringed_enabled as lookup table indexed by infringed_bit
+        std::vector<PointCloudFieldProperty> m_field_properties; // properties of enabled fields in order of the pointcloud fields
+        std::vector<FieldCopy> m_field_copies; // packed layout: copies from a lidar point to the pointcloud data
+        uint32_t m_point_step = 0;             // number of bytes per point in the pointcloud
         PointCloud2MsgPublisher m_publisher; // ros publisher of customized pointcloud
     };
 
@@ -219,6 +248,33 @@ namespace sick_scansegment_xd
     protected:
 
         typedef std::map<int,std::map<int,ros_sensor_msgs::LaserScan>> LaserScanMsgMap; // LaserScanMsgMap[echo][layer] := LaserScan message given echo (Multiscan136: max 3 echos) and layer index (Multiscan136: 16 layer)
+
+        /*
+        * Azimuth and range limits and azimuth bins of the points of one echo and layer, used by convertPointsToLaserscanMsg
+        */
+        struct LaserScanAccumulator
+        {
+            LaserScanAccumulator() { reset(); }
+            void reset(void)
+            {
+                point_cnt = 0;
+                azimuth_min = FLT_MAX;
+                azimuth_max = -FLT_MAX;
+                azimuth_increment = 0;
+                num_bins = 0;
+                full_circle = false;
+            }
+            size_t point_cnt;         // number of points
+            float azimuth_min;        // min. azimuth in radians
+            float azimuth_max;        // max. azimuth in radians
+            float azimuth_increment;  // angular resolution in radians, i.e. azimuth step between consecutive bins
+            int num_bins;             // number of azimuth bins, 0: no laserscan message for this echo and layer
+            bool full_circle;         // true: bins cover 360 degree, azimuth values wrap around
+            std::vector<float> bin_range;     // range of the point in each bin, reused for each scan
+            std::vector<float> bin_intensity; // intensity of the point in each bin, reused for each scan
+            std::vector<float> bin_azimuth;   // azimuth of the point in each bin, reused for each scan
+            std::vector<uint8_t> bin_used;    // 1: bin contains a point, 0: bin empty
+        };
       
         /*
         * Container to collect all points of 12 segments (12 segments * 30 deg = 360 deg)
@@ -226,12 +282,31 @@ namespace sick_scansegment_xd
         class SegmentPointsCollector
         {
         public:
-            SegmentPointsCollector(int telegram_idx = 0) : timestamp_sec(0), timestamp_nsec(0), telegram_cnt(telegram_idx), min_azimuth(0), max_azimuth(0), total_point_count(0), lidar_points()
+            SegmentPointsCollector(int telegram_idx = 0) : timestamp_sec(0), timestamp_nsec(0), telegram_cnt(telegram_idx), min_azimuth(0), max_azimuth(0), total_point_count(0), lidar_points(), 
+                coverage_num_rows(0), coverage_last_row(-1), coverage_elevation_mdeg_min(0), coverage_elevation_mdeg_max(0), coverage_mask_azimuth_min(0), coverage_mask_azimuth_max(-1)
             {
                 segment_list.reserve(12);
                 telegram_list.reserve(12);
-                segment_coverage.clear();
+                segment_coverage.reserve(16); // multiScan136: 16 layer, picoScan: 1 layer
             }
+
+            // Starts a new collection with a given telegram counter. Coverage rows and point buffers keep their capacity, i.e. no heap allocation after warm-up.
+            void reset(int telegram_idx)
+            {
+                timestamp_sec = 0;
+                timestamp_nsec = 0;
+                telegram_cnt = telegram_idx;
+                min_azimuth = 0;
+                max_azimuth = 0;
+                total_point_count = 0;
+                for (int echoIdx = 0; echoIdx < lidar_points.size(); echoIdx++)
+                    lidar_points[echoIdx].clear();
+                segment_list.clear();
+                telegram_list.clear();
+                coverage_num_rows = 0;
+                coverage_last_row = -1;
+            }
+
             void appendLidarPoints(const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& points, int32_t segment_idx, int32_t telegram_cnt)
             {
                 for (int echoIdx = 0; echoIdx < points.size() && echoIdx < lidar_points.size(); echoIdx++)
@@ -249,28 +324,19 @@ namespace sick_scansegment_xd
                             azimuth_fdeg -= 360.0f; // i.e. -180 <= azimuth_deg <= +180
                         int elevation_mdeg = (int)(1000.0f * elevation_deg);
                         int azimuth_ideg = (int)(azimuth_fdeg);
-                        segment_coverage[elevation_mdeg][azimuth_ideg] += 1;
+                        if (azimuth_ideg < -180 || azimuth_ideg > 180)
+                            continue; // invalid azimuth
+                        AzimuthCoverage& azimuth_coverage = coverageRow(elevation_mdeg);
+                        azimuth_coverage.set(azimuth_ideg + COVERAGE_AZIMUTH_OFFSET);
                         if (azimuth_fdeg - azimuth_ideg > 0.5f)
-                            segment_coverage[elevation_mdeg][azimuth_ideg + 1] += 1;
+                            azimuth_coverage.set(azimuth_ideg + 1 + COVERAGE_AZIMUTH_OFFSET);
                         if (azimuth_fdeg - azimuth_ideg < -0.5f)
-                            segment_coverage[elevation_mdeg][azimuth_ideg - 1] += 1;
+                            azimuth_coverage.set(azimuth_ideg - 1 + COVERAGE_AZIMUTH_OFFSET);
                     }
                 }
                 segment_list.push_back(segment_idx);
                 telegram_list.push_back(telegram_cnt);
-                // for (std::map<int, std::map<int, int>>::iterator segment_coverage_elevation_iter = segment_coverage.begin(); segment_coverage_elevation_iter != segment_coverage.end(); segment_coverage_elevation_iter++)
-                // {
-                //     const int& elevation_deg = segment_coverage_elevation_iter->first;
-                //     std::map<int, int>& azimuth_histogram = segment_coverage_elevation_iter->second;
-                //     for (std::map<int, int>::iterator segment_coverage_azimuth_iter = azimuth_histogram.begin(); segment_coverage_azimuth_iter != azimuth_histogram.end(); segment_coverage_azimuth_iter++)
-                //     {
-                //         const int& azimuth_deg = segment_coverage_azimuth_iter->first;
-                //         int cnt = segment_coverage_azimuth_iter->second;
-                //         std::cout << "seg[" << elevation_deg << "][" << azimuth_deg << "]=" << cnt << " ";
-                //     }
-                //     std::cout << std::endl;
-                // }
-                }
+            }
             
             // Returns the last segment index appended by appendLidarPoints
             int32_t lastSegmentIdx()
@@ -282,42 +348,38 @@ namespace sick_scansegment_xd
              // Otherwise allSegmentsCovered returns false.
              bool allSegmentsCovered(float all_segments_azimuth_min_deg, float all_segments_azimuth_max_deg, float all_segments_elevation_min_deg, float all_segments_elevation_max_deg)
              {
-                float elevation_deg_min = 999, elevation_deg_max = -999;
-                for (std::map<int, std::map<int, int>>::iterator segment_coverage_elevation_iter = segment_coverage.begin(); segment_coverage_elevation_iter != segment_coverage.end(); segment_coverage_elevation_iter++)
+                int azimuth_min_deg = std::max<int>((int)all_segments_azimuth_min_deg, -COVERAGE_AZIMUTH_OFFSET);
+                int azimuth_max_deg = std::min<int>((int)all_segments_azimuth_max_deg, COVERAGE_AZIMUTH_OFFSET);
+                if (coverage_mask_azimuth_min != azimuth_min_deg || coverage_mask_azimuth_max != azimuth_max_deg) // azimuth range changed, update the coverage mask
                 {
-                    int azimuth_deg_first = 999, azimuth_deg_last = -999;
-                    float elevation_deg = 0.001f * (segment_coverage_elevation_iter->first);
-                    elevation_deg_min = std::min<float>(elevation_deg, elevation_deg_min);
-                    elevation_deg_max = std::max<float>(elevation_deg, elevation_deg_max);
-                    std::map<int, int>& azimuth_histogram = segment_coverage_elevation_iter->second;
-                    for (std::map<int, int>::iterator segment_coverage_azimuth_iter = azimuth_histogram.begin(); segment_coverage_azimuth_iter != azimuth_histogram.end(); segment_coverage_azimuth_iter++)
-                    {
-                        const int& azimuth_deg = segment_coverage_azimuth_iter->first;
-                        const int& azimuth_cnt = segment_coverage_azimuth_iter->second;
-                        if (azimuth_cnt > 0 && azimuth_deg >= (int)all_segments_azimuth_min_deg && azimuth_deg <= (int)all_segments_azimuth_max_deg)
-                        {
-                            azimuth_deg_first = std::min<int>(azimuth_deg_first, azimuth_deg);
-                            azimuth_deg_last = std::max<int>(azimuth_deg_last, azimuth_deg);
-                        }
-                    }
-                    bool azimuth_success = (azimuth_deg_last - azimuth_deg_first + 1 >= all_segments_azimuth_max_deg - all_segments_azimuth_min_deg);
-                    // Check azimuth_histogram[azimuth_deg] > 0 for all azimuth_deg in range (azimuth_deg_first, azimuth_deg_last)
-                    for(int azimuth_deg = azimuth_deg_first; azimuth_success && azimuth_deg <= azimuth_deg_last; azimuth_deg++)
-                    {
-                        if (azimuth_histogram[azimuth_deg] <= 0)
-                            azimuth_success = false;
-                    }
-                    // ROS_INFO_STREAM("    SegmentPointsCollector::allSegmentsCovered(): lastSegmentIdx=" << lastSegmentIdx() << ", total_point_count=" << total_point_count 
-                    //      << ", cur_elevation=" << elevation_deg << ", azimuth=(" << azimuth_deg_first << "," << azimuth_deg_last << ")"
-                    //      << ", azimuth_range=(" << all_segments_azimuth_min_deg << "," << all_segments_azimuth_max_deg << "), azimuth_success=" << azimuth_success);
+                    coverage_mask.reset();
+                    for (int azimuth_deg = azimuth_min_deg; azimuth_deg <= azimuth_max_deg; azimuth_deg++)
+                        coverage_mask.set(azimuth_deg + COVERAGE_AZIMUTH_OFFSET);
+                    coverage_mask_azimuth_min = azimuth_min_deg;
+                    coverage_mask_azimuth_max = azimuth_max_deg;
+                }
+                float azimuth_range_required = all_segments_azimuth_max_deg - all_segments_azimuth_min_deg;
+                for (int row = 0; row < coverage_num_rows; row++)
+                {
+                    AzimuthCoverage azimuth_coverage = segment_coverage[row].second & coverage_mask;
+                    // All azimuth bins from first to last covered bin must be set, i.e. the number of covered bins is a lower bound of the covered azimuth range.
+                    // The exact check of first and last covered bin is required only if the number of covered bins is sufficient.
+                    size_t azimuth_cnt = azimuth_coverage.count();
+                    if (azimuth_cnt == 0 || azimuth_cnt < azimuth_range_required)
+                        return false;
+                    int azimuth_idx_first = azimuth_min_deg + COVERAGE_AZIMUTH_OFFSET, azimuth_idx_last = azimuth_max_deg + COVERAGE_AZIMUTH_OFFSET;
+                    while (!azimuth_coverage.test(azimuth_idx_first))
+                        azimuth_idx_first++;
+                    while (!azimuth_coverage.test(azimuth_idx_last))
+                        azimuth_idx_last--;
+                    // Check azimuth_coverage[azimuth_idx] is set for all azimuth_idx in range (azimuth_idx_first, azimuth_idx_last)
+                    bool azimuth_success = (azimuth_idx_last - azimuth_idx_first + 1 >= azimuth_range_required) && (azimuth_cnt == (size_t)(azimuth_idx_last - azimuth_idx_first + 1));
                     if (!azimuth_success)
                         return false;
                 }
+                float elevation_deg_min = (coverage_num_rows > 0) ? (0.001f * coverage_elevation_mdeg_min) : 999;
+                float elevation_deg_max = (coverage_num_rows > 0) ? (0.001f * coverage_elevation_mdeg_max) : -999;
                 bool elevation_success = (elevation_deg_max - elevation_deg_min + 1 >= all_segments_elevation_max_deg - all_segments_elevation_min_deg);
-                // ROS_INFO_STREAM("    SegmentPointsCollector::allSegmentsCovered(): lastSegmentIdx=" << lastSegmentIdx() << ", total_point_count=" << total_point_count 
-                //     << ", elevation_deg_min=" << elevation_deg_min << ", elevation_deg_max=" << elevation_deg_max
-                //     << ", all_segments_elevation_min_deg=" << all_segments_elevation_min_deg << ", all_segments_elevation_max_deg=" << all_segments_elevation_max_deg
-                //     << ", elevation_success=" << elevation_success);
                 if (!elevation_success)
                     return false;
                 return true; // all scans in all elevation angles cover azimuth from all_segments_azimuth_min_deg to all_segments_azimuth_max_deg
@@ -326,6 +388,10 @@ namespace sick_scansegment_xd
             // Returns the number of echos
             int numEchos(void) const { return (int)lidar_points.size(); }
 
+            // Azimuth coverage of one elevation: bit azimuth_deg + COVERAGE_AZIMUTH_OFFSET is set, if azimuth_deg (-181 to +181 degree incl. neighbour bins) is covered by at least one point
+            enum { COVERAGE_AZIMUTH_OFFSET = 181, COVERAGE_AZIMUTH_BINS = 2 * COVERAGE_AZIMUTH_OFFSET + 1 };
+            typedef std::bitset<COVERAGE_AZIMUTH_BINS> AzimuthCoverage;
+
             uint32_t timestamp_sec;   // seconds part of timestamp of the first segment
             uint32_t timestamp_nsec;  // nanoseconds part of timestamp of the first segment
             // int32_t segment_count; // number of segments collected
@@ -336,21 +402,53 @@ namespace sick_scansegment_xd
             std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>> lidar_points; // list of PointXYZRAEI32f: lidar_points[echoIdx] are the points of all segments of an echo (idx echoIdx)
             std::vector<int32_t> segment_list; // list of all collected segment indices
             std::vector<int32_t> telegram_list; // list of all collected telegram counters
-            std::map<int, std::map<int, int>> segment_coverage; // (elevation,azimuth) histogram: segment_coverage[elevation][azimuth] > 0: elevation in mdeg and azimuth in deg covered (otherwise no hits)
+            std::vector<std::pair<int, AzimuthCoverage>> segment_coverage; // (elevation,azimuth) coverage: segment_coverage[row] = (elevation in mdeg, azimuth bits), rows 0 to coverage_num_rows-1 are in use
+            int coverage_num_rows;             // number of elevations (layer) collected in segment_coverage
+            int coverage_last_row;             // row of the last point appended, consecutive points are usually in the same layer
+            int coverage_elevation_mdeg_min;   // min. elevation in segment_coverage in mdeg
+            int coverage_elevation_mdeg_max;   // max. elevation in segment_coverage in mdeg
+            AzimuthCoverage coverage_mask;     // azimuth bins required by allSegmentsCovered
+            int coverage_mask_azimuth_min;     // min. azimuth in deg of coverage_mask
+            int coverage_mask_azimuth_max;     // max. azimuth in deg of coverage_mask
+
+        protected:
+
+            // Returns the azimuth coverage of a given elevation. Rows are allocated once per layer and reused after reset.
+            AzimuthCoverage& coverageRow(int elevation_mdeg)
+            {
+                if (coverage_last_row >= 0 && segment_coverage[coverage_last_row].first == elevation_mdeg)
+                    return segment_coverage[coverage_last_row].second;
+                for (int row = 0; row < coverage_num_rows; row++)
+                {
+                    if (segment_coverage[row].first == elevation_mdeg)
+                    {
+                        coverage_last_row = row;
+                        return segment_coverage[row].second;
+                    }
+                }
+                if (coverage_num_rows >= (int)segment_coverage.size())
+                    segment_coverage.push_back(std::pair<int, AzimuthCoverage>());
+                segment_coverage[coverage_num_rows].first = elevation_mdeg;
+                segment_coverage[coverage_num_rows].second.reset();
+                coverage_elevation_mdeg_min = (coverage_num_rows > 0) ? std::min<int>(coverage_elevation_mdeg_min, elevation_mdeg) : elevation_mdeg;
+                coverage_elevation_mdeg_max = (coverage_num_rows > 0) ? std::max<int>(coverage_elevation_mdeg_max, elevation_mdeg) : elevation_mdeg;
+                coverage_last_row = coverage_num_rows;
+                coverage_num_rows++;
+                return segment_coverage[coverage_last_row].second;
+            }
         };
 
         /*
-        * Converts the lidarpoints to a customized PointCloud2Msg containing configured fields (e.g. x, y, z, i, range, azimuth, elevation, layer, echo, reflector).
+        * Converts the lidarpoints to customized PointCloud2Msg containing configured fields (e.g. x, y, z, i, range, azimuth, elevation, layer, echo, reflector).
+        * All customized pointclouds with a given update method (fullframe or segmented) are filled in one traversal of the lidar points.
         * @param[in] timestamp_sec seconds part of timestamp
         * @param[in] timestamp_nsec  nanoseconds part of timestamp
-        * @param[in] last_timestamp_sec seconds part of last timestamp
-        * @param[in] last_timestamp_nsec  nanoseconds part of last timestamp
         * @param[in] lidar_points list of PointXYZRAEI32f: lidar_points[echoIdx] are the points of one echo
-        * @param[in] pointcloud_cfg configuration of customized pointcloud
-        * @param[out] pointcloud_msg customized pointcloud message
+        * @param[in] fullframe true: convert all fullframe pointclouds, false: convert all segmented pointclouds
+        * @param[out] pointcloud_msgs customized pointcloud messages, pointcloud_msgs[n] is converted if m_custom_pointclouds_cfg[n] is published with the given update method
         */
-        void convertPointsToCustomizedFieldsCloud(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points, 
-            CustomPointCloudConfiguration& pointcloud_cfg, PointCloud2Msg& pointcloud_msg);
+        void convertPointsToCustomizedFieldsClouds(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points, 
+            bool fullframe, std::vector<PointCloud2Msg>& pointcloud_msgs);
 
         void convertPointsToLaserscanMsg(uint32_t timestamp_sec, uint32_t timestamp_nsec, const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points, size_t total_point_count, LaserScanMsgMap& laser_scan_msg_map, const std::string& frame_id, bool is_fullframe);
 
@@ -368,7 +466,7 @@ namespace sick_scansegment_xd
         std::string printElevationAzimuthTable(const std::vector<std::vector<sick_scansegment_xd::PointXYZRAEI32f>>& lidar_points);
 
         /** Prints (elevation,azimuth) values of the coverage table of collected lidar points */
-        std::string printCoverageTable(const std::map<int, std::map<int, int>>& elevation_azimuth_histograms);
+        std::string printCoverageTable(const SegmentPointsCollector& points_collector);
 
         bool m_active; // activate publishing
         rosNodePtr m_node; // ros node handle
@@ -384,7 +482,18 @@ namespace sick_scansegment_xd
         bool m_publisher_imu_initialized = false;            // imu messages enabled, ros publisher for Imu messages initialized
         double m_scan_time = 0;                              // scan_time = 1 / scan_frequency = time for a full 360-degree rotation of the sensor
         std::vector<int> m_laserscan_layer_filter;           // Configuration of laserscan messages (ROS only), activate/deactivate laserscan messages for each layer
+        LaserScanMsgMap m_laser_scan_msg_map_segment;        // LaserScan messages of the current segment, reused for each segment
+        LaserScanMsgMap m_laser_scan_msg_map_fullframe;      // LaserScan messages of all segments (360 degree), reused for each fullframe
+        float m_laserscan_azimuth_increment_cfg = 0;         // Angular resolution of laserscan messages in radians configured by parameter "laserscan_angular_resolution" (0: angular resolution transmitted by the lidar)
+        std::vector<float> m_laserscan_azimuth_increment_lidar; // Angular resolution in radians transmitted by the lidar for each layer, kept for the next scans
+        size_t m_laserscan_bin_collisions = 0;               // Number of scan points not converted to laserscan messages since last warning, because their azimuth bin was already occupied
+        std::chrono::steady_clock::time_point m_laserscan_bin_collisions_warning_time; // Time of last warning about azimuth bin collisions
+        std::vector<std::vector<LaserScanAccumulator>> m_laserscan_accumulators; // temporary in convertPointsToLaserscanMsg: m_laserscan_accumulators[echo][layer]
+        std::string m_laserscan_frame_id;                    // temporary in convertPointsToLaserscanMsg: frame id of a laserscan message
 	    std::vector<CustomPointCloudConfiguration> m_custom_pointclouds_cfg; // Configuration of customized pointclouds
+        std::vector<PointCloud2Msg> m_custom_pointclouds_msg;                // Customized pointcloud messages, m_custom_pointclouds_msg[n] is published by m_custom_pointclouds_cfg[n], reused for each segment
+        std::vector<int> m_custom_pointclouds_active;                        // temporary in convertPointsToCustomizedFieldsClouds: indices of the pointclouds converted in one traversal
+        std::vector<uint8_t*> m_custom_pointclouds_data;                     // temporary in convertPointsToCustomizedFieldsClouds: next destination point in the pointcloud data
 
     };  // class RosMsgpackPublisher
 
@@ -81,6 +81,7 @@
 #ifndef __SICK_SCANSEGMENT_XD_PARSER_OUTPUT_H
 #define __SICK_SCANSEGMENT_XD_PARSER_OUTPUT_H
 
+#include <algorithm>
 #include "sick_scan/sick_ros_wrapper.h"
 
 namespace sick_scansegment_xd
@@ -121,10 +122,17 @@ namespace sick_scansegment_xd
 
         ScanSegmentParserOutput();
 
+        /*
+         * @brief Removes all scandata and points and resets timestamps and counters. The point arrays keep their capacity for reuse.
+         */
+        void Clear(void);
+
         /*
          * @brief class LidarPoint is a data point in cartesian coordinates with x, y, z in meter and an intensity value.
          * Additionally, polar coordinates with azimuth and elevation in radians and distance in meter are given plus the
          * group index (0 up to 15 for multiScan136) and the echo index (0 up to 2).
+         * Scan points are stored as struct-of-arrays in SegmentPoints, LidarPoint is a single point returned by SegmentPoints::get()
+         * for debug output and file exports.
          */
         class LidarPoint
         {
@@ -146,12 +154,96 @@ namespace sick_scansegment_xd
         };
 
         /*
-         * @brief type Scanline is a vector of LidarPoint data. multiScan136 and picoScan transmit up to 3 echos, each echo is a Scanline.
+         * @brief class SegmentPoints is a flat struct-of-arrays container for all scan points of a segment.
+         * Point n is given by x[n], y[n], z[n], i[n], range[n], azimuth[n], elevation[n], layer[n], echo[n], pointIdx[n] and flags[n].
+         * All arrays have the same size. Parsers allocate the arrays once per segment (resize) and fill them by index,
+         * consumers iterate over the arrays without per-point allocations.
+         */
+        class SegmentPoints
+        {
+        public:
+            static const uint8_t FLAG_REFLECTOR = 0x01; // flags[n] & FLAG_REFLECTOR: reflector bit set
+
+            size_t size() const { return x.size(); }
+            bool empty() const { return x.empty(); }
+
+            /*
+             * @brief Resizes all arrays to num_points. Shrinking does not reallocate, i.e. capacity is kept for reuse.
+             */
+            void resize(size_t num_points)
+            {
+                x.resize(num_points); y.resize(num_points); z.resize(num_points); i.resize(num_points);
+                range.resize(num_points); azimuth.resize(num_points); elevation.resize(num_points);
+                layer.resize(num_points); echo.resize(num_points); pointIdx.resize(num_points); flags.resize(num_points);
+            }
+
+            /*
+             * @brief Removes all points (capacity is kept).
+             */
+            void clear()
+            {
+                resize(0);
+            }
+
+            /*
+             * @brief Sets point n, requires n < size()
+             */
+            inline void set(size_t n, float _x, float _y, float _z, float _i, float _range, float _azimuth, float _elevation, int _layer, int _echo, int _pointIdx, uint8_t _flags)
+            {
+                x[n] = _x; y[n] = _y; z[n] = _z; i[n] = _i;
+                range[n] = _range; azimuth[n] = _azimuth; elevation[n] = _elevation;
+                layer[n] = (uint16_t)_layer; echo[n] = (uint8_t)_echo; pointIdx[n] = (uint16_t)_pointIdx; flags[n] = _flags;
+            }
+
+            /*
+             * @brief Copies num_points points from src[src_idx] to this[dst_idx], requires dst_idx + num_points <= size()
+             */
+            void copy(size_t dst_idx, const SegmentPoints& src, size_t src_idx, size_t num_points)
+            {
+                std::copy(src.x.begin() + src_idx, src.x.begin() + src_idx + num_points, x.begin() + dst_idx);
+                std::copy(src.y.begin() + src_idx, src.y.begin() + src_idx + num_points, y.begin() + dst_idx);
+                std::copy(src.z.begin() + src_idx, src.z.begin() + src_idx + num_points, z.begin() + dst_idx);
+                std::copy(src.i.begin() + src_idx, src.i.begin() + src_idx + num_points, i.begin() + dst_idx);
+                std::copy(src.range.begin() + src_idx, src.range.begin() + src_idx + num_points, range.begin() + dst_idx);
+                std::copy(src.azimuth.begin() + src_idx, src.azimuth.begin() + src_idx + num_points, azimuth.begin() + dst_idx);
+                std::copy(src.elevation.begin() + src_idx, src.elevation.begin() + src_idx + num_points, elevation.begin() + dst_idx);
+                std::copy(src.layer.begin() + src_idx, src.layer.begin() + src_idx + num_points, layer.begin() + dst_idx);
+                std::copy(src.echo.begin() + src_idx, src.echo.begin() + src_idx + num_points, echo.begin() + dst_idx);
+                std::copy(src.pointIdx.begin() + src_idx, src.pointIdx.begin() + src_idx + num_points, pointIdx.begin() + dst_idx);
+                std::copy(src.flags.begin() + src_idx, src.flags.begin() + src_idx + num_points, flags.begin() + dst_idx);
+            }
+
+            /*
+             * @brief Returns point n as LidarPoint (debug output and exports only, not intended for time critical loops)
+             */
+            LidarPoint get(size_t n) const
+            {
+                return LidarPoint(x[n], y[n], z[n], i[n], range[n], azimuth[n], elevation[n], layer[n], echo[n], pointIdx[n], (uint8_t)(flags[n] & FLAG_REFLECTOR));
+            }
+
+            std::vector<float> x;           // cartesian x coordinate in meter
+            std::vector<float> y;           // cartesian y coordinate in meter
+            std::vector<float> z;           // cartesian z coordinate in meter
+            std::vector<float> i;           // intensity
+            std::vector<float> range;       // polar coordinate range in meter
+            std::vector<float> azimuth;     // polar coordinate azimuth in radians
+            std::vector<float> elevation;   // polar coordinate elevation in radians
+            std::vector<uint16_t> layer;    // group index (layer), 0 <= layer < 16 for multiScan136
+            std::vector<uint8_t> echo;      // echo index, 0 <= echo < 3 for multiScan136
+            std::vector<uint16_t> pointIdx; // point index within its scanline
+            std::vector<uint8_t> flags;     // bitarray, (flags & FLAG_REFLECTOR) != 0: reflector detected on any number of echos
+        };
+
+        /*
+         * @brief type Scanline is an index range of points. multiScan136 and picoScan transmit up to 3 echos, each echo is a Scanline.
+         * The points of a scanline are points[start] up to points[start + count - 1] of the ScanSegmentParserOutput.
          */
         class Scanline
         {
         public:
-            std::vector<LidarPoint> points; // list of all scan points
+            Scanline(size_t _start = 0, size_t _count = 0) : start(_start), count(_count) {}
+            size_t start; // index of the first point in ScanSegmentParserOutput::points
+            size_t count; // number of points in this scanline
         };
 
         /*
@@ -160,19 +252,28 @@ namespace sick_scansegment_xd
         class Scangroup
         {
         public:
-            Scangroup() : timestampStart_sec(0), timestampStart_nsec(0), timestampStop_sec(0), timestampStop_nsec(0), scanlines() {}
+            Scangroup() : timestampStart_sec(0), timestampStart_nsec(0), timestampStop_sec(0), timestampStop_nsec(0), timestampStart_ticks(0), timestampStop_ticks(0), azimuthIncrement(0), scanlines() {}
             uint32_t timestampStart_sec;
             uint32_t timestampStart_nsec;
             uint32_t timestampStop_sec;
             uint32_t timestampStop_nsec;
+            uint32_t timestampStart_ticks; // sensor ticks of timestampStart (msgpack only), converted to timestampStart_sec and timestampStart_nsec by ApplySoftwarePLL()
+            uint32_t timestampStop_ticks;  // sensor ticks of timestampStop (msgpack only), converted to timestampStop_sec and timestampStop_nsec by ApplySoftwarePLL()
+            float azimuthIncrement;        // angular resolution of the lidar in radians, i.e. azimuth step between consecutive beams as transmitted by the lidar (0: unknown)
             std::vector<Scanline> scanlines;
         };
 
         /*
-         * @brief scandata contains all data of a msgpack or compact scan.
+         * @brief scandata contains the groups and scanlines of a msgpack or compact scan,
+         * the scanlines are index ranges into points. Points are stored contiguously by group and echo.
          */
         std::vector<Scangroup> scandata;
 
+        /*
+         * @brief points contains all scan points of a msgpack or compact scan as struct-of-arrays.
+         */
+        SegmentPoints points;
+
         /*
          * @brief optional imu data
          */
@@ -190,6 +291,23 @@ namespace sick_scansegment_xd
          */
         int segmentIndex;
         int telegramCnt;
+
+        /*
+         * @brief Sensor ticks of the segment timestamp, converted to system time by ApplySoftwarePLL()
+         */
+        bool sensorTicksValid;    // true, if sensorTicks is available
+        uint32_t sensorTicks;     // sensor ticks of the segment timestamp (msgpack: TimestampTransmit, compact: start of scan resp. imu timestamp)
+        bool scangroupTicksValid; // true, if timestampStart_ticks and timestampStop_ticks of the scangroups are available (msgpack only)
+
+        /*
+         * @brief Updates the software pll with the sensor ticks and converts the sensor ticks to system time. The software pll has to be
+         * updated in order of arrival, i.e. ApplySoftwarePLL is called by the parser (use_software_pll = true) or, if segments are
+         * parsed in parallel, by MsgPackConverter in order of arrival.
+         * @param[in] system_timestamp receive timestamp of the segment (system time)
+         * @param[in] verbose true: enable debug output, false: quiet mode
+         * @return true, if timestamps have been converted, false if the software pll is not yet initialized
+         */
+        bool ApplySoftwarePLL(const std::chrono::system_clock::time_point& system_timestamp, bool verbose = false);
     };
 
     /*
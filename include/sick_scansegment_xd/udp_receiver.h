@@ -62,6 +62,11 @@
 #include "sick_scansegment_xd/common.h"
 #include "sick_scansegment_xd/fifo.h"
 
+namespace sick_scan_xd
+{
+    class SocketReactor; // forward declaration of the epoll reactor shared by all sensor sockets
+}
+
 namespace sick_scansegment_xd
 {
     /*
@@ -98,11 +103,19 @@ namespace sick_scansegment_xd
          * @param[in] export_udp_msg: true: export binary udp and msgpack data to file (*.udp and *.msg), default: false
          * @param[in] scandataformat ScanDataFormat: 1 for msgpack or 2 for compact scandata, default: 1
          * @param[in] PayloadFifo* fifo: Fifo to handle payload data
+         * @param[in] udp_recv_batch_size max. number of udp datagrams received by one recvmmsg syscall using kernel receive timestamps (Linux only), default: 0 (one recv call per datagram)
+         */
+        bool Init(const std::string& udp_sender, int udp_port, int udp_input_fifolength = 20, bool verbose = false, bool export_udp_msg = false, int scandataformat = 1, PayloadFifo* fifo = 0, int udp_recv_batch_size = 0);
+
+        /*
+         * @brief Sets an optional socket reactor (Linux only). If a reactor is set before Start(), the udp socket is registered
+         * in the reactor and received datagrams are assembled by the reactor thread. Otherwise (default), Start() runs a
+         * background thread per udp receiver.
          */
-        bool Init(const std::string& udp_sender, int udp_port, int udp_input_fifolength = 20, bool verbose = false, bool export_udp_msg = false, int scandataformat = 1, PayloadFifo* fifo = 0);
+        void SetSocketReactor(sick_scan_xd::SocketReactor* reactor) { m_reactor = reactor; }
 
         /*
-         * @brief Starts receiving udp packages in a background thread and pops msgpack data packages to the fifo.
+         * @brief Starts receiving udp packages in a background thread (or by the socket reactor) and pops msgpack data packages to the fifo.
          */
         bool Start(void);
 
@@ -142,6 +155,28 @@ namespace sick_scansegment_xd
          */
         bool Run(void);
 
+        /*
+         * @brief Reactor callback, called by the socket reactor thread if the udp socket is readable.
+         * Receives the available datagram(s) without blocking and appends them to the current message.
+         */
+        void OnSocketReadable(void);
+
+        /*
+         * @brief Incremental message framing in reactor mode: appends a received datagram to the current message
+         * and pushes the message to the fifo after all bytes have been received.
+         */
+        void AppendDatagram(const uint8_t* datagram, size_t datagram_size, const chrono_system_time& datagram_timestamp);
+
+        /*
+         * @brief Checks the CRC of a received message and pushes its payload to the fifo. Returns false in case of CRC errors.
+         */
+        bool PushMessage(const std::vector<uint8_t>& udp_payload, size_t bytes_received, uint32_t bytes_to_receive, uint32_t payload_length_bytes, uint32_t udp_payload_offset, const fifo_timestamp& recv_timestamp);
+
+        /*
+         * @brief Unregisters the udp socket from the socket reactor (if registered)
+         */
+        void RemoveFromReactor(void);
+
         /*
          * Configuration and parameter
          */
@@ -161,6 +196,19 @@ namespace sick_scansegment_xd
         bool m_fifo_impl_created;                 // m_fifo_impl has been created and needs be deleted at exit
         std::thread* m_receiver_thread;           // background thread to receive udp packages
         bool m_run_receiver_thread;               // flag to start and stop the udp receiver thread
+        size_t m_udp_recv_counter;                // number of messages pushed to the fifo
+        chrono_system_time m_timestamp_last_print;           // avoid printing with more than 1 Hz
+        chrono_system_time m_timestamp_last_print_crc_error; // avoid printing crc errors with more than 1 Hz
+
+        /*
+         * Member data to receive udp packages by a socket reactor (optional, Linux only)
+         */
+        sick_scan_xd::SocketReactor* m_reactor;   // socket reactor or 0 (default: background thread per udp receiver)
+        bool m_reactor_registered;                // true if the udp socket is registered in m_reactor
+        std::vector<uint8_t> m_reactor_datagram;  // receive buffer for a single datagram
+        std::vector<uint8_t> m_frame_buffer;      // message assembled from the datagrams received so far
+        size_t m_frame_bytes;                     // number of bytes in m_frame_buffer
+        chrono_system_time m_frame_timestamp;     // receive timestamp of the first datagram of the current message
 
 
     };  // class UdpReceiver
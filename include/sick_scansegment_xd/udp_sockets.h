@@ -57,6 +57,7 @@
 #define __SICK_SCANSEGMENT_XD_UDP_SOCKETS_H
 
 #include <string>
+#include <errno.h>
 #if defined WIN32 || defined _MSC_VER
 #ifndef _WINSOCK_DEPRECATED_NO_WARNINGS
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
@@ -78,6 +79,7 @@ static std::string getErrorMessage(void)
 #include <netinet/udp.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <time.h>
 typedef int SOCKET;
 typedef struct sockaddr SOCKADDR;
 #define INVALID_SOCKET (-1)
@@ -108,8 +110,10 @@ namespace sick_scansegment_xd
     public:
 
         /** Default constructor */
-        UdpReceiverSocketImpl() : m_udp_sender(""), m_udp_port(0), m_udp_socket(INVALID_SOCKET) 
+        UdpReceiverSocketImpl() : m_udp_sender(""), m_udp_port(0), m_udp_socket(INVALID_SOCKET), m_batch_size(0), m_batch_datagram_size(0), m_batch_count(0), m_batch_next(0)
         {
+            m_datagram_timestamp = chrono_system_clock::now();
+            m_message_timestamp = m_datagram_timestamp;
         }
 
         /** Destructor, closes the socket */
@@ -176,12 +180,56 @@ namespace sick_scansegment_xd
             }
         }
 
+        /*
+         * Enables the batched receive mode (Linux only): up to batch_size datagrams are received by one recvmmsg syscall
+         * and the kernel receive timestamp of each datagram (SO_TIMESTAMPNS) is used instead of the system time after reading.
+         * Returns false, if batch_size <= 1 or batched receive is not supported (i.e. default mode with one recv call per datagram)
+         */
+        bool InitBatchReceive(int batch_size, size_t max_datagram_size = 64 * 1024)
+        {
+#if defined __linux__
+            if (batch_size <= 1 || m_udp_socket == INVALID_SOCKET)
+                return false;
+            int timestamp_opt = 1;
+            if (setsockopt(m_udp_socket, SOL_SOCKET, SO_TIMESTAMPNS, &timestamp_opt, sizeof(timestamp_opt)) < 0)
+            {
+                ROS_WARN_STREAM("## WARNING UdpReceiverSocketImpl::InitBatchReceive(): setsockopt(SO_TIMESTAMPNS) failed, error: " << getErrorMessage() << ", using system time after receive");
+            }
+            m_batch_size = batch_size;
+            m_batch_datagram_size = max_datagram_size;
+            m_batch_buffer.resize(m_batch_size * m_batch_datagram_size);
+            m_batch_control.resize(m_batch_size * CMSG_SPACE(sizeof(struct timespec)));
+            m_batch_iovecs.resize(m_batch_size);
+            m_batch_msgs.resize(m_batch_size);
+            for (size_t n = 0; n < m_batch_size; n++)
+            {
+                m_batch_iovecs[n].iov_base = m_batch_buffer.data() + n * m_batch_datagram_size;
+                m_batch_iovecs[n].iov_len = m_batch_datagram_size;
+                memset(&m_batch_msgs[n], 0, sizeof(m_batch_msgs[n]));
+                m_batch_msgs[n].msg_hdr.msg_iov = &m_batch_iovecs[n];
+                m_batch_msgs[n].msg_hdr.msg_iovlen = 1;
+            }
+            m_batch_count = 0;
+            m_batch_next = 0;
+            ROS_INFO_STREAM("UdpReceiverSocketImpl: batched receive of max. " << m_batch_size << " datagrams per recvmmsg enabled on port " << m_udp_port);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /** Returns true, if batched receive mode is enabled (Linux only) */
+        bool BatchReceiveEnabled(void) const { return m_batch_size > 1; }
+
+        /** Returns the receive timestamp of the first datagram of the last message received by Receive(msg_payload, timeout, udp_msg_start_seq) */
+        const chrono_system_time& MessageTimestamp(void) const { return m_message_timestamp; }
+
         /** Reads blocking until some data has been received successfully or an error occurs. Returns the number of bytes received. */
         size_t Receive(std::vector<uint8_t>& msg_payload)
         {
             int64_t bytes_received = 0;
             while(bytes_received == 0)
-                bytes_received = recv(m_udp_socket, (char*)msg_payload.data(), (int)msg_payload.size(), 0);
+                bytes_received = ReceiveDatagram((char*)msg_payload.data(), msg_payload.size());
             if (bytes_received < 0)
                 return 0; // socket error
             return (size_t)bytes_received;
@@ -197,7 +245,7 @@ namespace sick_scansegment_xd
             // Receive \x02\x02\x02\x02 | 4Bytes payloadlength incl. CRC | Payload | CRC32
             while (bytes_received < bytes_to_receive && (timeout < 0 || sick_scansegment_xd::Seconds(start_timestamp, chrono_system_clock::now()) < timeout))
             {
-                int64_t chunk_bytes_received = recv(m_udp_socket, (char*)msg_payload.data() + bytes_received, (int)msg_payload.size() - bytes_received, 0);
+                int64_t chunk_bytes_received = ReceiveDatagram((char*)msg_payload.data() + bytes_received, msg_payload.size() - bytes_received);
                 if (chunk_bytes_received <= 0)
                 {
                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -211,6 +259,7 @@ namespace sick_scansegment_xd
                 {
                     // Start of new message: restart timeout
                     start_timestamp = chrono_system_clock::now();
+                    m_message_timestamp = m_datagram_timestamp;
                     // Decode 8 byte header: 0x02020202 + Payloadlength
                     size_t Payloadlength= Convert4Byte(msg_payload.data() + udp_msg_start_seq.size());
                     bytes_to_receive = Payloadlength + headerlength + sizeof(uint32_t); // 8 byte header + payload + 4 byte CRC
@@ -229,14 +278,98 @@ namespace sick_scansegment_xd
             return bytes_received;
         }
 
+        /*
+         * Receives the next datagram without blocking (Linux only, used by the socket reactor after the socket became readable).
+         * In batched receive mode, pending datagrams of the last recvmmsg call are returned first. Returns the number of bytes
+         * received, 0 if no datagram is available or a value < 0 on socket errors.
+         */
+        int64_t ReceiveNonBlocking(std::vector<uint8_t>& datagram, chrono_system_time& datagram_timestamp)
+        {
+            int64_t bytes_received = ReceiveDatagram((char*)datagram.data(), datagram.size(), true);
+            if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                bytes_received = 0;
+            datagram_timestamp = m_datagram_timestamp;
+            return bytes_received;
+        }
+
+        /** Returns true, if datagrams of the last recvmmsg call are still pending (batched receive mode only) */
+        bool DatagramPending(void) const { return m_batch_next < m_batch_count; }
+
+        /** Returns the socket handle */
+        SOCKET SocketHandle(void) const { return m_udp_socket; }
+
         /** Return the udp port */
         int port(void) const { return m_udp_port; }
 
     protected:
 
+        /*
+         * Receives the next datagram and sets its receive timestamp. In batched receive mode, the datagram is taken from the
+         * datagrams received by the last recvmmsg call. Otherwise, the datagram is received by recv. Returns the number of bytes received.
+         * If nonblocking is true, the call returns immediately if no datagram is available (Linux only).
+         */
+        int64_t ReceiveDatagram(char* buffer, size_t buffer_size, bool nonblocking = false)
+        {
+#if defined __linux__
+            int recv_flags = (nonblocking ? MSG_DONTWAIT : 0);
+#else
+            int recv_flags = 0;
+#endif
+#if defined __linux__
+            if (m_batch_size > 1)
+            {
+                if (m_batch_next >= m_batch_count) // all datagrams of the last batch consumed, receive next batch
+                {
+                    for (size_t n = 0; n < m_batch_size; n++)
+                    {
+                        m_batch_msgs[n].msg_hdr.msg_control = m_batch_control.data() + n * CMSG_SPACE(sizeof(struct timespec));
+                        m_batch_msgs[n].msg_hdr.msg_controllen = CMSG_SPACE(sizeof(struct timespec));
+                        m_batch_msgs[n].msg_len = 0;
+                    }
+                    int num_datagrams = recvmmsg(m_udp_socket, m_batch_msgs.data(), (unsigned int)m_batch_size, MSG_WAITFORONE | recv_flags, 0); // blocks until at least one datagram received (unless nonblocking)
+                    if (num_datagrams <= 0)
+                        return num_datagrams;
+                    m_batch_count = (size_t)num_datagrams;
+                    m_batch_next = 0;
+                }
+                size_t datagram_idx = m_batch_next++;
+                struct msghdr& msg_hdr = m_batch_msgs[datagram_idx].msg_hdr;
+                m_datagram_timestamp = chrono_system_clock::now();
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg_hdr); cmsg != 0; cmsg = CMSG_NXTHDR(&msg_hdr, cmsg))
+                {
+                    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                    {
+                        struct timespec kernel_timestamp;
+                        memcpy(&kernel_timestamp, CMSG_DATA(cmsg), sizeof(kernel_timestamp));
+                        m_datagram_timestamp = chrono_system_time(std::chrono::duration_cast<chrono_system_clock::duration>(std::chrono::seconds(kernel_timestamp.tv_sec) + std::chrono::nanoseconds(kernel_timestamp.tv_nsec)));
+                        break;
+                    }
+                }
+                size_t bytes_received = std::min<size_t>(m_batch_msgs[datagram_idx].msg_len, buffer_size);
+                memcpy(buffer, m_batch_buffer.data() + datagram_idx * m_batch_datagram_size, bytes_received);
+                return (int64_t)bytes_received;
+            }
+#endif
+            int64_t bytes_received = recv(m_udp_socket, buffer, (int)buffer_size, recv_flags);
+            m_datagram_timestamp = chrono_system_clock::now();
+            return bytes_received;
+        }
+
         std::string m_udp_sender; // IP of udp sender
         int m_udp_port;           // udp port
         SOCKET m_udp_socket;      // udp raw socket
+        chrono_system_time m_datagram_timestamp; // receive timestamp of the last datagram (kernel timestamp in batched receive mode, otherwise system time after recv)
+        chrono_system_time m_message_timestamp;  // receive timestamp of the first datagram of the last message
+        size_t m_batch_size;                     // max. number of datagrams received by one recvmmsg call (batched receive mode, Linux only), 0: batched receive disabled
+        size_t m_batch_datagram_size;            // max. size of a datagram in batched receive mode
+        size_t m_batch_count;                    // number of datagrams received by the last recvmmsg call
+        size_t m_batch_next;                     // index of the next datagram to read from the last batch
+        std::vector<uint8_t> m_batch_buffer;     // receive buffer for m_batch_size datagrams
+        std::vector<uint8_t> m_batch_control;    // control message buffer for kernel receive timestamps
+#if defined __linux__
+        std::vector<struct iovec> m_batch_iovecs; // scatter/gather array for recvmmsg
+        std::vector<struct mmsghdr> m_batch_msgs; // message headers for recvmmsg
+#endif
     };
 
     /*!
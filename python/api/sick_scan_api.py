@@ -863,6 +863,7 @@ Callback declarations
 """
 
 SickScanPointCloudMsgCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(SickScanPointCloudMsg))                 # sick_scan_api.h: typedef void(* SickScanPointCloudMsgCallback)(SickScanApiHandle apiHandle, const SickScanPointCloudMsg* msg);
+SickScanPointCloudMsgZeroCopyCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(SickScanPointCloudMsg), ctypes.c_uint64) # sick_scan_api.h: typedef void(* SickScanPointCloudMsgZeroCopyCallback)(SickScanApiHandle apiHandle, const SickScanPointCloudMsg* msg, uint64_t buffer_handle);
 SickScanImuMsgCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(SickScanImuMsg))                               # sick_scan_api.h: typedef void(* SickScanImuMsgCallback)(SickScanApiHandle apiHandle, const SickScanImuMsg* msg);
 SickScanLFErecMsgCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(SickScanLFErecMsg))                         # sick_scan_api.h: typedef void(* SickScanLFErecMsgCallback)(SickScanApiHandle apiHandle, const SickScanLFErecMsg* msg);
 SickScanLIDoutputstateMsgCallback = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(SickScanLIDoutputstateMsg))         # sick_scan_api.h: typedef void(* SickScanLIDoutputstateMsgCallback)(SickScanApiHandle apiHandle, const SickScanLIDoutputstateMsg* msg);
@@ -926,6 +927,21 @@ def SickScanApiLoadLibrary(paths, lib_filname):
     # sick_scan_api.h: int32_t SickScanApiDeregisterPolarPointCloudMsg(SickScanApiHandle apiHandle, SickScanPointCloudMsgCallback callback);
     sick_scan_library.SickScanApiDeregisterPolarPointCloudMsg.argtypes = [ctypes.c_void_p, SickScanPointCloudMsgCallback]
     sick_scan_library.SickScanApiDeregisterPolarPointCloudMsg.restype = ctypes.c_int
+    # sick_scan_api.h: int32_t SickScanApiRegisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+    sick_scan_library.SickScanApiRegisterCartesianPointCloudMsgZeroCopy.argtypes = [ctypes.c_void_p, SickScanPointCloudMsgZeroCopyCallback]
+    sick_scan_library.SickScanApiRegisterCartesianPointCloudMsgZeroCopy.restype = ctypes.c_int
+    # sick_scan_api.h: int32_t SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+    sick_scan_library.SickScanApiDeregisterCartesianPointCloudMsgZeroCopy.argtypes = [ctypes.c_void_p, SickScanPointCloudMsgZeroCopyCallback]
+    sick_scan_library.SickScanApiDeregisterCartesianPointCloudMsgZeroCopy.restype = ctypes.c_int
+    # sick_scan_api.h: int32_t SickScanApiRegisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+    sick_scan_library.SickScanApiRegisterPolarPointCloudMsgZeroCopy.argtypes = [ctypes.c_void_p, SickScanPointCloudMsgZeroCopyCallback]
+    sick_scan_library.SickScanApiRegisterPolarPointCloudMsgZeroCopy.restype = ctypes.c_int
+    # sick_scan_api.h: int32_t SickScanApiDeregisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+    sick_scan_library.SickScanApiDeregisterPolarPointCloudMsgZeroCopy.argtypes = [ctypes.c_void_p, SickScanPointCloudMsgZeroCopyCallback]
+    sick_scan_library.SickScanApiDeregisterPolarPointCloudMsgZeroCopy.restype = ctypes.c_int
+    # sick_scan_api.h: int32_t SickScanApiReleasePointCloudBuffer(SickScanApiHandle apiHandle, uint64_t buffer_handle);
+    sick_scan_library.SickScanApiReleasePointCloudBuffer.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    sick_scan_library.SickScanApiReleasePointCloudBuffer.restype = ctypes.c_int
     # sick_scan_api.h: int32_t SickScanApiRegisterImuMsg(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback);
     sick_scan_library.SickScanApiRegisterImuMsg.argtypes = [ctypes.c_void_p, SickScanImuMsgCallback]
     sick_scan_library.SickScanApiRegisterImuMsg.restype = ctypes.c_int
@@ -1103,6 +1119,40 @@ def SickScanApiDeregisterPolarPointCloudMsg(sick_scan_library, api_handle, point
     """ 
     return sick_scan_library.SickScanApiDeregisterPolarPointCloudMsg(api_handle, pointcloud_callback)
 
+def SickScanApiRegisterCartesianPointCloudMsgZeroCopy(sick_scan_library, api_handle, pointcloud_callback):
+    """ 
+    Register a zero-copy callback for cartesian PointCloud messages. The pointcloud data is borrowed from a ring of reference counted buffers
+    and can be mapped without copying, e.g. by numpy.ctypeslib.as_array(msg.contents.data.buffer, shape=(msg.contents.data.size,)).
+    The callback receives the buffer handle as third argument, each buffer handle has to be released by SickScanApiReleasePointCloudBuffer after use.
+    """ 
+    return sick_scan_library.SickScanApiRegisterCartesianPointCloudMsgZeroCopy(api_handle, pointcloud_callback)
+
+def SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(sick_scan_library, api_handle, pointcloud_callback):
+    """ 
+    Deregister a zero-copy callback for cartesian PointCloud messages
+    """ 
+    return sick_scan_library.SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(api_handle, pointcloud_callback)
+
+def SickScanApiRegisterPolarPointCloudMsgZeroCopy(sick_scan_library, api_handle, pointcloud_callback):
+    """ 
+    Register a zero-copy callback for polar PointCloud messages. The pointcloud data is borrowed from a ring of reference counted buffers
+    and can be mapped without copying. The callback receives the buffer handle as third argument, each buffer handle has to be released
+    by SickScanApiReleasePointCloudBuffer after use.
+    """ 
+    return sick_scan_library.SickScanApiRegisterPolarPointCloudMsgZeroCopy(api_handle, pointcloud_callback)
+
+def SickScanApiDeregisterPolarPointCloudMsgZeroCopy(sick_scan_library, api_handle, pointcloud_callback):
+    """ 
+    Deregister a zero-copy callback for polar PointCloud messages
+    """ 
+    return sick_scan_library.SickScanApiDeregisterPolarPointCloudMsgZeroCopy(api_handle, pointcloud_callback)
+
+def SickScanApiReleasePointCloudBuffer(sick_scan_library, api_handle, buffer_handle):
+    """ 
+    Release a pointcloud buffer received by a zero-copy callback (buffer_handle is the handle received by the callback). The pointcloud data must not be used after release.
+    """ 
+    return sick_scan_library.SickScanApiReleasePointCloudBuffer(api_handle, buffer_handle)
+
 def SickScanApiRegisterImuMsg(sick_scan_library, api_handle, imu_callback):
     """ 
     Register a callback for Imu messages
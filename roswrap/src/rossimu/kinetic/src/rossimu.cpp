@@ -3,6 +3,7 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <mutex>
 #include <sick_scan/sick_scan_common.h>
 
 
@@ -39,6 +40,7 @@ public:
 	// Some accessor functions for the class, itself
 	bool hasTag(std::string tag)
 	{
+		std::lock_guard<std::mutex> lock(mMapMutex);
 		std::map<std::string, std::string>::const_iterator   find = mMapString.find(tag);
 		if (find != mMapString.end())
 		{
@@ -53,6 +55,7 @@ public:
 	std::string getVal(std::string tag) const
 	{
 		std::string s;
+		std::lock_guard<std::mutex> lock(mMapMutex);
 		std::map<std::string, std::string>::const_iterator   find = mMapString.find(tag);
 		if (find != mMapString.end())
 		{
@@ -64,6 +67,7 @@ public:
 
 	void setVal(std::string tag, std::string val)
 	{
+		std::lock_guard<std::mutex> lock(mMapMutex);
 		mMapString[tag] = val;
 	}
 
@@ -96,10 +100,21 @@ private:
 	~MapStringSingleton() {}
 private: // private data for an instance of this class
 	std::map<std::string, std::string> mMapString;
+	mutable std::mutex mMapMutex; // parameter can be set and queried by multiple lidars running in one process
 };
 
 namespace roswrap
 {
+	// Returns the key of a parameter in the parameter map. Parameter of a node handle with a namespace other than "" or "~"
+	// are prefixed by this namespace, i.e. nodes created with different namespaces (e.g. multiple lidars in one process) have their own parameter.
+	static std::string paramKey(const NodeHandle* nh, const std::string& key)
+	{
+		const std::string& ns = nh->getNamespace();
+		if (ns.empty() || ns == "~")
+			return key;
+		return ns + "/" + key;
+	}
+
 	namespace console
 	{
 	ROSCPP_DECL   bool set_logger_level(const std::string& name, console::levels::Level level)
@@ -117,7 +132,7 @@ namespace roswrap
 		char szTmp[255];
 		MapStringSingleton& single = MapStringSingleton::Instance();
 		sprintf(szTmp, "%d", d);
-		single.setVal(key, szTmp);
+		single.setVal(paramKey(this, key), szTmp);
 	}
 
 	ROSCPP_DECL  void NodeHandle::setParam(const std::string& key, double d) const
@@ -125,7 +140,7 @@ namespace roswrap
 		char szTmp[255];
 		MapStringSingleton& single = MapStringSingleton::Instance();
 		sprintf(szTmp, "%le", d);
-		single.setVal(key, szTmp);
+		single.setVal(paramKey(this, key), szTmp);
 
 		//	00530   return param::set(resolveName(key), d);
 	}
@@ -133,20 +148,20 @@ namespace roswrap
 	ROSCPP_DECL  void NodeHandle::setParam(const std::string& key, bool b) const
 	{
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		single.setVal(key, b ? "true" : "false");
+		single.setVal(paramKey(this, key), b ? "true" : "false");
 	}
 	void NodeHandle::setParam(const std::string& key, const std::string& s) const
 	{
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		single.setVal(key, s);
+		single.setVal(paramKey(this, key), s);
 
 	}
 	bool NodeHandle::getParam(const std::string& key, std::string& s) const
 	{
 		bool fnd = true;
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		fnd = single.hasTag(key);
-		s = single.getVal(key);
+		fnd = single.hasTag(paramKey(this, key));
+		s = single.getVal(paramKey(this, key));
 		return(fnd);
 	}
 	bool NodeHandle::getParam(const std::string& key, double& d) const
@@ -155,10 +170,10 @@ namespace roswrap
 		double dummy = 0.0;
 		std::string s;
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		fnd = single.hasTag(key);
+		fnd = single.hasTag(paramKey(this, key));
 		if (fnd)
 		{
-			s = single.getVal(key);
+			s = single.getVal(paramKey(this, key));
 			sscanf(s.c_str(), "%le", &dummy);
 			d = dummy;
 		}
@@ -170,10 +185,10 @@ namespace roswrap
 		float dummy = 0.0;
 		std::string s;
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		fnd = single.hasTag(key);
+		fnd = single.hasTag(paramKey(this, key));
 		if (fnd)
 		{
-			s = single.getVal(key);
+			s = single.getVal(paramKey(this, key));
 			sscanf(s.c_str(), "%e", &dummy);
 			d = dummy;
 		}
@@ -185,10 +200,10 @@ namespace roswrap
 		int dummy = -1;
 		std::string s;
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		fnd = single.hasTag(key);
+		fnd = single.hasTag(paramKey(this, key));
 		if (fnd)
 		{
-			s = single.getVal(key);
+			s = single.getVal(paramKey(this, key));
 			sscanf(s.c_str(),  "%d", &dummy);
 			d = dummy;
 		}
@@ -200,10 +215,10 @@ namespace roswrap
 		bool dummy = false;
 		std::string s;
 		MapStringSingleton& single = MapStringSingleton::Instance();
-		fnd = single.hasTag(key);
+		fnd = single.hasTag(paramKey(this, key));
 		if (fnd)
 		{
-			s = single.getVal(key);
+			s = single.getVal(paramKey(this, key));
 			if (s.length() > 0)
 			{
 				if (s[0] == '1' || s[0] == 't' || s[0] == 'T')
@@ -331,7 +346,7 @@ ros::ServiceServer::~ServiceServer(void)
 
 }
 
-ros::NodeHandle::NodeHandle(class ros::NodeHandle const &)
+ros::NodeHandle::NodeHandle(class ros::NodeHandle const & rhs) : namespace_(rhs.namespace_), unresolved_namespace_(rhs.unresolved_namespace_)
 {
 }
 
@@ -409,7 +424,7 @@ bool ros::NodeHandle::hasParam(class std::basic_string<char, struct std::char_tr
 }
 
 
-ros::NodeHandle::NodeHandle(class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > const &, class std::map<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> >, class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> >, struct std::less<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > >, class std::allocator<struct std::pair<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > const, class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > > > > const &)
+ros::NodeHandle::NodeHandle(class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > const & ns, class std::map<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> >, class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> >, struct std::less<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > >, class std::allocator<struct std::pair<class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > const, class std::basic_string<char, struct std::char_traits<char>, class std::allocator<char> > > > > const &) : namespace_(ns), unresolved_namespace_(ns)
 {
 }
 
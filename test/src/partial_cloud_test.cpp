@@ -0,0 +1,190 @@
+/*
+ * @brief partial_cloud_test checks the slicing of partial pointclouds in cloud_output_mode 2 (SickScanCommon::slicePartialCloud).
+ * Pointclouds with 4 accumulated layers are filled with points encoding their row and column. All sectors of default and
+ * non-default sector configurations (cloud_output_sector_size, cloud_output_sector_count) are sliced into reused messages and
+ * compared to the expected shots, i.e. shots [j * size * count + sector * size, + size) of layer j, clamped to the cloud width.
+ * Each sector is sliced into a new message, too, so that writes behind the sliced points are not hidden by spare capacity.
+ * The sector configuration clamped by SickScanCommon::clampCloudOutputSectors is checked, too. The test target is built with
+ * AddressSanitizer (gcc and clang), i.e. reads or writes outside of the cloud buffers abort the test. The test returns 0 if all
+ * checks passed.
+ *
+ * Usage: partial_cloud_test
+ *
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sick_scan/sick_scan_common.h>
+
+/*
+ * Returns a pointcloud with 4 float channels (x, y, z, intensity), x := row and y := column of each point
+ */
+static ros_sensor_msgs::PointCloud2 createLayerCloud(int width, int height)
+{
+    ros_sensor_msgs::PointCloud2 cloud;
+    cloud.width = width;
+    cloud.height = height;
+    cloud.point_step = 4 * sizeof(float);
+    cloud.row_step = cloud.point_step * cloud.width;
+    cloud.data.resize(cloud.row_step * cloud.height);
+    for (int row = 0; row < height; row++)
+    {
+        for (int col = 0; col < width; col++)
+        {
+            float point[4] = { (float)row, (float)col, 0.0f, 1.0f };
+            memcpy(&cloud.data[(row * width + col) * cloud.point_step], point, sizeof(point));
+        }
+    }
+    return cloud;
+}
+
+/*
+ * Slices all sectors of a sector configuration into the reused messages partial_clouds and compares them to the expected shots
+ */
+static bool checkSectors(const ros_sensor_msgs::PointCloud2& cloud, const int layer_seq[4], int layer_cnt, int sector_size, int sector_count, std::vector<ros_sensor_msgs::PointCloud2>& partial_clouds)
+{
+    partial_clouds.resize(sector_count);
+    for (int sector_idx = 0; sector_idx < sector_count; sector_idx++)
+    {
+        ros_sensor_msgs::PointCloud2& partial_cloud = partial_clouds[sector_idx];
+        sick_scan_xd::SickScanCommon::slicePartialCloud(cloud, layer_seq, layer_cnt, sector_size, sector_count, sector_idx, partial_cloud);
+        ros_sensor_msgs::PointCloud2 new_partial_cloud; // new message without spare capacity, i.e. AddressSanitizer detects any write behind the sliced points
+        sick_scan_xd::SickScanCommon::slicePartialCloud(cloud, layer_seq, layer_cnt, sector_size, sector_count, sector_idx, new_partial_cloud);
+        std::vector<std::pair<int,int>> expected; // expected (row, column) of all points
+        for (int j = 0; j < 4; j++)
+        {
+            int row = 1 + layer_seq[(j + layer_cnt) % 4];
+            for (int k = 0, col = j * sector_size * sector_count + sector_idx * sector_size; k < sector_size && col < (int)cloud.width; k++, col++)
+            {
+                if (row >= 0 && row < (int)cloud.height)
+                    expected.push_back(std::make_pair(row, col));
+            }
+        }
+        bool success = (partial_cloud.width == expected.size() && partial_cloud.point_step == cloud.point_step
+            && partial_cloud.row_step == partial_cloud.width * partial_cloud.point_step && partial_cloud.data.size() == partial_cloud.row_step
+            && new_partial_cloud.width == partial_cloud.width && new_partial_cloud.data == partial_cloud.data);
+        for (size_t n = 0; success && n < expected.size(); n++)
+        {
+            float point[4];
+            memcpy(point, &partial_cloud.data[n * partial_cloud.point_step], sizeof(point));
+            success = (point[0] == (float)expected[n].first && point[1] == (float)expected[n].second);
+        }
+        if (!success)
+        {
+            ROS_ERROR_STREAM("## ERROR partial_cloud_test: cloud " << cloud.height << " x " << cloud.width << ", sector_size=" << sector_size << ", sector_count=" << sector_count
+                << ", sector " << sector_idx << ": " << partial_cloud.width << " points sliced, " << expected.size() << " points expected");
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Checks the sector configuration clamped to the number of shots per scan
+ */
+static bool checkClamp(int num_shots, int sector_size, int sector_count, int expected_size, int expected_count)
+{
+    bool expected_unchanged = (sector_size == expected_size && sector_count == expected_count);
+    bool unchanged = sick_scan_xd::SickScanCommon::clampCloudOutputSectors(num_shots, sector_size, sector_count);
+    if (unchanged != expected_unchanged || sector_size != expected_size || sector_count != expected_count)
+    {
+        ROS_ERROR_STREAM("## ERROR partial_cloud_test: clampCloudOutputSectors(" << num_shots << ") returned sector_size=" << sector_size << ", sector_count=" << sector_count
+            << ", expected sector_size=" << expected_size << ", sector_count=" << expected_count);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool success = true;
+    int num_configs = 0;
+
+    // Sector configurations clamped to the shots per scan
+    success = checkClamp(1101, 40, 9, 40, 9) && success;   // MRS1104 default
+    success = checkClamp(1101, 40, 8, 40, 8) && success;
+    success = checkClamp(1101, 100, 20, 100, 11) && success;
+    success = checkClamp(241, 40, 9, 40, 6) && success;
+    success = checkClamp(241, 500, 2, 241, 1) && success;
+    success = checkClamp(1101, 0, -3, 1, 1) && success;
+    success = checkClamp(0, 40, 9, 40, 9) && success;      // number of shots unknown
+
+    // Default and non-default sector configurations, including configurations not clamped to the cloud width
+    const int widths[] = { 1101, 367, 1100, 241, 40, 1 };
+    const int sector_configs[][2] = { { 40, 9 }, { 40, 8 }, { 40, 1 }, { 1, 1 }, { 7, 13 }, { 100, 11 }, { 64, 4 }, { 1101, 1 }, { 300, 4 }, { 500, 3 } };
+    const int layer_seqs[][4] = { { 0, 1, 2, 3 }, { 2, 3, 0, 1 }, { -1, 0, 1, 2 }, { 3, 3, 3, 3 }, { -2, 4, 7, 0 } }; // rows 1 + layer_seq, out of range rows are skipped
+    std::vector<ros_sensor_msgs::PointCloud2> partial_clouds; // reused for all configurations like SickScanCommon::m_partial_clouds
+    for (int width : widths)
+    {
+        ros_sensor_msgs::PointCloud2 cloud = createLayerCloud(width, 5);
+        for (const auto& sector_config : sector_configs)
+        {
+            for (const auto& layer_seq : layer_seqs)
+            {
+                for (int layer_cnt = 4; layer_cnt < 8; layer_cnt++)
+                {
+                    success = checkSectors(cloud, layer_seq, layer_cnt, sector_config[0], sector_config[1], partial_clouds) && success;
+                    num_configs++;
+                }
+            }
+        }
+    }
+
+    if (success)
+        ROS_INFO_STREAM("partial_cloud_test passed (" << num_configs << " configurations)");
+    else
+        ROS_ERROR_STREAM("## ERROR partial_cloud_test failed");
+    return success ? 0 : 1;
+}
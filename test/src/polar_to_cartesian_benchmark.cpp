@@ -0,0 +1,211 @@
+/*
+ * @brief polar_to_cartesian_benchmark measures the polar to cartesian conversion of scan points in points per second.
+ * It compares the previous per point conversion (sin and cos for each point, transform applied to each point) with
+ * the vectorized PolarToCartesian kernel using precomputed resp. cached sin/cos tables.
+ *
+ * Usage example:
+ *
+ * polar_to_cartesian_benchmark -iterations=10000 -points=1141 -echos=3 -transform=0.1,0.2,0.3,0.01,0.02,0.03
+ *
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <chrono>
+#include <iomanip>
+#include <sick_scan/sick_polar_to_cartesian.h>
+
+typedef std::chrono::high_resolution_clock benchmark_clock;
+
+/*
+ * Returns the time in seconds between two timestamps
+ */
+static double seconds(const benchmark_clock::time_point& start, const benchmark_clock::time_point& end)
+{
+    return 1.0e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/*
+ * main runs polar_to_cartesian_benchmark:
+ * - generate a scan with a given number of points and echos (azimuth grid with constant increment, constant elevation),
+ * - convert by sin and cos for each point plus SickCloudTransform::applyTransform for each point (previous implementation),
+ * - convert by PolarToCartesian::convert with sin/cos tables computed once for each scan resp. cached by PolarToCartesianTableCache,
+ * - compare the results and report the number of converted points per second.
+ */
+int main(int argc, char** argv)
+{
+    int iterations = 10000, num_points = 1141, num_echos = 3;
+    std::string add_transform_xyz_rpy = "0,0,0,0,0,0";
+    for (int n = 1; n < argc; n++)
+    {
+        std::string arg(argv[n]);
+        if (arg.find("-iterations=") == 0)
+            iterations = std::max(1, std::stoi(arg.substr(12)));
+        else if (arg.find("-points=") == 0)
+            num_points = std::max(1, std::stoi(arg.substr(8)));
+        else if (arg.find("-echos=") == 0)
+            num_echos = std::max(1, std::stoi(arg.substr(7)));
+        else if (arg.find("-transform=") == 0)
+            add_transform_xyz_rpy = arg.substr(11);
+    }
+    sick_scan_xd::SickCloudTransform transform(0, add_transform_xyz_rpy, true, false);
+    sick_scan_xd::SickRangeFilter range_filter(0.05f, 100.0f, sick_scan_xd::RANGE_FILTER_DROP);
+    float angle_min = (float)(-95.0 * M_PI / 180.0), angle_increment = (float)(190.0 * M_PI / 180.0 / num_points);
+    float elevation = (float)(-2.5 * M_PI / 180.0);
+    size_t num_values = (size_t)num_points * num_echos;
+    std::vector<float> range(num_values);
+    for (size_t n = 0; n < num_values; n++)
+        range[n] = 0.01f + 0.001f * (n % 100000); // includes a few points dropped by the range filter
+    std::vector<float> x0(num_values), y0(num_values), z0(num_values), x1(num_values), y1(num_values), z1(num_values);
+    std::vector<float> range_echo(num_points), cos_azimuth(num_points), sin_azimuth(num_points);
+    std::vector<uint8_t> point_valid(num_values);
+    float cos_elevation = std::cos(elevation), sin_elevation = std::sin(elevation);
+
+    // Previous implementation: sin and cos for each point, transform applied for each point
+    benchmark_clock::time_point start_time = benchmark_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        for (int echo_idx = 0; echo_idx < num_echos; echo_idx++)
+        {
+            float azimuth = angle_min;
+            for (int point_idx = 0; point_idx < num_points; point_idx++, azimuth += angle_increment)
+            {
+                size_t n = (size_t)echo_idx * num_points + point_idx;
+                float range_meter = range[n];
+                bool range_modified = false;
+                if (range_filter.apply(range_meter, range_modified))
+                {
+                    float range_cos = range_meter * std::cos(elevation);
+                    float phi = azimuth + transform.azimuthOffset();
+                    x0[n] = range_cos * std::cos(phi);
+                    y0[n] = range_cos * std::sin(phi);
+                    z0[n] = range_meter * std::sin(elevation);
+                    transform.applyTransform(x0[n], y0[n], z0[n]);
+                }
+            }
+        }
+    }
+    double seconds_per_point = seconds(start_time, benchmark_clock::now());
+
+    // PolarToCartesian kernel, sin/cos tables computed once for each scan
+    start_time = benchmark_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        float azimuth = angle_min;
+        for (int point_idx = 0; point_idx < num_points; point_idx++, azimuth += angle_increment)
+        {
+            cos_azimuth[point_idx] = std::cos(azimuth + transform.azimuthOffset());
+            sin_azimuth[point_idx] = std::sin(azimuth + transform.azimuthOffset());
+        }
+        for (int echo_idx = 0; echo_idx < num_echos; echo_idx++)
+        {
+            size_t n = (size_t)echo_idx * num_points;
+            std::copy(range.begin() + n, range.begin() + n + num_points, range_echo.begin());
+            sick_scan_xd::PolarToCartesian::convert(num_points, range_echo.data(), range_filter, point_valid.data() + n, cos_azimuth.data(), sin_azimuth.data(),
+                &cos_elevation, &sin_elevation, 0, 1.0f, &transform, x1.data() + n, y1.data() + n, z1.data() + n);
+        }
+    }
+    double seconds_kernel = seconds(start_time, benchmark_clock::now());
+
+    // PolarToCartesian kernel, sin/cos tables cached by PolarToCartesianTableCache (i.e. computed once for identical scan configurations)
+    sick_scan_xd::PolarToCartesianTableCache table_cache;
+    std::fill(x1.begin(), x1.end(), 0.0f);
+    std::fill(y1.begin(), y1.end(), 0.0f);
+    std::fill(z1.begin(), z1.end(), 0.0f);
+    start_time = benchmark_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        bool table_valid = false;
+        sick_scan_xd::PolarToCartesianTable& table = table_cache.lookup(angle_min, angle_increment, num_points, 1.0f, transform.azimuthOffset(), &elevation, 1, 0, table_valid);
+        if (!table_valid)
+        {
+            float azimuth = angle_min;
+            for (int point_idx = 0; point_idx < num_points; point_idx++, azimuth += angle_increment)
+            {
+                table.azimuth[point_idx] = azimuth;
+                table.cos_azimuth[point_idx] = std::cos(azimuth + transform.azimuthOffset());
+                table.sin_azimuth[point_idx] = std::sin(azimuth + transform.azimuthOffset());
+            }
+            table.elevation[0] = elevation;
+            table.cos_elevation[0] = cos_elevation;
+            table.sin_elevation[0] = sin_elevation;
+        }
+        for (int echo_idx = 0; echo_idx < num_echos; echo_idx++)
+        {
+            size_t n = (size_t)echo_idx * num_points;
+            std::copy(range.begin() + n, range.begin() + n + num_points, range_echo.begin());
+            sick_scan_xd::PolarToCartesian::convert(num_points, range_echo.data(), range_filter, point_valid.data() + n, table.cos_azimuth.data(), table.sin_azimuth.data(),
+                table.cos_elevation.data(), table.sin_elevation.data(), table.elevation_stride, 1.0f, &transform, x1.data() + n, y1.data() + n, z1.data() + n);
+        }
+    }
+    double seconds_kernel_cached = seconds(start_time, benchmark_clock::now());
+
+    // Compare results
+    double max_deviation = 0;
+    for (size_t n = 0; n < num_values; n++)
+    {
+        if (point_valid[n])
+        {
+            max_deviation = std::max(max_deviation, (double)std::fabs(x0[n] - x1[n]));
+            max_deviation = std::max(max_deviation, (double)std::fabs(y0[n] - y1[n]));
+            max_deviation = std::max(max_deviation, (double)std::fabs(z0[n] - z1[n]));
+        }
+    }
+    bool success = (max_deviation < 1.0e-4);
+    double num_points_total = (double)iterations * num_values;
+    ROS_INFO_STREAM("polar_to_cartesian_benchmark: " << iterations << " x " << num_points << " points x " << num_echos << " echos, simd: " << sick_scan_xd::PolarToCartesian::simdInstructionSet()
+        << ", transform: (" << add_transform_xyz_rpy << ")");
+    ROS_INFO_STREAM("polar_to_cartesian_benchmark: per point conversion:  " << std::fixed << std::setprecision(1) << (1.0e-6 * num_points_total / std::max(seconds_per_point, 1.0e-9)) << " million points/sec");
+    ROS_INFO_STREAM("polar_to_cartesian_benchmark: kernel, tables/scan:  " << std::fixed << std::setprecision(1) << (1.0e-6 * num_points_total / std::max(seconds_kernel, 1.0e-9)) << " million points/sec");
+    ROS_INFO_STREAM("polar_to_cartesian_benchmark: kernel, tables cached: " << std::fixed << std::setprecision(1) << (1.0e-6 * num_points_total / std::max(seconds_kernel_cached, 1.0e-9)) << " million points/sec");
+    ROS_INFO_STREAM("polar_to_cartesian_benchmark: max deviation " << std::scientific << max_deviation << " meter, " << (success ? "passed" : "failed"));
+    return success ? 0 : 1;
+}
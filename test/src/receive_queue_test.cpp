@@ -0,0 +1,184 @@
+/*
+ * @brief receive_queue_test checks the keyword classification of the receive queue (template_queue.h).
+ * Datagrams with keywords sharing a prefix (e.g. "LMDscandata", "LMDscandatamon" and "LMDscandatacfg") are pushed
+ * in CoLa-A and CoLa-B framing. A request for the loopOnce keywords must return scan data only, i.e. a "sRA LMDscandatacfg"
+ * reply must stay in the queue until it is requested by its own keyword. The test returns 0 if all checks passed.
+ *
+ * Usage: receive_queue_test
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <string>
+#include <vector>
+#include "sick_scan/sick_ros_wrapper.h"
+#include "sick_scan/template_queue.h"
+
+/*
+ * Datagram of the receive queue, equivalent to DatagramWithTimeStamp without timestamp
+ */
+class QueueTestDatagram
+{
+public:
+    QueueTestDatagram(const std::vector<unsigned char>& datagram_ = std::vector<unsigned char>()) : datagram(datagram_) {}
+    std::vector<unsigned char>& data(void) { return datagram; }
+    std::vector<unsigned char> datagram;
+};
+
+/*
+ * Returns a CoLa-A datagram "<STX>command<ETX>"
+ */
+static QueueTestDatagram colaA(const std::string& command)
+{
+    std::string datagram = "\x02" + command + "\x03";
+    return QueueTestDatagram(std::vector<unsigned char>(datagram.begin(), datagram.end()));
+}
+
+/*
+ * Returns a CoLa-B datagram "0x02020202 + { 4 byte payload length } + command + { binary payload }"
+ */
+static QueueTestDatagram colaB(const std::string& command, const std::vector<unsigned char>& payload)
+{
+    std::vector<unsigned char> datagram = { 0x02, 0x02, 0x02, 0x02 };
+    uint32_t length = (uint32_t)(command.size() + payload.size());
+    for (int n = 3; n >= 0; n--)
+        datagram.push_back((unsigned char)((length >> (8 * n)) & 0xFF));
+    datagram.insert(datagram.end(), command.begin(), command.end());
+    datagram.insert(datagram.end(), payload.begin(), payload.end());
+    return QueueTestDatagram(datagram);
+}
+
+/*
+ * Waits for a datagram with one of the given keywords and checks that it equals the expected datagram (or that no datagram is available, if expected is empty)
+ */
+static bool checkPop(Queue<QueueTestDatagram>& queue, const std::vector<std::string>& keywords, const QueueTestDatagram& expected, const std::string& info)
+{
+    bool available = queue.waitForIncomingObject(10, keywords);
+    bool success = false;
+    if (expected.datagram.empty())
+        success = !available;
+    else if (available)
+        success = (queue.pop(keywords).datagram == expected.datagram);
+    if (!success)
+        ROS_ERROR_STREAM("## ERROR receive_queue_test: " << info << " failed");
+    else
+        ROS_INFO_STREAM("receive_queue_test: " << info << " passed");
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<std::string> loop_keywords = {  // keyword list of datagrams handled in SickScanCommon::loopOnce
+        "LMDscandata", "LMDscandatamon", "mNPOSGetData",
+        "LMDradardata", "InertialMeasurementUnit", "LIDoutputstate", "LIDinputstate", "LFErec" };
+    const std::vector<unsigned char> binary_payload = { 0x00, 0x20, 0x03, 0x4C, 0x4D, 0x44, 0x02 }; // binary data containing space, ETX and STX
+    bool success = true;
+
+    // CoLa-A: sopas replies with keywords starting with "LMDscandata" are not scan data
+    {
+        Queue<QueueTestDatagram> queue;
+        QueueTestDatagram cfg_write_reply = colaA("sWA LMDscandatacfg");
+        QueueTestDatagram cfg_read_reply = colaA("sRA LMDscandatacfg 01 00 1 0 0 0 00 0 0 0 1 1");
+        QueueTestDatagram scandata = colaA("sSN LMDscandata 1 1 F 0 0");
+        QueueTestDatagram scandatamon = colaA("sSN LMDscandatamon 1");
+        queue.push(cfg_write_reply);
+        queue.push(cfg_read_reply);
+        success = checkPop(queue, loop_keywords, QueueTestDatagram(), "CoLa-A: no scan data returned for LMDscandatacfg replies") && success;
+        queue.push(scandata);
+        queue.push(scandatamon);
+        success = checkPop(queue, { "LMDscandatamon" }, scandatamon, "CoLa-A: LMDscandatamon returned for \"LMDscandatamon\"") && success;
+        success = checkPop(queue, loop_keywords, scandata, "CoLa-A: LMDscandata returned for loopOnce keywords") && success;
+        success = checkPop(queue, { "LMDscandatacfg" }, cfg_write_reply, "CoLa-A: sWA LMDscandatacfg returned for \"LMDscandatacfg\"") && success;
+        success = checkPop(queue, { "LMDscandatacfg" }, cfg_read_reply, "CoLa-A: sRA LMDscandatacfg returned for \"LMDscandatacfg\"") && success;
+        success = checkPop(queue, {}, QueueTestDatagram(), "CoLa-A: queue empty") && success;
+    }
+
+    // CoLa-A: "LMDscandata" matches "LMDscandata" and "LMDscandatamon" in order of arrival, "LMDscandatamon" matches "LMDscandatamon" only
+    {
+        Queue<QueueTestDatagram> queue;
+        QueueTestDatagram scandatamon = colaA("sSN LMDscandatamon 1");
+        QueueTestDatagram scandata = colaA("sSN LMDscandata 1 1 F 0 0");
+        queue.push(scandatamon);
+        queue.push(scandata);
+        success = checkPop(queue, { "LMDscandata" }, scandatamon, "CoLa-A: LMDscandatamon returned for \"LMDscandata\"") && success;
+        success = checkPop(queue, { "LMDscandatamon" }, QueueTestDatagram(), "CoLa-A: no LMDscandata returned for \"LMDscandatamon\"") && success;
+        success = checkPop(queue, { "LMDscandata" }, scandata, "CoLa-A: LMDscandata returned for \"LMDscandata\"") && success;
+    }
+
+    // CoLa-B: keyword token terminated by a space followed by binary data, keyword token terminated by the end of the datagram
+    {
+        Queue<QueueTestDatagram> queue;
+        QueueTestDatagram cfg_read_reply = colaB("sRA LMDscandatacfg ", binary_payload);
+        QueueTestDatagram scandata = colaB("sSN LMDscandata ", binary_payload);
+        QueueTestDatagram outputstate = colaB("sSN LIDoutputstate", {});
+        queue.push(cfg_read_reply);
+        queue.push(scandata);
+        queue.push(outputstate);
+        success = checkPop(queue, loop_keywords, scandata, "CoLa-B: LMDscandata returned for loopOnce keywords") && success;
+        success = checkPop(queue, loop_keywords, outputstate, "CoLa-B: LIDoutputstate returned for loopOnce keywords") && success;
+        success = checkPop(queue, loop_keywords, QueueTestDatagram(), "CoLa-B: no scan data returned for LMDscandatacfg reply") && success;
+        success = checkPop(queue, { "LMDscandatacfg" }, cfg_read_reply, "CoLa-B: sRA LMDscandatacfg returned for \"LMDscandatacfg\"") && success;
+    }
+
+    // sFA error replies are returned on any request
+    {
+        Queue<QueueTestDatagram> queue;
+        QueueTestDatagram error_reply = colaA("sFA 5");
+        queue.push(error_reply);
+        success = checkPop(queue, { "LMDscandatacfg" }, error_reply, "CoLa-A: sFA returned for \"LMDscandatacfg\"") && success;
+    }
+
+    if (success)
+        ROS_INFO_STREAM("receive_queue_test passed");
+    else
+        ROS_ERROR_STREAM("## ERROR receive_queue_test failed");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/*
+ * @brief scan_decode_allocation_test counts the memory allocations of the LMDscandata decoding in SickScanCommon::loopOnce.
+ * It decodes synthetic binary LMDscandata telegrams (multiple echos with ranges and intensities) by parseCommonBinaryResultTelegram,
+ * splits the echos into LaserScan messages and converts them to cartesian points, once with the previous implementation
+ * (temporary vectors for each telegram) and once with the reusable ScanDecodeBuffer. The ScanDecodeBuffer path calls the
+ * same functions as loopOnce (ScanDecodeBuffer::beginTelegram, takeEchos, sliceEcho, resizeEchoPoints and convertEcho).
+ * After the first telegrams, the ScanDecodeBuffer path must not allocate any memory. The ranges, intensities and cartesian
+ * points of all echos are compared to the values encoded in the telegram for each telegram.
+ *
+ * Usage example:
+ *
+ * scan_decode_allocation_test -iterations=1000 -points=541 -echos=3
+ *
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sick_scan/sick_scan_common.h>
+#include <sick_scan/sick_lmd_scandata_parser.h>
+
+/*
+ * Counts all memory allocations while s_count_allocations is set
+ */
+static std::atomic<bool> s_count_allocations(false);
+static std::atomic<size_t> s_allocation_cnt(0);
+
+void* operator new(std::size_t size)
+{
+    if (s_count_allocations)
+        s_allocation_cnt++;
+    void* ptr = std::malloc(size > 0 ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/*
+ * Appends a value in big endian byte order
+ */
+template<typename T> static void appendBigEndian(std::vector<uint8_t>& telegram, T value)
+{
+    uint8_t bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    for (int n = (int)sizeof(T) - 1; n >= 0; n--)
+        telegram.push_back(bytes[n]);
+}
+
+/*
+ * Appends a 16 bit channel (DIST or RSSI) with 21 byte channel header and num_points values
+ */
+static void appendChannel(std::vector<uint8_t>& telegram, const char* name, float scale_factor, int num_points, int value_offset)
+{
+    telegram.insert(telegram.end(), name, name + 5);
+    appendBigEndian<float>(telegram, scale_factor);
+    appendBigEndian<float>(telegram, 0.0f);                // scale factor offset
+    appendBigEndian<int32_t>(telegram, -50000);            // start angle: -5 deg
+    appendBigEndian<uint16_t>(telegram, 3333);             // angular step: 0.3333 deg
+    appendBigEndian<uint16_t>(telegram, (uint16_t)num_points);
+    for (int n = 0; n < num_points; n++)
+        appendBigEndian<uint16_t>(telegram, (uint16_t)(value_offset + n));
+}
+
+/*
+ * Creates a binary LMDscandata telegram with num_echos DIST and RSSI channels
+ */
+static std::vector<uint8_t> createTelegram(int num_points, int num_echos)
+{
+    std::vector<uint8_t> telegram(64, 0);
+    memset(telegram.data(), 0x02, 4);                      // 4 byte STX
+    memcpy(telegram.data() + 8, "sSN LMDscandata ", 16);
+    std::vector<uint8_t> field;
+    appendBigEndian<int32_t>(field, 5000);                 // byte 52: scan frequency 50 Hz
+    appendBigEndian<int32_t>(field, 270);                  // byte 56: measurement frequency 27 kHz
+    appendBigEndian<uint16_t>(field, 0);                   // byte 60: no encoder
+    appendBigEndian<uint16_t>(field, (uint16_t)(2 * num_echos)); // byte 62: number of 16 bit channels
+    std::copy(field.begin(), field.end(), telegram.begin() + 52);
+    for (int echo_idx = 0; echo_idx < num_echos; echo_idx++)
+        appendChannel(telegram, (std::string("DIST") + std::to_string(echo_idx + 1)).c_str(), 1.0f, num_points, 1000 + 100 * echo_idx);
+    for (int echo_idx = 0; echo_idx < num_echos; echo_idx++)
+        appendChannel(telegram, (std::string("RSSI") + std::to_string(echo_idx + 1)).c_str(), 1.0f, num_points, 10 * echo_idx);
+    appendBigEndian<uint16_t>(telegram, 0);                // no 8 bit channels
+    telegram.resize(telegram.size() + 64, 0);              // position, name, comment, time, event info (not evaluated) and crc
+    uint32_t length = (uint32_t)(telegram.size() - 9);
+    for (int n = 0; n < 4; n++)
+        telegram[4 + n] = (uint8_t)((length >> (8 * (3 - n))) & 0xFF);
+    return telegram;
+}
+
+/*
+ * Fills the azimuth table for a LaserScan message
+ */
+static void fillTable(sick_scan_xd::PolarToCartesianTable& table, const ros_sensor_msgs::LaserScan& msg, size_t num_points)
+{
+    float azimuth = msg.angle_min;
+    for (size_t n = 0; n < num_points; n++, azimuth += msg.angle_increment)
+    {
+        table.azimuth[n] = azimuth;
+        table.cos_azimuth[n] = std::cos(azimuth);
+        table.sin_azimuth[n] = std::sin(azimuth);
+    }
+    table.elevation[0] = 0;
+    table.cos_elevation[0] = 1;
+    table.sin_elevation[0] = 0;
+}
+
+/*
+ * Returns true, if ranges and intensities of a LaserScan message are the complete echo echo_idx of the telegram created by createTelegram
+ */
+static bool checkEchoSlice(const ros_sensor_msgs::LaserScan& msg, int echo_idx, int num_points)
+{
+    if ((int)msg.ranges.size() != num_points || (int)msg.intensities.size() != num_points)
+        return false;
+    for (int n = 0; n < num_points; n++)
+    {
+        if (msg.ranges[n] != (float)(1000 + 100 * echo_idx + n) * 0.001f || msg.intensities[n] != (float)(10 * echo_idx + n))
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Returns true, if the ranges and cartesian points of an echo are the complete echo echo_idx of the telegram created by createTelegram
+ */
+static bool checkEchoPoints(const float* range, const uint8_t* valid, const float* x, const float* y, const float* z,
+    const sick_scan_xd::PolarToCartesianTable& table, int echo_idx, int num_points)
+{
+    for (int n = 0; n < num_points; n++)
+    {
+        float range_expected = (float)(1000 + 100 * echo_idx + n) * 0.001f;
+        if (range[n] != range_expected || !valid[n]
+        || std::fabs(x[n] - range_expected * table.cos_azimuth[n]) > 1.0e-5f || std::fabs(y[n] - range_expected * table.sin_azimuth[n]) > 1.0e-5f || std::fabs(z[n]) > 1.0e-5f)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * main runs scan_decode_allocation_test:
+ * - decode telegrams with temporary vectors for each telegram (previous implementation of SickScanCommon::loopOnce),
+ * - decode telegrams with a ScanDecodeBuffer,
+ * - count the allocations per telegram after some warm up telegrams and check the decoded echos of each telegram.
+ */
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "scan_decode_allocation_test");
+    int iterations = 1000, num_points = 541, num_echos = 3, warmup = 3;
+    for (int n = 1; n < argc; n++)
+    {
+        std::string arg(argv[n]);
+        if (arg.find("-iterations=") == 0)
+            iterations = std::max(1, std::stoi(arg.substr(12)));
+        else if (arg.find("-points=") == 0)
+            num_points = std::max(1, std::stoi(arg.substr(8)));
+        else if (arg.find("-echos=") == 0)
+            num_echos = std::max(1, std::min(5, std::stoi(arg.substr(7))));
+    }
+    sick_scan_xd::SickGenericParser parser(SICK_SCANNER_LMS_5XX_NAME);
+    sick_scan_xd::SickRangeFilter range_filter(0.05f, 100.0f, sick_scan_xd::RANGE_FILTER_DEACTIVATED);
+    sick_scan_xd::PolarToCartesianTableCache table_cache;
+    std::vector<uint8_t> telegram = createTelegram(num_points, num_echos);
+    std::vector<uint8_t> receive_buffer(telegram.size());
+    sick_scan_msg::Encoder encoder_msg;
+    bool success = true;
+    size_t echo_errors[2] = { 0, 0 };
+    size_t allocations[2] = { 0, 0 };
+
+    for (int mode = 0; mode < 2; mode++) // mode 0: previous implementation, mode 1: ScanDecodeBuffer
+    {
+        sick_scan_xd::ScanDecodeBuffer decode_buffer;
+        for (int iteration = 0; iteration < warmup + iterations; iteration++)
+        {
+            s_count_allocations = (iteration >= warmup);
+            memcpy(receive_buffer.data(), telegram.data(), telegram.size()); // the parser swaps the byte order in place
+            short elev_angle_x200 = 0;
+            double elevation_angle_rad = 0;
+            rosTime recv_timestamp(iteration, 0);
+            bool fire_encoder = false;
+            int echos_decoded = 0;
+            if (mode == 0)
+            {
+                ros_sensor_msgs::LaserScan msg;
+                std::vector<float> vang_vec;
+                std::vector<unsigned char> receive_buffer_vec(receive_buffer.begin(), receive_buffer.end());
+                success = sick_scan_xd::parseCommonBinaryResultTelegram(receive_buffer.data(), (int)receive_buffer.size(), elev_angle_x200, 1.0 / 200.0, elevation_angle_rad, recv_timestamp,
+                    false, true, &parser, fire_encoder, encoder_msg, echos_decoded, vang_vec, msg) && success;
+                std::vector<float> range_tmp = msg.ranges;
+                std::vector<float> intensity_tmp = msg.intensities;
+                size_t echo_values = range_tmp.size() / std::max(1, echos_decoded);
+                for (int echo_idx = 0; echo_idx < echos_decoded; echo_idx++)
+                {
+                    msg.ranges = std::vector<float>(range_tmp.begin() + echo_idx * echo_values, range_tmp.begin() + (echo_idx + 1) * echo_values);
+                    msg.intensities = std::vector<float>(intensity_tmp.begin() + echo_idx * echo_values, intensity_tmp.begin() + (echo_idx + 1) * echo_values);
+                    if (!checkEchoSlice(msg, echo_idx, num_points))
+                        echo_errors[mode]++;
+                }
+                bool table_valid = false;
+                float elevation = 0;
+                sick_scan_xd::PolarToCartesianTable& table = table_cache.lookup(msg.angle_min, msg.angle_increment, echo_values, 1.0f, 0.0f, &elevation, 1, 0, table_valid);
+                if (!table_valid)
+                    fillTable(table, msg, echo_values);
+                std::vector<float> range_echo(echo_values), x_echo(echo_values), y_echo(echo_values), z_echo(echo_values);
+                std::vector<uint8_t> range_echo_valid(echo_values);
+                for (int echo_idx = 0; echo_idx < echos_decoded; echo_idx++)
+                {
+                    std::copy(range_tmp.begin() + echo_idx * echo_values, range_tmp.begin() + (echo_idx + 1) * echo_values, range_echo.begin());
+                    sick_scan_xd::PolarToCartesian::convert(echo_values, range_echo.data(), range_filter, range_echo_valid.data(), table.cos_azimuth.data(), table.sin_azimuth.data(),
+                        table.cos_elevation.data(), table.sin_elevation.data(), table.elevation_stride, 1.0f, 0, x_echo.data(), y_echo.data(), z_echo.data());
+                    if (!checkEchoPoints(range_echo.data(), range_echo_valid.data(), x_echo.data(), y_echo.data(), z_echo.data(), table, echo_idx, num_points))
+                        echo_errors[mode]++;
+                }
+            }
+            else
+            {
+                ros_sensor_msgs::LaserScan& msg = decode_buffer.beginTelegram();
+                success = sick_scan_xd::parseCommonBinaryResultTelegram(receive_buffer.data(), (int)receive_buffer.size(), elev_angle_x200, 1.0 / 200.0, elevation_angle_rad, recv_timestamp,
+                    false, true, &parser, fire_encoder, encoder_msg, echos_decoded, decode_buffer.vang, msg) && success;
+                decode_buffer.takeEchos(msg);
+                size_t echo_values = decode_buffer.ranges_all_echos.size() / std::max(1, echos_decoded);
+                for (int echo_idx = 0; echo_idx < echos_decoded; echo_idx++)
+                {
+                    decode_buffer.sliceEcho(echo_idx, echo_values, msg);
+                    if (!checkEchoSlice(msg, echo_idx, num_points))
+                        echo_errors[mode]++;
+                }
+                bool table_valid = false;
+                float elevation = 0;
+                sick_scan_xd::PolarToCartesianTable& table = table_cache.lookup(msg.angle_min, msg.angle_increment, echo_values, 1.0f, 0.0f, &elevation, 1, 0, table_valid);
+                if (!table_valid)
+                    fillTable(table, msg, echo_values);
+                decode_buffer.resizeEchoPoints(echo_values);
+                for (int echo_idx = 0; echo_idx < echos_decoded; echo_idx++)
+                {
+                    decode_buffer.convertEcho(echo_idx, echo_values, range_filter, table, 0, true);
+                    if (!checkEchoPoints(decode_buffer.echo_range.data(), decode_buffer.echo_valid.data(), decode_buffer.echo_x.data(), decode_buffer.echo_y.data(), decode_buffer.echo_z.data(), table, echo_idx, num_points))
+                        echo_errors[mode]++;
+                }
+            }
+            s_count_allocations = false;
+            success = success && (echos_decoded == num_echos);
+        }
+        allocations[mode] = s_allocation_cnt;
+        s_allocation_cnt = 0;
+    }
+    success = success && echo_errors[0] == 0 && echo_errors[1] == 0 && allocations[1] == 0;
+    ROS_INFO_STREAM("scan_decode_allocation_test: " << iterations << " telegrams x " << num_points << " points x " << num_echos << " echos");
+    ROS_INFO_STREAM("scan_decode_allocation_test: previous implementation: " << ((double)allocations[0] / iterations) << " allocations per telegram");
+    ROS_INFO_STREAM("scan_decode_allocation_test: ScanDecodeBuffer:        " << ((double)allocations[1] / iterations) << " allocations per telegram");
+    ROS_INFO_STREAM("scan_decode_allocation_test: echos different from telegram: " << echo_errors[0] << " (previous implementation), " << echo_errors[1] << " (ScanDecodeBuffer), " << (success ? "passed" : "failed"));
+    return success ? 0 : 1;
+}
@@ -68,6 +68,21 @@ static SickScanApiRegisterPolarPointCloudMsg_PROCTYPE ptSickScanApiRegisterPolar
 typedef int32_t(*SickScanApiDeregisterPolarPointCloudMsg_PROCTYPE)(SickScanApiHandle apiHandle, SickScanPointCloudMsgCallback callback);
 static SickScanApiDeregisterPolarPointCloudMsg_PROCTYPE ptSickScanApiDeregisterPolarPointCloudMsg = 0;
 
+typedef int32_t(*SickScanApiRegisterCartesianPointCloudMsgZeroCopy_PROCTYPE)(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+static SickScanApiRegisterCartesianPointCloudMsgZeroCopy_PROCTYPE ptSickScanApiRegisterCartesianPointCloudMsgZeroCopy = 0;
+
+typedef int32_t(*SickScanApiDeregisterCartesianPointCloudMsgZeroCopy_PROCTYPE)(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+static SickScanApiDeregisterCartesianPointCloudMsgZeroCopy_PROCTYPE ptSickScanApiDeregisterCartesianPointCloudMsgZeroCopy = 0;
+
+typedef int32_t(*SickScanApiRegisterPolarPointCloudMsgZeroCopy_PROCTYPE)(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+static SickScanApiRegisterPolarPointCloudMsgZeroCopy_PROCTYPE ptSickScanApiRegisterPolarPointCloudMsgZeroCopy = 0;
+
+typedef int32_t(*SickScanApiDeregisterPolarPointCloudMsgZeroCopy_PROCTYPE)(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback);
+static SickScanApiDeregisterPolarPointCloudMsgZeroCopy_PROCTYPE ptSickScanApiDeregisterPolarPointCloudMsgZeroCopy = 0;
+
+typedef int32_t(*SickScanApiReleasePointCloudBuffer_PROCTYPE)(SickScanApiHandle apiHandle, uint64_t buffer_handle);
+static SickScanApiReleasePointCloudBuffer_PROCTYPE ptSickScanApiReleasePointCloudBuffer = 0;
+
 typedef int32_t(*SickScanApiRegisterImuMsg_PROCTYPE)(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback);
 static SickScanApiRegisterImuMsg_PROCTYPE ptSickScanApiRegisterImuMsg = 0;
 
@@ -243,6 +258,11 @@ int32_t SickScanApiUnloadLibrary()
     ptSickScanApiDeregisterCartesianPointCloudMsg = 0;
     ptSickScanApiRegisterPolarPointCloudMsg = 0;
     ptSickScanApiDeregisterPolarPointCloudMsg = 0;
+    ptSickScanApiRegisterCartesianPointCloudMsgZeroCopy = 0;
+    ptSickScanApiDeregisterCartesianPointCloudMsgZeroCopy = 0;
+    ptSickScanApiRegisterPolarPointCloudMsgZeroCopy = 0;
+    ptSickScanApiDeregisterPolarPointCloudMsgZeroCopy = 0;
+    ptSickScanApiReleasePointCloudBuffer = 0;
     ptSickScanApiRegisterImuMsg = 0;
     ptSickScanApiDeregisterImuMsg = 0;
     ptSickScanApiRegisterLFErecMsg = 0;
@@ -393,6 +413,48 @@ int32_t SickScanApiDeregisterPolarPointCloudMsg(SickScanApiHandle apiHandle, Sic
     return ret;
 }
 
+// Register / deregister a zero-copy callback for cartesian resp. polar PointCloud messages, release the pointcloud buffer after use
+int32_t SickScanApiRegisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    CACHE_FUNCTION_PTR(apiHandle, ptSickScanApiRegisterCartesianPointCloudMsgZeroCopy, "SickScanApiRegisterCartesianPointCloudMsgZeroCopy", SickScanApiRegisterCartesianPointCloudMsgZeroCopy_PROCTYPE);
+    int32_t ret = (ptSickScanApiRegisterCartesianPointCloudMsgZeroCopy ? (ptSickScanApiRegisterCartesianPointCloudMsgZeroCopy(apiHandle, callback)) : SICK_SCAN_API_NOT_INITIALIZED);
+    if (ret != SICK_SCAN_API_SUCCESS)
+        printf("## ERROR SickScanApiRegisterCartesianPointCloudMsgZeroCopy: library call SickScanApiRegisterCartesianPointCloudMsgZeroCopy() failed, error code %d\n", ret);
+    return ret;
+}
+int32_t SickScanApiDeregisterCartesianPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    CACHE_FUNCTION_PTR(apiHandle, ptSickScanApiDeregisterCartesianPointCloudMsgZeroCopy, "SickScanApiDeregisterCartesianPointCloudMsgZeroCopy", SickScanApiDeregisterCartesianPointCloudMsgZeroCopy_PROCTYPE);
+    int32_t ret = (ptSickScanApiDeregisterCartesianPointCloudMsgZeroCopy ? (ptSickScanApiDeregisterCartesianPointCloudMsgZeroCopy(apiHandle, callback)) : SICK_SCAN_API_NOT_INITIALIZED);
+    if (ret != SICK_SCAN_API_SUCCESS)
+        printf("## ERROR SickScanApiDeregisterCartesianPointCloudMsgZeroCopy: library call SickScanApiDeregisterCartesianPointCloudMsgZeroCopy() failed, error code %d\n", ret);
+    return ret;
+}
+int32_t SickScanApiRegisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    CACHE_FUNCTION_PTR(apiHandle, ptSickScanApiRegisterPolarPointCloudMsgZeroCopy, "SickScanApiRegisterPolarPointCloudMsgZeroCopy", SickScanApiRegisterPolarPointCloudMsgZeroCopy_PROCTYPE);
+    int32_t ret = (ptSickScanApiRegisterPolarPointCloudMsgZeroCopy ? (ptSickScanApiRegisterPolarPointCloudMsgZeroCopy(apiHandle, callback)) : SICK_SCAN_API_NOT_INITIALIZED);
+    if (ret != SICK_SCAN_API_SUCCESS)
+        printf("## ERROR SickScanApiRegisterPolarPointCloudMsgZeroCopy: library call SickScanApiRegisterPolarPointCloudMsgZeroCopy() failed, error code %d\n", ret);
+    return ret;
+}
+int32_t SickScanApiDeregisterPolarPointCloudMsgZeroCopy(SickScanApiHandle apiHandle, SickScanPointCloudMsgZeroCopyCallback callback)
+{
+    CACHE_FUNCTION_PTR(apiHandle, ptSickScanApiDeregisterPolarPointCloudMsgZeroCopy, "SickScanApiDeregisterPolarPointCloudMsgZeroCopy", SickScanApiDeregisterPolarPointCloudMsgZeroCopy_PROCTYPE);
+    int32_t ret = (ptSickScanApiDeregisterPolarPointCloudMsgZeroCopy ? (ptSickScanApiDeregisterPolarPointCloudMsgZeroCopy(apiHandle, callback)) : SICK_SCAN_API_NOT_INITIALIZED);
+    if (ret != SICK_SCAN_API_SUCCESS)
+        printf("## ERROR SickScanApiDeregisterPolarPointCloudMsgZeroCopy: library call SickScanApiDeregisterPolarPointCloudMsgZeroCopy() failed, error code %d\n", ret);
+    return ret;
+}
+int32_t SickScanApiReleasePointCloudBuffer(SickScanApiHandle apiHandle, uint64_t buffer_handle)
+{
+    CACHE_FUNCTION_PTR(apiHandle, ptSickScanApiReleasePointCloudBuffer, "SickScanApiReleasePointCloudBuffer", SickScanApiReleasePointCloudBuffer_PROCTYPE);
+    int32_t ret = (ptSickScanApiReleasePointCloudBuffer ? (ptSickScanApiReleasePointCloudBuffer(apiHandle, buffer_handle)) : SICK_SCAN_API_NOT_INITIALIZED);
+    if (ret != SICK_SCAN_API_SUCCESS)
+        printf("## ERROR SickScanApiReleasePointCloudBuffer: library call SickScanApiReleasePointCloudBuffer() failed, error code %d\n", ret);
+    return ret;
+}
+
 // Register / deregister a callback for Imu messages
 int32_t SickScanApiRegisterImuMsg(SickScanApiHandle apiHandle, SickScanImuMsgCallback callback)
 {
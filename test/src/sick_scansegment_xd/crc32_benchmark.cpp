@@ -0,0 +1,152 @@
+/*
+ * @brief crc32_benchmark tests and measures the CRC32 checksum of scansegment payloads in GB/s.
+ * It compares Crc32::Compute (runtime dispatched hardware or slice-by-8 implementation) and Crc32::ComputeSliceBy8
+ * with the bitwise reference implementation for all lengths and alignments up to 1024 bytes and reports the throughput.
+ *
+ * Usage: crc32_benchmark [-iterations=<number>] [-size=<bytes>]
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include "sick_scan/sick_ros_wrapper.h"
+#include "sick_scansegment_xd/crc32.h"
+
+typedef std::chrono::high_resolution_clock benchmark_clock;
+
+/*
+ * Returns the time in seconds between two timestamps
+ */
+static double seconds(const benchmark_clock::time_point& start, const benchmark_clock::time_point& end)
+{
+    return 1.0e-9 * std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+typedef uint32_t(*Crc32Function)(uint32_t crc, const uint8_t* buf, size_t len);
+
+/*
+ * Measures the throughput of a crc implementation in GB/s
+ */
+static double benchmark(Crc32Function crc32, const std::vector<uint8_t>& data, int iterations, uint32_t& crc)
+{
+    crc = 0;
+    benchmark_clock::time_point start_time = benchmark_clock::now();
+    for (int iteration = 0; iteration < iterations; iteration++)
+        crc ^= crc32(0, data.data(), data.size());
+    return 1.0e-9 * iterations * data.size() / std::max(seconds(start_time, benchmark_clock::now()), 1.0e-9);
+}
+
+/*
+ * main runs crc32_benchmark:
+ * - unittest: compare Crc32::Compute and Crc32::ComputeSliceBy8 with the bitwise reference for all lengths 0 to 1024 bytes, all alignments 0 to 15
+ *   and incremental checksums (crc of the previous block as initial crc), plus the known checksum of "123456789",
+ * - benchmark: checksum a random payload of a typical multiScan size and report GB/s for each implementation.
+ */
+int main(int argc, char** argv)
+{
+    int iterations = 1000, size = 64 * 1024;
+    for (int n = 1; n < argc; n++)
+    {
+        std::string arg(argv[n]);
+        if (arg.find("-iterations=") == 0)
+            iterations = std::max(1, std::stoi(arg.substr(12)));
+        else if (arg.find("-size=") == 0)
+            size = std::max(1, std::stoi(arg.substr(6)));
+    }
+    std::mt19937 random_generator(42);
+    std::vector<uint8_t> data(std::max(size, 1024 + 16));
+    for (size_t n = 0; n < data.size(); n++)
+        data[n] = (uint8_t)(random_generator() & 0xff);
+
+    // Unittest
+    bool success = true;
+    const char* check_str = "123456789";
+    uint32_t check_crc = 0xcbf43926; // zlib.crc32(b"123456789")
+    if (sick_scansegment_xd::Crc32::Compute(0, (const uint8_t*)check_str, 9) != check_crc || sick_scansegment_xd::Crc32::ComputeSliceBy8(0, (const uint8_t*)check_str, 9) != check_crc)
+    {
+        ROS_ERROR_STREAM("## ERROR crc32_benchmark: crc32(\"123456789\") != 0x" << std::hex << check_crc);
+        success = false;
+    }
+    for (size_t offset = 0; success && offset < 16; offset++)
+    {
+        for (size_t len = 0; success && len <= 1024; len++)
+        {
+            uint32_t crc_expected = sick_scansegment_xd::Crc32::ComputeBitwise(0, data.data() + offset, len);
+            uint32_t crc_computed = sick_scansegment_xd::Crc32::Compute(0, data.data() + offset, len);
+            uint32_t crc_slice_by_8 = sick_scansegment_xd::Crc32::ComputeSliceBy8(0, data.data() + offset, len);
+            size_t len1 = len / 3; // incremental checksum of 2 blocks
+            uint32_t crc_incremental = sick_scansegment_xd::Crc32::Compute(sick_scansegment_xd::Crc32::Compute(0, data.data() + offset, len1), data.data() + offset + len1, len - len1);
+            if (crc_computed != crc_expected || crc_slice_by_8 != crc_expected || crc_incremental != crc_expected)
+            {
+                ROS_ERROR_STREAM("## ERROR crc32_benchmark: offset " << offset << ", length " << len << ": crc 0x" << std::hex << crc_computed << ", slice-by-8 0x" << crc_slice_by_8
+                    << ", incremental 0x" << crc_incremental << " different to bitwise reference 0x" << crc_expected);
+                success = false;
+            }
+        }
+    }
+
+    // Benchmark
+    data.resize(size);
+    uint32_t crc_bitwise = 0, crc_slice_by_8 = 0, crc_computed = 0;
+    double gbps_bitwise = benchmark(sick_scansegment_xd::Crc32::ComputeBitwise, data, std::max(1, iterations / 10), crc_bitwise);
+    double gbps_slice_by_8 = benchmark(sick_scansegment_xd::Crc32::ComputeSliceBy8, data, iterations, crc_slice_by_8);
+    double gbps_computed = benchmark(sick_scansegment_xd::Crc32::Compute, data, iterations, crc_computed);
+    if (sick_scansegment_xd::Crc32::ComputeBitwise(0, data.data(), data.size()) != sick_scansegment_xd::Crc32::Compute(0, data.data(), data.size()))
+        success = false;
+    ROS_INFO_STREAM("crc32_benchmark: " << iterations << " x " << size << " byte, implementation: " << sick_scansegment_xd::Crc32::Implementation());
+    ROS_INFO_STREAM("crc32_benchmark: bitwise:    " << std::fixed << std::setprecision(3) << gbps_bitwise << " GB/s");
+    ROS_INFO_STREAM("crc32_benchmark: slice-by-8: " << std::fixed << std::setprecision(3) << gbps_slice_by_8 << " GB/s");
+    ROS_INFO_STREAM("crc32_benchmark: " << sick_scansegment_xd::Crc32::Implementation() << ": " << std::fixed << std::setprecision(3) << gbps_computed << " GB/s");
+    ROS_INFO_STREAM("crc32_benchmark: unittest " << (success ? "passed" : "failed"));
+    return success ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*
+ * @brief msgpack_parser_benchmark compares the in place msgpack decoding of MsgPackParser with msgpack11 decoding.
+ *
+ * Usage example:
+ *
+ * msgpack_parser_benchmark -iterations=1000 udp_received_msg_001.msg udp_received_msg_002.msg
+ *
+ * Msgpack files can be recorded by sick_generic_caller with parameter export_udp_msg:=True (files udp_received_msg_<nnn>.msg).
+ * Without msgpack files on the commandline, the recorded multiScan samples in test/emulator/scandata are decoded,
+ * i.e. msgpack_parser_benchmark runs as a parity test of both decoders and returns 0 (passed) or 1 (failed):
+ *
+ * msgpack_parser_benchmark -iterations=10
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <sstream>
+#include "sick_scansegment_xd/msgpack_parser.h"
+
+#ifndef MSGPACK_SAMPLE_DIR
+#define MSGPACK_SAMPLE_DIR "./test/emulator/scandata" // default folder of the recorded msgpack samples, overwritten by CMakeLists.txt
+#endif
+
+/*
+ * Compares the scan points of two parser results, returns true if identical.
+ */
+static bool compareParserOutput(const sick_scansegment_xd::ScanSegmentParserOutput& output1, const sick_scansegment_xd::ScanSegmentParserOutput& output2)
+{
+    if (output1.segmentIndex != output2.segmentIndex || output1.telegramCnt != output2.telegramCnt || output1.scandata.size() != output2.scandata.size())
+        return false;
+    for (size_t groupIdx = 0; groupIdx < output1.scandata.size(); groupIdx++)
+    {
+        const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::Scanline>& scanlines1 = output1.scandata[groupIdx].scanlines;
+        const std::vector<sick_scansegment_xd::ScanSegmentParserOutput::Scanline>& scanlines2 = output2.scandata[groupIdx].scanlines;
+        if (scanlines1.size() != scanlines2.size())
+            return false;
+        for (size_t echoIdx = 0; echoIdx < scanlines1.size(); echoIdx++)
+        {
+            if (scanlines1[echoIdx].count != scanlines2[echoIdx].count)
+                return false;
+            for (size_t pointIdx = 0; pointIdx < scanlines1[echoIdx].count; pointIdx++)
+            {
+                sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint p1 = output1.points.get(scanlines1[echoIdx].start + pointIdx);
+                sick_scansegment_xd::ScanSegmentParserOutput::LidarPoint p2 = output2.points.get(scanlines2[echoIdx].start + pointIdx);
+                if (p1.x != p2.x || p1.y != p2.y || p1.z != p2.z || p1.i != p2.i || p1.range != p2.range || p1.azimuth != p2.azimuth || p1.elevation != p2.elevation 
+                    || p1.groupIdx != p2.groupIdx || p1.echoIdx != p2.echoIdx || p1.pointIdx != p2.pointIdx || p1.reflectorbit != p2.reflectorbit)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * main runs msgpack_parser_benchmark:
+ * - read all msgpack files given on the commandline (default: recorded multiScan samples with 1 and 3 echos),
+ * - decode each file by MsgPackParser::Parse(const std::vector<uint8_t>&) (in place decoding) and MsgPackParser::Parse(std::istream&) (msgpack11),
+ * - compare the results and report the decoding times.
+ */
+int main(int argc, char** argv)
+{
+    int iterations = 1000;
+    std::vector<std::string> msgpack_files;
+    for (int n = 1; n < argc; n++)
+    {
+        std::string arg(argv[n]);
+        if (arg.find("-iterations=") == 0)
+            iterations = std::max(1, std::stoi(arg.substr(12)));
+        else
+            msgpack_files.push_back(arg);
+    }
+    if (msgpack_files.empty())
+    {
+        msgpack_files.push_back(std::string(MSGPACK_SAMPLE_DIR) + "/multiscan_msgpack_1echo.msg");
+        msgpack_files.push_back(std::string(MSGPACK_SAMPLE_DIR) + "/multiscan_msgpack_3echos.msg");
+    }
+    sick_scan_xd::SickCloudTransform add_transform_xyz_rpy;
+    sick_scansegment_xd::MsgPackValidatorData msgpack_validator_data_collector;
+    bool success = true;
+    for (size_t file_cnt = 0; file_cnt < msgpack_files.size(); file_cnt++)
+    {
+        std::vector<uint8_t> msgpack_data = sick_scansegment_xd::MsgPackParser::ReadFile(msgpack_files[file_cnt]);
+        if (msgpack_data.empty())
+        {
+            ROS_ERROR_STREAM("## ERROR msgpack_parser_benchmark: can't read file \"" << msgpack_files[file_cnt] << "\"");
+            success = false;
+            continue;
+        }
+        fifo_timestamp msgpack_timestamp = fifo_clock::now();
+        sick_scansegment_xd::ScanSegmentParserOutput output_inplace, output_msgpack11;
+        double seconds_inplace = 0, seconds_msgpack11 = 0;
+        for (int iteration = 0; iteration < iterations; iteration++)
+        {
+            // In place decoding (default)
+            output_inplace = sick_scansegment_xd::ScanSegmentParserOutput();
+            fifo_timestamp start_time = fifo_clock::now();
+            bool success_inplace = sick_scansegment_xd::MsgPackParser::Parse(msgpack_data, msgpack_timestamp, add_transform_xyz_rpy, output_inplace, msgpack_validator_data_collector,
+                sick_scansegment_xd::MsgPackValidator(), false, false, false, false);
+            seconds_inplace += sick_scansegment_xd::Seconds(start_time, fifo_clock::now());
+            // Decoding by msgpack11 (fallback)
+            output_msgpack11 = sick_scansegment_xd::ScanSegmentParserOutput();
+            start_time = fifo_clock::now();
+            std::istringstream msgpack_istream(std::string((const char*)msgpack_data.data(), msgpack_data.size()));
+            bool success_msgpack11 = sick_scansegment_xd::MsgPackParser::Parse(msgpack_istream, msgpack_timestamp, add_transform_xyz_rpy, output_msgpack11, msgpack_validator_data_collector,
+                sick_scansegment_xd::MsgPackValidator(), false, false, false, false);
+            seconds_msgpack11 += sick_scansegment_xd::Seconds(start_time, fifo_clock::now());
+            if (!success_inplace || !success_msgpack11)
+            {
+                ROS_ERROR_STREAM("## ERROR msgpack_parser_benchmark: MsgPackParser::Parse(\"" << msgpack_files[file_cnt] << "\") failed");
+                success = false;
+                break;
+            }
+        }
+        if (output_inplace.scandata.empty() || output_inplace.points.size() == 0)
+        {
+            ROS_ERROR_STREAM("## ERROR msgpack_parser_benchmark: no scan points decoded from \"" << msgpack_files[file_cnt] << "\"");
+            success = false;
+        }
+        else if (!compareParserOutput(output_inplace, output_msgpack11))
+        {
+            ROS_ERROR_STREAM("## ERROR msgpack_parser_benchmark: different results of in place decoding and msgpack11 decoding of \"" << msgpack_files[file_cnt] << "\"");
+            success = false;
+        }
+        ROS_INFO_STREAM("msgpack_parser_benchmark: \"" << msgpack_files[file_cnt] << "\" (" << msgpack_data.size() << " byte): "
+            << std::fixed << std::setprecision(3) << (1.0e6 * seconds_inplace / iterations) << " microsec in place decoding, "
+            << (1.0e6 * seconds_msgpack11 / iterations) << " microsec msgpack11 decoding, speedup " << (seconds_msgpack11 / std::max(seconds_inplace, 1.0e-9)));
+    }
+    ROS_INFO_STREAM("msgpack_parser_benchmark " << (success ? "passed" : "failed"));
+    return success ? 0 : 1;
+}
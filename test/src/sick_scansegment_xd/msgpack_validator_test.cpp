@@ -0,0 +1,204 @@
+/*
+ * @brief msgpack_validator_test checks that msgpack validation data collected by several parser threads and merged
+ * by MsgPackValidatorData::update() in order of arrival are identical to the data collected by one thread.
+ * Scan points are generated for 300 random configurations of echos, segments, layers and azimuth and elevation limits,
+ * including unexpected echos, segments and layers and missing scan data. For each configuration, the point counts,
+ * out of bounds counts and out of bounds records (incl. their index) and the validation results of the merged data
+ * are compared to the single thread data. The test returns 0 if all checks passed.
+ *
+ * Usage: msgpack_validator_test
+ *
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "sick_scan/sick_ros_wrapper.h"
+#include "sick_scansegment_xd/msgpack_validator.h"
+
+/*
+ * Generated scan point
+ */
+struct ValidatorTestPoint
+{
+    int echo_idx;
+    int segment_idx;
+    float azimuth;
+    float elevation;
+};
+
+static float normalizeTestAngle(float angle)
+{
+    while (angle > (float)M_PI)
+        angle -= (float)(2.0 * M_PI);
+    while (angle < (float)(-M_PI))
+        angle += (float)(2.0 * M_PI);
+    return angle;
+}
+
+/*
+ * Compares the out of bounds records of merged and single thread data
+ */
+static bool equalOutOfBoundsRecords(const std::vector<sick_scansegment_xd::MsgPackValidatorData::OutOfBoundsRecord>& records1, const std::vector<sick_scansegment_xd::MsgPackValidatorData::OutOfBoundsRecord>& records2)
+{
+    if (records1.size() != records2.size())
+        return false;
+    for (size_t n = 0; n < records1.size(); n++)
+    {
+        if (records1[n].out_of_bounds_idx != records2[n].out_of_bounds_idx || records1[n].reason != records2[n].reason || records1[n].echo_idx != records2[n].echo_idx
+            || records1[n].segment_idx != records2[n].segment_idx || records1[n].elevation_idx != records2[n].elevation_idx || records1[n].azimuth_idx != records2[n].azimuth_idx)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 random_generator(1);
+    int num_configurations = 300, num_errors = 0;
+    for (int config_cnt = 0; config_cnt < num_configurations; config_cnt++)
+    {
+        // Random validator configuration
+        std::vector<int> echos = (random_generator() % 2) ? std::vector<int>{ 0 } : std::vector<int>{ 0, 1, 2 };
+        float azimuth_start = (random_generator() % 3 == 0) ? (float)(-M_PI / 2) : (float)(-M_PI);
+        float azimuth_end = (random_generator() % 3 == 0) ? (float)(M_PI / 3) : (float)(M_PI);
+        float elevation_start = (float)(-M_PI / 2);
+        float elevation_end = (random_generator() % 4 == 0) ? 0.5f : (float)(M_PI / 2);
+        int num_segments = (random_generator() % 2) ? 12 : 9;
+        std::vector<int> segments;
+        for (int n = 0; n < num_segments; n++)
+            segments.push_back(n);
+        int num_layers = (random_generator() % 3 == 0) ? 1 : 16;
+        std::vector<int> layers(num_layers, 1);
+        sick_scansegment_xd::MsgPackValidator validator(echos, azimuth_start, azimuth_end, elevation_start, elevation_end, segments, layers, 0);
+        bool full_range = (azimuth_start <= (float)(-M_PI) && azimuth_end >= (float)(M_PI) && elevation_end >= (float)(M_PI / 2));
+
+        // Random scan data with unexpected echos, segments and layers and missing scan points
+        int data_echos = (random_generator() % 5 == 0) ? 3 : (int)echos.size();
+        int data_segments = num_segments + ((random_generator() % 5 == 0) ? 1 : 0);
+        int data_layers = num_layers - ((random_generator() % 6 == 0) ? 1 : 0);
+        bool data_gap = (random_generator() % 4 == 0);
+        float gap_azimuth = (float)((int)(random_generator() % 300) - 150) * (float)(M_PI / 180);
+        float azimuth_resolution = 0.125f * (float)(M_PI / 180), segment_width = (float)(2 * M_PI) / num_segments;
+        std::vector<ValidatorTestPoint> points;
+        std::vector<size_t> expected_point_cnt(3, 0); // points of valid echos and segments
+        size_t expected_out_of_bounds_cnt = 0;        // points of unexpected echos or segments
+        for (int echo_idx = 0; echo_idx < data_echos; echo_idx++)
+        {
+            for (int segment_idx = 0; segment_idx < data_segments; segment_idx++)
+            {
+                for (int layer_idx = 0; layer_idx < data_layers; layer_idx++)
+                {
+                    float elevation = (num_layers == 1) ? 0.0f : (-22.2f + layer_idx * 5.6f) * (float)(M_PI / 180);
+                    for (float azimuth = (float)(-M_PI) + segment_idx * segment_width; azimuth < (float)(-M_PI) + (segment_idx + 1) * segment_width; azimuth += azimuth_resolution)
+                    {
+                        ValidatorTestPoint point = { echo_idx, segment_idx, normalizeTestAngle(azimuth), elevation };
+                        if (data_gap && layer_idx == 3 && std::fabs(point.azimuth - gap_azimuth) < 3 * (float)(M_PI / 180))
+                            continue;
+                        points.push_back(point);
+                        if (echo_idx < (int)echos.size() && segment_idx < num_segments)
+                            expected_point_cnt[echo_idx]++;
+                        else
+                            expected_out_of_bounds_cnt++;
+                    }
+                }
+            }
+        }
+
+        // Collect all points in one thread
+        sick_scansegment_xd::MsgPackValidatorData single_data;
+        validator.initValidatorData(single_data);
+        for (size_t n = 0; n < points.size(); n++)
+            single_data.update(points[n].echo_idx, points[n].segment_idx, points[n].azimuth, points[n].elevation);
+
+        // Collect consecutive chunks of points in up to 4 parser threads and merge them in order of arrival
+        sick_scansegment_xd::MsgPackValidatorData merged_data, thread_data;
+        if (config_cnt % 2)
+            validator.initValidatorData(merged_data); // otherwise merged_data takes the counter layout of the first thread data
+        int num_threads = 1 + random_generator() % 4;
+        std::vector<size_t> chunk_end;
+        for (int n = 0; n + 1 < num_threads; n++)
+            chunk_end.push_back(random_generator() % (points.size() + 1));
+        chunk_end.push_back(points.size());
+        std::sort(chunk_end.begin(), chunk_end.end());
+        for (size_t chunk_idx = 0, point_idx = 0; chunk_idx < chunk_end.size(); chunk_idx++)
+        {
+            validator.initValidatorData(thread_data);
+            for ( ; point_idx < chunk_end[chunk_idx]; point_idx++)
+                thread_data.update(points[point_idx].echo_idx, points[point_idx].segment_idx, points[point_idx].azimuth, points[point_idx].elevation);
+            merged_data.update(thread_data);
+        }
+
+        // Compare merged data with single thread data
+        bool success = true;
+        for (int echo_idx = 0; echo_idx < 3; echo_idx++)
+            success = success && merged_data.getPointCount(echo_idx) == single_data.getPointCount(echo_idx) && single_data.getPointCount(echo_idx) == expected_point_cnt[echo_idx];
+        success = success && merged_data.getOutOfBoundsCount() == single_data.getOutOfBoundsCount();
+        success = success && (full_range ? (single_data.getOutOfBoundsCount() == expected_out_of_bounds_cnt) : (single_data.getOutOfBoundsCount() >= expected_out_of_bounds_cnt));
+        success = success && equalOutOfBoundsRecords(merged_data.getOutOfBoundsRecords(), single_data.getOutOfBoundsRecords());
+        success = success && validator.validateNotOutOfBound(merged_data) == validator.validateNotOutOfBound(single_data);
+        success = success && validator.validateNoMissingScandata(merged_data) == validator.validateNoMissingScandata(single_data);
+        if (!success)
+        {
+            ROS_ERROR_STREAM("## ERROR msgpack_validator_test: configuration " << config_cnt << " failed (" << echos.size() << " echos, " << num_segments << " segments, " << num_layers << " layers, "
+                << num_threads << " threads, " << points.size() << " points, " << single_data.getOutOfBoundsCount() << " points out of bounds)");
+            num_errors++;
+        }
+    }
+
+    if (num_errors == 0)
+        ROS_INFO_STREAM("msgpack_validator_test passed (" << num_configurations << " configurations)");
+    else
+        ROS_ERROR_STREAM("## ERROR msgpack_validator_test failed (" << num_errors << " of " << num_configurations << " configurations)");
+    return num_errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+/*
+ * @brief tcp_timestamp_jitter_test measures the jitter of tcp receive timestamps.
+ * A local sender thread emulates a lidar and sends small datagrams with its send time in fixed intervals.
+ * The Tcp client stamps the received data with kernel receive timestamps (Tcp::getReceiveTimestamp) and with
+ * the system time in the read callback, while the read callback is delayed and cpu load threads are running.
+ * The test reports the standard deviation of the latency (receive timestamp - send time) for both timestamps.
+ *
+ * Usage: tcp_timestamp_jitter_test [-datagrams=<number>] [-interval_ms=<milliseconds>] [-load_threads=<number>]
+ *
+ * Copyright (C) 2020,2021 Ing.-Buero Dr. Michael Lehning, Hildesheim
+ * Copyright (C) 2020,2021 SICK AG, Waldkirch
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of SICK AG nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *     * Neither the name of Ing.-Buero Dr. Michael Lehning nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *      Authors:
+ *         Michael Lehning <michael.lehning@lehning.de>
+ *
+ *  Copyright 2020 SICK AG
+ *  Copyright 2020 Ing.-Buero Dr. Michael Lehning
+ *
+ */
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#ifndef _MSC_VER
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#endif
+#include "sick_scan/sick_ros_wrapper.h"
+#include "sick_scan/tcp/tcp.hpp"
+
+#ifndef _MSC_VER
+
+/*
+ * Datagram sent by the sender thread: start marker and send time in nanoseconds
+ */
+#pragma pack(push,1)
+struct JitterTestDatagram
+{
+    uint32_t marker;
+    uint64_t send_time_nsec;
+    uint8_t payload[52];
+};
+#pragma pack(pop)
+static const uint32_t JITTER_TEST_MARKER = 0x02020202;
+
+/*
+ * Receiver state shared with the Tcp read callback
+ */
+struct JitterTestReceiver
+{
+    Tcp* tcp = 0;
+    std::vector<double> latency_kernel_stamp;   // kernel receive timestamp - send time in seconds
+    std::vector<double> latency_callback_stamp; // system time in read callback - send time in seconds
+    std::mt19937 random_generator{ 42 };
+    int max_callback_delay_us = 0;
+};
+
+/*
+ * Tcp read callback: stamps the last datagram of the received data and simulates datagram processing with a random delay
+ */
+static void readCallback(void* obj, UINT8* buffer, UINT32& numOfBytes)
+{
+    JitterTestReceiver* receiver = (JitterTestReceiver*)obj;
+    double callback_time = rosTimeToSeconds(rosTimeNow());
+    double kernel_time = rosTimeToSeconds(receiver->tcp->getReceiveTimestamp());
+    if (numOfBytes >= sizeof(JitterTestDatagram) && (numOfBytes % sizeof(JitterTestDatagram)) == 0)
+    {
+        JitterTestDatagram datagram;
+        memcpy(&datagram, buffer + numOfBytes - sizeof(JitterTestDatagram), sizeof(datagram));
+        if (datagram.marker == JITTER_TEST_MARKER)
+        {
+            double send_time = 1.0e-9 * datagram.send_time_nsec;
+            receiver->latency_kernel_stamp.push_back(kernel_time - send_time);
+            receiver->latency_callback_stamp.push_back(callback_time - send_time);
+        }
+    }
+    if (receiver->max_callback_delay_us > 0)
+        std::this_thread::sleep_for(std::chrono::microseconds(receiver->random_generator() % receiver->max_callback_delay_us));
+}
+
+/*
+ * Returns the mean and standard deviation of a list of values
+ */
+static void meanStddev(const std::vector<double>& values, double& mean, double& stddev)
+{
+    mean = 0, stddev = 0;
+    for (size_t n = 0; n < values.size(); n++)
+        mean += values[n];
+    mean /= std::max((size_t)1, values.size());
+    for (size_t n = 0; n < values.size(); n++)
+        stddev += (values[n] - mean) * (values[n] - mean);
+    stddev = std::sqrt(stddev / std::max((size_t)1, values.size()));
+}
+
+/*
+ * main runs tcp_timestamp_jitter_test
+ */
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "tcp_timestamp_jitter_test");
+    int num_datagrams = 500, interval_ms = 10, num_load_threads = (int)std::thread::hardware_concurrency();
+    for (int n = 1; n < argc; n++)
+    {
+        std::string arg(argv[n]);
+        if (arg.find("-datagrams=") == 0)
+            num_datagrams = std::max(1, std::stoi(arg.substr(11)));
+        else if (arg.find("-interval_ms=") == 0)
+            interval_ms = std::max(1, std::stoi(arg.substr(13)));
+        else if (arg.find("-load_threads=") == 0)
+            num_load_threads = std::max(0, std::stoi(arg.substr(14)));
+    }
+
+    // Sender: listen on a local port and send datagrams with their send time in fixed intervals
+    int server_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in server_addr;
+    memset(&server_addr, 0, sizeof(server_addr));
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    server_addr.sin_port = 0;
+    socklen_t addr_len = sizeof(server_addr);
+    if (server_socket < 0 || bind(server_socket, (struct sockaddr*)&server_addr, sizeof(server_addr)) != 0 || listen(server_socket, 1) != 0
+        || getsockname(server_socket, (struct sockaddr*)&server_addr, &addr_len) != 0)
+    {
+        ROS_ERROR_STREAM("## ERROR tcp_timestamp_jitter_test: failed to create server socket");
+        return 1;
+    }
+    std::thread sender_thread([&]()
+        {
+            int client_socket = accept(server_socket, 0, 0);
+            int nodelay = 1;
+            setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            JitterTestDatagram datagram;
+            memset(&datagram, 0, sizeof(datagram));
+            datagram.marker = JITTER_TEST_MARKER;
+            std::chrono::steady_clock::time_point send_time = std::chrono::steady_clock::now();
+            for (int n = 0; n < num_datagrams; n++)
+            {
+                send_time += std::chrono::milliseconds(interval_ms);
+                std::this_thread::sleep_until(send_time);
+                datagram.send_time_nsec = rosNanosecTimestampNow();
+                if (send(client_socket, &datagram, sizeof(datagram), 0) != sizeof(datagram))
+                    break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ::close(client_socket);
+        });
+
+    // Cpu load
+    std::atomic<bool> run_load_threads(true);
+    std::vector<std::thread> load_threads;
+    for (int n = 0; n < num_load_threads; n++)
+        load_threads.push_back(std::thread([&]() { volatile uint64_t cnt = 0; while (run_load_threads) cnt = cnt + 1; }));
+
+    // Receiver with delayed read callback
+    Tcp tcp;
+    JitterTestReceiver receiver;
+    receiver.tcp = &tcp;
+    receiver.max_callback_delay_us = 1500 * interval_ms; // delays up to 1.5 intervals: the next datagram is waiting in the socket, when the read thread is busy
+    tcp.setReadCallbackFunction(readCallback, &receiver);
+    bool success = tcp.open("127.0.0.1", ntohs(server_addr.sin_port));
+    sender_thread.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * interval_ms));
+    tcp.close();
+    ::close(server_socket);
+    run_load_threads = false;
+    for (size_t n = 0; n < load_threads.size(); n++)
+        load_threads[n].join();
+
+    // Jitter of kernel and callback timestamps
+    double mean_kernel = 0, stddev_kernel = 0, mean_callback = 0, stddev_callback = 0;
+    meanStddev(receiver.latency_kernel_stamp, mean_kernel, stddev_kernel);
+    meanStddev(receiver.latency_callback_stamp, mean_callback, stddev_callback);
+    success = success && !receiver.latency_kernel_stamp.empty() && stddev_kernel <= stddev_callback;
+    ROS_INFO_STREAM("tcp_timestamp_jitter_test: " << receiver.latency_kernel_stamp.size() << " of " << num_datagrams << " datagrams stamped, "
+        << num_load_threads << " load threads, callback delay up to " << (0.001 * receiver.max_callback_delay_us) << " ms");
+    ROS_INFO_STREAM("tcp_timestamp_jitter_test: kernel receive timestamp: latency " << std::fixed << std::setprecision(3) << (1000.0 * mean_kernel) << " ms, jitter " << (1000.0 * stddev_kernel) << " ms");
+    ROS_INFO_STREAM("tcp_timestamp_jitter_test: read callback timestamp:  latency " << std::fixed << std::setprecision(3) << (1000.0 * mean_callback) << " ms, jitter " << (1000.0 * stddev_callback) << " ms");
+    ROS_INFO_STREAM("tcp_timestamp_jitter_test: " << (success ? "passed" : "failed"));
+    return success ? 0 : 1;
+}
+
+#else // _MSC_VER
+
+int main(int argc, char** argv)
+{
+    ROS_WARN_STREAM("tcp_timestamp_jitter_test: kernel receive timestamps not supported on Windows");
+    return 0;
+}
+
+#endif // _MSC_VER